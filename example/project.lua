@@ -15,6 +15,7 @@ project(ProjectName)
     ignoredefaultlibraries { "msvcrt" }
   filter { "system:linux" }
     cppdialect "C++11"
+    links { "pthread" }
   filter { }
   
   defines { "_CRT_SECURE_NO_WARNINGS", "SSE2" }
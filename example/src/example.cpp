@@ -33,30 +33,329 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef _DEBUG
+#if defined(_DEBUG) && defined(_MSC_VER)
 #define DBG_BREAK() __debugbreak()
 #else
 #define DBG_BREAK()
 #endif
 
-#define FATAL(x, ...) do { printf(x "\n", __VA_ARGS__); DBG_BREAK(); exit(-1); } while (0)
-#define FATAL_IF(conditional, x, ...) do { if (conditional) { FATAL(x, __VA_ARGS__); } } while (0)
+// The format string is part of `__VA_ARGS__`, so messages without arguments don't leave a trailing comma.
+#define FATAL(...) do { printf(__VA_ARGS__); puts(""); DBG_BREAK(); exit(-1); } while (0)
+#define FATAL_IF(conditional, ...) do { if (conditional) { FATAL(__VA_ARGS__); } } while (0)
 
 ////////////////////////////////////////////////////////////////////////////////
 
 static const char ArgumentNoContext[] = "--no-context";
 static const char ArgumentLinearContext[] = "--linear";
 static const char ArgumentLoopMode[] = "--loop";
+static const char ArgumentControlFlowGraphMode[] = "--cfg";
+static const char ArgumentLoopNestMode[] = "--loop-nest";
 static const char ArgumentNoSimplification[] = "--no-simplify";
+static const char ArgumentFuseFlags[] = "--fuse-flags";
+static const char ArgumentCollapseUnrolled[] = "--collapse-unrolled";
 static const char ArgumentIsaSet[] = "--isa";
 static const char ArgumentAfterCallRegisterRetentionWindows[] = "--register-retention=windows";
 static const char ArgumentAfterCallRegisterRetentionLinux[] = "--register-retention=linux";
+static const char ArgumentBenchmark[] = "--benchmark";
+static const char ArgumentStream[] = "--stream";
+static const char ArgumentHugePages[] = "--huge-pages";
+static const char ArgumentThreads[] = "--threads";
+static const char StdinFilename[] = "-";
 
 static bool LinearMode = true;
 static bool LoopMode = false;
+static bool ControlFlowGraphMode = false;
+static bool LoopNestMode = false;
+static bool CollapseUnrolledMode = false;
 static bool ShowIsaSet = false;
+static bool BenchmarkMode = false;
+static bool StreamMode = false;
+static bool UseHugePages = false;
+static size_t ThreadCount = 0; // Translates partitions of the file on this many threads up front, if set.
+
+constexpr size_t BenchmarkIterations = 64;
+constexpr size_t StreamBufferSize = 64 * 1024;
+constexpr size_t AddressDisplayOffset = 0x140000000;
+constexpr size_t MinPartitionSize = 16 * 1024; // Independent of the thread count, so the partitions & therefore the output are too.
+
+////////////////////////////////////////////////////////////////////////////////
+
+// A read-only view of the whole input file, so translation can start without copying it first.
+struct MappedFile
+{
+  const uint8_t *pData = nullptr;
+  size_t size = 0;
+
+#ifdef _WIN32
+  HANDLE file = INVALID_HANDLE_VALUE;
+  HANDLE mapping = nullptr;
+#endif
+};
+
+static bool MapFile(MappedFile *pMappedFile, const char *filename, const bool hugePages)
+{
+#ifdef _WIN32
+  (void)hugePages; // Large pages aren't available for file backed views.
+
+  pMappedFile->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+  if (pMappedFile->file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER fileSize;
+
+  if (!GetFileSizeEx(pMappedFile->file, &fileSize) || fileSize.QuadPart == 0)
+    return false;
+
+  pMappedFile->size = (size_t)fileSize.QuadPart;
+  pMappedFile->mapping = CreateFileMappingA(pMappedFile->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (pMappedFile->mapping == nullptr)
+    return false;
+
+  pMappedFile->pData = reinterpret_cast<const uint8_t *>(MapViewOfFile(pMappedFile->mapping, FILE_MAP_READ, 0, 0, 0));
+
+  return pMappedFile->pData != nullptr;
+#else
+  const int fd = open(filename, O_RDONLY);
+
+  if (fd < 0)
+    return false;
+
+  struct stat fileStat;
+
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  pMappedFile->size = (size_t)fileStat.st_size;
+
+  void *pMapping = mmap(nullptr, pMappedFile->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); // The mapping keeps the file alive.
+
+  if (pMapping == MAP_FAILED)
+    return false;
+
+  pMappedFile->pData = reinterpret_cast<const uint8_t *>(pMapping);
+
+  // Only hints, so failures don't matter.
+  madvise(pMapping, pMappedFile->size, MADV_SEQUENTIAL);
+
+#ifdef MADV_HUGEPAGE
+  if (hugePages)
+    madvise(pMapping, pMappedFile->size, MADV_HUGEPAGE);
+#else
+  (void)hugePages;
+#endif
+
+  return true;
+#endif
+}
+
+static void UnmapFile(MappedFile *pMappedFile)
+{
+#ifdef _WIN32
+  if (pMappedFile->pData != nullptr)
+    UnmapViewOfFile(pMappedFile->pData);
+
+  if (pMappedFile->mapping != nullptr)
+    CloseHandle(pMappedFile->mapping);
+
+  if (pMappedFile->file != INVALID_HANDLE_VALUE)
+    CloseHandle(pMappedFile->file);
+#else
+  if (pMappedFile->pData != nullptr)
+    munmap(const_cast<uint8_t *>(pMappedFile->pData), pMappedFile->size);
+#endif
+
+  *pMappedFile = MappedFile();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Decodes, disassembles & translates the instruction at the start of `pCode` and prints it. Returns the length of the instruction.
+// Prints `pTranslation` instead if the instruction has already been translated with the rest of its block.
+static size_t PrintInstruction(ZydecTranslator *pTranslator, const ZydisDecoder *pDecoder, const ZydisFormatter *pFormatter, const uint8_t *pCode, const size_t size, const size_t virtualAddress, const char *pTranslation = nullptr)
+{
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[10];
+
+  char disasmBuffer[1024] = "";
+  char decompBuffer[1024] = "";
+
+  FATAL_IF(!(ZYAN_SUCCESS(ZydisDecoderDecodeFull(pDecoder, pCode, size, &instruction, operands))), "Invalid Instruction at 0x%" PRIX64 ".", (uint64_t)virtualAddress);
+  FATAL_IF(!ZYAN_SUCCESS(ZydisFormatterFormatInstruction(pFormatter, &instruction, operands, sizeof(operands) / sizeof(operands[0]), disasmBuffer, sizeof(disasmBuffer), virtualAddress + AddressDisplayOffset, nullptr)), "Failed to Format Instruction at 0x%" PRIX64 ".", (uint64_t)virtualAddress);
+
+  bool hasTranslation = false;
+  size_t requiredCapacity = 0;
+  char *decomp = decompBuffer;
+
+  bool translated = pTranslation == nullptr && zydec_Translator_TranslateInstruction(pTranslator, &instruction, operands, sizeof(operands) / sizeof(operands[0]), virtualAddress + AddressDisplayOffset, decompBuffer, sizeof(decompBuffer), &hasTranslation, &requiredCapacity);
+
+  if (pTranslation != nullptr)
+  {
+    decomp = const_cast<char *>(pTranslation);
+    translated = hasTranslation = true;
+  }
+  else if (!translated && requiredCapacity != 0)
+  {
+    // Doesn't fit into `decompBuffer`, so retry with a large enough one.
+    decomp = reinterpret_cast<char *>(malloc(requiredCapacity));
+    FATAL_IF(decomp == nullptr, "Memory allocation failure. Aborting.");
+
+    translated = zydec_Translator_TranslateInstruction(pTranslator, &instruction, operands, sizeof(operands) / sizeof(operands[0]), virtualAddress + AddressDisplayOffset, decomp, requiredCapacity, &hasTranslation);
+  }
+
+  if (!translated || !hasTranslation)
+    decomp[0] = '\0';
+
+  if (ShowIsaSet)
+  {
+    const char *isaSet = ZydisISASetGetString(instruction.meta.isa_set);
+
+    printf("% 8" PRIX64 " | %-64s | %-12s | %s\n", (uint64_t)(virtualAddress + AddressDisplayOffset), disasmBuffer, isaSet ? isaSet : "", decomp);
+  }
+  else
+  {
+    printf("% 8" PRIX64 " | %-64s | %s\n", (uint64_t)(virtualAddress + AddressDisplayOffset), disasmBuffer, decomp);
+  }
+
+  if (decomp != decompBuffer && decomp != pTranslation)
+    free(decomp);
+
+  FATAL_IF(instruction.length == 0, "Invalid instruction length. Aborting.");
+
+  return instruction.length;
+}
+
+// Splits the file where functions usually end & translates the partitions on `threadCount` threads. The lines are laid out in `*ppArena` like with `zydec_Translator_TranslateBlock`.
+static void TranslatePartitioned(ZydecTranslator *pTranslator, const uint8_t *pData, const size_t fileSize, const size_t threadCount, char **ppArena, size_t **ppOffsets, size_t *pTranslatedCount)
+{
+  const size_t partitionCapacity = fileSize / MinPartitionSize + 1;
+  ZydecCodePartition *pPartitions = reinterpret_cast<ZydecCodePartition *>(malloc(sizeof(ZydecCodePartition) * partitionCapacity));
+  FATAL_IF(pPartitions == nullptr, "Memory allocation failure. Aborting.");
+
+  size_t partitionCount = 0;
+  FATAL_IF(!zydec_Translator_FindPartitions(pTranslator, pData, fileSize, MinPartitionSize, pPartitions, partitionCapacity, &partitionCount), "Failed to partition the code. Aborting.");
+
+  // Usually large enough, otherwise the partitions report exactly how much they need.
+  size_t arenaCapacity = fileSize * 16;
+  size_t requiredArenaCapacity = 0;
+
+  *ppArena = reinterpret_cast<char *>(malloc(arenaCapacity));
+  *ppOffsets = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * fileSize));
+  FATAL_IF(*ppArena == nullptr || *ppOffsets == nullptr, "Memory allocation failure. Aborting.");
+
+  if (!zydec_Translator_TranslatePartitions(pTranslator, pData, fileSize, AddressDisplayOffset, pPartitions, partitionCount, threadCount, *ppArena, arenaCapacity, *ppOffsets, fileSize, pTranslatedCount, &requiredArenaCapacity))
+  {
+    FATAL_IF(requiredArenaCapacity == 0, "Failed to translate. Aborting.");
+
+    arenaCapacity = requiredArenaCapacity;
+    *ppArena = reinterpret_cast<char *>(realloc(*ppArena, arenaCapacity));
+    FATAL_IF(*ppArena == nullptr, "Memory allocation failure. Aborting.");
+
+    FATAL_IF(!zydec_Translator_TranslatePartitions(pTranslator, pData, fileSize, AddressDisplayOffset, pPartitions, partitionCount, threadCount, *ppArena, arenaCapacity, *ppOffsets, fileSize, pTranslatedCount), "Failed to translate. Aborting.");
+  }
+
+  free(pPartitions);
+}
+
+// The number formatting zydec used before computing the length up front, to compare `zydec_FormatUInt` & `zydec_FormatHex` against in `--benchmark`.
+static bool LegacyFormatUInt(const uint64_t value, char *buffer, const size_t bufferCapacity)
+{
+  char digits[20];
+  char *digitsFromEnd = digits + sizeof(digits);
+  uint64_t tmp = value;
+
+  do
+  {
+    digitsFromEnd--;
+    *digitsFromEnd = (char)('0' + (tmp % 10));
+    tmp /= 10;
+  } while (tmp != 0);
+
+  const size_t length = (size_t)(digits + sizeof(digits) - digitsFromEnd);
+
+  if (length >= bufferCapacity)
+    return false;
+
+  memcpy(buffer, digitsFromEnd, length);
+  buffer[length] = '\0';
+
+  return true;
+}
+
+static bool LegacyFormatHex(const uint64_t value, char *buffer, const size_t bufferCapacity)
+{
+  const char lut[] = "0123456789ABCDEF";
+
+  char digits[2 + 2 * 8];
+  char *digitsFromEnd = digits + sizeof(digits);
+  uint64_t tmp = value;
+
+  do
+  {
+    digitsFromEnd--;
+    *digitsFromEnd = lut[tmp & 0xF];
+    tmp >>= 4;
+  } while (tmp != 0);
+
+  digitsFromEnd--;
+  *digitsFromEnd = 'x';
+  digitsFromEnd--;
+  *digitsFromEnd = '0';
+
+  const size_t length = (size_t)(digits + sizeof(digits) - digitsFromEnd);
+
+  if (length >= bufferCapacity)
+    return false;
+
+  memcpy(buffer, digitsFromEnd, length);
+  buffer[length] = '\0';
+
+  return true;
+}
+
+// Formats all `values` `BenchmarkIterations` times & returns the nanoseconds that took.
+static double BenchmarkNumberFormatting(bool (*format)(const uint64_t, char *, const size_t), const uint64_t *pValues, const size_t valueCount, size_t *pOutputSize)
+{
+  char buffer[32];
+  size_t outputSize = 0;
+
+  const auto before = std::chrono::high_resolution_clock::now();
+
+  for (size_t iteration = 0; iteration < BenchmarkIterations; iteration++)
+  {
+    for (size_t i = 0; i < valueCount; i++)
+    {
+      format(pValues[i], buffer, sizeof(buffer));
+      outputSize += strlen(buffer);
+    }
+  }
+
+  *pOutputSize = outputSize;
+
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - before).count();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -64,14 +363,13 @@ int main(int argc, char **pArgv)
 {
   if (argc == 1)
   {
-    printf("Usage: example <RawAssembledBinaryFile>\n\t[%s / %s / %s]\n\t[%s]\n\t[%s]\n\t[%s / %s]\n", ArgumentNoContext, ArgumentLinearContext, ArgumentLoopMode, ArgumentNoSimplification, ArgumentIsaSet, ArgumentAfterCallRegisterRetentionWindows, ArgumentAfterCallRegisterRetentionLinux);
+    printf("Usage: example <RawAssembledBinaryFile / %s for stdin>\n\t[%s / %s / %s / %s / %s]\n\t[%s]\n\t[%s]\n\t[%s]\n\t[%s]\n\t[%s / %s]\n\t[%s]\n\t[%s / %s]\n\t[%s <ThreadCount>]\n", StdinFilename, ArgumentNoContext, ArgumentLinearContext, ArgumentLoopMode, ArgumentControlFlowGraphMode, ArgumentLoopNestMode, ArgumentNoSimplification, ArgumentFuseFlags, ArgumentCollapseUnrolled, ArgumentIsaSet, ArgumentAfterCallRegisterRetentionWindows, ArgumentAfterCallRegisterRetentionLinux, ArgumentBenchmark, ArgumentStream, ArgumentHugePages, ArgumentThreads);
     return 0;
   }
 
   const char *filename = pArgv[1];
 
   ZydecFormattingInfo info;
-  ZydecLinearContext linearContext;
 
   // Parse additional arguments.
   if (argc > 2)
@@ -100,6 +398,21 @@ int main(int argc, char **pArgv)
         LinearMode = true;
         LoopMode = true;
       }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentControlFlowGraphMode, sizeof(ArgumentControlFlowGraphMode)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        LinearMode = true;
+        ControlFlowGraphMode = true;
+      }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentLoopNestMode, sizeof(ArgumentLoopNestMode)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        LinearMode = true;
+        ControlFlowGraphMode = true;
+        LoopNestMode = true;
+      }
       else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentIsaSet, sizeof(ArgumentIsaSet)) == 0)
       {
         argIndex++;
@@ -113,6 +426,19 @@ int main(int argc, char **pArgv)
         info.simplifyCommonShorthands = false;
         info.simplifyValueSelfModification = false;
       }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentFuseFlags, sizeof(ArgumentFuseFlags)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        info.fuseFlagConditions = true;
+      }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentCollapseUnrolled, sizeof(ArgumentCollapseUnrolled)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        info.collapseUnrolledGroups = true;
+        CollapseUnrolledMode = true;
+      }
       else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentAfterCallRegisterRetentionWindows, sizeof(ArgumentAfterCallRegisterRetentionWindows)) == 0)
       {
         argIndex++;
@@ -125,6 +451,36 @@ int main(int argc, char **pArgv)
         argsRemaining--;
         info.afterCallRegisterRetentionMode = ZydecFormattingInfo::AfterCallRegisterRetentionMode::Linux;
       }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentBenchmark, sizeof(ArgumentBenchmark)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        BenchmarkMode = true;
+      }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentStream, sizeof(ArgumentStream)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        StreamMode = true;
+      }
+      else if (argsRemaining >= 1 && strncmp(pArgv[argIndex], ArgumentHugePages, sizeof(ArgumentHugePages)) == 0)
+      {
+        argIndex++;
+        argsRemaining--;
+        UseHugePages = true;
+      }
+      else if (argsRemaining >= 2 && strncmp(pArgv[argIndex], ArgumentThreads, sizeof(ArgumentThreads)) == 0)
+      {
+        ThreadCount = strtoull(pArgv[argIndex + 1], nullptr, 10);
+        argIndex += 2;
+        argsRemaining -= 2;
+
+        if (ThreadCount == 0)
+        {
+          printf("Invalid thread count '%s'. Aborting.", pArgv[argIndex - 1]);
+          return 1;
+        }
+      }
       else
       {
         printf("Invalid Parameter '%s'. Aborting.", pArgv[argIndex]);
@@ -133,18 +489,8 @@ int main(int argc, char **pArgv)
     }
   }
 
-  FILE *pFile = fopen(filename, "rb");
-  FATAL_IF(pFile == nullptr, "Failed to open file. Aborting.");
-
-  fseek(pFile, 0, SEEK_END);
-  const size_t fileSize = _ftelli64(pFile);
-  FATAL_IF(fileSize == 0, "The specified file is empty. Aborting.");
-
-  fseek(pFile, 0, SEEK_SET);
-
-  uint8_t *pData = reinterpret_cast<uint8_t *>(malloc(fileSize));
-  FATAL_IF(pData == nullptr, "Memory allocation failure. Aborting.");
-  FATAL_IF(fileSize != fread(pData, 1, fileSize, pFile), "Failed to read file contents. Aborting.");
+  ZydecTranslator *pTranslator = nullptr;
+  FATAL_IF(!zydec_CreateTranslator(&pTranslator, LinearMode ? ZydecTranslatorMode::LinearContext : ZydecTranslatorMode::WithoutContext, &info), "Failed to create translator.");
 
   ZydisDecoder decoder;
   ZydisFormatter formatter;
@@ -152,78 +498,335 @@ int main(int argc, char **pArgv)
   FATAL_IF(!ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)), "Failed to initialize disassembler.");
   FATAL_IF(!ZYAN_SUCCESS(ZydisFormatterInit(&formatter, ZYDIS_FORMATTER_STYLE_INTEL)) || !ZYAN_SUCCESS(ZydisFormatterSetProperty(&formatter, ZYDIS_FORMATTER_PROP_FORCE_SEGMENT, ZYAN_TRUE)) || !ZYAN_SUCCESS(ZydisFormatterSetProperty(&formatter, ZYDIS_FORMATTER_PROP_FORCE_SIZE, ZYAN_TRUE)), "Failed to initialize instruction formatter.");
 
-  ZydisDecodedInstruction instruction;
-  ZydisDecodedOperand operands[10];
-
   size_t virtualAddress = 0;
-  constexpr size_t addressDisplayOffset = 0x140000000;
-
-  char disasmBuffer[1024] = "";
-  char decompBuffer[1024] = "";
 
-  if (LoopMode && LinearMode)
+  if (StreamMode || strcmp(filename, StdinFilename) == 0)
   {
-    const uint64_t hashStateBefore = linearContext.hashState;
-    size_t addr = 0;
+    FATAL_IF(LoopMode || ControlFlowGraphMode || BenchmarkMode || ThreadCount != 0, "%s, %s, %s and %s require the whole file up front. Aborting.", ArgumentLoopMode, ArgumentControlFlowGraphMode, ArgumentBenchmark, ArgumentThreads);
+
+    FILE *pFile = stdin;
 
-    while (addr < fileSize)
+    if (strcmp(filename, StdinFilename) == 0)
     {
-      if (!(ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, pData + addr, fileSize - addr, &instruction, operands))))
-      {
-        puts("Failed to decode instruction in loop pre-run. Aborting pre-run.");
-        break;
-      }
+#ifdef _WIN32
+      _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    }
+    else
+    {
+      pFile = fopen(filename, "rb");
+      FATAL_IF(pFile == nullptr, "Failed to open file. Aborting.");
+    }
 
-      bool hasTranslation;
+    uint8_t *pBuffer = reinterpret_cast<uint8_t *>(malloc(StreamBufferSize));
+    FATAL_IF(pBuffer == nullptr, "Memory allocation failure. Aborting.");
 
-      zydec_TranslateInstructionWithLinearContext(&linearContext, &instruction, operands, sizeof(operands) / sizeof(operands[0]), addr + addressDisplayOffset, decompBuffer, sizeof(decompBuffer), &hasTranslation, &info);
+    size_t begin = 0;
+    size_t end = 0;
+    bool endOfStream = false;
 
-      if (instruction.length == 0)
+    printf("// %s\n\n", filename);
+
+    while (true)
+    {
+      // Refill before an instruction could straddle the end of the buffer. The bytes that are left are moved to the front, so the instruction is contiguous with the next chunk.
+      if (!endOfStream && end - begin < ZYDIS_MAX_INSTRUCTION_LENGTH)
       {
-        puts("Invalid instruction length in loop pre-run. Aborting pre-run.");
-        break;
+        memmove(pBuffer, pBuffer + begin, end - begin);
+        end -= begin;
+        begin = 0;
+
+        const size_t bytesRead = fread(pBuffer + end, 1, StreamBufferSize - end, pFile);
+        FATAL_IF(ferror(pFile), "Failed to read from stream. Aborting.");
+
+        end += bytesRead;
+        endOfStream = bytesRead == 0;
+        continue;
       }
 
-      addr += instruction.length;
+      if (begin == end)
+        break;
+
+      const size_t length = PrintInstruction(pTranslator, &decoder, &formatter, pBuffer + begin, end - begin, virtualAddress);
+      begin += length;
+      virtualAddress += length;
     }
 
-    linearContext.hashState = hashStateBefore;
+    free(pBuffer);
+
+    if (pFile != stdin)
+      fclose(pFile);
+
+    zydec_DestroyTranslator(&pTranslator);
+
+    return 0;
   }
 
-  printf("// %s\n\n", filename);
-  
-  while (virtualAddress < fileSize)
+  // Partitions start without the names of the code in front of them, which control flow graphs are all about.
+  FATAL_IF(ControlFlowGraphMode && ThreadCount != 0, "%s can't be combined with %s. Aborting.", ArgumentThreads, ArgumentControlFlowGraphMode);
+
+  MappedFile mappedFile;
+  FATAL_IF(!MapFile(&mappedFile, filename, UseHugePages), "Failed to map file or the file is empty. Aborting.");
+
+  const uint8_t *pData = mappedFile.pData;
+  const size_t fileSize = mappedFile.size;
+
+  if (BenchmarkMode)
   {
-    FATAL_IF(!(ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, pData + virtualAddress, fileSize - virtualAddress, &instruction, operands))), "Invalid Instruction at 0x%" PRIX64 ".", virtualAddress);
-    FATAL_IF(!ZYAN_SUCCESS(ZydisFormatterFormatInstruction(&formatter, &instruction, operands, sizeof(operands) / sizeof(operands[0]), disasmBuffer, sizeof(disasmBuffer), virtualAddress + addressDisplayOffset, nullptr)), "Failed to Format Instruction at 0x%" PRIX64 ".", virtualAddress);
+    ZydisDecodedOperand operands[10];
+    char decompBuffer[1024] = "";
+
+    // Decode everything up front, so only the translation is measured.
+    ZydisDecodedInstruction *pInstructions = reinterpret_cast<ZydisDecodedInstruction *>(malloc(sizeof(ZydisDecodedInstruction) * fileSize));
+    ZydisDecodedOperand *pOperands = reinterpret_cast<ZydisDecodedOperand *>(malloc(sizeof(operands) * fileSize));
+    size_t *pAddresses = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * fileSize));
+    FATAL_IF(pInstructions == nullptr || pOperands == nullptr || pAddresses == nullptr, "Memory allocation failure. Aborting.");
 
-    bool hasTranslation = false;
+    size_t instructionCount = 0;
 
-    if (LinearMode)
+    while (virtualAddress < fileSize)
     {
-      if (!zydec_TranslateInstructionWithLinearContext(&linearContext, &instruction, operands, sizeof(operands) / sizeof(operands[0]), virtualAddress + addressDisplayOffset, decompBuffer, sizeof(decompBuffer), &hasTranslation, &info) || !hasTranslation)
-        decompBuffer[0] = '\0';
+      ZydisDecodedOperand *pInstructionOperands = pOperands + instructionCount * (sizeof(operands) / sizeof(operands[0]));
+
+      FATAL_IF(!(ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, pData + virtualAddress, fileSize - virtualAddress, &pInstructions[instructionCount], pInstructionOperands))), "Invalid Instruction at 0x%" PRIX64 ".", virtualAddress);
+      FATAL_IF(pInstructions[instructionCount].length == 0, "Invalid instruction length. Aborting.");
+
+      pAddresses[instructionCount] = virtualAddress + AddressDisplayOffset;
+      virtualAddress += pInstructions[instructionCount].length;
+      instructionCount++;
     }
-    else
+
+    size_t outputSize = 0;
+    const auto before = std::chrono::high_resolution_clock::now();
+
+    for (size_t iteration = 0; iteration < BenchmarkIterations; iteration++)
     {
-      if (!zydec_TranslateInstructionWithoutContext(&instruction, operands, sizeof(operands) / sizeof(operands[0]), virtualAddress + addressDisplayOffset, decompBuffer, sizeof(decompBuffer), &hasTranslation, &info) || !hasTranslation)
-        decompBuffer[0] = '\0';
+      for (size_t i = 0; i < instructionCount; i++)
+      {
+        bool hasTranslation = false;
+        const ZydisDecodedOperand *pInstructionOperands = pOperands + i * (sizeof(operands) / sizeof(operands[0]));
+
+        zydec_Translator_TranslateInstruction(pTranslator, &pInstructions[i], pInstructionOperands, sizeof(operands) / sizeof(operands[0]), pAddresses[i], decompBuffer, sizeof(decompBuffer), &hasTranslation);
+
+        if (hasTranslation)
+          outputSize += strlen(decompBuffer);
+      }
     }
 
-    if (ShowIsaSet)
+    const double nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - before).count();
+
+    printf("Translated %" PRIu64 " instructions %" PRIu64 " times (%" PRIu64 " bytes of output) in %.3f ms: %.2f ns / instruction.\n", (uint64_t)instructionCount, (uint64_t)BenchmarkIterations, (uint64_t)outputSize, nanoseconds * 1e-6, nanoseconds / (double)(instructionCount * BenchmarkIterations));
+
+    // The IR pass includes decoding, as that's how a viewer would use it.
     {
-      const char *isaSet = ZydisISASetGetString(instruction.meta.isa_set);
+      const auto irBefore = std::chrono::high_resolution_clock::now();
 
-      printf("% 8" PRIX64 " | %-64s | %-12s | %s\n", virtualAddress + addressDisplayOffset, disasmBuffer, isaSet ? isaSet : "", decompBuffer);
+      for (size_t iteration = 0; iteration < BenchmarkIterations; iteration++)
+      {
+        ZydecBlockIR *pBlockIR = nullptr;
+        FATAL_IF(!zydec_Translator_BuildBlockIR(pTranslator, pData, fileSize, AddressDisplayOffset, &pBlockIR), "Failed to build IR. Aborting.");
+        zydec_DestroyBlockIR(&pBlockIR);
+      }
+
+      const double irNanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - irBefore).count();
+
+      printf("Built IR for %" PRIu64 " instructions %" PRIu64 " times in %.3f ms: %.2f ns / instruction.\n", (uint64_t)instructionCount, (uint64_t)BenchmarkIterations, irNanoseconds * 1e-6, irNanoseconds / (double)(instructionCount * BenchmarkIterations));
     }
-    else
+
+    // Number formatting on the immediates, displacements & addresses of the file, the old implementation vs. the current one.
     {
-      printf("% 8" PRIX64 " | %-64s | %s\n", virtualAddress + addressDisplayOffset, disasmBuffer, decompBuffer);
+      uint64_t *pValues = reinterpret_cast<uint64_t *>(malloc(sizeof(uint64_t) * instructionCount * 2));
+      FATAL_IF(pValues == nullptr, "Memory allocation failure. Aborting.");
+
+      size_t valueCount = 0;
+
+      // The address of every instruction & the first immediate or displacement it has.
+      for (size_t i = 0; i < instructionCount; i++)
+      {
+        const ZydisDecodedOperand *pInstructionOperands = pOperands + i * (sizeof(operands) / sizeof(operands[0]));
+
+        pValues[valueCount++] = pAddresses[i];
+
+        for (size_t j = 0; j < pInstructions[i].operand_count_visible; j++)
+        {
+          if (pInstructionOperands[j].type == ZYDIS_OPERAND_TYPE_IMMEDIATE)
+          {
+            pValues[valueCount++] = pInstructionOperands[j].imm.value.u;
+            break;
+          }
+          else if (pInstructionOperands[j].type == ZYDIS_OPERAND_TYPE_MEMORY && pInstructionOperands[j].mem.disp.has_displacement)
+          {
+            pValues[valueCount++] = (uint64_t)pInstructionOperands[j].mem.disp.value;
+            break;
+          }
+        }
+      }
+
+      for (size_t i = 0; i < valueCount; i++)
+      {
+        char legacy[32];
+        char current[32];
+
+        FATAL_IF(!LegacyFormatUInt(pValues[i], legacy, sizeof(legacy)) || !zydec_FormatUInt(pValues[i], current, sizeof(current)) || strcmp(legacy, current) != 0, "Decimal formatting of %" PRIu64 " differs. Aborting.", pValues[i]);
+        FATAL_IF(!LegacyFormatHex(pValues[i], legacy, sizeof(legacy)) || !zydec_FormatHex(pValues[i], current, sizeof(current)) || strcmp(legacy, current) != 0, "Hex formatting of %" PRIu64 " differs. Aborting.", pValues[i]);
+      }
+
+      struct
+      {
+        const char *name;
+        bool (*legacy)(const uint64_t, char *, const size_t);
+        bool (*current)(const uint64_t, char *, const size_t);
+      } formats[] = { { "decimal", LegacyFormatUInt, zydec_FormatUInt }, { "hex", LegacyFormatHex, zydec_FormatHex } };
+
+      for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+      {
+        size_t outputSize = 0;
+        const double legacyNanoseconds = BenchmarkNumberFormatting(formats[i].legacy, pValues, valueCount, &outputSize);
+        const double currentNanoseconds = BenchmarkNumberFormatting(formats[i].current, pValues, valueCount, &outputSize);
+
+        printf("Formatted %" PRIu64 " numbers as %s %" PRIu64 " times (%" PRIu64 " bytes of output): %.2f ns / number before, %.2f ns / number now.\n", (uint64_t)valueCount, formats[i].name, (uint64_t)BenchmarkIterations, (uint64_t)outputSize, legacyNanoseconds / (double)(valueCount * BenchmarkIterations), currentNanoseconds / (double)(valueCount * BenchmarkIterations));
+      }
+
+      free(pValues);
+    }
+
+    // Partitioned translation on a single thread vs. `--threads`, including decoding & partitioning.
+    if (ThreadCount != 0)
+    {
+      const size_t threadCounts[] = { 1, ThreadCount };
+
+      for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+      {
+        const auto partitionsBefore = std::chrono::high_resolution_clock::now();
+
+        for (size_t iteration = 0; iteration < BenchmarkIterations; iteration++)
+        {
+          char *pArena = nullptr;
+          size_t *pOffsets = nullptr;
+          size_t translatedCount = 0;
+
+          TranslatePartitioned(pTranslator, pData, fileSize, threadCounts[i], &pArena, &pOffsets, &translatedCount);
+
+          free(pArena);
+          free(pOffsets);
+        }
+
+        const double partitionNanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - partitionsBefore).count();
+
+        printf("Translated partitions of %" PRIu64 " instructions %" PRIu64 " times on %" PRIu64 " thread(s) in %.3f ms: %.2f ns / instruction.\n", (uint64_t)instructionCount, (uint64_t)BenchmarkIterations, (uint64_t)threadCounts[i], partitionNanoseconds * 1e-6, partitionNanoseconds / (double)(instructionCount * BenchmarkIterations));
+      }
     }
 
-    FATAL_IF(instruction.length == 0, "Invalid instruction length. Aborting.");
-    virtualAddress += instruction.length;
+    free(pInstructions);
+    free(pOperands);
+    free(pAddresses);
+    UnmapFile(&mappedFile);
+    zydec_DestroyTranslator(&pTranslator);
+
+    return 0;
   }
 
+  if (LoopMode && LinearMode)
+  {
+    ZydecLinearContext *pLinearContext = zydec_Translator_GetLinearContext(pTranslator);
+    const uint64_t hashStateBefore = pLinearContext->hashState;
+    size_t instructionCount = 0;
+
+    // Only establishes the register names, without formatting anything.
+    if (!zydec_Translator_AdvanceBlock(pTranslator, pData, fileSize, AddressDisplayOffset, &instructionCount))
+      puts("Failed to decode instruction in loop pre-run. Aborting pre-run.");
+
+    pLinearContext->hashState = hashStateBefore;
+  }
+
+  ZydecControlFlowGraph *pGraph = nullptr;
+
+  if (ControlFlowGraphMode && LinearMode && !zydec_Translator_BuildControlFlowGraph(pTranslator, pData, fileSize, AddressDisplayOffset, &pGraph))
+    puts("Failed to build control flow graph. Continuing without it.");
+
+  ZydecSSA *pSSA = nullptr;
+  ZydecLoopNest *pLoopNest = nullptr;
+
+  if (LoopNestMode && pGraph != nullptr && !(zydec_Translator_BuildSSA(pTranslator, pGraph, &pSSA) && zydec_Translator_BuildLoopNest(pTranslator, pGraph, pSSA, &pLoopNest)))
+    puts("Failed to find loops. Continuing without them.");
+
+  // Unrolled groups are only found by the block functions & partitions are translated in parallel, so everything is translated up front.
+  char *pArena = nullptr;
+  size_t *pOffsets = nullptr;
+  size_t translatedCount = 0;
+
+  if (ThreadCount != 0)
+  {
+    TranslatePartitioned(pTranslator, pData, fileSize, ThreadCount, &pArena, &pOffsets, &translatedCount);
+  }
+  else if (CollapseUnrolledMode)
+  {
+    size_t arenaCapacity = fileSize * 16;
+    size_t requiredArenaCapacity = 0;
+
+    pArena = reinterpret_cast<char *>(malloc(arenaCapacity));
+    pOffsets = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * fileSize));
+    FATAL_IF(pArena == nullptr || pOffsets == nullptr, "Memory allocation failure. Aborting.");
+
+    const bool translated = pGraph != nullptr ? zydec_Translator_TranslateControlFlowGraph(pTranslator, pGraph, pArena, arenaCapacity, pOffsets, fileSize, &translatedCount, &requiredArenaCapacity) : zydec_Translator_TranslateBlock(pTranslator, pData, fileSize, AddressDisplayOffset, pArena, arenaCapacity, pOffsets, fileSize, &translatedCount, &requiredArenaCapacity);
+
+    if (!translated)
+    {
+      // The linear context & flags are left as they were, so the exact capacity only requires a single retry.
+      FATAL_IF(requiredArenaCapacity == 0, "Failed to translate. Aborting.");
+
+      arenaCapacity = requiredArenaCapacity;
+      pArena = reinterpret_cast<char *>(realloc(pArena, arenaCapacity));
+      FATAL_IF(pArena == nullptr, "Memory allocation failure. Aborting.");
+
+      FATAL_IF(!(pGraph != nullptr ? zydec_Translator_TranslateControlFlowGraph(pTranslator, pGraph, pArena, arenaCapacity, pOffsets, fileSize, &translatedCount) : zydec_Translator_TranslateBlock(pTranslator, pData, fileSize, AddressDisplayOffset, pArena, arenaCapacity, pOffsets, fileSize, &translatedCount)), "Failed to translate. Aborting.");
+    }
+  }
+
+  printf("// %s\n\n", filename);
+
+  size_t nextBlock = 0;
+  size_t nextLoop = 0;
+  size_t instructionIndex = 0;
+
+  while (virtualAddress < fileSize)
+  {
+    // Every block starts with the register names its predecessors agree on.
+    const ZydecBasicBlock *pBlock = zydec_ControlFlowGraph_GetBlock(pGraph, nextBlock);
+
+    if (pBlock != nullptr && pBlock->offset == virtualAddress)
+    {
+      // Loops are summarized above their header.
+      for (const ZydecLoop *pLoop = zydec_LoopNest_GetLoop(pLoopNest, nextLoop); pLoop != nullptr && pLoop->header == nextBlock; pLoop = zydec_LoopNest_GetLoop(pLoopNest, ++nextLoop))
+      {
+        char loopBuffer[256];
+
+        if (!zydec_LoopNest_FormatLoop(pLoopNest, nextLoop, loopBuffer, sizeof(loopBuffer)))
+          continue;
+
+        if (ShowIsaSet)
+          printf("%8s | %-64s | %-12s | %s\n", "", "", "", loopBuffer);
+        else
+          printf("%8s | %-64s | %s\n", "", "", loopBuffer);
+      }
+
+      *zydec_Translator_GetLinearContext(pTranslator) = *zydec_ControlFlowGraph_GetEntryContext(pGraph, nextBlock++);
+      zydec_Translator_ForgetFlags(pTranslator);
+    }
+
+    const char *pTranslation = instructionIndex < translatedCount ? pArena + pOffsets[instructionIndex] : nullptr;
+    instructionIndex++;
+
+    virtualAddress += PrintInstruction(pTranslator, &decoder, &formatter, pData + virtualAddress, fileSize - virtualAddress, virtualAddress, pTranslation);
+  }
+
+  free(pArena);
+  free(pOffsets);
+  zydec_DestroyLoopNest(&pLoopNest);
+  zydec_DestroySSA(&pSSA);
+  zydec_DestroyControlFlowGraph(&pGraph);
+  UnmapFile(&mappedFile);
+  zydec_DestroyTranslator(&pTranslator);
+
   return 0;
 }
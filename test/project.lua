@@ -0,0 +1,80 @@
+ProjectName = "test"
+project(ProjectName)
+
+  --Settings
+  kind "ConsoleApp"
+  language "C++"
+  staticruntime "On"
+
+  dependson { "zydec" }
+
+  filter { "system:windows" }
+    buildoptions { '/Gm-' }
+    buildoptions { '/MP' }
+
+    ignoredefaultlibraries { "msvcrt" }
+  filter { "system:linux" }
+    cppdialect "C++11"
+    links { "pthread" }
+  filter { }
+  
+  defines { "_CRT_SECURE_NO_WARNINGS", "SSE2" }
+  
+  objdir "intermediate/obj"
+
+  files { "src/**.cpp", "src/**.c", "src/**.cc", "src/**.h", "src/**.hh", "src/**.hpp", "src/**.inl", "src/**rc" }
+  files { "project.lua" }
+  
+  includedirs { "../zydec/include" }
+  includedirs { "../3rdParty/Zydis/include" }
+
+  links { "../3rdParty/zydis/lib/Zydis.lib" }
+  links { "../builds/lib/zydec.lib" }
+
+  filter { "configurations:Debug", "system:Windows" }
+    ignoredefaultlibraries { "libcmt" }
+  filter { }
+  
+  targetname(ProjectName)
+  targetdir "../builds/bin"
+  debugdir "../builds/bin"
+  
+filter {}
+configuration {}
+
+warnings "Extra"
+
+filter {"configurations:Release"}
+  targetname "%{prj.name}"
+filter {"configurations:Debug"}
+  targetname "%{prj.name}D"
+
+filter {}
+configuration {}
+flags { "NoMinimalRebuild", "NoPCH" }
+exceptionhandling "Off"
+rtti "Off"
+floatingpoint "Fast"
+
+filter { "configurations:Debug*" }
+	defines { "_DEBUG" }
+	optimize "Off"
+	symbols "On"
+
+filter { "configurations:Release" }
+	defines { "NDEBUG" }
+	optimize "Speed"
+	flags { "NoBufferSecurityCheck", "NoIncrementalLink" }
+  omitframepointer "On"
+	symbols "On"
+
+filter { "system:windows", "configurations:Release", "action:vs2012" }
+	buildoptions { "/d2Zi+" }
+
+filter { "system:windows", "configurations:Release", "action:vs2013" }
+	buildoptions { "/Zo" }
+
+filter { "system:windows", "configurations:Release" }
+	flags { "NoIncrementalLink" }
+
+editandcontinue "Off"
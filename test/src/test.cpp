@@ -0,0 +1,1141 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) 2023, Christoph Stiller. All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation 
+//    and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "zydec.h"
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#define TEST_ASSERT(conditional) do { if (!(conditional)) { printf("  %s(%d): Assertion failed: %s\n", __FILE__, __LINE__, #conditional); return false; } } while (0)
+
+constexpr uint64_t TestBaseAddress = 0x140000000;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Translates the instructions in `pCode` one after another & returns the line of the last one.
+static bool TranslateLast(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, char *buffer, const size_t bufferCapacity)
+{
+  ZydisDecoder decoder;
+  ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64);
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+  size_t offset = 0;
+
+  while (offset < size)
+  {
+    bool hasTranslation = false;
+
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, pCode + offset, size - offset, &instruction, operands)))
+      return false;
+
+    if (!zydec_Translator_TranslateInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + offset, buffer, bufferCapacity, &hasTranslation) || !hasTranslation)
+      return false;
+
+    offset += instruction.length;
+  }
+
+  return true;
+}
+
+// Finds the token that's exactly `name` or a name the linear context derived from it (`name_...`).
+static bool FindTokenKind(const char *line, const ZydecTokenList *pTokenList, const char *name, ZydecTokenKind *pKind)
+{
+  const size_t nameLength = strlen(name);
+
+  for (size_t i = 0; i < pTokenList->tokenCount && i < pTokenList->tokenCapacity; i++)
+  {
+    const ZydecTokenSpan *pSpan = &pTokenList->pTokens[i];
+
+    if (pSpan->length < nameLength || strncmp(line + pSpan->offset, name, nameLength) != 0 || (pSpan->length != nameLength && line[pSpan->offset + nameLength] != '_'))
+      continue;
+
+    *pKind = pSpan->kind;
+    return true;
+  }
+
+  return false;
+}
+
+// Translates `pCode` as a block & copies the annotation of the first collapsed group into `annotation` (empty if nothing was collapsed).
+static bool FindUnrolledAnnotation(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, char *annotation, const size_t annotationCapacity)
+{
+  char arena[4096];
+  size_t offsets[64];
+  size_t instructionCount = 0;
+
+  if (!zydec_Translator_TranslateBlock(pTranslator, pCode, size, TestBaseAddress, arena, sizeof(arena), offsets, sizeof(offsets) / sizeof(offsets[0]), &instructionCount))
+    return false;
+
+  annotation[0] = '\0';
+
+  for (size_t i = 0; i < instructionCount; i++)
+  {
+    const char *unrolled = strstr(arena + offsets[i], "// x");
+
+    if (unrolled != nullptr)
+    {
+      snprintf(annotation, annotationCapacity, "%s", unrolled);
+      break;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static bool TestRegisterTokenKinds()
+{
+  // mov rax, [rdi]; add rdx, rax
+  const uint8_t code[] = { 0x48, 0x8B, 0x07, 0x48, 0x01, 0xC2 };
+
+  ZydecTokenSpan spans[32];
+  ZydecTokenList tokenList;
+  tokenList.pTokens = spans;
+  tokenList.tokenCapacity = sizeof(spans) / sizeof(spans[0]);
+
+  ZydecFormattingInfo info;
+  info.pTokenList = &tokenList;
+
+  char line[256];
+  ZydecTokenKind kind;
+
+  // Without context, no register is ever renamed.
+  {
+    ZydecTranslator *pTranslator = nullptr;
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::WithoutContext, &info));
+    TEST_ASSERT(TranslateLast(pTranslator, code, 3, line, sizeof(line)));
+    zydec_DestroyTranslator(&pTranslator);
+
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "a", &kind) && kind == ZydecTokenKind::Register);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "di", &kind) && kind == ZydecTokenKind::Register);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "data_segment", &kind) && kind == ZydecTokenKind::Register);
+  }
+
+  // With the linear context, only the registers that got a name are renamed.
+  {
+    ZydecTranslator *pTranslator = nullptr;
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+    TEST_ASSERT(TranslateLast(pTranslator, code, 3, line, sizeof(line)));
+
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "a", &kind) && kind == ZydecTokenKind::RenamedRegister);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "di", &kind) && kind == ZydecTokenKind::Register);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "data_segment", &kind) && kind == ZydecTokenKind::Register);
+
+    TEST_ASSERT(TranslateLast(pTranslator, code + 3, sizeof(code) - 3, line, sizeof(line)));
+    zydec_DestroyTranslator(&pTranslator);
+
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "a", &kind) && kind == ZydecTokenKind::RenamedRegister);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "d", &kind) && kind == ZydecTokenKind::RenamedRegister); // The result.
+    TEST_ASSERT(strstr(line, "(i64)d +") != nullptr); // The unnamed operand.
+  }
+
+  // Block IR replays the recorded names & has to come to the same conclusion.
+  {
+    ZydecTranslator *pTranslator = nullptr;
+    ZydecBlockIR *pBlockIR = nullptr;
+    bool hasTranslation = false;
+
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+    TEST_ASSERT(zydec_Translator_BuildBlockIR(pTranslator, code, sizeof(code), TestBaseAddress, &pBlockIR));
+    zydec_DestroyTranslator(&pTranslator);
+
+    TEST_ASSERT(zydec_BlockIR_RenderInstruction(pBlockIR, 0, line, sizeof(line), &hasTranslation) && hasTranslation);
+    zydec_DestroyBlockIR(&pBlockIR);
+
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "a", &kind) && kind == ZydecTokenKind::RenamedRegister);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "di", &kind) && kind == ZydecTokenKind::Register);
+    TEST_ASSERT(FindTokenKind(line, &tokenList, "data_segment", &kind) && kind == ZydecTokenKind::Register);
+  }
+
+  return true;
+}
+
+static bool TestUnsignedFusedConditions()
+{
+  ZydecFormattingInfo info;
+  info.fuseFlagConditions = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::WithoutContext, &info));
+
+  char line[256];
+
+  // cmp rax, rdx; jnb $
+  const uint8_t registers[] = { 0x48, 0x39, 0xD0, 0x73, 0xFE };
+  TEST_ASSERT(TranslateLast(pTranslator, registers, sizeof(registers), line, sizeof(line)) && strstr(line, "if ((u64)a >= (u64)d)") != nullptr);
+
+  // cmp eax, -1; jb $
+  const uint8_t immediate[] = { 0x83, 0xF8, 0xFF, 0x72, 0xFE };
+  TEST_ASSERT(TranslateLast(pTranslator, immediate, sizeof(immediate), line, sizeof(line)) && strstr(line, "if ((u32)a < 0xFFFFFFFF)") != nullptr);
+
+  // cmp al, -2; setnbe cl
+  const uint8_t byteImmediate[] = { 0x3C, 0xFE, 0x0F, 0x97, 0xC1 };
+  TEST_ASSERT(TranslateLast(pTranslator, byteImmediate, sizeof(byteImmediate), line, sizeof(line)) && strstr(line, "((u8)a > 254 ? 1 : 0)") != nullptr);
+
+  // cmp [rdi], rsi; cmovnbe rax, rbx
+  const uint8_t memory[] = { 0x48, 0x39, 0x37, 0x48, 0x0F, 0x47, 0xC3 };
+  TEST_ASSERT(TranslateLast(pTranslator, memory, sizeof(memory), line, sizeof(line)) && strstr(line, "if ((u64)*(data_segment: (i64)di) > (u64)si)") != nullptr);
+
+  // Signed conditions keep their signed operands: cmp rax, -2; jl $
+  const uint8_t signedCompare[] = { 0x48, 0x83, 0xF8, 0xFE, 0x7C, 0xFE };
+  TEST_ASSERT(TranslateLast(pTranslator, signedCompare, sizeof(signedCompare), line, sizeof(line)) && strstr(line, "if ((i64)a < -2)") != nullptr);
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestFlagsForgottenAtBranchTargets()
+{
+  ZydecFormattingInfo info;
+  info.fuseFlagConditions = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  // The `jl` is reached from the `cmp` or with the flags of the `test` from the `jz`.
+  //   test rcx, rcx; jz target; cmp rdi, rsi; target: jl next; next: ret
+  const uint8_t code[] = { 0x48, 0x85, 0xC9, 0x74, 0x03, 0x48, 0x39, 0xF7, 0x7C, 0x00, 0xC3 };
+
+  char arena[1024];
+  size_t offsets[8];
+  size_t instructionCount = 0;
+
+  size_t requiredArenaCapacity = 0;
+  TEST_ASSERT(zydec_Translator_MeasureBlock(pTranslator, code, sizeof(code), 0x1000, &requiredArenaCapacity, &instructionCount));
+
+  TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, code, sizeof(code), 0x1000, arena, sizeof(arena), offsets, sizeof(offsets) / sizeof(offsets[0]), &instructionCount));
+  TEST_ASSERT(instructionCount == 5);
+  TEST_ASSERT(offsets[4] + strlen(arena + offsets[4]) + 1 == requiredArenaCapacity);
+
+  // The `jz` itself still fuses with the `test`.
+  TEST_ASSERT(strstr(arena + offsets[1], "if ((i64)c == 0)") != nullptr);
+  TEST_ASSERT(strstr(arena + offsets[3], "(i64)di") == nullptr && strstr(arena + offsets[3], "sign_flag != overflow_flag") != nullptr);
+
+  const ZydecCodePartition partition = { 0, sizeof(code) };
+  char partitionArena[1024];
+
+  TEST_ASSERT(zydec_Translator_TranslatePartitions(pTranslator, code, sizeof(code), 0x1000, &partition, 1, 1, partitionArena, sizeof(partitionArena), offsets, sizeof(offsets) / sizeof(offsets[0]), &instructionCount));
+  TEST_ASSERT(instructionCount == 5 && strstr(partitionArena + offsets[3], "sign_flag != overflow_flag") != nullptr);
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestLoopBoundFromTwoPredecessors()
+{
+  // The bound `r8` is set on two paths into the loop, so it's a phi in the header that the loop only passes back to itself.
+  //   test rcx, rcx; jz set_rsi; mov r8, rdx; jmp loop; set_rsi: mov r8, rsi
+  //   loop: add r9, 256; cmp r9, r8; jnz loop; ret
+  const uint8_t code[] = { 0x48, 0x85, 0xC9, 0x74, 0x05, 0x49, 0x89, 0xD0, 0xEB, 0x03, 0x49, 0x89, 0xF0, 0x49, 0x81, 0xC1, 0x00, 0x01, 0x00, 0x00, 0x4D, 0x39, 0xC1, 0x75, 0xF4, 0xC3 };
+
+  ZydecFormattingInfo info;
+  ZydecTranslator *pTranslator = nullptr;
+  ZydecControlFlowGraph *pGraph = nullptr;
+  ZydecSSA *pSSA = nullptr;
+  ZydecLoopNest *pNest = nullptr;
+
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+  TEST_ASSERT(zydec_Translator_BuildControlFlowGraph(pTranslator, code, sizeof(code), TestBaseAddress, &pGraph));
+  TEST_ASSERT(zydec_Translator_BuildSSA(pTranslator, pGraph, &pSSA));
+  TEST_ASSERT(zydec_Translator_BuildLoopNest(pTranslator, pGraph, pSSA, &pNest));
+
+  TEST_ASSERT(zydec_LoopNest_GetLoopCount(pNest) == 1);
+
+  const ZydecLoop *pLoop = zydec_LoopNest_GetLoop(pNest, 0);
+  TEST_ASSERT(pLoop->hasInductionVariable && pLoop->inductionVariable.hasBound);
+  TEST_ASSERT(pLoop->inductionVariable.relation == ZydecLoopRelation::NotEqual && pLoop->inductionVariable.stride == 256);
+  TEST_ASSERT(pLoop->inductionVariable.boundValue != SIZE_MAX && zydec_SSA_GetValue(pSSA, pLoop->inductionVariable.boundValue)->kind == ZydecValueKind::Phi);
+
+  char summary[256];
+  TEST_ASSERT(zydec_LoopNest_FormatLoop(pNest, 0, summary, sizeof(summary)));
+  TEST_ASSERT(strstr(summary, "for (r9; r9 != r8; r9 += 256)") != nullptr);
+
+  zydec_DestroyLoopNest(&pNest);
+  zydec_DestroySSA(&pSSA);
+  zydec_DestroyControlFlowGraph(&pGraph);
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestPipelinedCopiesDontCollapse()
+{
+  ZydecFormattingInfo info;
+  info.collapseUnrolledGroups = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  char arena[4096];
+  size_t offsets[16];
+  size_t instructionCount = 0;
+
+  // Every copy adds the product of the previous copy, so the copies don't compute the same thing on different lanes.
+  //   vmulps ymm2, ymm0, [rdi]; vaddps ymm3, ymm3, ymm1; vmulps ymm4, ymm0, [rdi + 32]; vaddps ymm3, ymm3, ymm2; vmulps ymm6, ymm0, [rdi + 64]; vaddps ymm3, ymm3, ymm4; ret
+  const uint8_t pipelined[] = { 0xC5, 0xFC, 0x59, 0x17, 0xC5, 0xE4, 0x58, 0xD9, 0xC5, 0xFC, 0x59, 0x67, 0x20, 0xC5, 0xE4, 0x58, 0xDA, 0xC5, 0xFC, 0x59, 0x77, 0x40, 0xC5, 0xE4, 0x58, 0xDC, 0xC3 };
+
+  TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, pipelined, sizeof(pipelined), TestBaseAddress, arena, sizeof(arena), offsets, sizeof(offsets) / sizeof(offsets[0]), &instructionCount));
+  TEST_ASSERT(instructionCount == 7);
+
+  for (size_t i = 0; i < instructionCount; i++)
+    TEST_ASSERT(arena[offsets[i]] != '\0' && strstr(arena + offsets[i], "unrolled") == nullptr);
+
+  // Copies that continue the accumulator & pointer of the previous copy still collapse.
+  //   add rax, [rdi]; add rdi, 8 (x3); ret
+  const uint8_t accumulated[] = { 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0xC3 };
+
+  TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, accumulated, sizeof(accumulated), TestBaseAddress, arena, sizeof(arena), offsets, sizeof(offsets) / sizeof(offsets[0]), &instructionCount));
+  TEST_ASSERT(instructionCount == 7);
+
+  size_t collapsedCount = 0;
+
+  for (size_t i = 0; i < instructionCount; i++)
+    if (strstr(arena + offsets[i], "unrolled") != nullptr)
+      collapsedCount++;
+
+  TEST_ASSERT(collapsedCount == 1);
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestDifferingConstantsDontCollapse()
+{
+  ZydecFormattingInfo info;
+  info.collapseUnrolledGroups = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  char annotation[256];
+
+  // The copies add different constants.
+  //   mov rax, [rsi]; add rax, 1; mov [rdi], rax; mov rbx, [rsi + 8]; add rbx, 2; mov [rdi + 8], rbx; ret
+  const uint8_t immediates[] = { 0x48, 0x8B, 0x06, 0x48, 0x83, 0xC0, 0x01, 0x48, 0x89, 0x07, 0x48, 0x8B, 0x5E, 0x08, 0x48, 0x83, 0xC3, 0x02, 0x48, 0x89, 0x5F, 0x08, 0xC3 };
+  TEST_ASSERT(FindUnrolledAnnotation(pTranslator, immediates, sizeof(immediates), annotation, sizeof(annotation)) && annotation[0] == '\0');
+
+  // With the same constant, only the displacements differ & advance by 8 with every copy.
+  //   mov rax, [rsi]; add rax, 1; mov [rdi], rax; mov rbx, [rsi + 8]; add rbx, 1; mov [rdi + 8], rbx; ret
+  const uint8_t strided[] = { 0x48, 0x8B, 0x06, 0x48, 0x83, 0xC0, 0x01, 0x48, 0x89, 0x07, 0x48, 0x8B, 0x5E, 0x08, 0x48, 0x83, 0xC3, 0x01, 0x48, 0x89, 0x5F, 0x08, 0xC3 };
+  TEST_ASSERT(FindUnrolledAnnotation(pTranslator, strided, sizeof(strided), annotation, sizeof(annotation)) && strstr(annotation, "// x2 unrolled") != nullptr && strstr(annotation, "(stride: 8)") != nullptr);
+
+  // The shuffle controls differ.
+  //   vpshufd xmm1, xmm0, 0x1B; vpaddd xmm3, xmm3, xmm1; vpshufd xmm2, xmm0, 0xB1; vpaddd xmm3, xmm3, xmm2; vpshufd xmm4, xmm0, 0x4E; vpaddd xmm3, xmm3, xmm4; ret
+  const uint8_t shuffles[] = { 0xC5, 0xF9, 0x70, 0xC8, 0x1B, 0xC5, 0xE1, 0xFE, 0xD9, 0xC5, 0xF9, 0x70, 0xD0, 0xB1, 0xC5, 0xE1, 0xFE, 0xDA, 0xC5, 0xF9, 0x70, 0xE0, 0x4E, 0xC5, 0xE1, 0xFE, 0xDC, 0xC3 };
+  TEST_ASSERT(FindUnrolledAnnotation(pTranslator, shuffles, sizeof(shuffles), annotation, sizeof(annotation)) && annotation[0] == '\0');
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestPartitionsIndependentOfThreadCount()
+{
+  ZydecFormattingInfo info;
+  info.fuseFlagConditions = true;
+  info.collapseUnrolledGroups = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  // A few functions, repeated.
+  //   test rcx, rcx; jz target; cmp rdi, rsi; target: jl next; next: ret
+  //   add rax, [rdi]; add rdi, 8 (x3); ret
+  //   mov rax, rdi; jmp rsi
+  const uint8_t functions[] = { 0x48, 0x85, 0xC9, 0x74, 0x03, 0x48, 0x39, 0xF7, 0x7C, 0x00, 0xC3, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0xC3, 0x48, 0x89, 0xF8, 0xFF, 0xE6 };
+  constexpr size_t Repetitions = 16;
+  constexpr size_t MinPartitionSize = 40;
+
+  uint8_t code[sizeof(functions) * Repetitions];
+
+  for (size_t i = 0; i < Repetitions; i++)
+    memcpy(code + i * sizeof(functions), functions, sizeof(functions));
+
+  ZydecCodePartition partitions[sizeof(code) / MinPartitionSize + 1];
+  size_t partitionCount = 0;
+
+  TEST_ASSERT(zydec_Translator_FindPartitions(pTranslator, code, sizeof(code), MinPartitionSize, partitions, sizeof(partitions) / sizeof(partitions[0]), &partitionCount));
+  TEST_ASSERT(partitionCount > 4);
+
+  // The partitions cover all of the code & end after a `ret` or `jmp`.
+  for (size_t i = 0; i < partitionCount; i++)
+  {
+    TEST_ASSERT(partitions[i].offset == (i == 0 ? 0 : partitions[i - 1].offset + partitions[i - 1].size));
+    TEST_ASSERT(partitions[i].size >= MinPartitionSize || i + 1 == partitionCount);
+
+    const uint8_t *pEnd = code + partitions[i].offset + partitions[i].size;
+    TEST_ASSERT(pEnd[-1] == 0xC3 || (pEnd[-2] == 0xFF && pEnd[-1] == 0xE6));
+  }
+
+  TEST_ASSERT(partitions[partitionCount - 1].offset + partitions[partitionCount - 1].size == sizeof(code));
+
+  static char arenas[2][16 * 1024];
+  size_t offsets[2][sizeof(code)];
+  size_t instructionCounts[2] = { 0, 0 };
+  const size_t threadCounts[2] = { 1, 4 };
+
+  for (size_t i = 0; i < 2; i++)
+    TEST_ASSERT(zydec_Translator_TranslatePartitions(pTranslator, code, sizeof(code), TestBaseAddress, partitions, partitionCount, threadCounts[i], arenas[i], sizeof(arenas[i]), offsets[i], sizeof(offsets[i]) / sizeof(offsets[i][0]), &instructionCounts[i]));
+
+  TEST_ASSERT(instructionCounts[0] == 14 * Repetitions && instructionCounts[0] == instructionCounts[1]);
+
+  for (size_t i = 0; i < instructionCounts[0]; i++)
+    TEST_ASSERT(offsets[0][i] == offsets[1][i] && strcmp(arenas[0] + offsets[0][i], arenas[1] + offsets[1][i]) == 0);
+
+  // Too small an arena reports exactly how much is required.
+  const size_t usedArenaSize = offsets[0][instructionCounts[0] - 1] + strlen(arenas[0] + offsets[0][instructionCounts[0] - 1]) + 1;
+  size_t requiredArenaCapacity = 0;
+
+  TEST_ASSERT(!zydec_Translator_TranslatePartitions(pTranslator, code, sizeof(code), TestBaseAddress, partitions, partitionCount, 4, arenas[1], usedArenaSize - 1, offsets[1], sizeof(offsets[1]) / sizeof(offsets[1][0]), &instructionCounts[1], &requiredArenaCapacity));
+  TEST_ASSERT(requiredArenaCapacity == usedArenaSize);
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestSymbolTableLookup()
+{
+  const ZydecSymbol symbols[] =
+  {
+    { 0x3000, 0, "open" },
+    { 0x1040, 0x10, "inner" },
+    { 0x1000, 0x100, "outer" },
+    { 0x1040, 0x20, "alias" }, // Same address as `inner` & first by name, so it replaces it.
+    { 0x10C0, 0x8, "outer" },
+    { 0x2000, 0x10, "tail" },
+  };
+
+  ZydecSymbolTable *pSymbolTable = nullptr;
+  TEST_ASSERT(zydec_CreateSymbolTable(&pSymbolTable, symbols, sizeof(symbols) / sizeof(symbols[0])));
+
+  const struct
+  {
+    uint64_t address;
+    const char *name; // `nullptr` if no symbol contains the address.
+    uint64_t offset;
+  } lookups[] =
+  {
+    { 0x0FFF, nullptr, 0 },
+    { 0x1000, "outer", 0 },
+    { 0x1045, "alias", 0x5 },
+    { 0x1070, "outer", 0x70 }, // Past the end of `alias`, but still within `outer`.
+    { 0x10C4, "outer", 0x4 },
+    { 0x10C8, "outer", 0xC8 },
+    { 0x1100, nullptr, 0 },
+    { 0x2008, "tail", 0x8 },
+    { 0x2010, nullptr, 0 },
+    { 0x3500, "open", 0x500 },
+  };
+
+  const char *outerName = nullptr;
+
+  for (size_t i = 0; i < sizeof(lookups) / sizeof(lookups[0]); i++)
+  {
+    const char *name = nullptr;
+    size_t nameLength = 0;
+    uint64_t offset = 0;
+
+    const bool found = zydec_SymbolTable_Find(pSymbolTable, lookups[i].address, &name, &nameLength, &offset);
+    TEST_ASSERT(found == (lookups[i].name != nullptr));
+
+    if (!found)
+      continue;
+
+    TEST_ASSERT(strcmp(name, lookups[i].name) == 0 && nameLength == strlen(lookups[i].name));
+    TEST_ASSERT(offset == lookups[i].offset);
+
+    // Names are interned.
+    if (strcmp(name, "outer") == 0)
+    {
+      TEST_ASSERT(outerName == nullptr || outerName == name);
+      outerName = name;
+    }
+  }
+
+  zydec_DestroySymbolTable(&pSymbolTable);
+
+  return true;
+}
+
+// Appends an instruction ending in a 32 bit displacement, which translations resolve to `target` (relative to the virtual address of the instruction).
+static void AppendRelative(uint8_t *pCode, size_t *pSize, const uint8_t *pPrefix, const size_t prefixLength, const uint64_t target)
+{
+  const int32_t displacement = (int32_t)(target - (TestBaseAddress + *pSize));
+
+  memcpy(pCode + *pSize, pPrefix, prefixLength);
+  *pSize += prefixLength;
+
+  memcpy(pCode + *pSize, &displacement, sizeof(displacement));
+  *pSize += sizeof(displacement);
+}
+
+struct ResolverCalls
+{
+  size_t single;
+  size_t batched;
+  size_t batchedAddresses;
+};
+
+// Resolves the addresses in `[0x3000, 0x4000)` past `TestBaseAddress`.
+static bool ResolveExtern(const size_t virtualAddress, char *friendlyName, const size_t friendlyNameCapacity, size_t *pOffsetFromStart, void *pUserData)
+{
+  static_cast<ResolverCalls *>(pUserData)->single++;
+
+  if (virtualAddress < TestBaseAddress + 0x3000 || virtualAddress >= TestBaseAddress + 0x4000)
+    return false;
+
+  snprintf(friendlyName, friendlyNameCapacity, "extern");
+  *pOffsetFromStart = virtualAddress - (TestBaseAddress + 0x3000);
+
+  return true;
+}
+
+static bool ResolveExterns(const uint64_t *pAddresses, ZydecFormattingInfo::ResolvedAddress *pResolved, const size_t addressCount, void *pUserData)
+{
+  static_cast<ResolverCalls *>(pUserData)->batched++;
+  static_cast<ResolverCalls *>(pUserData)->batchedAddresses += addressCount;
+
+  for (size_t i = 0; i < addressCount; i++)
+  {
+    if (pAddresses[i] < TestBaseAddress + 0x3000 || pAddresses[i] >= TestBaseAddress + 0x4000)
+      continue;
+
+    pResolved[i].name = "extern";
+    pResolved[i].offsetFromStart = pAddresses[i] - (TestBaseAddress + 0x3000);
+  }
+
+  return true;
+}
+
+static bool TestBatchedAddressResolution()
+{
+  const uint8_t call[] = { 0xE8 };
+  const uint8_t jmp[] = { 0xE9 };
+  const uint8_t movRaxRip[] = { 0x48, 0x8B, 0x05 };
+  const uint8_t leaRcxRip[] = { 0x48, 0x8D, 0x0D };
+
+  const struct
+  {
+    const uint8_t *pPrefix;
+    size_t prefixLength;
+    uint64_t target;
+  } instructions[] =
+  {
+    { call, sizeof(call), 0x1000 },
+    { call, sizeof(call), 0x1010 },
+    { movRaxRip, sizeof(movRaxRip), 0x2014 }, // Within `field`, which is nested in `data`.
+    { leaRcxRip, sizeof(leaRcxRip), 0x2030 }, // Past `field`, but within `data`.
+    { call, sizeof(call), 0x3000 },
+    { call, sizeof(call), 0x3000 },
+    { movRaxRip, sizeof(movRaxRip), 0x3008 },
+    { call, sizeof(call), 0x1000 },
+    { jmp, sizeof(jmp), 0x5000 }, // Resolved by nothing.
+  };
+
+  constexpr size_t InstructionCount = sizeof(instructions) / sizeof(instructions[0]);
+
+  uint8_t code[InstructionCount * 8];
+  size_t size = 0;
+
+  for (size_t i = 0; i < InstructionCount; i++)
+    AppendRelative(code, &size, instructions[i].pPrefix, instructions[i].prefixLength, TestBaseAddress + instructions[i].target);
+
+  const ZydecSymbol symbols[] =
+  {
+    { TestBaseAddress + 0x1000, 0x100, "func" },
+    { TestBaseAddress + 0x2000, 0x40, "data" },
+    { TestBaseAddress + 0x2010, 0x8, "field" },
+  };
+
+  ZydecSymbolTable *pSymbolTable = nullptr;
+  TEST_ASSERT(zydec_CreateSymbolTable(&pSymbolTable, symbols, sizeof(symbols) / sizeof(symbols[0])));
+
+  ResolverCalls calls;
+  memset(&calls, 0, sizeof(calls));
+
+  ZydecFormattingInfo info;
+  info.pSymbolTable = pSymbolTable;
+  info.pResolveAddressToFriendlyName = ResolveExtern;
+  info.pUserData = &calls;
+
+  // One line at a time, resolving every operand on its own.
+  char lines[InstructionCount][256];
+
+  {
+    ZydecTranslator *pTranslator = nullptr;
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+    ZydisDecoder decoder;
+    ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64);
+
+    ZydisDecodedInstruction instruction;
+    ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+    size_t offset = 0;
+
+    for (size_t i = 0; i < InstructionCount; i++)
+    {
+      bool hasTranslation = false;
+
+      TEST_ASSERT(ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, code + offset, size - offset, &instruction, operands)));
+      TEST_ASSERT(zydec_Translator_TranslateInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + offset, lines[i], sizeof(lines[i]), &hasTranslation) && hasTranslation);
+
+      offset += instruction.length;
+    }
+
+    zydec_DestroyTranslator(&pTranslator);
+  }
+
+  TEST_ASSERT(strstr(lines[0], "func") != nullptr && strstr(lines[2], "field") != nullptr && strstr(lines[3], "data") != nullptr && strstr(lines[4], "extern") != nullptr);
+
+  // The symbol table resolves everything below `0x3000`, the callback is consulted for the other four operands.
+  TEST_ASSERT(calls.single == 4);
+
+  // Batched with a callback per distinct address & with a single callback for all of them.
+  info.batchAddressResolution = true;
+
+  for (size_t batched = 0; batched < 2; batched++)
+  {
+    if (batched)
+    {
+      info.pResolveAddressToFriendlyName = nullptr;
+      info.pResolveAddressesToFriendlyNames = ResolveExterns;
+    }
+
+    memset(&calls, 0, sizeof(calls));
+
+    ZydecTranslator *pTranslator = nullptr;
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+    char arena[InstructionCount * 256];
+    size_t offsets[InstructionCount];
+    size_t instructionCount = 0;
+
+    TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, code, size, TestBaseAddress, arena, sizeof(arena), offsets, InstructionCount, &instructionCount));
+    TEST_ASSERT(instructionCount == InstructionCount);
+
+    for (size_t i = 0; i < InstructionCount; i++)
+      TEST_ASSERT(strcmp(arena + offsets[i], lines[i]) == 0);
+
+    // `0x3000`, `0x3008` & `0x5000` are left to the callback.
+    if (batched)
+      TEST_ASSERT(calls.single == 0 && calls.batched == 1 && calls.batchedAddresses == 3);
+    else
+      TEST_ASSERT(calls.single == 3);
+
+    zydec_DestroyTranslator(&pTranslator);
+  }
+
+  zydec_DestroySymbolTable(&pSymbolTable);
+
+  return true;
+}
+
+static bool TestCheckpointsMatchLinearTranslation()
+{
+  const uint8_t loop[] =
+  {
+    0x48, 0x8B, 0x07, // mov rax, [rdi]
+    0x48, 0x39, 0xD0, // cmp rax, rdx
+    0x72, 0x03, // jb +3 (to the `jz`)
+    0x48, 0x39, 0xF2, // cmp rdx, rsi
+    0x74, 0x04, // jz +4 (to the `test`), with the flags of the `cmp` in front of it only if not coming from the `jb`
+    0x48, 0x83, 0xC7, 0x08, // add rdi, 8
+    0x48, 0x85, 0xFF, // test rdi, rdi
+    0x75, 0xEA, // jnz -22 (to the start)
+  };
+
+  constexpr size_t Repetitions = 6;
+  constexpr size_t InstructionsPerRepetition = 8;
+  constexpr size_t InstructionCount = InstructionsPerRepetition * Repetitions;
+
+  uint8_t code[sizeof(loop) * Repetitions];
+
+  for (size_t i = 0; i < Repetitions; i++)
+    memcpy(code + i * sizeof(loop), loop, sizeof(loop));
+
+  ZydecFormattingInfo info;
+  info.fuseFlagConditions = true;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  static char linearArena[InstructionCount * 256];
+  size_t linearOffsets[InstructionCount];
+  size_t instructionCount = 0;
+
+  ZydecLinearContext *pContext = zydec_Translator_GetLinearContext(pTranslator);
+  const ZydecLinearContext contextBefore = *pContext;
+
+  TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, code, sizeof(code), TestBaseAddress, linearArena, sizeof(linearArena), linearOffsets, InstructionCount, &instructionCount));
+  TEST_ASSERT(instructionCount == InstructionCount);
+
+  size_t instructionOffsets[InstructionCount];
+
+  for (size_t i = 0, offset = 0; i < InstructionCount; i++)
+  {
+    const size_t instructionLengths[InstructionsPerRepetition] = { 3, 3, 2, 3, 2, 4, 3, 2 };
+
+    instructionOffsets[i] = offset;
+    offset += instructionLengths[i % InstructionsPerRepetition];
+  }
+
+  const size_t intervals[] = { 1, 3, 16 };
+
+  for (size_t intervalIndex = 0; intervalIndex < sizeof(intervals) / sizeof(intervals[0]); intervalIndex++)
+  {
+    *pContext = contextBefore;
+    zydec_Translator_ForgetFlags(pTranslator);
+
+    ZydecCheckpointIndex *pCheckpointIndex = nullptr;
+    TEST_ASSERT(zydec_Translator_BuildCheckpoints(pTranslator, code, sizeof(code), TestBaseAddress, intervals[intervalIndex], &pCheckpointIndex));
+
+    // Start at any instruction & translate the rest of the block from the checkpoint before it.
+    for (size_t i = 0; i < InstructionCount; i++)
+    {
+      uint64_t checkpointAddress = 0;
+      size_t checkpointIndex = 0;
+
+      TEST_ASSERT(zydec_Translator_RestoreCheckpoint(pTranslator, pCheckpointIndex, TestBaseAddress + instructionOffsets[i], &checkpointAddress, &checkpointIndex));
+      TEST_ASSERT(checkpointIndex <= i && i - checkpointIndex < intervals[intervalIndex]);
+      TEST_ASSERT(checkpointAddress == TestBaseAddress + instructionOffsets[checkpointIndex]);
+
+      static char arena[InstructionCount * 256];
+      size_t offsets[InstructionCount];
+      const size_t codeOffset = instructionOffsets[checkpointIndex];
+
+      TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, code + codeOffset, sizeof(code) - codeOffset, checkpointAddress, arena, sizeof(arena), offsets, InstructionCount, &instructionCount));
+      TEST_ASSERT(instructionCount == InstructionCount - checkpointIndex);
+
+      for (size_t j = 0; j < instructionCount; j++)
+        TEST_ASSERT(strcmp(arena + offsets[j], linearArena + linearOffsets[checkpointIndex + j]) == 0);
+    }
+
+    zydec_DestroyCheckpointIndex(&pCheckpointIndex);
+  }
+
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+static bool TestBlockIRRendersLikeTranslation()
+{
+  const uint8_t code[] =
+  {
+    0x48, 0x8B, 0x07, // mov rax, [rdi]
+    0x48, 0x01, 0xC2, // add rdx, rax
+    0x48, 0x8D, 0x0D, 0x00, 0x10, 0x00, 0x00, // lea rcx, [rip + 0x1000]
+    0x48, 0x6B, 0xC0, 0x0C, // imul rax, rax, 12
+    0x0F, 0x10, 0x06, // movups xmm0, [rsi]
+    0x0F, 0x58, 0xC1, // addps xmm0, xmm1
+    0x48, 0xC1, 0xE2, 0x04, // shl rdx, 4
+    0x53, // push rbx
+    0x5B, // pop rbx
+    0xE8, 0x00, 0x02, 0x00, 0x00, // call +0x200
+    0x90, // nop
+    0x48, 0x39, 0xD0, // cmp rax, rdx
+    0x7C, 0xD0, // jl -0x30
+    0xC3, // ret
+  };
+
+  constexpr size_t InstructionCount = 14;
+  const uint8_t next[] = { 0x48, 0x01, 0xC8 }; // add rax, rcx
+
+  const ZydecTranslatorMode modes[] = { ZydecTranslatorMode::WithoutContext, ZydecTranslatorMode::LinearContext };
+
+  for (size_t modeIndex = 0; modeIndex < sizeof(modes) / sizeof(modes[0]); modeIndex++)
+  {
+    ZydecFormattingInfo info;
+
+    ZydecTranslator *pTranslator = nullptr;
+    ZydecTranslator *pIRTranslator = nullptr;
+    TEST_ASSERT(zydec_CreateTranslator(&pTranslator, modes[modeIndex], &info));
+    TEST_ASSERT(zydec_CreateTranslator(&pIRTranslator, modes[modeIndex], &info));
+
+    char arena[InstructionCount * 256];
+    size_t offsets[InstructionCount];
+    size_t instructionCount = 0;
+
+    TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslator, code, sizeof(code), TestBaseAddress, arena, sizeof(arena), offsets, InstructionCount, &instructionCount));
+    TEST_ASSERT(instructionCount == InstructionCount);
+
+    ZydecBlockIR *pBlockIR = nullptr;
+    TEST_ASSERT(zydec_Translator_BuildBlockIR(pIRTranslator, code, sizeof(code), TestBaseAddress, &pBlockIR));
+    TEST_ASSERT(zydec_BlockIR_GetInstructionCount(pBlockIR) == InstructionCount);
+
+    // Lines are rendered on their own, in any order.
+    for (size_t i = InstructionCount; i-- > 0;)
+    {
+      char line[256];
+      bool hasTranslation = false;
+
+      // Like the translation, this fails without setting `hasTranslation` for instructions that aren't translated.
+      const bool rendered = zydec_BlockIR_RenderInstruction(pBlockIR, i, line, sizeof(line), &hasTranslation);
+      TEST_ASSERT(rendered == hasTranslation);
+      TEST_ASSERT(hasTranslation == (arena[offsets[i]] != '\0'));
+
+      if (hasTranslation)
+        TEST_ASSERT(strcmp(line, arena + offsets[i]) == 0);
+    }
+
+    for (size_t i = 0, codeOffset = 0; i < InstructionCount; i++)
+    {
+      TEST_ASSERT(zydec_BlockIR_GetInstruction(pBlockIR, i)->virtualAddress == TestBaseAddress + codeOffset);
+      codeOffset += zydec_BlockIR_GetInstruction(pBlockIR, i)->length;
+    }
+
+    // Too small a buffer fails.
+    {
+      char line[4];
+      bool hasTranslation = false;
+
+      TEST_ASSERT(!zydec_BlockIR_RenderInstruction(pBlockIR, 0, line, sizeof(line), &hasTranslation));
+    }
+
+    zydec_DestroyBlockIR(&pBlockIR);
+
+    // Building the IR advanced the linear context just like the translation.
+    char line[256];
+    char irLine[256];
+
+    TEST_ASSERT(TranslateLast(pTranslator, next, sizeof(next), line, sizeof(line)));
+    TEST_ASSERT(TranslateLast(pIRTranslator, next, sizeof(next), irLine, sizeof(irLine)));
+    TEST_ASSERT(strcmp(line, irLine) == 0);
+
+    zydec_DestroyTranslator(&pTranslator);
+    zydec_DestroyTranslator(&pIRTranslator);
+  }
+
+  return true;
+}
+
+// The bit of `reg` in the register retention mask, which is also its SSA register slot.
+static size_t RegisterSlot(const ZydisRegister reg)
+{
+  const uint64_t mask = zydec_GetRegisterRetentionMask(&reg, 1);
+
+  for (size_t slot = 0; slot < 64; slot++)
+    if (mask & (1ULL << slot))
+      return slot;
+
+  return SIZE_MAX;
+}
+
+// The value of the register in `slot` the instruction reads, `SIZE_MAX` if it doesn't read it.
+static size_t FindOperandValue(const ZydecSSA *pSSA, const size_t instructionIndex, const size_t slot)
+{
+  size_t count = 0;
+  const size_t *pOperands = zydec_SSA_GetOperands(pSSA, instructionIndex, &count);
+
+  for (size_t i = 0; i < count; i++)
+    if (zydec_SSA_GetValue(pSSA, pOperands[i])->registerSlot == slot)
+      return pOperands[i];
+
+  return SIZE_MAX;
+}
+
+// The value of the register in `slot` the instruction writes, `SIZE_MAX` if it doesn't write it.
+static size_t FindDefinition(const ZydecSSA *pSSA, const size_t instructionIndex, const size_t slot)
+{
+  size_t first = 0;
+  size_t count = 0;
+
+  if (!zydec_SSA_GetDefinitions(pSSA, instructionIndex, &first, &count))
+    return SIZE_MAX;
+
+  for (size_t i = first; i < first + count; i++)
+    if (zydec_SSA_GetValue(pSSA, i)->registerSlot == slot)
+      return i;
+
+  return SIZE_MAX;
+}
+
+static bool TestDefUseChainsOfDiamond()
+{
+  const uint8_t code[] =
+  {
+    0x48, 0x85, 0xFF, // 0: test rdi, rdi
+    0x74, 0x08, // 1: jz +8 (to 5)
+    0x48, 0x89, 0xF8, // 2: mov rax, rdi
+    0x48, 0x01, 0xF0, // 3: add rax, rsi
+    0xEB, 0x03, // 4: jmp +3 (to 6)
+    0x48, 0x89, 0xF0, // 5: mov rax, rsi
+    0x48, 0x01, 0xD0, // 6: add rax, rdx
+    0xC3, // 7: ret
+  };
+
+  ZydecFormattingInfo info;
+
+  ZydecTranslator *pTranslator = nullptr;
+  TEST_ASSERT(zydec_CreateTranslator(&pTranslator, ZydecTranslatorMode::LinearContext, &info));
+
+  ZydecControlFlowGraph *pGraph = nullptr;
+  TEST_ASSERT(zydec_Translator_BuildControlFlowGraph(pTranslator, code, sizeof(code), TestBaseAddress, &pGraph));
+  TEST_ASSERT(zydec_ControlFlowGraph_GetBlockCount(pGraph) == 4);
+  TEST_ASSERT(zydec_ControlFlowGraph_GetInstructionCount(pGraph) == 8);
+
+  ZydecSSA *pSSA = nullptr;
+  TEST_ASSERT(zydec_Translator_BuildSSA(pTranslator, pGraph, &pSSA));
+
+  const size_t rax = RegisterSlot(ZYDIS_REGISTER_RAX);
+  const size_t rdi = RegisterSlot(ZYDIS_REGISTER_RDI);
+  const size_t rsi = RegisterSlot(ZYDIS_REGISTER_RSI);
+  const size_t rdx = RegisterSlot(ZYDIS_REGISTER_RDX);
+
+  // `rdi` enters the code & is read by the `test` & the first `mov`.
+  const size_t rdiLiveIn = FindOperandValue(pSSA, 0, rdi);
+  TEST_ASSERT(rdiLiveIn != SIZE_MAX && zydec_SSA_GetValue(pSSA, rdiLiveIn)->kind == ZydecValueKind::LiveIn && zydec_SSA_GetValue(pSSA, rdiLiveIn)->block == 0);
+  TEST_ASSERT(FindOperandValue(pSSA, 2, rdi) == rdiLiveIn);
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, rdiLiveIn)->useCount == 2);
+  TEST_ASSERT(zydec_SSA_GetUses(pSSA, rdiLiveIn)[0].index == 0 && !zydec_SSA_GetUses(pSSA, rdiLiveIn)[0].isPhi);
+  TEST_ASSERT(zydec_SSA_GetUses(pSSA, rdiLiveIn)[1].index == 2 && !zydec_SSA_GetUses(pSSA, rdiLiveIn)[1].isPhi);
+
+  // Both sides read the same `rsi`, so there's no phi for it.
+  TEST_ASSERT(FindOperandValue(pSSA, 3, rsi) != SIZE_MAX && FindOperandValue(pSSA, 3, rsi) == FindOperandValue(pSSA, 5, rsi));
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, FindOperandValue(pSSA, 3, rsi))->kind == ZydecValueKind::LiveIn);
+
+  // The `add` of the left side continues the `mov` in front of it.
+  const size_t leftMov = FindDefinition(pSSA, 2, rax);
+  const size_t leftAdd = FindDefinition(pSSA, 3, rax);
+  const size_t rightMov = FindDefinition(pSSA, 5, rax);
+
+  TEST_ASSERT(leftMov != SIZE_MAX && leftAdd != SIZE_MAX && rightMov != SIZE_MAX);
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, leftMov)->kind == ZydecValueKind::Definition && zydec_SSA_GetValue(pSSA, leftMov)->instruction == 2);
+  TEST_ASSERT(FindOperandValue(pSSA, 3, rax) == leftMov);
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, leftMov)->useCount == 1 && zydec_SSA_GetUses(pSSA, leftMov)[0].index == 3);
+
+  // Both sides define `rax`, so the join reads it from a phi with one operand per predecessor.
+  const size_t joinValue = FindOperandValue(pSSA, 6, rax);
+  TEST_ASSERT(joinValue != SIZE_MAX);
+
+  const ZydecValue *pPhi = zydec_SSA_GetValue(pSSA, joinValue);
+  TEST_ASSERT(pPhi->kind == ZydecValueKind::Phi && pPhi->block == 3 && pPhi->operandCount == 2);
+
+  const ZydecBasicBlock *pJoin = zydec_ControlFlowGraph_GetBlock(pGraph, 3);
+  const size_t *pPredecessors = zydec_ControlFlowGraph_GetPredecessors(pGraph, 3);
+  TEST_ASSERT(pJoin->predecessorCount == 2);
+
+  for (size_t i = 0; i < 2; i++)
+  {
+    TEST_ASSERT(pPredecessors[i] == 1 || pPredecessors[i] == 2);
+    TEST_ASSERT(zydec_SSA_GetPhiOperands(pSSA, joinValue)[i] == (pPredecessors[i] == 1 ? leftAdd : rightMov));
+  }
+
+  // The definitions on both sides are only used by the phi, the phi only by the last `add`.
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, leftAdd)->useCount == 1 && zydec_SSA_GetUses(pSSA, leftAdd)[0].isPhi && zydec_SSA_GetUses(pSSA, leftAdd)[0].index == joinValue);
+  TEST_ASSERT(zydec_SSA_GetValue(pSSA, rightMov)->useCount == 1 && zydec_SSA_GetUses(pSSA, rightMov)[0].isPhi && zydec_SSA_GetUses(pSSA, rightMov)[0].index == joinValue);
+  TEST_ASSERT(pPhi->useCount >= 1 && zydec_SSA_GetUses(pSSA, joinValue)[0].index == 6 && !zydec_SSA_GetUses(pSSA, joinValue)[0].isPhi);
+
+  // `rdx` is never written, so the join reads the value it entered the code with.
+  const size_t rdxValue = FindOperandValue(pSSA, 6, rdx);
+  TEST_ASSERT(rdxValue != SIZE_MAX && zydec_SSA_GetValue(pSSA, rdxValue)->kind == ZydecValueKind::LiveIn && zydec_SSA_GetValue(pSSA, rdxValue)->block == 0);
+
+  // `rdx` stays live on either side until the last `add`. `rax` isn't live in front of the sides, as both overwrite it.
+  TEST_ASSERT((zydec_SSA_GetLiveAfter(pSSA, 2) & (1ULL << rdx)) != 0 && (zydec_SSA_GetLiveAfter(pSSA, 5) & (1ULL << rdx)) != 0);
+  TEST_ASSERT((zydec_SSA_GetLiveAfter(pSSA, 3) & (1ULL << rax)) != 0 && (zydec_SSA_GetLiveAfter(pSSA, 6) & (1ULL << rdx)) == 0);
+  TEST_ASSERT((zydec_SSA_GetLiveAfter(pSSA, 0) & (1ULL << rax)) == 0);
+
+  zydec_DestroySSA(&pSSA);
+  zydec_DestroyControlFlowGraph(&pGraph);
+  zydec_DestroyTranslator(&pTranslator);
+
+  return true;
+}
+
+// The size of the arena up to & including the terminator of the last line.
+static size_t UsedArenaSize(const char *pArena, const size_t *pOffsets, const size_t instructionCount)
+{
+  return pOffsets[instructionCount - 1] + strlen(pArena + pOffsets[instructionCount - 1]) + 1;
+}
+
+static bool TestRequiredArenaCapacityOnOverflow()
+{
+  ZydecFormattingInfo info;
+  info.fuseFlagConditions = true;
+  info.collapseUnrolledGroups = true;
+
+  //   test rcx, rcx; jz target; cmp rdi, rsi; target: jl next; next: ret
+  //   add rax, [rdi]; add rdi, 8 (x3); ret
+  //   mov rax, rdi; jmp rsi
+  const uint8_t code[] = { 0x48, 0x85, 0xC9, 0x74, 0x03, 0x48, 0x39, 0xF7, 0x7C, 0x00, 0xC3, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0x48, 0x03, 0x07, 0x48, 0x83, 0xC7, 0x08, 0xC3, 0x48, 0x89, 0xF8, 0xFF, 0xE6 };
+  constexpr size_t InstructionCount = 14;
+
+  char arenas[2][1024];
+  size_t offsets[2][InstructionCount];
+  size_t instructionCounts[2] = { 0, 0 };
+  size_t requiredArenaCapacity = 0;
+
+  // A translator block that doesn't fit leaves the translator as it was, so retrying with the reported capacity matches a translation that fit right away.
+  {
+    ZydecTranslator *pTranslators[2] = { nullptr, nullptr };
+
+    for (size_t i = 0; i < 2; i++)
+      TEST_ASSERT(zydec_CreateTranslator(&pTranslators[i], ZydecTranslatorMode::LinearContext, &info));
+
+    TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslators[0], code, sizeof(code), TestBaseAddress, arenas[0], sizeof(arenas[0]), offsets[0], InstructionCount, &instructionCounts[0], &requiredArenaCapacity));
+    TEST_ASSERT(instructionCounts[0] == InstructionCount && requiredArenaCapacity == 0);
+
+    const size_t usedArenaSize = UsedArenaSize(arenas[0], offsets[0], instructionCounts[0]);
+
+    TEST_ASSERT(!zydec_Translator_TranslateBlock(pTranslators[1], code, sizeof(code), TestBaseAddress, arenas[1], usedArenaSize - 1, offsets[1], InstructionCount, &instructionCounts[1], &requiredArenaCapacity));
+    TEST_ASSERT(requiredArenaCapacity == usedArenaSize);
+
+    TEST_ASSERT(zydec_Translator_TranslateBlock(pTranslators[1], code, sizeof(code), TestBaseAddress, arenas[1], requiredArenaCapacity, offsets[1], InstructionCount, &instructionCounts[1]));
+    TEST_ASSERT(instructionCounts[1] == instructionCounts[0]);
+
+    for (size_t i = 0; i < instructionCounts[0]; i++)
+      TEST_ASSERT(offsets[0][i] == offsets[1][i] && strcmp(arenas[0] + offsets[0][i], arenas[1] + offsets[1][i]) == 0);
+
+    TEST_ASSERT(memcmp(zydec_Translator_GetLinearContext(pTranslators[0]), zydec_Translator_GetLinearContext(pTranslators[1]), sizeof(ZydecLinearContext)) == 0);
+
+    // Failures other than the arena don't report a capacity.
+    TEST_ASSERT(!zydec_Translator_TranslateBlock(pTranslators[1], code, sizeof(code), TestBaseAddress, arenas[1], sizeof(arenas[1]), offsets[1], InstructionCount - 1, &instructionCounts[1], &requiredArenaCapacity));
+    TEST_ASSERT(requiredArenaCapacity == 0);
+
+    // The blocks of a control flow graph collapse on their own.
+    ZydecControlFlowGraph *pGraph = nullptr;
+    TEST_ASSERT(zydec_Translator_BuildControlFlowGraph(pTranslators[0], code, sizeof(code), TestBaseAddress, &pGraph));
+
+    TEST_ASSERT(zydec_Translator_TranslateControlFlowGraph(pTranslators[0], pGraph, arenas[0], sizeof(arenas[0]), offsets[0], InstructionCount, &instructionCounts[0]));
+
+    const size_t usedGraphArenaSize = UsedArenaSize(arenas[0], offsets[0], instructionCounts[0]);
+
+    TEST_ASSERT(!zydec_Translator_TranslateControlFlowGraph(pTranslators[1], pGraph, arenas[1], usedGraphArenaSize - 1, offsets[1], InstructionCount, &instructionCounts[1], &requiredArenaCapacity));
+    TEST_ASSERT(requiredArenaCapacity == usedGraphArenaSize);
+
+    zydec_DestroyControlFlowGraph(&pGraph);
+
+    for (size_t i = 0; i < 2; i++)
+      zydec_DestroyTranslator(&pTranslators[i]);
+  }
+
+  // Same for the free functions with a linear context.
+  {
+    ZydecLinearContext contexts[2];
+    ZydecFormattingInfo freeInfo;
+
+    TEST_ASSERT(zydec_TranslateBlock(&contexts[0], code, sizeof(code), TestBaseAddress, arenas[0], sizeof(arenas[0]), offsets[0], InstructionCount, &instructionCounts[0], &freeInfo));
+
+    const size_t usedArenaSize = UsedArenaSize(arenas[0], offsets[0], instructionCounts[0]);
+
+    TEST_ASSERT(!zydec_TranslateBlock(&contexts[1], code, sizeof(code), TestBaseAddress, arenas[1], usedArenaSize - 1, offsets[1], InstructionCount, &instructionCounts[1], &freeInfo, &requiredArenaCapacity));
+    TEST_ASSERT(requiredArenaCapacity == usedArenaSize);
+
+    TEST_ASSERT(zydec_TranslateBlock(&contexts[1], code, sizeof(code), TestBaseAddress, arenas[1], requiredArenaCapacity, offsets[1], InstructionCount, &instructionCounts[1], &freeInfo));
+
+    for (size_t i = 0; i < instructionCounts[0]; i++)
+      TEST_ASSERT(offsets[0][i] == offsets[1][i] && strcmp(arenas[0] + offsets[0][i], arenas[1] + offsets[1][i]) == 0);
+
+    TEST_ASSERT(memcmp(&contexts[0], &contexts[1], sizeof(ZydecLinearContext)) == 0);
+  }
+
+  // And for single instructions.
+  {
+    ZydisDecoder decoder;
+    ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64);
+
+    ZydisDecodedInstruction instruction;
+    ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+    TEST_ASSERT(ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, code + 11, sizeof(code) - 11, &instruction, operands))); // add rax, [rdi]
+
+    const ZydecLinearContext initialContext;
+    ZydecLinearContext contexts[2];
+    ZydecFormattingInfo freeInfo;
+    char line[2][256];
+    bool hasTranslation = false;
+    size_t requiredCapacity = 0;
+
+    TEST_ASSERT(zydec_TranslateInstructionWithLinearContext(&contexts[0], &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + 11, line[0], sizeof(line[0]), &hasTranslation, &freeInfo, &requiredCapacity) && hasTranslation);
+    TEST_ASSERT(requiredCapacity == 0);
+
+    TEST_ASSERT(!zydec_TranslateInstructionWithLinearContext(&contexts[1], &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + 11, line[1], 4, &hasTranslation, &freeInfo, &requiredCapacity));
+    TEST_ASSERT(requiredCapacity == strlen(line[0]) + 1);
+    TEST_ASSERT(memcmp(&contexts[1], &initialContext, sizeof(ZydecLinearContext)) == 0);
+
+    TEST_ASSERT(zydec_TranslateInstructionWithLinearContext(&contexts[1], &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + 11, line[1], requiredCapacity, &hasTranslation, &freeInfo));
+    TEST_ASSERT(strcmp(line[0], line[1]) == 0 && memcmp(&contexts[0], &contexts[1], sizeof(ZydecLinearContext)) == 0);
+
+    TEST_ASSERT(zydec_TranslateInstructionWithoutContext(&instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + 11, line[0], sizeof(line[0]), &hasTranslation, &freeInfo) && hasTranslation);
+    TEST_ASSERT(!zydec_TranslateInstructionWithoutContext(&instruction, operands, ZYDIS_MAX_OPERAND_COUNT, TestBaseAddress + 11, line[1], 4, &hasTranslation, &freeInfo, &requiredCapacity));
+    TEST_ASSERT(requiredCapacity == strlen(line[0]) + 1);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Test
+{
+  const char *name;
+  bool (*pFunc)();
+};
+
+static const Test Tests[] =
+{
+  { "RegisterTokenKinds", TestRegisterTokenKinds },
+  { "UnsignedFusedConditions", TestUnsignedFusedConditions },
+  { "FlagsForgottenAtBranchTargets", TestFlagsForgottenAtBranchTargets },
+  { "LoopBoundFromTwoPredecessors", TestLoopBoundFromTwoPredecessors },
+  { "PipelinedCopiesDontCollapse", TestPipelinedCopiesDontCollapse },
+  { "DifferingConstantsDontCollapse", TestDifferingConstantsDontCollapse },
+  { "PartitionsIndependentOfThreadCount", TestPartitionsIndependentOfThreadCount },
+  { "SymbolTableLookup", TestSymbolTableLookup },
+  { "BatchedAddressResolution", TestBatchedAddressResolution },
+  { "CheckpointsMatchLinearTranslation", TestCheckpointsMatchLinearTranslation },
+  { "BlockIRRendersLikeTranslation", TestBlockIRRendersLikeTranslation },
+  { "DefUseChainsOfDiamond", TestDefUseChainsOfDiamond },
+  { "RequiredArenaCapacityOnOverflow", TestRequiredArenaCapacityOnOverflow },
+};
+
+int main()
+{
+  size_t failed = 0;
+
+  for (size_t i = 0; i < sizeof(Tests) / sizeof(Tests[0]); i++)
+  {
+    const bool succeeded = Tests[i].pFunc();
+    printf("[%s] %s\n", succeeded ? " OK " : "FAIL", Tests[i].name);
+
+    if (!succeeded)
+      failed++;
+  }
+
+  printf("%" PRIu64 " / %" PRIu64 " tests passed.\n", (uint64_t)(sizeof(Tests) / sizeof(Tests[0]) - failed), (uint64_t)(sizeof(Tests) / sizeof(Tests[0])));
+
+  return failed == 0 ? 0 : 1;
+}
@@ -41,6 +41,41 @@ extern "C"
 
 ////////////////////////////////////////////////////////////////////////////////
 
+enum class ZydecTokenKind : uint8_t
+{
+  Register,
+  RenamedRegister,
+  Intrinsic,
+  Immediate,
+  Address,
+  Symbol,
+  Comment,
+};
+
+struct ZydecTokenSpan
+{
+  uint32_t offset; // from the start of the line.
+  uint16_t length;
+  ZydecTokenKind kind;
+};
+
+// Receives the token spans of a translated line, so it doesn't have to be lexed again for highlighting.
+// Text that isn't covered by any span (operators, punctuation, ...) is plain text.
+struct ZydecTokenList
+{
+  ZydecTokenSpan *pTokens = nullptr;
+  size_t tokenCapacity = 0;
+  size_t tokenCount = 0; // May exceed `tokenCapacity`, in which case only the first `tokenCapacity` spans were stored.
+
+  const char *pLineStart = nullptr; // Set by the translation.
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ZydecSymbolTable;
+struct ZydecAddressCache;
+struct ZydecFlagProducer;
+
 struct ZydecFormattingInfo
 {
   // Returns `true` on success.
@@ -49,6 +84,18 @@ struct ZydecFormattingInfo
   ResolveAddressToFriendlyName *pResolveAddressToFriendlyName = nullptr;
   void *pUserData = nullptr;
 
+  struct ResolvedAddress
+  {
+    const char *name; // Zero terminated, `nullptr` if the address couldn't be resolved.
+    uint64_t offsetFromStart;
+  };
+
+  // Resolves many addresses at once. `pAddresses` is sorted & free of duplicates, `pResolved` is initialized to unresolved entries.
+  // The names have to remain valid until the translation of the block (or instruction) is done. Returns `true` on success.
+  typedef bool ResolveAddressesToFriendlyNames(const uint64_t *pAddresses, ResolvedAddress *pResolved, const size_t addressCount, void *pUserData);
+
+  ResolveAddressesToFriendlyNames *pResolveAddressesToFriendlyNames = nullptr; // Preferred with `batchAddressResolution`, otherwise only used if `pResolveAddressToFriendlyName` isn't set.
+
   typedef bool RegisterAppendStringFunc(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, void *pRegUserData);
   
   enum HintOperation
@@ -122,6 +169,7 @@ struct ZydecFormattingInfo
   {
     Linux,
     Windows,
+    Custom, // `afterCallRetainedRegisters`
 
     Default = 
 #if defined(_WIN32) || defined(_WIN64)
@@ -132,22 +180,368 @@ struct ZydecFormattingInfo
   };
   
   AfterCallRegisterRetentionMode afterCallRegisterRetentionMode = AfterCallRegisterRetentionMode::Default;
+  uint64_t afterCallRetainedRegisters = 0; // For `AfterCallRegisterRetentionMode::Custom` (e.g. `__vectorcall` or `preserve_most`), see `zydec_GetRegisterRetentionMask`.
+
+  enum class RegisterNaming
+  {
+    Sequential, // Every name depends on all preceding instructions.
+    AddressSeeded, // Names only depend on `registerNamingSeed`, the address of the defining instruction & the register (or the hints), so they don't change with unrelated code.
+  };
+
+  RegisterNaming registerNaming = RegisterNaming::Sequential; // Only used by the linear context.
+  uint64_t registerNamingSeed = 0;
+
+  ZydecTokenList *pTokenList = nullptr; // Optional. Filled with the token spans of every translated instruction.
+  const ZydecSymbolTable *pSymbolTable = nullptr; // Optional. Consulted before `pResolveAddressToFriendlyName`.
+
+  // Lets the block functions collect all jump, call & rip relative targets of a block up front and resolve every distinct address only once:
+  // With a single pass over `pSymbolTable` and a single call of `pResolveAddressesToFriendlyNames` (or one call of `pResolveAddressToFriendlyName` per distinct address).
+  // Requires an additional (partial) decoding pass over the block, so it pays off with expensive resolvers.
+  bool batchAddressResolution = false;
+  const ZydecAddressCache *pAddressCache = nullptr; // Set by the block functions while `batchAddressResolution` is in effect.
+
+  // Lets the translator remember the last `cmp`, `test`, `and`, `sub` (...) and render the `jcc`, `setcc` & `cmovcc` depending on its flags as a condition on its operands (e.g. `if ((i64)di < (i64)r14) goto`).
+  // Jumps that the processor may macro-fuse with the instruction in front of them are marked as such. Only available with `ZydecTranslator`, block IR doesn't fuse.
+  // The block functions, partitions & checkpoints forget the flags at the targets of the direct jumps within their code, translating single instructions requires `zydec_Translator_ForgetFlags` there.
+  bool fuseFlagConditions = false;
+  const ZydecFlagProducer *pFlagProducer = nullptr; // Set by the translator while `fuseFlagConditions` is in effect.
+
+  // Lets the block functions of `ZydecTranslator` find runs of copies of the same instructions within a block (like the bodies of unrolled loops): The same mnemonics & operand kinds, with every copy reading the registers written by its own instructions in the same way. Values of earlier copies must continue the registers the first copy read (like accumulators or advanced pointers), so software pipelined code isn't collapsed.
+  // Only the first copy is translated & its last instruction annotated with `// x3 unrolled (lanes: ...)`, the first register or constant that tells the copies apart, & ` (stride: 8)` if the other displacements advance with every copy. Copies that differ in any other input or constant aren't collapsed. The other copies only advance the linear context & remain empty.
+  // Requires an additional decoding pass over the block. `zydec_Translator_TranslateBlock`, `zydec_Translator_MeasureBlock` & every partition treat their code as a single block (branches merely end groups), control flow graphs use their basic blocks. Checkpoints & block IR don't collapse anything.
+  bool collapseUnrolledGroups = false;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-// Currently requires all 10 operands.
-bool zydec_TranslateInstructionWithoutContext(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo);
+struct ZydecSymbol
+{
+  uint64_t address;
+  uint64_t size; // 0 if unknown, in which case the symbol extends up to the next one.
+  const char *name;
+};
+
+// Immutable index of symbols to resolve addresses with, without calling back into the application.
+// `pSymbols` is copied. If multiple symbols share an address, the first one by name is used.
+bool zydec_CreateSymbolTable(ZydecSymbolTable **ppSymbolTable, const ZydecSymbol *pSymbols, const size_t symbolCount);
+void zydec_DestroySymbolTable(ZydecSymbolTable **ppSymbolTable);
+
+// Finds the symbol containing `address`, the one starting closest to it if symbols overlap. `*pName` points into the symbol table and is zero terminated.
+bool zydec_SymbolTable_Find(const ZydecSymbolTable *pSymbolTable, const uint64_t address, const char **pName, size_t *pNameLength, uint64_t *pOffsetFromStart);
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Formats numbers the way translations do: decimal, or uppercase hex prefixed with `0x`. The output is zero terminated.
+bool zydec_FormatUInt(const uint64_t value, char *buffer, const size_t bufferCapacity);
+bool zydec_FormatHex(const uint64_t value, char *buffer, const size_t bufferCapacity);
+
+////////////////////////////////////////////////////////////////////////////////
+
+// The number of leading operands (as ordered by Zydis, so visible operands first) the translation of the instruction reads, which may be 0.
+// The `operandCount` of the translation functions only has to cover these, so `ZydisDecoderDecodeOperands` can be called with this instead of decoding all operands.
+size_t zydec_GetRequiredOperandCount(const ZydisDecodedInstruction *pInstruction);
+
+// Requires at least `zydec_GetRequiredOperandCount` operands.
+// If `pRequiredCapacity` is provided and the buffer is too small, it receives the required capacity (including the terminator). It's set to 0 otherwise.
+bool zydec_TranslateInstructionWithoutContext(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo, size_t *pRequiredCapacity = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////
 
 struct ZydecLinearContext
 {
+  static constexpr size_t RegisterSlotCount = 64;
+
   uint64_t hashState = 0xBADC0FFEECA7F00D;
-  uint32_t regInfo[ZYDIS_REGISTER_MAX_VALUE] = {};
+  uint32_t regInfo[RegisterSlotCount] = {}; // The names of 16 GPRs, 32 vector registers (shared by xmm, ymm & zmm), 8 mask & 8 mmx registers. Other registers aren't renamed.
+};
+
+// Builds `ZydecFormattingInfo::afterCallRetainedRegisters` from the registers whose names survive a call. Sub registers & vector widths retain the whole register.
+uint64_t zydec_GetRegisterRetentionMask(const ZydisRegister *pRegisters, const size_t registerCount);
+
+// Requires at least `zydec_GetRequiredOperandCount` operands.
+// If `pRequiredCapacity` is provided and the buffer is too small, it receives the required capacity (including the terminator) and `pContext` is left untouched, so the translation can be retried. It's set to 0 otherwise.
+bool zydec_TranslateInstructionWithLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo, size_t *pRequiredCapacity = nullptr);
+
+// Only applies the register assignments & name changes the translation of the instruction would cause to `pContext`, without formatting any text.
+bool zydec_AdvanceLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, ZydecFormattingInfo *pInfo);
+
+// Decodes & translates all 64 bit instructions in `pCode` with the linear context into `pArena`.
+// The zero terminated translation of the n-th instruction starts at `pArena + pOffsets[n]`, instructions without translation are empty.
+// Fails if the code can't be decoded or `pArena` / `pOffsets` are too small, `*pInstructionCount` contains the number of instructions translated until then.
+// If `pRequiredArenaCapacity` is provided and the translation fails, `pContext` is left as it was before the block. If `pArena` was too small, it receives the exact arena capacity the whole block requires, so a single retry suffices. It's set to 0 otherwise.
+bool zydec_TranslateBlock(ZydecLinearContext *pContext, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, ZydecFormattingInfo *pInfo, size_t *pRequiredArenaCapacity = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class ZydecTranslatorMode
+{
+  WithoutContext,
+  LinearContext,
+};
+
+// Holds the options, callbacks and (if applicable) the linear context, so they only have to be set up once.
+struct ZydecTranslator;
+
+// `pInfo` is copied. The register & call callbacks of `pInfo` are only used with `ZydecTranslatorMode::WithoutContext`.
+bool zydec_CreateTranslator(ZydecTranslator **ppTranslator, const ZydecTranslatorMode mode, const ZydecFormattingInfo *pInfo);
+void zydec_DestroyTranslator(ZydecTranslator **ppTranslator);
+
+// Returns `nullptr` if the translator doesn't use a linear context.
+ZydecLinearContext *zydec_Translator_GetLinearContext(ZydecTranslator *pTranslator);
+
+// Requires at least `zydec_GetRequiredOperandCount` operands, with `fuseFlagConditions` all operands of the instruction are required to keep track of the flags.
+// If `pRequiredCapacity` is provided and the buffer is too small, it receives the required capacity (including the terminator) and the linear context is left untouched, so the translation can be retried. It's set to 0 otherwise.
+bool zydec_Translator_TranslateInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, size_t *pRequiredCapacity = nullptr);
+
+// Like `zydec_Translator_TranslateInstruction`, but only decodes the operands the translation reads, from the context `ZydisDecoderDecodeInstruction` returned for the instruction (decoded in 64 bit mode).
+bool zydec_Translator_TranslateDecodedInstruction(ZydecTranslator *pTranslator, const ZydisDecoderContext *pDecoderContext, const ZydisDecodedInstruction *pInstruction, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, size_t *pRequiredCapacity = nullptr);
+
+// See `zydec_TranslateBlock`. With `pRequiredArenaCapacity` the fused flag conditions are restored on failure as well.
+bool zydec_Translator_TranslateBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity = nullptr);
+
+// Retrieves the exact capacity (including the terminator) required to translate the instruction, without writing anything or advancing the linear context.
+// In `WithoutContext` mode the callbacks of the formatting info are called just like during a translation.
+bool zydec_Translator_MeasureInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, size_t *pRequiredCapacity, bool *pHasTranslation);
+
+// Retrieves the exact arena capacity `zydec_Translator_TranslateBlock` requires for the same code, without advancing the linear context.
+bool zydec_Translator_MeasureBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, size_t *pRequiredArenaCapacity, size_t *pInstructionCount);
+
+// See `zydec_AdvanceLinearContext`. Require `ZydecTranslatorMode::LinearContext`.
+bool zydec_Translator_AdvanceInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress);
+
+// Fails if the code can't be decoded, `*pInstructionCount` contains the number of instructions applied until then.
+bool zydec_Translator_AdvanceBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, size_t *pInstructionCount);
+
+// With `fuseFlagConditions`: Stops conditions from being fused with the last flag producer, e.g. at jump targets, where the flags may come from elsewhere.
+// The advance functions don't track the flags at all.
+void zydec_Translator_ForgetFlags(ZydecTranslator *pTranslator);
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ZydecCodePartition
+{
+  size_t offset; // Into the code, has to be the start of an instruction.
+  size_t size;
 };
 
-// Currently requires all 10 operands.
-bool zydec_TranslateInstructionWithLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo);
+// Translates the partitions (e.g. functions or sections) of `pCode` on a work stealing pool of `threadCount` threads (0 for one per hardware thread) and lays them out in order in `pArena`, like `zydec_Translator_TranslateBlock`.
+// Every partition starts with its own copy of the linear context of the translator (which isn't advanced) & without a flag producer, so the text doesn't depend on the number of threads.
+// The callbacks of the translator are called concurrently, token lists aren't filled. Fails if a partition can't be decoded or `pArena` / `pOffsets` are too small, `*pInstructionCount` contains the number of instructions laid out until then.
+// If `pRequiredArenaCapacity` is provided and every partition was translated, it receives the exact arena capacity the partitions require (0 if they didn't fit into `pArena`).
+bool zydec_Translator_TranslatePartitions(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const ZydecCodePartition *pPartitions, const size_t partitionCount, const size_t threadCount, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity = nullptr);
+
+// Splits `pCode` into partitions for `zydec_Translator_TranslatePartitions` where functions usually end: After a `ret`, an unconditional jump, `int3` or `ud2`, once the partition is at least `minPartitionSize` bytes long.
+// There are at most `size / minPartitionSize + 1` partitions. Fails if the code can't be decoded or `pPartitions` is too small, `*pPartitionCount` contains the number of partitions found until then.
+bool zydec_Translator_FindPartitions(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const size_t minPartitionSize, ZydecCodePartition *pPartitions, const size_t partitionCapacity, size_t *pPartitionCount);
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Snapshots of the linear context, so the translation of a large block can start close to any instruction rather than at the beginning.
+struct ZydecCheckpointIndex;
+
+// Runs the linear context over all 64 bit instructions in `pCode` without producing any text & takes a snapshot before every `interval`-th instruction, starting with the first one.
+// Requires `ZydecTranslatorMode::LinearContext`. The linear context of the translator is left untouched.
+bool zydec_Translator_BuildCheckpoints(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const size_t interval, ZydecCheckpointIndex **ppCheckpointIndex);
+void zydec_DestroyCheckpointIndex(ZydecCheckpointIndex **ppCheckpointIndex);
+
+// Sets the linear context (& with `fuseFlagConditions` the flag producer) of the translator to the last checkpoint at or before `virtualAddress`.
+// Translating from `*pCheckpointAddress` (the `*pInstructionIndex`-th instruction of the block) onwards then produces the same text as translating the whole block.
+// With `fuseFlagConditions`, the translator also forgets the flags at the targets of the jumps in front of the checkpoint that lie behind it, until the next restore.
+bool zydec_Translator_RestoreCheckpoint(ZydecTranslator *pTranslator, const ZydecCheckpointIndex *pCheckpointIndex, const uint64_t virtualAddress, uint64_t *pCheckpointAddress, size_t *pInstructionIndex = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ZydecOperandIR
+{
+  enum Flags : uint8_t
+  {
+    HasDisplacement = 1 << 0,
+    IsSigned = 1 << 1,
+    IsRelative = 1 << 2,
+  };
+
+  int64_t value; // Immediate, displacement or pointer offset.
+  uint16_t reg; // `ZydisRegister`, the memory base for memory operands.
+  uint16_t index; // `ZydisRegister`
+  uint16_t segment; // `ZydisRegister` or pointer segment.
+  uint16_t elementSize;
+  uint8_t type; // `ZydisOperandType`
+  uint8_t memoryType; // `ZydisMemoryOperandType`
+  uint8_t scale;
+  uint8_t flags; // `ZydecOperandIR::Flags`
+};
+
+struct ZydecInstructionIR
+{
+  uint64_t virtualAddress;
+  uint32_t firstOperand; // See `zydec_BlockIR_GetOperands`.
+  uint32_t firstRegisterName; // See `zydec_BlockIR_GetRegisterNames`.
+  uint16_t mnemonic; // `ZydisMnemonic`, selects the statement / intrinsic and comment of the translation.
+  uint8_t operandCount;
+  uint8_t registerNameCount; // Linear context register names in the order they're written.
+  uint8_t length;
+  bool hasTranslation;
+};
+
+// Compact translation of a block of code, that's only turned into text on demand.
+struct ZydecBlockIR;
+
+// Decodes & translates all 64 bit instructions in `pCode` without producing any text. Advances the linear context of the translator just like a regular translation would.
+// The callbacks of the translator have to remain valid for as long as the block is rendered.
+bool zydec_Translator_BuildBlockIR(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, ZydecBlockIR **ppBlockIR);
+void zydec_DestroyBlockIR(ZydecBlockIR **ppBlockIR);
+
+size_t zydec_BlockIR_GetInstructionCount(const ZydecBlockIR *pBlockIR);
+const ZydecInstructionIR *zydec_BlockIR_GetInstruction(const ZydecBlockIR *pBlockIR, const size_t index);
+const ZydecOperandIR *zydec_BlockIR_GetOperands(const ZydecBlockIR *pBlockIR, const size_t index);
+const uint32_t *zydec_BlockIR_GetRegisterNames(const ZydecBlockIR *pBlockIR, const size_t index);
+
+// Produces the same text the translator would have produced for the instruction.
+bool zydec_BlockIR_RenderInstruction(const ZydecBlockIR *pBlockIR, const size_t index, char *buffer, const size_t bufferCapacity, bool *pHasTranslation);
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ZydecBasicBlock
+{
+  uint64_t virtualAddress;
+  size_t offset; // Into the code.
+  size_t size;
+  size_t firstInstruction; // See `zydec_ControlFlowGraph_GetInstructionOffsets`.
+  size_t instructionCount;
+  size_t successors[2]; // Block indices, the fall through block comes first.
+  size_t successorCount;
+  size_t firstPredecessor; // Only used internally, see `zydec_ControlFlowGraph_GetPredecessors`.
+  size_t predecessorCount;
+};
+
+// Basic blocks of a piece of code with the register names every block starts with.
+struct ZydecControlFlowGraph;
+
+// Splits all 64 bit instructions in `pCode` into basic blocks at the targets of relative branches & after branches.
+// Register names are propagated along the edges until they don't change anymore: blocks with a single predecessor continue with its names, registers that predecessors disagree on get a new name at the join & entry points start with the linear context of the translator (which is left untouched).
+// Requires `ZydecTranslatorMode::LinearContext`. `pCode` has to remain valid for as long as the graph is used.
+bool zydec_Translator_BuildControlFlowGraph(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, ZydecControlFlowGraph **ppGraph);
+void zydec_DestroyControlFlowGraph(ZydecControlFlowGraph **ppGraph);
+
+size_t zydec_ControlFlowGraph_GetBlockCount(const ZydecControlFlowGraph *pGraph);
+const ZydecBasicBlock *zydec_ControlFlowGraph_GetBlock(const ZydecControlFlowGraph *pGraph, const size_t index);
+const size_t *zydec_ControlFlowGraph_GetPredecessors(const ZydecControlFlowGraph *pGraph, const size_t index); // `predecessorCount` block indices.
+const ZydecLinearContext *zydec_ControlFlowGraph_GetEntryContext(const ZydecControlFlowGraph *pGraph, const size_t index);
+size_t zydec_ControlFlowGraph_GetInstructionCount(const ZydecControlFlowGraph *pGraph);
+const size_t *zydec_ControlFlowGraph_GetInstructionOffsets(const ZydecControlFlowGraph *pGraph); // Into the code, ascending.
+
+// Finds the block containing `virtualAddress`.
+bool zydec_ControlFlowGraph_FindBlock(const ZydecControlFlowGraph *pGraph, const uint64_t virtualAddress, size_t *pBlockIndex);
+
+// Like `zydec_Translator_TranslateBlock` for the code of the graph, but every block starts with its propagated register names.
+// If `pRequiredArenaCapacity` is provided and `pArena` was too small, it receives the exact arena capacity the whole graph requires. It's set to 0 otherwise.
+bool zydec_Translator_TranslateControlFlowGraph(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class ZydecValueKind : uint8_t
+{
+  LiveIn, // The register when entering `block` from outside of the code.
+  Phi, // Merges the values of the register at the ends of the predecessors of `block`.
+  Definition, // Written by `instruction`.
+};
+
+struct ZydecValue
+{
+  ZydecValueKind kind;
+  uint8_t registerSlot; // The bit of the register in `zydec_GetRegisterRetentionMask`.
+  size_t block;
+  size_t instruction; // `SIZE_MAX` unless `kind` is `ZydecValueKind::Definition`.
+  size_t operandCount; // Phis only, see `zydec_SSA_GetPhiOperands`.
+  size_t firstOperand; // Only used internally.
+  size_t useCount; // Including phis. Values without uses are dead.
+  size_t firstUse; // Only used internally, see `zydec_SSA_GetUses`.
+};
+
+struct ZydecValueUse
+{
+  size_t index; // Of the instruction or, if `isPhi`, of the phi value.
+  bool isPhi;
+};
+
+// Static single assignment form of the registers of the instructions in a `ZydecControlFlowGraph`.
+struct ZydecSSA;
+
+// Every value of a register (general purpose, vector, mask & mmx registers, sub registers count as their full register) gets an index, registers that are only partially written (8 & 16 bit, legacy SSE or merge masked) are read as well.
+// Phis are only placed where the register is live & the predecessors disagree. Memory & flags aren't tracked, calls write the registers they don't retain according to `afterCallRegisterRetentionMode`.
+// Memory use is linear in the number of instructions & blocks.
+bool zydec_Translator_BuildSSA(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, ZydecSSA **ppSSA);
+void zydec_DestroySSA(ZydecSSA **ppSSA);
+
+// Values are ordered by block, starting with the live in values & phis of the block, followed by the definitions of its instructions.
+size_t zydec_SSA_GetValueCount(const ZydecSSA *pSSA);
+const ZydecValue *zydec_SSA_GetValue(const ZydecSSA *pSSA, const size_t index);
+const size_t *zydec_SSA_GetPhiOperands(const ZydecSSA *pSSA, const size_t valueIndex); // `operandCount` values, one per predecessor of the block (see `zydec_ControlFlowGraph_GetPredecessors`) followed by the live in value if the code can be entered there.
+const ZydecValueUse *zydec_SSA_GetUses(const ZydecSSA *pSSA, const size_t valueIndex); // `useCount` uses, the instructions in address order come before the phis.
+
+// Per instruction of the graph, see `zydec_ControlFlowGraph_GetInstructionOffsets`.
+bool zydec_SSA_GetDefinitions(const ZydecSSA *pSSA, const size_t instructionIndex, size_t *pFirstValue, size_t *pCount); // Consecutive values, ordered by register slot.
+const size_t *zydec_SSA_GetOperands(const ZydecSSA *pSSA, const size_t instructionIndex, size_t *pCount); // The values the instruction reads, ordered by register slot.
+uint64_t zydec_SSA_GetLiveAfter(const ZydecSSA *pSSA, const size_t instructionIndex); // The register slots that are read again after the instruction.
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class ZydecLoopRelation : uint8_t
+{
+  Less,
+  LessOrEqual,
+  Greater,
+  GreaterOrEqual,
+  Equal,
+  NotEqual,
+};
+
+// A general purpose register that's advanced by the same constant in every iteration.
+struct ZydecInductionVariable
+{
+  size_t value; // The phi of the register in the header, see `zydec_SSA_GetValue`.
+  uint8_t registerSlot;
+  int64_t stride;
+
+  // The loop keeps iterating while `register relation bound` holds, as checked at the end of `exitBlock`.
+  bool hasBound;
+  bool isUnsigned;
+  ZydecLoopRelation relation;
+  size_t exitBlock;
+  size_t boundValue; // Defined outside of the loop, `SIZE_MAX` if the bound is `boundImmediate`.
+  uint8_t boundRegisterSlot;
+  int64_t boundImmediate;
+};
+
+struct ZydecLoop
+{
+  size_t header; // Block index. Dominates every block of the loop.
+  size_t parent; // The innermost loop containing this one, `SIZE_MAX` if there's none.
+  size_t depth; // 1 for loops that aren't nested.
+  size_t blockCount;
+  size_t firstBlock; // Only used internally, see `zydec_LoopNest_GetBlocks`.
+  size_t backEdgeCount;
+  size_t bytesRead; // Memory accessed by the blocks that aren't part of a nested loop, as if every one of them ran once per iteration.
+  size_t bytesWritten;
+  bool hasInductionVariable;
+  ZydecInductionVariable inductionVariable; // Preferably one that bounds the loop.
+};
+
+// The natural loops of a `ZydecControlFlowGraph` with their nesting & induction variables.
+struct ZydecLoopNest;
+
+// Back edges lead to a block that dominates their origin (relative to the blocks the register names are seeded at), the blocks that reach them without passing that header form the loop. Back edges to the same header form a single loop, cycles without a dominating header aren't loops.
+// Induction variables are phis in the header that are only advanced by `add` & `sub` with immediates, `inc`, `dec` or `lea` with a displacement. They're bounded by a conditional jump out of the loop after `cmp` with a loop invariant register or an immediate, or after the flags of the step itself.
+bool zydec_Translator_BuildLoopNest(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, ZydecLoopNest **ppLoopNest);
+void zydec_DestroyLoopNest(ZydecLoopNest **ppLoopNest);
+
+// Loops are ordered by the address of their header.
+size_t zydec_LoopNest_GetLoopCount(const ZydecLoopNest *pLoopNest);
+const ZydecLoop *zydec_LoopNest_GetLoop(const ZydecLoopNest *pLoopNest, const size_t index);
+const size_t *zydec_LoopNest_GetBlocks(const ZydecLoopNest *pLoopNest, const size_t index); // `blockCount` block indices, ascending.
+size_t zydec_LoopNest_GetInnermostLoop(const ZydecLoopNest *pLoopNest, const size_t blockIndex); // `SIZE_MAX` for blocks that aren't part of a loop.
+
+// Summarizes the loop like `for (di; di < r14; di += 32) // ~ (r14 - di) / 32 iterations, 64 bytes per iteration (32 read & 32 written)`.
+bool zydec_LoopNest_FormatLoop(const ZydecLoopNest *pLoopNest, const size_t index, char *buffer, const size_t bufferCapacity);
 
 #endif // zydec_h__
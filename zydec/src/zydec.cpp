@@ -28,7 +28,15 @@
 
 #include "zydec.h"
 
+#include <stdlib.h>
 #include <string.h>
+#include <new>
+#include <mutex>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -36,24 +44,47 @@ enum ZydecOperandFlags_ : size_t
 {
   zof_none = 0,
   zof_noAddressDeref = 1 << 0,
+  zof_unsigned = 1 << 1, // integer registers & memory are read as unsigned values.
 };
 
 typedef size_t ZydecOperandFlags;
 
+// A string with a precomputed length, so writing it doesn't require a `strlen`.
+struct ZydecString
+{
+  const char *text;
+  size_t length;
+
+  constexpr ZydecString() : text(nullptr), length(0) {}
+  constexpr ZydecString(decltype(nullptr)) : text(nullptr), length(0) {}
+  constexpr ZydecString(const char *text, const size_t length) : text(text), length(length) {}
+
+  template <size_t TCount>
+  constexpr ZydecString(const char (&text)[TCount]) : text(text), length(TCount - 1) {}
+
+  // Mutable buffers aren't necessarily filled to their capacity.
+  template <size_t TCount>
+  ZydecString(char (&text)[TCount]) = delete;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
-bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const char *text);
-bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags = zof_none, const bool isNewResult = false);
-bool zydec_WriteResultOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags = zof_none);
-void zydec_HintOperand(const ZydisDecodedOperand *pOperand, ZydecFormattingInfo *pInfo);
-void zydec_HintValue(const int64_t value, ZydecFormattingInfo *pInfo);
-void zydec_HintOp(const ZydecFormattingInfo::HintOperation op, ZydecFormattingInfo *pInfo);
-bool zydec_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo, const bool isNewResult);
-bool zydec_WriteRegisterRaw(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg);
-bool zydec_WriteHex(char **pBufferPos, size_t *pRemainingSize, const uint64_t value);
-bool zydec_WriteUInt(char **pBufferPos, size_t *pRemainingSize, const uint64_t value);
-bool zydec_WriteInt(char **pBufferPos, size_t *pRemainingSize, const int64_t value);
+bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const char *text, const size_t length);
+bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const ZydecString &string);
+template <typename TPolicy> bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags = zof_none, const bool isNewResult = false);
+template <typename TPolicy> bool zydec_WriteResultOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags = zof_none);
+template <typename TPolicy> void zydec_HintOperand(const ZydisDecodedOperand *pOperand, ZydecFormattingInfo *pInfo);
+template <typename TPolicy> void zydec_HintValue(const int64_t value, ZydecFormattingInfo *pInfo);
+template <typename TPolicy> void zydec_HintOp(const ZydecFormattingInfo::HintOperation op, ZydecFormattingInfo *pInfo);
+template <typename TPolicy> bool zydec_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo, const bool isNewResult, const bool isUnsigned = false);
+template <typename TSink> bool zydec_WriteRegisterRaw(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg);
+template <typename TSink> bool zydec_WriteHex(char **pBufferPos, size_t *pRemainingSize, const uint64_t value);
+template <typename TSink> bool zydec_WriteUInt(char **pBufferPos, size_t *pRemainingSize, const uint64_t value);
+template <typename TSink> bool zydec_WriteInt(char **pBufferPos, size_t *pRemainingSize, const int64_t value);
 ZydisRegister zydec_ResolveBaseRegister(const ZydisRegister reg);
+ZydecString zydec_ResolveUnsignedCast(const size_t bitCount);
+static bool zydec_AddressCache_Create(ZydecAddressCache **ppAddressCache, const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const ZydecFormattingInfo *pInfo);
+static void zydec_AddressCache_Destroy(ZydecAddressCache **ppAddressCache);
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -61,6907 +92,8907 @@ ZydisRegister zydec_ResolveBaseRegister(const ZydisRegister reg);
 
 ////////////////////////////////////////////////////////////////////////////////
 
-bool zydec_TranslateInstructionWithoutContext(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo)
+// Every mnemonic is translated by one of a handful of patterns. The pattern decides the overall shape of the line, the descriptor only supplies the strings and flags to fill it with.
+enum ZydecPatternKind : uint8_t
 {
-  if (pInstruction == nullptr || pOperands == nullptr || operandCount < 10 || buffer == nullptr || bufferCapacity == 0 || pHasTranslation == nullptr)
-    return false;
+  zpk_none, // no translation available.
+  zpk_text, // `text`.
+  zpk_assign, // `altText` result = `text` operand1 `suffix`.
+  zpk_assignText, // result `text`.
+  zpk_compare, // `text` operand0, operand1 `suffix`.
+  zpk_operand, // `text` operand0 `suffix`.
+  zpk_statement, // `text` operand0, ..., operandN `suffix`.
+  zpk_arithmetic, // result `text` operand1 `suffix` or result = operand0 `altText` operand1 `suffix` without value self modification.
+  zpk_multiply, // result = a * b `suffix`.
+  zpk_divide, // result = a / b; remainder = a % b `suffix`.
+  zpk_maskOperation, // result = operand1 `text` operand2 `suffix`.
+  zpk_alignedMove, // `_mm_aligned_load`, `_mm_aligned_store`, ... with the type postfix `text`.
+  zpk_unalignedMove, // `_mm_unaligned_load`, `_mm_unaligned_store`, ... with the type postfix `text`.
+  zpk_intrinsic, // result = `text` or `altText` (operand1, ..., operandN `suffix`.
+  zpk_intrinsicSized, // like `zpk_intrinsic`, but picks `altText` for 32 bit and `suffix` for 64 bit operands and always closes with `);`.
+};
 
-  char *bufferPos = buffer;
-  size_t remainingSize = bufferCapacity - 1;
+enum ZydecMnemonicFlags_ : uint16_t
+{
+  zmf_none = 0,
+  zmf_nopIfSameRegister = 1 << 0, // `mov a, a` is a nop.
+  zmf_hintOperand1 = 1 << 1, // the result inherits the name of operand 1.
+  zmf_afterCall = 1 << 2, // calls `pAfterCall`.
+  zmf_shorthandNop = 1 << 3, // `a = a op a` is a nop.
+  zmf_shorthandZero = 1 << 4, // `a = b op b` is zero.
+  zmf_shorthandAllOnes = 1 << 5, // `a = b op b` is -1.
+  zmf_shorthandCopy = 1 << 6, // `a = b op b` is `b`.
+  zmf_addressParam = 1 << 7, // memory operands are passed as addresses rather than values.
+  zmf_noSelfReference = 1 << 8, // the result doesn't double as the first parameter.
+  zmf_altTextIfOperand0Memory = 1 << 9,
+  zmf_altTextIfOperand1Memory = 1 << 10,
+  zmf_sizedByOperand0 = 1 << 11,
+  zmf_sizedByOperand2 = 1 << 12,
+  zmf_annotateUnalignedStore = 1 << 13,
+  zmf_annotateUnalignedLoad = 1 << 14,
+};
 
-  *pHasTranslation = true;
-  bufferPos[0] = '\0';
+struct ZydecMnemonicDescriptor
+{
+  uint16_t mnemonic;
+  uint8_t pattern;
+  uint8_t hint;
+  uint16_t flags;
+  ZydecString text;
+  ZydecString altText;
+  ZydecString suffix;
+
+  // Fills the fields a row leaves out, so mnemonics without translation only need to name themselves.
+  constexpr ZydecMnemonicDescriptor(const uint16_t mnemonic, const uint8_t pattern = zpk_none, const uint8_t hint = ZydecFormattingInfo::None, const uint16_t flags = zmf_none, const ZydecString text = nullptr, const ZydecString altText = nullptr, const ZydecString suffix = nullptr) : mnemonic(mnemonic), pattern(pattern), hint(hint), flags(flags), text(text), altText(altText), suffix(suffix) {}
+};
 
-  const bool simplifyShorthands = pInfo == nullptr || pInfo->simplifyCommonShorthands;
-  const bool simplifySelfModification = pInfo == nullptr || pInfo->simplifyValueSelfModification;
+static constexpr ZydecMnemonicDescriptor MnemonicDescriptors[] = {
+  { ZYDIS_MNEMONIC_INVALID },
+  { ZYDIS_MNEMONIC_AAA },
+  { ZYDIS_MNEMONIC_AAD },
+  { ZYDIS_MNEMONIC_AAM },
+  { ZYDIS_MNEMONIC_AAS },
+  { ZYDIS_MNEMONIC_ADC, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", " + carry_flag;" },
+  { ZYDIS_MNEMONIC_ADCX, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", " + carry_flag; // unsigned integer add with carry_flag" },
+  { ZYDIS_MNEMONIC_ADD, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", ";" },
+  { ZYDIS_MNEMONIC_ADDPD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADDPS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADDSD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADDSS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADDSUBPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_addsub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADDSUBPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_addsub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ADOX, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", " + overflow_flag; // unsigned integer add with overflow_flag" },
+  { ZYDIS_MNEMONIC_AESDEC },
+  { ZYDIS_MNEMONIC_AESDEC128KL },
+  { ZYDIS_MNEMONIC_AESDEC256KL },
+  { ZYDIS_MNEMONIC_AESDECLAST },
+  { ZYDIS_MNEMONIC_AESDECWIDE128KL },
+  { ZYDIS_MNEMONIC_AESDECWIDE256KL },
+  { ZYDIS_MNEMONIC_AESENC },
+  { ZYDIS_MNEMONIC_AESENC128KL },
+  { ZYDIS_MNEMONIC_AESENC256KL },
+  { ZYDIS_MNEMONIC_AESENCLAST },
+  { ZYDIS_MNEMONIC_AESENCWIDE128KL },
+  { ZYDIS_MNEMONIC_AESENCWIDE256KL },
+  { ZYDIS_MNEMONIC_AESIMC },
+  { ZYDIS_MNEMONIC_AESKEYGENASSIST },
+  { ZYDIS_MNEMONIC_AND, zpk_arithmetic, ZydecFormattingInfo::And, zmf_shorthandNop, " &= ", " & ", ";" },
+  { ZYDIS_MNEMONIC_ANDN, zpk_arithmetic, ZydecFormattingInfo::AndNot, zmf_none, " &= ~", " & ~", ";" },
+  { ZYDIS_MNEMONIC_ANDNPD },
+  { ZYDIS_MNEMONIC_ANDNPS },
+  { ZYDIS_MNEMONIC_ANDPD },
+  { ZYDIS_MNEMONIC_ANDPS },
+  { ZYDIS_MNEMONIC_ARPL },
+  { ZYDIS_MNEMONIC_BEXTR },
+  { ZYDIS_MNEMONIC_BLCFILL },
+  { ZYDIS_MNEMONIC_BLCI },
+  { ZYDIS_MNEMONIC_BLCIC },
+  { ZYDIS_MNEMONIC_BLCMSK },
+  { ZYDIS_MNEMONIC_BLCS },
+  { ZYDIS_MNEMONIC_BLENDPD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BLENDPS, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BLENDVPD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BLENDVPS, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BLSFILL },
+  { ZYDIS_MNEMONIC_BLSI },
+  { ZYDIS_MNEMONIC_BLSIC },
+  { ZYDIS_MNEMONIC_BLSMSK },
+  { ZYDIS_MNEMONIC_BLSR },
+  { ZYDIS_MNEMONIC_BNDCL },
+  { ZYDIS_MNEMONIC_BNDCN },
+  { ZYDIS_MNEMONIC_BNDCU },
+  { ZYDIS_MNEMONIC_BNDLDX },
+  { ZYDIS_MNEMONIC_BNDMK },
+  { ZYDIS_MNEMONIC_BNDMOV },
+  { ZYDIS_MNEMONIC_BNDSTX },
+  { ZYDIS_MNEMONIC_BOUND },
+  { ZYDIS_MNEMONIC_BSF, zpk_assign, ZydecFormattingInfo::BitScanF, zmf_none, "__bitscan_forward(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BSR, zpk_assign, ZydecFormattingInfo::BitScanR, zmf_none, "__bitscan_reverse(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_BSWAP },
+  { ZYDIS_MNEMONIC_BT },
+  { ZYDIS_MNEMONIC_BTC },
+  { ZYDIS_MNEMONIC_BTR },
+  { ZYDIS_MNEMONIC_BTS },
+  { ZYDIS_MNEMONIC_BZHI },
+  { ZYDIS_MNEMONIC_CALL, zpk_operand, ZydecFormattingInfo::None, zmf_afterCall, "(", nullptr, ")();" },
+  { ZYDIS_MNEMONIC_CBW, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_CDQ, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_CDQE, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_CLAC },
+  { ZYDIS_MNEMONIC_CLC },
+  { ZYDIS_MNEMONIC_CLD },
+  { ZYDIS_MNEMONIC_CLDEMOTE },
+  { ZYDIS_MNEMONIC_CLEVICT0 },
+  { ZYDIS_MNEMONIC_CLEVICT1 },
+  { ZYDIS_MNEMONIC_CLFLUSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_addressParam, "_mm_clflush(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CLFLUSHOPT, zpk_intrinsic, ZydecFormattingInfo::None, zmf_addressParam, "_mm_clflushopt(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CLGI },
+  { ZYDIS_MNEMONIC_CLI },
+  { ZYDIS_MNEMONIC_CLRSSBSY },
+  { ZYDIS_MNEMONIC_CLTS },
+  { ZYDIS_MNEMONIC_CLUI },
+  { ZYDIS_MNEMONIC_CLWB },
+  { ZYDIS_MNEMONIC_CLZERO },
+  { ZYDIS_MNEMONIC_CMC },
+  { ZYDIS_MNEMONIC_CMOVB, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (carry_flag) ", "; // if below" },
+  { ZYDIS_MNEMONIC_CMOVBE, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (carry_flag || zero_flag) ", "; // if below or equal" },
+  { ZYDIS_MNEMONIC_CMOVL, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (sign_flag != overflow_flag) ", "; // if less" },
+  { ZYDIS_MNEMONIC_CMOVLE, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (zero_flag || sign_flag != overflow_flag) ", "; // if less or equal" },
+  { ZYDIS_MNEMONIC_CMOVNB, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!carry_flag) ", "; // if not below" },
+  { ZYDIS_MNEMONIC_CMOVNBE, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!carry_flag && !zero_flag) ", "; // if not below or equal" },
+  { ZYDIS_MNEMONIC_CMOVNL, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (sign_flag == overflow_flag) ", "; // if not less" },
+  { ZYDIS_MNEMONIC_CMOVNLE, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!zero_flag && sign_flag == overflow_flag) ", "; // if not less or equal" },
+  { ZYDIS_MNEMONIC_CMOVNO, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!overflow_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVNP, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!parity_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVNS, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!sign_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVNZ, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (!zero_flag) ", "; // if not zero / not equal" },
+  { ZYDIS_MNEMONIC_CMOVO, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (overflow_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVP, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (parity_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVS, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (sign_flag) ", ";" },
+  { ZYDIS_MNEMONIC_CMOVZ, zpk_assign, ZydecFormattingInfo::ConditionalMov, zmf_hintOperand1, "", "if (zero_flag) ", "; // if zero / equal" },
+  { ZYDIS_MNEMONIC_CMP, zpk_compare, ZydecFormattingInfo::None, zmf_none, "compare(", nullptr, "); // set flags: carry, overflow, signed, zero, aux_carry and parity" },
+  { ZYDIS_MNEMONIC_CMPPD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CMPPS, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CMPSB },
+  { ZYDIS_MNEMONIC_CMPSD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CMPSQ },
+  { ZYDIS_MNEMONIC_CMPSS, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CMPSW },
+  { ZYDIS_MNEMONIC_CMPXCHG },
+  { ZYDIS_MNEMONIC_CMPXCHG16B },
+  { ZYDIS_MNEMONIC_CMPXCHG8B },
+  { ZYDIS_MNEMONIC_COMISD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_comieq_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_COMISS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_comieq_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CPUID },
+  { ZYDIS_MNEMONIC_CQO, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_CRC32, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_crc32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTDQ2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTDQ2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPD2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPD2PI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_pi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPD2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPI2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpi32_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPI2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpi_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPS2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPS2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTPS2PI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_pi(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSD2SI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsd_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSD2SS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsd_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSI2SD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsi_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSI2SS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsi_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSS2SD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtss_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTSS2SI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtss_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTPD2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTPD2PI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_pi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTPS2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttps_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTPS2PI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttps_pi(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTSD2SI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttsd_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_CVTTSS2SI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttss_si(", "_mm_cvttss_si32(", "_mm_cvttss_si64(" },
+  { ZYDIS_MNEMONIC_CWD },
+  { ZYDIS_MNEMONIC_CWDE },
+  { ZYDIS_MNEMONIC_DAA },
+  { ZYDIS_MNEMONIC_DAS },
+  { ZYDIS_MNEMONIC_DEC, zpk_text, ZydecFormattingInfo::Dec, zmf_none, "" },
+  { ZYDIS_MNEMONIC_DELAY },
+  { ZYDIS_MNEMONIC_DIV, zpk_divide, ZydecFormattingInfo::Div, zmf_none, nullptr, nullptr, "; // unsigned integer divide; // signed integer divide" },
+  { ZYDIS_MNEMONIC_DIVPD, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_DIVPS, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_DIVSD, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_DIVSS, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_DPPD, zpk_intrinsic, ZydecFormattingInfo::DotProduct, zmf_none, "_mm_dp_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_DPPS, zpk_intrinsic, ZydecFormattingInfo::DotProduct, zmf_none, "_mm_dp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_EMMS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_empty(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ENCLS },
+  { ZYDIS_MNEMONIC_ENCLU },
+  { ZYDIS_MNEMONIC_ENCLV },
+  { ZYDIS_MNEMONIC_ENCODEKEY128 },
+  { ZYDIS_MNEMONIC_ENCODEKEY256 },
+  { ZYDIS_MNEMONIC_ENDBR32 },
+  { ZYDIS_MNEMONIC_ENDBR64 },
+  { ZYDIS_MNEMONIC_ENQCMD },
+  { ZYDIS_MNEMONIC_ENQCMDS },
+  { ZYDIS_MNEMONIC_ENTER },
+  { ZYDIS_MNEMONIC_EXTRACTPS, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_EXTRQ },
+  { ZYDIS_MNEMONIC_F2XM1 },
+  { ZYDIS_MNEMONIC_FABS },
+  { ZYDIS_MNEMONIC_FADD, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", ";" },
+  { ZYDIS_MNEMONIC_FADDP, zpk_arithmetic, ZydecFormattingInfo::Add, zmf_none, " += ", " + ", ";" },
+  { ZYDIS_MNEMONIC_FBLD },
+  { ZYDIS_MNEMONIC_FBSTP },
+  { ZYDIS_MNEMONIC_FCHS },
+  { ZYDIS_MNEMONIC_FCMOVB },
+  { ZYDIS_MNEMONIC_FCMOVBE },
+  { ZYDIS_MNEMONIC_FCMOVE },
+  { ZYDIS_MNEMONIC_FCMOVNB },
+  { ZYDIS_MNEMONIC_FCMOVNBE },
+  { ZYDIS_MNEMONIC_FCMOVNE },
+  { ZYDIS_MNEMONIC_FCMOVNU },
+  { ZYDIS_MNEMONIC_FCMOVU },
+  { ZYDIS_MNEMONIC_FCOM },
+  { ZYDIS_MNEMONIC_FCOMI },
+  { ZYDIS_MNEMONIC_FCOMIP },
+  { ZYDIS_MNEMONIC_FCOMP },
+  { ZYDIS_MNEMONIC_FCOMPP },
+  { ZYDIS_MNEMONIC_FCOS },
+  { ZYDIS_MNEMONIC_FDECSTP },
+  { ZYDIS_MNEMONIC_FDISI8087_NOP },
+  { ZYDIS_MNEMONIC_FDIV },
+  { ZYDIS_MNEMONIC_FDIVP },
+  { ZYDIS_MNEMONIC_FDIVR },
+  { ZYDIS_MNEMONIC_FDIVRP },
+  { ZYDIS_MNEMONIC_FEMMS },
+  { ZYDIS_MNEMONIC_FENI8087_NOP },
+  { ZYDIS_MNEMONIC_FFREE },
+  { ZYDIS_MNEMONIC_FFREEP },
+  { ZYDIS_MNEMONIC_FIADD },
+  { ZYDIS_MNEMONIC_FICOM },
+  { ZYDIS_MNEMONIC_FICOMP },
+  { ZYDIS_MNEMONIC_FIDIV },
+  { ZYDIS_MNEMONIC_FIDIVR },
+  { ZYDIS_MNEMONIC_FILD },
+  { ZYDIS_MNEMONIC_FIMUL },
+  { ZYDIS_MNEMONIC_FINCSTP },
+  { ZYDIS_MNEMONIC_FIST },
+  { ZYDIS_MNEMONIC_FISTP },
+  { ZYDIS_MNEMONIC_FISTTP },
+  { ZYDIS_MNEMONIC_FISUB, zpk_arithmetic, ZydecFormattingInfo::And, zmf_none, " -= ", " - ", ";" },
+  { ZYDIS_MNEMONIC_FISUBR },
+  { ZYDIS_MNEMONIC_FLD },
+  { ZYDIS_MNEMONIC_FLD1 },
+  { ZYDIS_MNEMONIC_FLDCW },
+  { ZYDIS_MNEMONIC_FLDENV },
+  { ZYDIS_MNEMONIC_FLDL2E },
+  { ZYDIS_MNEMONIC_FLDL2T },
+  { ZYDIS_MNEMONIC_FLDLG2 },
+  { ZYDIS_MNEMONIC_FLDLN2 },
+  { ZYDIS_MNEMONIC_FLDPI },
+  { ZYDIS_MNEMONIC_FLDZ },
+  { ZYDIS_MNEMONIC_FMUL },
+  { ZYDIS_MNEMONIC_FMULP },
+  { ZYDIS_MNEMONIC_FNCLEX },
+  { ZYDIS_MNEMONIC_FNINIT },
+  { ZYDIS_MNEMONIC_FNOP },
+  { ZYDIS_MNEMONIC_FNSAVE },
+  { ZYDIS_MNEMONIC_FNSTCW },
+  { ZYDIS_MNEMONIC_FNSTENV },
+  { ZYDIS_MNEMONIC_FNSTSW },
+  { ZYDIS_MNEMONIC_FPATAN },
+  { ZYDIS_MNEMONIC_FPREM },
+  { ZYDIS_MNEMONIC_FPREM1 },
+  { ZYDIS_MNEMONIC_FPTAN },
+  { ZYDIS_MNEMONIC_FRNDINT },
+  { ZYDIS_MNEMONIC_FRSTOR },
+  { ZYDIS_MNEMONIC_FSCALE },
+  { ZYDIS_MNEMONIC_FSETPM287_NOP },
+  { ZYDIS_MNEMONIC_FSIN },
+  { ZYDIS_MNEMONIC_FSINCOS },
+  { ZYDIS_MNEMONIC_FSQRT },
+  { ZYDIS_MNEMONIC_FST },
+  { ZYDIS_MNEMONIC_FSTP },
+  { ZYDIS_MNEMONIC_FSTPNCE },
+  { ZYDIS_MNEMONIC_FSUB },
+  { ZYDIS_MNEMONIC_FSUBP },
+  { ZYDIS_MNEMONIC_FSUBR },
+  { ZYDIS_MNEMONIC_FSUBRP },
+  { ZYDIS_MNEMONIC_FTST },
+  { ZYDIS_MNEMONIC_FUCOM },
+  { ZYDIS_MNEMONIC_FUCOMI },
+  { ZYDIS_MNEMONIC_FUCOMIP },
+  { ZYDIS_MNEMONIC_FUCOMP },
+  { ZYDIS_MNEMONIC_FUCOMPP },
+  { ZYDIS_MNEMONIC_FWAIT },
+  { ZYDIS_MNEMONIC_FXAM },
+  { ZYDIS_MNEMONIC_FXCH },
+  { ZYDIS_MNEMONIC_FXRSTOR },
+  { ZYDIS_MNEMONIC_FXRSTOR64 },
+  { ZYDIS_MNEMONIC_FXSAVE },
+  { ZYDIS_MNEMONIC_FXSAVE64 },
+  { ZYDIS_MNEMONIC_FXTRACT },
+  { ZYDIS_MNEMONIC_FYL2X },
+  { ZYDIS_MNEMONIC_FYL2XP1 },
+  { ZYDIS_MNEMONIC_GETSEC },
+  { ZYDIS_MNEMONIC_GF2P8AFFINEINVQB },
+  { ZYDIS_MNEMONIC_GF2P8AFFINEQB },
+  { ZYDIS_MNEMONIC_GF2P8MULB },
+  { ZYDIS_MNEMONIC_HADDPD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_HADDPS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_HLT },
+  { ZYDIS_MNEMONIC_HRESET },
+  { ZYDIS_MNEMONIC_HSUBPD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_HSUBPS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_IDIV, zpk_divide, ZydecFormattingInfo::Div, zmf_none, nullptr, nullptr, "; // signed integer divide" },
+  { ZYDIS_MNEMONIC_IMUL, zpk_multiply, ZydecFormattingInfo::Mul, zmf_none, nullptr, nullptr, "" },
+  { ZYDIS_MNEMONIC_IN },
+  { ZYDIS_MNEMONIC_INC, zpk_text, ZydecFormattingInfo::Inc, zmf_none, "" },
+  { ZYDIS_MNEMONIC_INCSSPD },
+  { ZYDIS_MNEMONIC_INCSSPQ },
+  { ZYDIS_MNEMONIC_INSB },
+  { ZYDIS_MNEMONIC_INSD },
+  { ZYDIS_MNEMONIC_INSERTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_INSERTQ },
+  { ZYDIS_MNEMONIC_INSW },
+  { ZYDIS_MNEMONIC_INT },
+  { ZYDIS_MNEMONIC_INT1 },
+  { ZYDIS_MNEMONIC_INT3, zpk_text, ZydecFormattingInfo::None, zmf_none, "__builtin_trap(); // __debugbreak();" },
+  { ZYDIS_MNEMONIC_INTO },
+  { ZYDIS_MNEMONIC_INVD },
+  { ZYDIS_MNEMONIC_INVEPT },
+  { ZYDIS_MNEMONIC_INVLPG },
+  { ZYDIS_MNEMONIC_INVLPGA },
+  { ZYDIS_MNEMONIC_INVLPGB },
+  { ZYDIS_MNEMONIC_INVPCID },
+  { ZYDIS_MNEMONIC_INVVPID },
+  { ZYDIS_MNEMONIC_IRET },
+  { ZYDIS_MNEMONIC_IRETD },
+  { ZYDIS_MNEMONIC_IRETQ },
+  { ZYDIS_MNEMONIC_JB, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (carry_flag) goto ", nullptr, "; // if below" },
+  { ZYDIS_MNEMONIC_JBE, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (carry_flag || zero_flag) goto ", nullptr, "; // if below or equal" },
+  { ZYDIS_MNEMONIC_JCXZ, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if ((u16)c == 0) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JECXZ, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if ((u32)c == 0) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JKNZD },
+  { ZYDIS_MNEMONIC_JKZD },
+  { ZYDIS_MNEMONIC_JL, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (sign_flag != overflow_flag) goto ", nullptr, "; // if less" },
+  { ZYDIS_MNEMONIC_JLE, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (zero_flag || sign_flag != overflow_flag) goto ", nullptr, "; // if less or equal" },
+  { ZYDIS_MNEMONIC_JMP, zpk_operand, ZydecFormattingInfo::None, zmf_none, "goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JNB, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!carry_flag) goto ", nullptr, "; // if not below" },
+  { ZYDIS_MNEMONIC_JNBE, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!carry_flag && !zero_flag) goto ", nullptr, "; // if not below or equal" },
+  { ZYDIS_MNEMONIC_JNL, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (sign_flag && overflow_flag) goto ", nullptr, "; // if not less" },
+  { ZYDIS_MNEMONIC_JNLE, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!zero_flag && sign_flag == overflow_flag) goto ", nullptr, "; // if not less or equal" },
+  { ZYDIS_MNEMONIC_JNO, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!overflow_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JNP, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!parity_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JNS, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!sign_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JNZ, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (!zero_flag) goto ", nullptr, "; // if not zero / not equal" },
+  { ZYDIS_MNEMONIC_JO, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (overflow_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JP, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (parity_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JRCXZ },
+  { ZYDIS_MNEMONIC_JS, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (sign_flag) goto ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_JZ, zpk_operand, ZydecFormattingInfo::None, zmf_none, "if (zero_flag) goto ", nullptr, "; // if zero / equal" },
+  { ZYDIS_MNEMONIC_KADDB, zpk_maskOperation, ZydecFormattingInfo::Add, zmf_none, " + ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KADDD, zpk_maskOperation, ZydecFormattingInfo::Add, zmf_none, " + ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KADDQ, zpk_maskOperation, ZydecFormattingInfo::Add, zmf_none, " + ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KADDW, zpk_maskOperation, ZydecFormattingInfo::Add, zmf_none, " + ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KAND },
+  { ZYDIS_MNEMONIC_KANDB, zpk_maskOperation, ZydecFormattingInfo::And, zmf_shorthandCopy, " & ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KANDD, zpk_maskOperation, ZydecFormattingInfo::And, zmf_shorthandCopy, " & ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KANDN },
+  { ZYDIS_MNEMONIC_KANDNB, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_kandn_mask8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KANDND, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_kandn_mask32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KANDNQ, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_kandn_mask64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KANDNR },
+  { ZYDIS_MNEMONIC_KANDNW, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_kandn_mask16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KANDQ, zpk_maskOperation, ZydecFormattingInfo::And, zmf_shorthandCopy, " & ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KANDW, zpk_maskOperation, ZydecFormattingInfo::And, zmf_shorthandCopy, " & ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KCONCATH },
+  { ZYDIS_MNEMONIC_KCONCATL },
+  { ZYDIS_MNEMONIC_KEXTRACT },
+  { ZYDIS_MNEMONIC_KMERGE2L1H },
+  { ZYDIS_MNEMONIC_KMERGE2L1L },
+  { ZYDIS_MNEMONIC_KMOV },
+  { ZYDIS_MNEMONIC_KMOVB, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KMOVD, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KMOVQ, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KMOVW, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KNOT },
+  { ZYDIS_MNEMONIC_KNOTB, zpk_intrinsic, ZydecFormattingInfo::Not, zmf_none, "_knot_mask8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KNOTD, zpk_intrinsic, ZydecFormattingInfo::Not, zmf_none, "_knot_mask32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KNOTQ, zpk_intrinsic, ZydecFormattingInfo::Not, zmf_none, "_knot_mask64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KNOTW, zpk_intrinsic, ZydecFormattingInfo::Not, zmf_none, "_knot_mask16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KOR },
+  { ZYDIS_MNEMONIC_KORB, zpk_maskOperation, ZydecFormattingInfo::Or, zmf_shorthandCopy, " | ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KORD, zpk_maskOperation, ZydecFormattingInfo::Or, zmf_shorthandCopy, " | ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KORQ, zpk_maskOperation, ZydecFormattingInfo::Or, zmf_shorthandCopy, " | ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KORTEST },
+  { ZYDIS_MNEMONIC_KORTESTB, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_kortest_u8(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KORTESTD, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_kortest_u32(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KORTESTQ, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_kortest_u64(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KORTESTW, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_kortest_u16(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KORW, zpk_maskOperation, ZydecFormattingInfo::Or, zmf_shorthandCopy, " | ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTLB, zpk_maskOperation, ZydecFormattingInfo::ShL, zmf_none, " << ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTLD, zpk_maskOperation, ZydecFormattingInfo::ShL, zmf_none, " << ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTLQ, zpk_maskOperation, ZydecFormattingInfo::ShL, zmf_none, " << ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTLW, zpk_maskOperation, ZydecFormattingInfo::ShL, zmf_none, " << ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTRB, zpk_maskOperation, ZydecFormattingInfo::ShR, zmf_none, " >> ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTRD, zpk_maskOperation, ZydecFormattingInfo::ShR, zmf_none, " >> ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTRQ, zpk_maskOperation, ZydecFormattingInfo::ShR, zmf_none, " >> ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KSHIFTRW, zpk_maskOperation, ZydecFormattingInfo::ShR, zmf_none, " >> ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KTESTB, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_ktest_u8(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KTESTD, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_ktest_u32(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KTESTQ, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_ktest_u64(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KTESTW, zpk_compare, ZydecFormattingInfo::None, zmf_none, "_ktest_u16(", nullptr, "); // set zero_flag & carry_flag accordingly" },
+  { ZYDIS_MNEMONIC_KUNPCKBW, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_kunpackepi8_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KUNPCKDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_kunpackepi32_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KUNPCKWD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_kunpackepi16_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KXNOR },
+  { ZYDIS_MNEMONIC_KXNORB, zpk_intrinsic, ZydecFormattingInfo::XNor, zmf_none, "_kxnor_mask8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KXNORD, zpk_intrinsic, ZydecFormattingInfo::XNor, zmf_none, "_kxnor_mask32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KXNORQ, zpk_intrinsic, ZydecFormattingInfo::XNor, zmf_none, "_kxnor_mask64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KXNORW, zpk_intrinsic, ZydecFormattingInfo::XNor, zmf_none, "_kxnor_mask16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_KXOR },
+  { ZYDIS_MNEMONIC_KXORB, zpk_maskOperation, ZydecFormattingInfo::XOr, zmf_shorthandZero, " ^ ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KXORD, zpk_maskOperation, ZydecFormattingInfo::XOr, zmf_shorthandZero, " ^ ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KXORQ, zpk_maskOperation, ZydecFormattingInfo::XOr, zmf_shorthandZero, " ^ ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_KXORW, zpk_maskOperation, ZydecFormattingInfo::XOr, zmf_shorthandZero, " ^ ", nullptr, ";" },
+  { ZYDIS_MNEMONIC_LAHF },
+  { ZYDIS_MNEMONIC_LAR },
+  { ZYDIS_MNEMONIC_LDDQU, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_cross_cache_line_si(" },
+  { ZYDIS_MNEMONIC_LDMXCSR },
+  { ZYDIS_MNEMONIC_LDS },
+  { ZYDIS_MNEMONIC_LDTILECFG },
+  { ZYDIS_MNEMONIC_LEA, zpk_assign, ZydecFormattingInfo::AddressOf, zmf_hintOperand1, "&", nullptr, ";" },
+  { ZYDIS_MNEMONIC_LEAVE },
+  { ZYDIS_MNEMONIC_LES },
+  { ZYDIS_MNEMONIC_LFENCE, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_lfence(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_LFS },
+  { ZYDIS_MNEMONIC_LGDT },
+  { ZYDIS_MNEMONIC_LGS },
+  { ZYDIS_MNEMONIC_LIDT },
+  { ZYDIS_MNEMONIC_LLDT },
+  { ZYDIS_MNEMONIC_LLWPCB },
+  { ZYDIS_MNEMONIC_LMSW },
+  { ZYDIS_MNEMONIC_LOADIWKEY },
+  { ZYDIS_MNEMONIC_LODSB },
+  { ZYDIS_MNEMONIC_LODSD },
+  { ZYDIS_MNEMONIC_LODSQ },
+  { ZYDIS_MNEMONIC_LODSW },
+  { ZYDIS_MNEMONIC_LOOP },
+  { ZYDIS_MNEMONIC_LOOPE },
+  { ZYDIS_MNEMONIC_LOOPNE },
+  { ZYDIS_MNEMONIC_LSL },
+  { ZYDIS_MNEMONIC_LSS },
+  { ZYDIS_MNEMONIC_LTR },
+  { ZYDIS_MNEMONIC_LWPINS },
+  { ZYDIS_MNEMONIC_LWPVAL },
+  { ZYDIS_MNEMONIC_LZCNT },
+  { ZYDIS_MNEMONIC_MASKMOVDQU, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_si128(" },
+  { ZYDIS_MNEMONIC_MASKMOVQ, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_epi64(" },
+  { ZYDIS_MNEMONIC_MAXPD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MAXPS, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MAXSD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MAXSS, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MCOMMIT },
+  { ZYDIS_MNEMONIC_MFENCE },
+  { ZYDIS_MNEMONIC_MINPD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MINPS, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MINSD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MINSS, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MONITOR },
+  { ZYDIS_MNEMONIC_MONITORX },
+  { ZYDIS_MNEMONIC_MONTMUL },
+  { ZYDIS_MNEMONIC_MOV, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_MOVAPD, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_pd(" },
+  { ZYDIS_MNEMONIC_MOVAPS, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_ps(" },
+  { ZYDIS_MNEMONIC_MOVBE, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "__byteswap(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi32(" },
+  { ZYDIS_MNEMONIC_MOVDDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_addressParam | zmf_altTextIfOperand1Memory, "_mm_movedup_pd(", "_mm_loaddup_pd(", ");" },
+  { ZYDIS_MNEMONIC_MOVDIR64B, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "__atomic_write(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVDIRI, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "__atomic_write(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVDQ2Q, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_pi(" },
+  { ZYDIS_MNEMONIC_MOVDQA, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_si(" },
+  { ZYDIS_MNEMONIC_MOVDQU, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_si(" },
+  { ZYDIS_MNEMONIC_MOVHLPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movehl_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVHPD, zpk_intrinsic, ZydecFormattingInfo::Mov, zmf_altTextIfOperand0Memory, "_mm_loadh_pd(", "_mm_storeh_pd(", ");" },
+  { ZYDIS_MNEMONIC_MOVHPS, zpk_intrinsic, ZydecFormattingInfo::Mov, zmf_altTextIfOperand0Memory, "_mm_loadh_pi(", "_mm_storeh_pi(", ");" },
+  { ZYDIS_MNEMONIC_MOVLHPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movelh_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVLPD, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_MOVLPS, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_MOVMSKPD, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVMSKPS, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVNTDQ, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_si(" },
+  { ZYDIS_MNEMONIC_MOVNTDQA, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_si(" },
+  { ZYDIS_MNEMONIC_MOVNTI, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with non-temporal hint" },
+  { ZYDIS_MNEMONIC_MOVNTPD, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_pd(" },
+  { ZYDIS_MNEMONIC_MOVNTPS, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_ps(" },
+  { ZYDIS_MNEMONIC_MOVNTQ, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with non-temporal hint" },
+  { ZYDIS_MNEMONIC_MOVNTSD, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with non-temporal hint" },
+  { ZYDIS_MNEMONIC_MOVNTSS, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with non-temporal hint" },
+  { ZYDIS_MNEMONIC_MOVQ, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi64(" },
+  { ZYDIS_MNEMONIC_MOVQ2DQ, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_MOVSB },
+  { ZYDIS_MNEMONIC_MOVSD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_sd(" },
+  { ZYDIS_MNEMONIC_MOVSHDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movehdup_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVSLDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_moveldup_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MOVSQ },
+  { ZYDIS_MNEMONIC_MOVSS, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_ss(" },
+  { ZYDIS_MNEMONIC_MOVSW },
+  { ZYDIS_MNEMONIC_MOVSX, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with sign extension" },
+  { ZYDIS_MNEMONIC_MOVSXD, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, "; // move with sign extension" },
+  { ZYDIS_MNEMONIC_MOVUPD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_pd(" },
+  { ZYDIS_MNEMONIC_MOVUPS, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_ps(" },
+  { ZYDIS_MNEMONIC_MOVZX, zpk_assign, ZydecFormattingInfo::Mov, zmf_nopIfSameRegister | zmf_hintOperand1, "", nullptr, ";" },
+  { ZYDIS_MNEMONIC_MPSADBW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_mpsadbw_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MUL, zpk_multiply, ZydecFormattingInfo::Mul, zmf_none, nullptr, nullptr, "" },
+  { ZYDIS_MNEMONIC_MULPD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MULPS, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MULSD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MULSS, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_MULX },
+  { ZYDIS_MNEMONIC_MWAIT },
+  { ZYDIS_MNEMONIC_MWAITX },
+  { ZYDIS_MNEMONIC_NEG },
+  { ZYDIS_MNEMONIC_NOP, zpk_text, ZydecFormattingInfo::None, zmf_none, "// nop" },
+  { ZYDIS_MNEMONIC_NOT },
+  { ZYDIS_MNEMONIC_OR, zpk_arithmetic, ZydecFormattingInfo::Or, zmf_shorthandNop, " |= ", " | ", ";" },
+  { ZYDIS_MNEMONIC_ORPD, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ORPS, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_OUT },
+  { ZYDIS_MNEMONIC_OUTSB },
+  { ZYDIS_MNEMONIC_OUTSD },
+  { ZYDIS_MNEMONIC_OUTSW },
+  { ZYDIS_MNEMONIC_PABSB, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PABSD, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PABSW, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PACKSSDW, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packs_epu32_to_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PACKSSWB, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packs_epu16_to_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PACKUSDW, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packus_epu32_to_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PACKUSWB, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packus_epu16_to_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDQ, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDSB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDUSB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDUSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PADDW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PALIGNR, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_alignr_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PAND, zpk_intrinsic, ZydecFormattingInfo::And, zmf_shorthandCopy, "_mm_and_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PANDN, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PAUSE, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_pause(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PAVGB, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_avg_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PAVGUSB },
+  { ZYDIS_MNEMONIC_PAVGW, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_avg_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PBLENDVB, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PBLENDW, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCLMULQDQ },
+  { ZYDIS_MNEMONIC_PCMPEQB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPEQD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPEQQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPEQW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPESTRI, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_cmpstr(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPESTRM, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_cmpestrm(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPGTB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPGTD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPGTQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPGTW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PCMPISTRI },
+  { ZYDIS_MNEMONIC_PCMPISTRM },
+  { ZYDIS_MNEMONIC_PCONFIG },
+  { ZYDIS_MNEMONIC_PDEP },
+  { ZYDIS_MNEMONIC_PEXT },
+  { ZYDIS_MNEMONIC_PEXTRB, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PEXTRD, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PEXTRQ, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PEXTRW, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PF2ID },
+  { ZYDIS_MNEMONIC_PF2IW },
+  { ZYDIS_MNEMONIC_PFACC },
+  { ZYDIS_MNEMONIC_PFADD },
+  { ZYDIS_MNEMONIC_PFCMPEQ },
+  { ZYDIS_MNEMONIC_PFCMPGE },
+  { ZYDIS_MNEMONIC_PFCMPGT },
+  { ZYDIS_MNEMONIC_PFCPIT1 },
+  { ZYDIS_MNEMONIC_PFMAX },
+  { ZYDIS_MNEMONIC_PFMIN },
+  { ZYDIS_MNEMONIC_PFMUL },
+  { ZYDIS_MNEMONIC_PFNACC },
+  { ZYDIS_MNEMONIC_PFPNACC },
+  { ZYDIS_MNEMONIC_PFRCP },
+  { ZYDIS_MNEMONIC_PFRCPIT2 },
+  { ZYDIS_MNEMONIC_PFRSQIT1 },
+  { ZYDIS_MNEMONIC_PFSQRT },
+  { ZYDIS_MNEMONIC_PFSUB },
+  { ZYDIS_MNEMONIC_PFSUBR },
+  { ZYDIS_MNEMONIC_PHADDD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHADDSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadds_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHADDW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHMINPOSUW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_minpos_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHSUBD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHSUBSW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsubs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PHSUBW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PI2FD },
+  { ZYDIS_MNEMONIC_PI2FW },
+  { ZYDIS_MNEMONIC_PINSRB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PINSRD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PINSRQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PINSRW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMADDUBSW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_maddubs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMADDWD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_pmadd_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXSB, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXSD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXSW, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXUB, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXUD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMAXUW, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINSB, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINSD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINSW, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINUB, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINUD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMINUW, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVMSKB, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXBD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXBQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXBW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXWD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi16_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVSXWQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi16_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXBD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXBQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXBW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu32_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXWD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu16_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMOVZXWQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu16_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULDQ, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULHRSW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhrs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULHRW },
+  { ZYDIS_MNEMONIC_PMULHUW },
+  { ZYDIS_MNEMONIC_PMULHW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULLD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mullo_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULLW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mullo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PMULUDQ, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_POP },
+  { ZYDIS_MNEMONIC_POPA },
+  { ZYDIS_MNEMONIC_POPAD },
+  { ZYDIS_MNEMONIC_POPCNT, zpk_assign, ZydecFormattingInfo::PopCnt, zmf_none, "__popcnt(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_POPF },
+  { ZYDIS_MNEMONIC_POPFD },
+  { ZYDIS_MNEMONIC_POPFQ },
+  { ZYDIS_MNEMONIC_POR, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCH, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHNTA, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHT0, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHT1, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHT2, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHW, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PREFETCHWT1, zpk_operand, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSADBW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sad_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSHUFB, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSHUFD, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSHUFHW, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shufflehi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSHUFLW, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shufflelo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSHUFW, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSIGNB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSIGND, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSIGNW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSLLD, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSLLDQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_bslli_epi128(", nullptr, " * 8); // byte shift left in 128 bit lanes" },
+  { ZYDIS_MNEMONIC_PSLLQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSLLW, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSMASH },
+  { ZYDIS_MNEMONIC_PSRAD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_sra_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSRAW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_sra_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSRLD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSRLDQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_bsrli_epi128(", nullptr, " * 8); // byte shift right in 128 bit lanes" },
+  { ZYDIS_MNEMONIC_PSRLQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSRLW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBB, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBQ, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBSB, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBSW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSUBUSB },
+  { ZYDIS_MNEMONIC_PSUBUSW },
+  { ZYDIS_MNEMONIC_PSUBW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PSWAPD },
+  { ZYDIS_MNEMONIC_PTEST, zpk_intrinsic, ZydecFormattingInfo::Test, zmf_none, "_mm_test(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PTWRITE },
+  { ZYDIS_MNEMONIC_PUNPCKHBW, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKHDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKHQDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKHWD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKLBW, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKLDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKLQDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUNPCKLWD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_PUSH },
+  { ZYDIS_MNEMONIC_PUSHA },
+  { ZYDIS_MNEMONIC_PUSHAD },
+  { ZYDIS_MNEMONIC_PUSHF },
+  { ZYDIS_MNEMONIC_PUSHFD },
+  { ZYDIS_MNEMONIC_PUSHFQ },
+  { ZYDIS_MNEMONIC_PVALIDATE },
+  { ZYDIS_MNEMONIC_PXOR, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RCL },
+  { ZYDIS_MNEMONIC_RCPPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RCPSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RCR },
+  { ZYDIS_MNEMONIC_RDFSBASE },
+  { ZYDIS_MNEMONIC_RDGSBASE },
+  { ZYDIS_MNEMONIC_RDMSR },
+  { ZYDIS_MNEMONIC_RDPID },
+  { ZYDIS_MNEMONIC_RDPKRU },
+  { ZYDIS_MNEMONIC_RDPMC },
+  { ZYDIS_MNEMONIC_RDPRU },
+  { ZYDIS_MNEMONIC_RDRAND },
+  { ZYDIS_MNEMONIC_RDSEED },
+  { ZYDIS_MNEMONIC_RDSSPD },
+  { ZYDIS_MNEMONIC_RDSSPQ },
+  { ZYDIS_MNEMONIC_RDTSC },
+  { ZYDIS_MNEMONIC_RDTSCP },
+  { ZYDIS_MNEMONIC_RET, zpk_text, ZydecFormattingInfo::None, zmf_none, "return;" },
+  { ZYDIS_MNEMONIC_RMPADJUST },
+  { ZYDIS_MNEMONIC_RMPUPDATE },
+  { ZYDIS_MNEMONIC_ROL },
+  { ZYDIS_MNEMONIC_ROR },
+  { ZYDIS_MNEMONIC_RORX },
+  { ZYDIS_MNEMONIC_ROUNDPD, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ROUNDPS, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ROUNDSD, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_ROUNDSS, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RSM },
+  { ZYDIS_MNEMONIC_RSQRTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RSQRTSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_RSTORSSP },
+  { ZYDIS_MNEMONIC_SAHF },
+  { ZYDIS_MNEMONIC_SALC, zpk_arithmetic, ZydecFormattingInfo::ShL, zmf_none, " <<= ", " << ", ";" },
+  { ZYDIS_MNEMONIC_SAR, zpk_arithmetic, ZydecFormattingInfo::ShR, zmf_none, " >>= ", " >> ", ";" },
+  { ZYDIS_MNEMONIC_SARX, zpk_arithmetic, ZydecFormattingInfo::ShR, zmf_none, " >>= ", " >> ", ";" },
+  { ZYDIS_MNEMONIC_SAVEPREVSSP },
+  { ZYDIS_MNEMONIC_SBB },
+  { ZYDIS_MNEMONIC_SCASB },
+  { ZYDIS_MNEMONIC_SCASD },
+  { ZYDIS_MNEMONIC_SCASQ },
+  { ZYDIS_MNEMONIC_SCASW },
+  { ZYDIS_MNEMONIC_SEAMCALL },
+  { ZYDIS_MNEMONIC_SEAMOPS },
+  { ZYDIS_MNEMONIC_SEAMRET },
+  { ZYDIS_MNEMONIC_SENDUIPI },
+  { ZYDIS_MNEMONIC_SERIALIZE },
+  { ZYDIS_MNEMONIC_SETB, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (carry_flag ? 1 : 0); // if below" },
+  { ZYDIS_MNEMONIC_SETBE, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = ((carry_flag || zero_flag) ? 1 : 0); // if below or equal" },
+  { ZYDIS_MNEMONIC_SETL, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (sign_flag != overflow_flag ? 1 : 0); // if less" },
+  { ZYDIS_MNEMONIC_SETLE, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = ((zero_flag || sign_flag != overflow_flag) ? 1 : 0); // if less or equal" },
+  { ZYDIS_MNEMONIC_SETNB, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (!carry_flag ? 1 : 0); // if not below" },
+  { ZYDIS_MNEMONIC_SETNBE, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = ((!carry_flag && !zero_flag) ? 1 : 0); // if not below or equal" },
+  { ZYDIS_MNEMONIC_SETNL, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (sign_flag == overflow_flag ? 1 : 0); // if not less" },
+  { ZYDIS_MNEMONIC_SETNLE, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = ((!zero_flag && sign_flag == overflow_flag) ? 1 : 0); // if not less or equal" },
+  { ZYDIS_MNEMONIC_SETNO, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (!overflow_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETNP, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (!parity_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETNS, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (!sign_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETNZ, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (!zero_flag ? 1 : 0); // if not zero / not equal" },
+  { ZYDIS_MNEMONIC_SETO, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (overflow_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETP, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (parity_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETS, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (sign_flag ? 1 : 0);" },
+  { ZYDIS_MNEMONIC_SETSSBSY },
+  { ZYDIS_MNEMONIC_SETZ, zpk_assignText, ZydecFormattingInfo::Set, zmf_none, " = (zero_flag ? 1 : 0); // if zero / equal" },
+  { ZYDIS_MNEMONIC_SFENCE, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sfence(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SGDT },
+  { ZYDIS_MNEMONIC_SHA1MSG1 },
+  { ZYDIS_MNEMONIC_SHA1MSG2 },
+  { ZYDIS_MNEMONIC_SHA1NEXTE },
+  { ZYDIS_MNEMONIC_SHA1RNDS4 },
+  { ZYDIS_MNEMONIC_SHA256MSG1 },
+  { ZYDIS_MNEMONIC_SHA256MSG2 },
+  { ZYDIS_MNEMONIC_SHA256RNDS2 },
+  { ZYDIS_MNEMONIC_SHL, zpk_arithmetic, ZydecFormattingInfo::ShL, zmf_none, " <<= ", " << ", ";" },
+  { ZYDIS_MNEMONIC_SHLD, zpk_arithmetic, ZydecFormattingInfo::ShL, zmf_none, " <<= ", " << ", ";" },
+  { ZYDIS_MNEMONIC_SHLX, zpk_arithmetic, ZydecFormattingInfo::ShL, zmf_none, " <<= ", " << ", ";" },
+  { ZYDIS_MNEMONIC_SHR, zpk_arithmetic, ZydecFormattingInfo::ShR, zmf_none, " >>= ", " >> ", ";" },
+  { ZYDIS_MNEMONIC_SHRD, zpk_arithmetic, ZydecFormattingInfo::ShR, zmf_none, " >>= ", " >> ", ";" },
+  { ZYDIS_MNEMONIC_SHRX, zpk_arithmetic, ZydecFormattingInfo::ShR, zmf_none, " >>= ", " >> ", ";" },
+  { ZYDIS_MNEMONIC_SHUFPD, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SHUFPS, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SIDT },
+  { ZYDIS_MNEMONIC_SKINIT },
+  { ZYDIS_MNEMONIC_SLDT },
+  { ZYDIS_MNEMONIC_SLWPCB },
+  { ZYDIS_MNEMONIC_SMSW },
+  { ZYDIS_MNEMONIC_SPFLT },
+  { ZYDIS_MNEMONIC_SQRTPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SQRTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SQRTSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SQRTSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_STAC },
+  { ZYDIS_MNEMONIC_STC },
+  { ZYDIS_MNEMONIC_STD },
+  { ZYDIS_MNEMONIC_STGI },
+  { ZYDIS_MNEMONIC_STI },
+  { ZYDIS_MNEMONIC_STMXCSR, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getcsr(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_STOSB },
+  { ZYDIS_MNEMONIC_STOSD },
+  { ZYDIS_MNEMONIC_STOSQ },
+  { ZYDIS_MNEMONIC_STOSW },
+  { ZYDIS_MNEMONIC_STR },
+  { ZYDIS_MNEMONIC_STTILECFG },
+  { ZYDIS_MNEMONIC_STUI },
+  { ZYDIS_MNEMONIC_SUB, zpk_arithmetic, ZydecFormattingInfo::And, zmf_none, " -= ", " - ", ";" },
+  { ZYDIS_MNEMONIC_SUBPD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SUBPS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SUBSD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SUBSS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_SWAPGS },
+  { ZYDIS_MNEMONIC_SYSCALL },
+  { ZYDIS_MNEMONIC_SYSENTER },
+  { ZYDIS_MNEMONIC_SYSEXIT },
+  { ZYDIS_MNEMONIC_SYSRET },
+  { ZYDIS_MNEMONIC_T1MSKC },
+  { ZYDIS_MNEMONIC_TDCALL },
+  { ZYDIS_MNEMONIC_TDPBF16PS },
+  { ZYDIS_MNEMONIC_TDPBSSD },
+  { ZYDIS_MNEMONIC_TDPBSUD },
+  { ZYDIS_MNEMONIC_TDPBUSD },
+  { ZYDIS_MNEMONIC_TDPBUUD },
+  { ZYDIS_MNEMONIC_TEST, zpk_compare, ZydecFormattingInfo::None, zmf_none, "compare(", nullptr, "); // set flags: carry, parity, zero" },
+  { ZYDIS_MNEMONIC_TESTUI },
+  { ZYDIS_MNEMONIC_TILELOADD },
+  { ZYDIS_MNEMONIC_TILELOADDT1 },
+  { ZYDIS_MNEMONIC_TILERELEASE },
+  { ZYDIS_MNEMONIC_TILESTORED },
+  { ZYDIS_MNEMONIC_TILEZERO },
+  { ZYDIS_MNEMONIC_TLBSYNC },
+  { ZYDIS_MNEMONIC_TPAUSE },
+  { ZYDIS_MNEMONIC_TZCNT },
+  { ZYDIS_MNEMONIC_TZCNTI },
+  { ZYDIS_MNEMONIC_TZMSK },
+  { ZYDIS_MNEMONIC_UCOMISD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ucomi_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_UCOMISS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ucomi_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_UD0 },
+  { ZYDIS_MNEMONIC_UD1 },
+  { ZYDIS_MNEMONIC_UD2 },
+  { ZYDIS_MNEMONIC_UIRET },
+  { ZYDIS_MNEMONIC_UMONITOR },
+  { ZYDIS_MNEMONIC_UMWAIT },
+  { ZYDIS_MNEMONIC_UNPCKHPD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_UNPCKHPS, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_UNPCKLPD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_UNPCKLPS, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_V4FMADDPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4fmadd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_V4FMADDSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4fmadd_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_V4FNMADDPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4fnmadd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_V4FNMADDSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4fnmadd_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDNPD },
+  { ZYDIS_MNEMONIC_VADDNPS },
+  { ZYDIS_MNEMONIC_VADDPD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDPH, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDPS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDSD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDSETSPS },
+  { ZYDIS_MNEMONIC_VADDSH, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDSS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDSUBPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_addsub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VADDSUBPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_addsub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VAESDEC },
+  { ZYDIS_MNEMONIC_VAESDECLAST },
+  { ZYDIS_MNEMONIC_VAESENC },
+  { ZYDIS_MNEMONIC_VAESENCLAST },
+  { ZYDIS_MNEMONIC_VAESIMC },
+  { ZYDIS_MNEMONIC_VAESKEYGENASSIST },
+  { ZYDIS_MNEMONIC_VALIGND, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_alignr_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VALIGNQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_alignr_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VANDNPD, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VANDNPS, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VANDPD },
+  { ZYDIS_MNEMONIC_VANDPS },
+  { ZYDIS_MNEMONIC_VBLENDMPD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBLENDMPS, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBLENDPD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBLENDPS, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBLENDVPD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBLENDVPS, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF128, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF32X2, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f32x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF32X4, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF32X8, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f32x8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF64X2, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTF64X4, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_f64x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI128, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcastsi128_si256(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI32X2, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_i32x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI32X4, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_i32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI32X8, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_i32x8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI64X2, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_i64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTI64X4, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_i64x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTSD, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VBROADCASTSS, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPPD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPPH, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_ph_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPPS, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPSD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPSH, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCMPSS, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCOMISD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_comieq_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCOMISH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_comieq_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCOMISS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_comieq_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCOMPRESSPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCOMPRESSPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTDQ2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTDQ2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTDQ2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTFXPNTDQ2PS },
+  { ZYDIS_MNEMONIC_VCVTFXPNTPD2DQ },
+  { ZYDIS_MNEMONIC_VCVTFXPNTPD2UDQ },
+  { ZYDIS_MNEMONIC_VCVTFXPNTPS2DQ },
+  { ZYDIS_MNEMONIC_VCVTFXPNTPS2UDQ },
+  { ZYDIS_MNEMONIC_VCVTFXPNTUDQ2PS },
+  { ZYDIS_MNEMONIC_VCVTNE2PS2BF16, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtne2ps_pbh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTNEPS2BF16, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtneps_pbh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2UDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPD2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtpd_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2PSX, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtxph_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2UDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2UW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPH2W, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtph_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2PHX, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtxps_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2UDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTPS2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtps_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTQQ2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi64_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTQQ2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi64_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTQQ2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi64_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSD2SH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsd_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSD2SI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsd_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSD2SS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsd_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSD2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvtsd_u(", "_mm_cvtsd_u32(", "_mm_cvtsd_u64(" },
+  { ZYDIS_MNEMONIC_VCVTSH2SD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsh_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSH2SI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvtsh_i(", "_mm_cvtsh_i32(", "_mm_cvtsh_i64(" },
+  { ZYDIS_MNEMONIC_VCVTSH2SS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsh_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSH2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvtsh_u(", "_mm_cvtsh_u32(", "_mm_cvtsh_u64(" },
+  { ZYDIS_MNEMONIC_VCVTSI2SD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsi_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSI2SH, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand2, "_mm_cvti_sh(", "_mm_cvti32_sh(", "_mm_cvti64_sh(" },
+  { ZYDIS_MNEMONIC_VCVTSI2SS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtsi_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSS2SD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtss_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSS2SH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtss_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSS2SI, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtss_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTSS2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvtss_u(", "_mm_cvtss_u32(", "_mm_cvtss_u64(" },
+  { ZYDIS_MNEMONIC_VCVTTPD2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPD2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPD2UDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPD2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttpd_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2UDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2UW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPH2W, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttph_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPS2DQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttps_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPS2QQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttps_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPS2UDQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_cvttps_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTPS2UQQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvttps_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTTSD2SI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttsd_si(", "_mm_cvttsd_i32(", "_mm_cvttsd_i64(" },
+  { ZYDIS_MNEMONIC_VCVTTSD2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttsd_u(", "_mm_cvttsd_u32(", "_mm_cvttsd_u64(" },
+  { ZYDIS_MNEMONIC_VCVTTSH2SI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttsh_si(", "_mm_cvttsh_si32(", "_mm_cvttsh_si64(" },
+  { ZYDIS_MNEMONIC_VCVTTSH2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttsh_u(", "_mm_cvttsh_u32(", "_mm_cvttsh_u64(" },
+  { ZYDIS_MNEMONIC_VCVTTSS2SI, zpk_intrinsicSized, ZydecFormattingInfo::None, zmf_sizedByOperand0, "_mm_cvttss_si(", "_mm_cvttss_si32(", "_mm_cvttss_si64(" },
+  { ZYDIS_MNEMONIC_VCVTTSS2USI, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand0, "_mm_cvttss_u(", "_mm_cvttss_u32(", "_mm_cvttss_u64(" },
+  { ZYDIS_MNEMONIC_VCVTUDQ2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu32_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUDQ2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu32_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUDQ2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu32_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUQQ2PD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu64_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUQQ2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu64_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUQQ2PS, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu64_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTUSI2SD, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand2, "_mm_cvtu_sd(", "_mm_cvtu32_sd(", "_mm_cvtu64_sd(" },
+  { ZYDIS_MNEMONIC_VCVTUSI2SH, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand2, "_mm_cvtu_sh(", "_mm_cvtu32_sh(", "_mm_cvtu64_sh(" },
+  { ZYDIS_MNEMONIC_VCVTUSI2SS, zpk_intrinsicSized, ZydecFormattingInfo::Convert, zmf_sizedByOperand2, "_mm_cvtu_ss(", "_mm_cvtu32_ss(", "_mm_cvtu64_ss(" },
+  { ZYDIS_MNEMONIC_VCVTUW2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu16_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VCVTW2PH, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi16_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDBPSADBW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dbsad_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVPD, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVPH, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVPS, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVSD, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVSH, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDIVSS, zpk_intrinsic, ZydecFormattingInfo::Div, zmf_none, "_mm_div_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDPBF16PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dpbf16_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDPPD, zpk_intrinsic, ZydecFormattingInfo::DotProduct, zmf_none, "_mm_dp_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VDPPS, zpk_intrinsic, ZydecFormattingInfo::DotProduct, zmf_none, "_mm_dp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VERR },
+  { ZYDIS_MNEMONIC_VERW },
+  { ZYDIS_MNEMONIC_VEXP223PS },
+  { ZYDIS_MNEMONIC_VEXP2PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_exp2a23_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXP2PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_exp2a23_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXPANDPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_mask_expand_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXPANDPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_mask_expand_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTF128, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_f128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTF32X4, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extractf32x4_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTF32X8, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extractf32x8_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTF64X2, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extractf64x2_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTF64X4, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extractf64x4_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTI128, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_i128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTI32X4, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extracti32x4_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTI32X8, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extracti32x8_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTI64X2, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extracti64x2_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTI64X4, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extracti64x4_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VEXTRACTPS, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFCMADDCPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fcmadd_pch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFCMADDCSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fcmadd_sch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFCMULCPH, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_cmul_pch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFCMULCSH, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_cmul_sch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFIXUPIMMPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fixupimm_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFIXUPIMMPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fixupimm_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFIXUPIMMSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fixupimm_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFIXUPIMMSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fixupimm_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFIXUPNANPD },
+  { ZYDIS_MNEMONIC_VFIXUPNANPS },
+  { ZYDIS_MNEMONIC_VFMADD132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD132SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD132SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sh(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD132SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ss(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sh(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD213SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ss(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sh(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD231SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_ss(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADD233PS },
+  { ZYDIS_MNEMONIC_VFMADDCPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_pch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFMADDCSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmadd_sch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFMADDPD },
+  { ZYDIS_MNEMONIC_VFMADDPS },
+  { ZYDIS_MNEMONIC_VFMADDSD },
+  { ZYDIS_MNEMONIC_VFMADDSS },
+  { ZYDIS_MNEMONIC_VFMADDSUB132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUB231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmaddsub_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMADDSUBPD },
+  { ZYDIS_MNEMONIC_VFMADDSUBPS },
+  { ZYDIS_MNEMONIC_VFMSUB132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB132SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB132SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sh(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB132SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ss(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sh(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB213SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ss(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_sh(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUB231SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsub_ss(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADD231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmsubadd_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFMSUBADDPD },
+  { ZYDIS_MNEMONIC_VFMSUBADDPS },
+  { ZYDIS_MNEMONIC_VFMSUBPD },
+  { ZYDIS_MNEMONIC_VFMSUBPS },
+  { ZYDIS_MNEMONIC_VFMSUBSD },
+  { ZYDIS_MNEMONIC_VFMSUBSS },
+  { ZYDIS_MNEMONIC_VFMULCPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmul_pch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFMULCSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fmul_sch(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFNMADD132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD132SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD132SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sh(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD132SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ss(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sh(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD213SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ss(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_sh(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADD231SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmadd_ss(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMADDPD },
+  { ZYDIS_MNEMONIC_VFNMADDPS },
+  { ZYDIS_MNEMONIC_VFNMADDSD },
+  { ZYDIS_MNEMONIC_VFNMADDSS },
+  { ZYDIS_MNEMONIC_VFNMSUB132PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_pd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB132PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ph(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB132PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ps(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB132SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sd(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB132SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sh(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB132SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ss(", nullptr, "); // part 1 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_pd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ph(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ps(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sd(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sh(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB213SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ss(", nullptr, "); // part 2 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_pd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231PH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ph(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ps(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sd(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231SH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_sh(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUB231SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fnmsub_ss(", nullptr, "); // part 3 / 3" },
+  { ZYDIS_MNEMONIC_VFNMSUBPD },
+  { ZYDIS_MNEMONIC_VFNMSUBPS },
+  { ZYDIS_MNEMONIC_VFNMSUBSD },
+  { ZYDIS_MNEMONIC_VFNMSUBSS },
+  { ZYDIS_MNEMONIC_VFPCLASSPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fpclass_pd_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFPCLASSPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fpclass_ph_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFPCLASSPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_fpclass_ps_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VFPCLASSSD },
+  { ZYDIS_MNEMONIC_VFPCLASSSH },
+  { ZYDIS_MNEMONIC_VFPCLASSSS },
+  { ZYDIS_MNEMONIC_VFRCZPD },
+  { ZYDIS_MNEMONIC_VFRCZPS },
+  { ZYDIS_MNEMONIC_VFRCZSD },
+  { ZYDIS_MNEMONIC_VFRCZSS },
+  { ZYDIS_MNEMONIC_VGATHERDPD, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i32gather_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGATHERDPS, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i32gather_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGATHERPF0DPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i32extgather_pd(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF0DPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i32extgather_ps(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF0HINTDPD },
+  { ZYDIS_MNEMONIC_VGATHERPF0HINTDPS },
+  { ZYDIS_MNEMONIC_VGATHERPF0QPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64gather_pd(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF0QPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64gather_ps(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF1DPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i32extgather_pd(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF1DPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i32extgather_ps(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF1QPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64gather_pd(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERPF1QPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64gather_ps(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VGATHERQPD, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i64gather_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGATHERQPS, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i64gather_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETEXPSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getexp_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGETMANTSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_getmant_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VGF2P8AFFINEINVQB },
+  { ZYDIS_MNEMONIC_VGF2P8AFFINEQB },
+  { ZYDIS_MNEMONIC_VGF2P8MULB },
+  { ZYDIS_MNEMONIC_VGMAXABSPS },
+  { ZYDIS_MNEMONIC_VGMAXPD },
+  { ZYDIS_MNEMONIC_VGMAXPS },
+  { ZYDIS_MNEMONIC_VGMINPD },
+  { ZYDIS_MNEMONIC_VGMINPS },
+  { ZYDIS_MNEMONIC_VHADDPD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VHADDPS, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VHSUBPD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VHSUBPS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTF128, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_f128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTF32X4, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insertf32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTF32X8, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insertf32x8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTF64X2, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insertf64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTF64X4, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insertf64x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTI128, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_i128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTI32X4, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_inserti32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTI32X8, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_inserti32x8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTI64X2, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_inserti64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTI64X4, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_inserti64x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VINSERTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VLDDQU },
+  { ZYDIS_MNEMONIC_VLDMXCSR },
+  { ZYDIS_MNEMONIC_VLOADUNPACKHD },
+  { ZYDIS_MNEMONIC_VLOADUNPACKHPD },
+  { ZYDIS_MNEMONIC_VLOADUNPACKHPS },
+  { ZYDIS_MNEMONIC_VLOADUNPACKHQ },
+  { ZYDIS_MNEMONIC_VLOADUNPACKLD },
+  { ZYDIS_MNEMONIC_VLOADUNPACKLPD },
+  { ZYDIS_MNEMONIC_VLOADUNPACKLPS },
+  { ZYDIS_MNEMONIC_VLOADUNPACKLQ },
+  { ZYDIS_MNEMONIC_VLOG2PS },
+  { ZYDIS_MNEMONIC_VMASKMOVDQU },
+  { ZYDIS_MNEMONIC_VMASKMOVPD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_pd(" },
+  { ZYDIS_MNEMONIC_VMASKMOVPS, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_ps(" },
+  { ZYDIS_MNEMONIC_VMAXPD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMAXPH, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMAXPS, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMAXSD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMAXSH, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMAXSS, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMCALL },
+  { ZYDIS_MNEMONIC_VMCLEAR },
+  { ZYDIS_MNEMONIC_VMFUNC },
+  { ZYDIS_MNEMONIC_VMINPD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMINPH, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMINPS, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMINSD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMINSH, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMINSS, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMLAUNCH },
+  { ZYDIS_MNEMONIC_VMLOAD },
+  { ZYDIS_MNEMONIC_VMMCALL },
+  { ZYDIS_MNEMONIC_VMOVAPD, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "(" },
+  { ZYDIS_MNEMONIC_VMOVAPS, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "(" },
+  { ZYDIS_MNEMONIC_VMOVD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi32(" },
+  { ZYDIS_MNEMONIC_VMOVDDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_addressParam | zmf_altTextIfOperand1Memory, "_mm_movedup_pd(", "_mm_loaddup_pd(", ");" },
+  { ZYDIS_MNEMONIC_VMOVDQA, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_si(" },
+  { ZYDIS_MNEMONIC_VMOVDQA32, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi32(" },
+  { ZYDIS_MNEMONIC_VMOVDQA64, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi64(" },
+  { ZYDIS_MNEMONIC_VMOVDQU, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_si(" },
+  { ZYDIS_MNEMONIC_VMOVDQU16, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi16(" },
+  { ZYDIS_MNEMONIC_VMOVDQU32, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi32(" },
+  { ZYDIS_MNEMONIC_VMOVDQU64, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi64(" },
+  { ZYDIS_MNEMONIC_VMOVDQU8, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi8(" },
+  { ZYDIS_MNEMONIC_VMOVHLPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movehl_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVHPD },
+  { ZYDIS_MNEMONIC_VMOVHPS },
+  { ZYDIS_MNEMONIC_VMOVLHPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movelh_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVLPD },
+  { ZYDIS_MNEMONIC_VMOVLPS },
+  { ZYDIS_MNEMONIC_VMOVMSKPD, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVMSKPS, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVNRAPD },
+  { ZYDIS_MNEMONIC_VMOVNRAPS },
+  { ZYDIS_MNEMONIC_VMOVNRNGOAPD },
+  { ZYDIS_MNEMONIC_VMOVNRNGOAPS },
+  { ZYDIS_MNEMONIC_VMOVNTDQ, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_si(" },
+  { ZYDIS_MNEMONIC_VMOVNTDQA, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_si(" },
+  { ZYDIS_MNEMONIC_VMOVNTPD, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_pd(" },
+  { ZYDIS_MNEMONIC_VMOVNTPS, zpk_alignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_stream_ps(" },
+  { ZYDIS_MNEMONIC_VMOVQ, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_epi64(" },
+  { ZYDIS_MNEMONIC_VMOVSD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_sd(" },
+  { ZYDIS_MNEMONIC_VMOVSH, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_sh(" },
+  { ZYDIS_MNEMONIC_VMOVSHDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_movehdup_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVSLDUP, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_moveldup_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMOVSS, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_ss(" },
+  { ZYDIS_MNEMONIC_VMOVUPD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "(" },
+  { ZYDIS_MNEMONIC_VMOVUPS, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "(" },
+  { ZYDIS_MNEMONIC_VMOVW },
+  { ZYDIS_MNEMONIC_VMPSADBW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_mpsadbw_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMPTRLD },
+  { ZYDIS_MNEMONIC_VMPTRST },
+  { ZYDIS_MNEMONIC_VMREAD },
+  { ZYDIS_MNEMONIC_VMRESUME },
+  { ZYDIS_MNEMONIC_VMRUN },
+  { ZYDIS_MNEMONIC_VMSAVE },
+  { ZYDIS_MNEMONIC_VMULPD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMULPH, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMULPS, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMULSD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMULSH, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMULSS, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VMWRITE },
+  { ZYDIS_MNEMONIC_VMXOFF },
+  { ZYDIS_MNEMONIC_VMXON },
+  { ZYDIS_MNEMONIC_VORPD, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VORPS, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VP2INTERSECTD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_2intersect_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VP2INTERSECTQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_2intersect_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VP4DPWSSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4dpwssd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VP4DPWSSDS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_4dpwssds_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPABSB, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPABSD, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPABSQ, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPABSW, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_abs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPACKSSDW, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packs_epu32_to_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPACKSSWB, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packs_epu16_to_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPACKSTOREHD },
+  { ZYDIS_MNEMONIC_VPACKSTOREHPD },
+  { ZYDIS_MNEMONIC_VPACKSTOREHPS },
+  { ZYDIS_MNEMONIC_VPACKSTOREHQ },
+  { ZYDIS_MNEMONIC_VPACKSTORELD },
+  { ZYDIS_MNEMONIC_VPACKSTORELPD },
+  { ZYDIS_MNEMONIC_VPACKSTORELPS },
+  { ZYDIS_MNEMONIC_VPACKSTORELQ },
+  { ZYDIS_MNEMONIC_VPACKUSDW, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packus_epu32_to_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPACKUSWB, zpk_intrinsic, ZydecFormattingInfo::Pack, zmf_none, "_mm_packus_epu16_to_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADCD },
+  { ZYDIS_MNEMONIC_VPADDB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDQ, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDSB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDSETCD },
+  { ZYDIS_MNEMONIC_VPADDSETSD },
+  { ZYDIS_MNEMONIC_VPADDSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDUSB, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDUSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_adds_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPADDW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_add_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPALIGNR, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_alignr_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPAND, zpk_intrinsic, ZydecFormattingInfo::And, zmf_shorthandCopy, "_mm_and_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPANDD, zpk_intrinsic, ZydecFormattingInfo::And, zmf_shorthandCopy, "_mm_and_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPANDN, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPANDND, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPANDNQ, zpk_intrinsic, ZydecFormattingInfo::AndNot, zmf_none, "_mm_andnot_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPANDQ, zpk_intrinsic, ZydecFormattingInfo::And, zmf_shorthandCopy, "_mm_and_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPAVGB, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_avg_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPAVGW, zpk_intrinsic, ZydecFormattingInfo::Abs, zmf_none, "_mm_avg_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDMB, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDMD, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDMQ, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDMW, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_mask_blend_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDVB, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blendv_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBLENDW, zpk_intrinsic, ZydecFormattingInfo::Blend, zmf_none, "_mm_blend_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTB, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTD, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTMB2Q, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcastmb_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTMW2D, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcastmw_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTQ, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPBROADCASTW, zpk_intrinsic, ZydecFormattingInfo::Broadcast, zmf_none, "_mm_broadcast_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCLMULQDQ },
+  { ZYDIS_MNEMONIC_VPCMOV },
+  { ZYDIS_MNEMONIC_VPCMPB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epi8_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epi32_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPEQB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPEQD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPEQQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPEQW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_shorthandAllOnes, "_mm_cmpeq_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPESTRI },
+  { ZYDIS_MNEMONIC_VPCMPESTRM },
+  { ZYDIS_MNEMONIC_VPCMPGTB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPGTD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPGTQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPGTW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmpgt_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPISTRI },
+  { ZYDIS_MNEMONIC_VPCMPISTRM },
+  { ZYDIS_MNEMONIC_VPCMPLTD },
+  { ZYDIS_MNEMONIC_VPCMPQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epi64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPUB, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epu8_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPUD, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epu32_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPUQ, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epu64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPUW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epu16_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCMPW, zpk_intrinsic, ZydecFormattingInfo::Cmp, zmf_none, "_mm_cmp_epi16_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCOMB },
+  { ZYDIS_MNEMONIC_VPCOMD },
+  { ZYDIS_MNEMONIC_VPCOMPRESSB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCOMPRESSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCOMPRESSQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCOMPRESSW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedStore, "_mm_mask_compress_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCOMQ },
+  { ZYDIS_MNEMONIC_VPCOMUB },
+  { ZYDIS_MNEMONIC_VPCOMUD },
+  { ZYDIS_MNEMONIC_VPCOMUQ },
+  { ZYDIS_MNEMONIC_VPCOMUW },
+  { ZYDIS_MNEMONIC_VPCOMW },
+  { ZYDIS_MNEMONIC_VPCONFLICTD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_conflict_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPCONFLICTQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_conflict_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPDPBUSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dpbusd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPDPBUSDS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dpbusds_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPDPWSSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dpwssd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPDPWSSDS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_dpwssds_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERM2F128, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute_2f128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERM2I128, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute_2i128(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMB, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutexvar_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMD, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutevar_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMF32X4 },
+  { ZYDIS_MNEMONIC_VPERMI2B },
+  { ZYDIS_MNEMONIC_VPERMI2D },
+  { ZYDIS_MNEMONIC_VPERMI2PD },
+  { ZYDIS_MNEMONIC_VPERMI2PS },
+  { ZYDIS_MNEMONIC_VPERMI2Q },
+  { ZYDIS_MNEMONIC_VPERMI2W },
+  { ZYDIS_MNEMONIC_VPERMIL2PD },
+  { ZYDIS_MNEMONIC_VPERMIL2PS },
+  { ZYDIS_MNEMONIC_VPERMILPD, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMILPS, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMPD, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute4x64_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMPS, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutevar8x32_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMQ, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permute4x64_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2B, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2D, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2PD, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2PS, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2Q, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMT2W, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutex2var_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPERMW, zpk_intrinsic, ZydecFormattingInfo::Permute, zmf_none, "_mm_permutexvar_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXPANDB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedLoad, "_mm_mask_expand_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXPANDD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedLoad, "_mm_mask_expand_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXPANDQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedLoad, "_mm_mask_expand_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXPANDW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_annotateUnalignedLoad, "_mm_mask_expand_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXTRB, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXTRD, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXTRQ, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPEXTRW, zpk_intrinsic, ZydecFormattingInfo::Extract, zmf_none, "_mm_extract_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPGATHERDD, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i32gather_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPGATHERDQ, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i32gather_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPGATHERQD, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i64gather_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPGATHERQQ, zpk_intrinsic, ZydecFormattingInfo::Gather, zmf_addressParam, "_mm_i64gather_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHADDBD },
+  { ZYDIS_MNEMONIC_VPHADDBQ },
+  { ZYDIS_MNEMONIC_VPHADDBW },
+  { ZYDIS_MNEMONIC_VPHADDD, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHADDDQ },
+  { ZYDIS_MNEMONIC_VPHADDSW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadds_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHADDUBD },
+  { ZYDIS_MNEMONIC_VPHADDUBQ },
+  { ZYDIS_MNEMONIC_VPHADDUBW },
+  { ZYDIS_MNEMONIC_VPHADDUDQ },
+  { ZYDIS_MNEMONIC_VPHADDUWD },
+  { ZYDIS_MNEMONIC_VPHADDUWQ },
+  { ZYDIS_MNEMONIC_VPHADDW, zpk_intrinsic, ZydecFormattingInfo::Add, zmf_none, "_mm_hadd_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHADDWD },
+  { ZYDIS_MNEMONIC_VPHADDWQ },
+  { ZYDIS_MNEMONIC_VPHMINPOSUW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_minpos_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHSUBBW },
+  { ZYDIS_MNEMONIC_VPHSUBD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHSUBDQ },
+  { ZYDIS_MNEMONIC_VPHSUBSW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsubs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHSUBW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_hsub_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPHSUBWD },
+  { ZYDIS_MNEMONIC_VPINSRB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPINSRD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPINSRQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPINSRW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_insert_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPLZCNTD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_lzcnt_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPLZCNTQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_lzcnt_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMACSDD },
+  { ZYDIS_MNEMONIC_VPMACSDQH },
+  { ZYDIS_MNEMONIC_VPMACSDQL },
+  { ZYDIS_MNEMONIC_VPMACSSDD },
+  { ZYDIS_MNEMONIC_VPMACSSDQH },
+  { ZYDIS_MNEMONIC_VPMACSSDQL },
+  { ZYDIS_MNEMONIC_VPMACSSWD },
+  { ZYDIS_MNEMONIC_VPMACSSWW },
+  { ZYDIS_MNEMONIC_VPMACSWD },
+  { ZYDIS_MNEMONIC_VPMACSWW },
+  { ZYDIS_MNEMONIC_VPMADCSSWD },
+  { ZYDIS_MNEMONIC_VPMADCSWD },
+  { ZYDIS_MNEMONIC_VPMADD231D },
+  { ZYDIS_MNEMONIC_VPMADD233D },
+  { ZYDIS_MNEMONIC_VPMADD52HUQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_madd52hi_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMADD52LUQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_madd52lo_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMADDUBSW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_maddubs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMADDWD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_pmadd_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMASKMOVD, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_epi32(" },
+  { ZYDIS_MNEMONIC_VPMASKMOVQ, zpk_unalignedMove, ZydecFormattingInfo::Mov, zmf_hintOperand1, "_mask_epi64(" },
+  { ZYDIS_MNEMONIC_VPMAXSB, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXSD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXSQ, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXSW, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXUB, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXUD, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXUQ, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMAXUW, zpk_intrinsic, ZydecFormattingInfo::Max, zmf_none, "_mm_max_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINSB, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINSD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINSQ, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINSW, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINUB, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINUD, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINUQ, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMINUW, zpk_intrinsic, ZydecFormattingInfo::Min, zmf_none, "_mm_min_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVB2M, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movepi8_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVD2M, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movepi32_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVDB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi32_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVDW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi32_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVM2B, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movm_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVM2D, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movm_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVM2Q, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movm_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVM2W, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movm_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVMSKB, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_noSelfReference, "_mm_movemask_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVQ2M, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movepi64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVQB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi64_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVQD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi64_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVQW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi64_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSDB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi32_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSDW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi32_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSQB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi64_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSQD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi64_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSQW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi64_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSWB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtsepi16_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXBD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXBQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXBW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi8_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi32_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXWD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi16_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVSXWQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepi16_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSDB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi32_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSDW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi32_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSQB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi64_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSQD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi64_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSQW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi64_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVUSWB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtusepi16_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVW2M, zpk_intrinsic, ZydecFormattingInfo::Mask, zmf_none, "_mm_movepi16_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVWB, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_annotateUnalignedStore, "_mm_cvtepi16_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXBD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXBQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXBW, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu8_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXDQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu32_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXWD, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu16_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMOVZXWQ, zpk_intrinsic, ZydecFormattingInfo::Convert, zmf_none, "_mm_cvtepu16_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULDQ, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULHD },
+  { ZYDIS_MNEMONIC_VPMULHRSW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhrs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULHUD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhi_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULHUW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhi_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULHW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mulhi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULLD, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mullo_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULLQ, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mullo_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULLW, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mullo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULTISHIFTQB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_multishift_epi64_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPMULUDQ, zpk_intrinsic, ZydecFormattingInfo::Mul, zmf_none, "_mm_mul_epu32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPOPCNTB, zpk_intrinsic, ZydecFormattingInfo::PopCnt, zmf_none, "_mm_popcnt_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPOPCNTD, zpk_intrinsic, ZydecFormattingInfo::PopCnt, zmf_none, "_mm_popcnt_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPOPCNTQ, zpk_intrinsic, ZydecFormattingInfo::PopCnt, zmf_none, "_mm_popcnt_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPOPCNTW, zpk_intrinsic, ZydecFormattingInfo::PopCnt, zmf_none, "_mm_popcnt_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPOR, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPORD, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPORQ, zpk_intrinsic, ZydecFormattingInfo::Or, zmf_shorthandCopy, "_mm_or_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPPERM },
+  { ZYDIS_MNEMONIC_VPREFETCH0 },
+  { ZYDIS_MNEMONIC_VPREFETCH1 },
+  { ZYDIS_MNEMONIC_VPREFETCH2 },
+  { ZYDIS_MNEMONIC_VPREFETCHE0 },
+  { ZYDIS_MNEMONIC_VPREFETCHE1 },
+  { ZYDIS_MNEMONIC_VPREFETCHE2 },
+  { ZYDIS_MNEMONIC_VPREFETCHENTA },
+  { ZYDIS_MNEMONIC_VPREFETCHNTA },
+  { ZYDIS_MNEMONIC_VPROLD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rol_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPROLQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rol_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPROLVD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rolv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPROLVQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rolv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPRORD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ror_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPRORQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ror_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPRORVD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rorv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPRORVQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rorv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPROTB },
+  { ZYDIS_MNEMONIC_VPROTD },
+  { ZYDIS_MNEMONIC_VPROTQ },
+  { ZYDIS_MNEMONIC_VPROTW },
+  { ZYDIS_MNEMONIC_VPSADBW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sad_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSBBD },
+  { ZYDIS_MNEMONIC_VPSBBRD },
+  { ZYDIS_MNEMONIC_VPSCATTERDD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i32scatter_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSCATTERDQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i32scatter_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSCATTERQD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i64scatter_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSCATTERQQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i64scatter_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHAB },
+  { ZYDIS_MNEMONIC_VPSHAD },
+  { ZYDIS_MNEMONIC_VPSHAQ },
+  { ZYDIS_MNEMONIC_VPSHAW },
+  { ZYDIS_MNEMONIC_VPSHLB, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_shl_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLD, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_shl_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldi_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldi_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDVD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDVQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDVW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldv_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLDW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shldi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_shl_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHLW, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_shl_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdi_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdi_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDVD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDVQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDVW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdv_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHRDW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_shrdi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHUFB, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHUFBITQMB, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_bitshuffle_epi64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHUFD, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHUFHW, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shufflehi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSHUFLW, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shufflelo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSIGNB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSIGND, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSIGNW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sign_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLD, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLDQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_bslli_epi128(", nullptr, " * 8); // byte shift left in 128 bit lanes" },
+  { ZYDIS_MNEMONIC_VPSLLQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLVD, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sllv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLVQ, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sllv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLVW, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sllv_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSLLW, zpk_intrinsic, ZydecFormattingInfo::ShL, zmf_none, "_mm_sll_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_sra_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_sra_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAVD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srav_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAVQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srav_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAVW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srav_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRAW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_sra_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLDQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_bsrli_epi128(", nullptr, " * 8); // byte shift right in 128 bit lanes" },
+  { ZYDIS_MNEMONIC_VPSRLQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLVD, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srlv_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLVQ, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srlv_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLVW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srlv_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSRLW, zpk_intrinsic, ZydecFormattingInfo::ShR, zmf_none, "_mm_srl_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBB, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBQ, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBRD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_??_(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBRSETBD },
+  { ZYDIS_MNEMONIC_VPSUBSB, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBSETBD },
+  { ZYDIS_MNEMONIC_VPSUBSW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBUSB, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epu8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBUSW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_subs_epu16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPSUBW, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTERNLOGD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ternarylogic_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTERNLOGQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ternarylogic_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTEST, zpk_intrinsic, ZydecFormattingInfo::Test, zmf_none, "_mm_test(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTMB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_test_epi8_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTMD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_test_epi32_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTMQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_test_epi64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTMW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_test_epi16_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTNMB, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_testn_epi8_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTNMD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_testn_epi32_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTNMQ, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_testn_epi64_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPTESTNMW, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_testn_epi16_mask(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKHBW, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKHDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKHQDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKHWD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKLBW, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi8(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKLDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKLQDQ, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPUNPCKLWD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_epi16(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPXOR, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_si(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPXORD, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_epi32(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VPXORQ, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_epi64(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRANGEPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_range_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRANGEPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_range_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRANGESD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_range_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRANGESS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_range_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP14PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp14_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP14PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp14_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP14SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp14_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP14SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp14_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP23PS },
+  { ZYDIS_MNEMONIC_VRCP28PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp28_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP28PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp28_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP28SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp28_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCP28SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp28_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCPPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCPPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCPSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRCPSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rcp_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCEPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCEPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCEPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCESD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCESH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VREDUCESS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_reduce_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDFXPNTPD },
+  { ZYDIS_MNEMONIC_VRNDFXPNTPS },
+  { ZYDIS_MNEMONIC_VRNDSCALEPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDSCALEPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDSCALEPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDSCALESD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDSCALESH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRNDSCALESS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_roundscale_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VROUNDPD, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VROUNDPS, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VROUNDSD, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VROUNDSS, zpk_intrinsic, ZydecFormattingInfo::Round, zmf_none, "_mm_round_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT14PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt14_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT14PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt14_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT14SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt14_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT14SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt14_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT23PS },
+  { ZYDIS_MNEMONIC_VRSQRT28PD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt28_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT28PS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt28_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT28SD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt28_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRT28SS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt28_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRTPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRTSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VRSQRTSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_rsqrt_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEFSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_scalef_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCALEPS },
+  { ZYDIS_MNEMONIC_VSCATTERDPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i32scatter_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCATTERDPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i32scatter_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCATTERPF0DPD },
+  { ZYDIS_MNEMONIC_VSCATTERPF0DPS },
+  { ZYDIS_MNEMONIC_VSCATTERPF0HINTDPD },
+  { ZYDIS_MNEMONIC_VSCATTERPF0HINTDPS },
+  { ZYDIS_MNEMONIC_VSCATTERPF0QPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64scatter_pd(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VSCATTERPF0QPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64scatter_ps(", nullptr, "); // part 1 / 2" },
+  { ZYDIS_MNEMONIC_VSCATTERPF1DPD },
+  { ZYDIS_MNEMONIC_VSCATTERPF1DPS },
+  { ZYDIS_MNEMONIC_VSCATTERPF1QPD, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64scatter_pd(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VSCATTERPF1QPS, zpk_statement, ZydecFormattingInfo::None, zmf_none, "_mm_prefetch_i64scatter_ps(", nullptr, "); // part 2 / 2" },
+  { ZYDIS_MNEMONIC_VSCATTERQPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i64scatter_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSCATTERQPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_i64scatter_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFF32X4, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_f32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFF64X2, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_f64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFI32X4, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_i32x4(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFI64X2, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_i64x2(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFPD, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSHUFPS, zpk_intrinsic, ZydecFormattingInfo::Shuffle, zmf_none, "_mm_shuffle_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTPD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTPH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTPS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTSD, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTSH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSQRTSS, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_sqrt_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSTMXCSR },
+  { ZYDIS_MNEMONIC_VSUBPD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSUBPH, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_ph(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSUBPS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSUBRPD },
+  { ZYDIS_MNEMONIC_VSUBRPS },
+  { ZYDIS_MNEMONIC_VSUBSD, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_sd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSUBSH, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VSUBSS, zpk_intrinsic, ZydecFormattingInfo::Sub, zmf_none, "_mm_sub_ss(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VTESTPD, zpk_intrinsic, ZydecFormattingInfo::Test, zmf_none, "_mm_test_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VTESTPS, zpk_intrinsic, ZydecFormattingInfo::Test, zmf_none, "_mm_test_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VUCOMISD },
+  { ZYDIS_MNEMONIC_VUCOMISH, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_ucomi_sh(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VUCOMISS },
+  { ZYDIS_MNEMONIC_VUNPCKHPD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VUNPCKHPS, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpackhi_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VUNPCKLPD, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VUNPCKLPS, zpk_intrinsic, ZydecFormattingInfo::Unpack, zmf_none, "_mm_unpacklo_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VXORPD, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VXORPS, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VZEROALL, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_zeroall(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_VZEROUPPER, zpk_intrinsic, ZydecFormattingInfo::None, zmf_none, "_mm_zeroupper(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_WBINVD },
+  { ZYDIS_MNEMONIC_WRFSBASE },
+  { ZYDIS_MNEMONIC_WRGSBASE },
+  { ZYDIS_MNEMONIC_WRMSR },
+  { ZYDIS_MNEMONIC_WRPKRU },
+  { ZYDIS_MNEMONIC_WRSSD },
+  { ZYDIS_MNEMONIC_WRSSQ },
+  { ZYDIS_MNEMONIC_WRUSSD },
+  { ZYDIS_MNEMONIC_WRUSSQ },
+  { ZYDIS_MNEMONIC_XABORT },
+  { ZYDIS_MNEMONIC_XADD },
+  { ZYDIS_MNEMONIC_XBEGIN },
+  { ZYDIS_MNEMONIC_XCHG },
+  { ZYDIS_MNEMONIC_XCRYPT_CBC },
+  { ZYDIS_MNEMONIC_XCRYPT_CFB },
+  { ZYDIS_MNEMONIC_XCRYPT_CTR },
+  { ZYDIS_MNEMONIC_XCRYPT_ECB },
+  { ZYDIS_MNEMONIC_XCRYPT_OFB },
+  { ZYDIS_MNEMONIC_XEND },
+  { ZYDIS_MNEMONIC_XGETBV },
+  { ZYDIS_MNEMONIC_XLAT },
+  { ZYDIS_MNEMONIC_XOR, zpk_arithmetic, ZydecFormattingInfo::XOr, zmf_shorthandZero, " ^= ", " ^ ", ";" },
+  { ZYDIS_MNEMONIC_XORPD, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_pd(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_XORPS, zpk_intrinsic, ZydecFormattingInfo::XOr, zmf_shorthandZero, "_mm_xor_ps(", nullptr, ");" },
+  { ZYDIS_MNEMONIC_XRESLDTRK },
+  { ZYDIS_MNEMONIC_XRSTOR },
+  { ZYDIS_MNEMONIC_XRSTOR64 },
+  { ZYDIS_MNEMONIC_XRSTORS },
+  { ZYDIS_MNEMONIC_XRSTORS64 },
+  { ZYDIS_MNEMONIC_XSAVE },
+  { ZYDIS_MNEMONIC_XSAVE64 },
+  { ZYDIS_MNEMONIC_XSAVEC },
+  { ZYDIS_MNEMONIC_XSAVEC64 },
+  { ZYDIS_MNEMONIC_XSAVEOPT },
+  { ZYDIS_MNEMONIC_XSAVEOPT64 },
+  { ZYDIS_MNEMONIC_XSAVES },
+  { ZYDIS_MNEMONIC_XSAVES64 },
+  { ZYDIS_MNEMONIC_XSETBV },
+  { ZYDIS_MNEMONIC_XSHA1 },
+  { ZYDIS_MNEMONIC_XSHA256 },
+  { ZYDIS_MNEMONIC_XSTORE },
+  { ZYDIS_MNEMONIC_XSUSLDTRK },
+  { ZYDIS_MNEMONIC_XTEST },
+};
 
-  switch (pInstruction->mnemonic)
-  {
-  case ZYDIS_MNEMONIC_MOV:
-  case ZYDIS_MNEMONIC_MOVBE:
-  case ZYDIS_MNEMONIC_MOVDIR64B:
-  case ZYDIS_MNEMONIC_MOVDIRI:
-  case ZYDIS_MNEMONIC_MOVLPD:
-  case ZYDIS_MNEMONIC_MOVLPS:
-  case ZYDIS_MNEMONIC_MOVNTI:
-  case ZYDIS_MNEMONIC_MOVNTQ:
-  case ZYDIS_MNEMONIC_MOVNTSD:
-  case ZYDIS_MNEMONIC_MOVNTSS:
-  case ZYDIS_MNEMONIC_MOVQ2DQ:
-  case ZYDIS_MNEMONIC_MOVSX:
-  case ZYDIS_MNEMONIC_MOVSXD:
-  case ZYDIS_MNEMONIC_MOVZX:
-  case ZYDIS_MNEMONIC_CBW:
-  case ZYDIS_MNEMONIC_CDQ:
-  case ZYDIS_MNEMONIC_CDQE:
-  case ZYDIS_MNEMONIC_CQO:
-  case ZYDIS_MNEMONIC_KMOVB:
-  case ZYDIS_MNEMONIC_KMOVD:
-  case ZYDIS_MNEMONIC_KMOVQ:
-  case ZYDIS_MNEMONIC_KMOVW:
-  {
-    if (simplifyShorthands)
-    {
-      if (pInstruction->operand_count == 2 && pOperands[0].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[1].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[0].reg.value == pOperands[1].reg.value)
-      {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "// nop"));
-        return true;
-      }
-    }
+constexpr bool zydec_MnemonicDescriptorsAreOrdered(const size_t first, const size_t count)
+{
+  return count == 1 ? MnemonicDescriptors[first].mnemonic == first : (zydec_MnemonicDescriptorsAreOrdered(first, count / 2) && zydec_MnemonicDescriptorsAreOrdered(first + count / 2, count - count / 2));
+}
 
-    zydec_HintOp(ZydecFormattingInfo::Mov, pInfo);
-    zydec_HintOperand(&pOperands[1], pInfo);
+static_assert(sizeof(MnemonicDescriptors) / sizeof(MnemonicDescriptors[0]) == ZYDIS_MNEMONIC_MAX_VALUE + 1, "Every mnemonic requires a descriptor.");
+static_assert(zydec_MnemonicDescriptorsAreOrdered(0, ZYDIS_MNEMONIC_MAX_VALUE + 1), "Mnemonic descriptors must be ordered by mnemonic.");
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_MOVBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "__byteswap("));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_MOVDIR64B:
-    case ZYDIS_MNEMONIC_MOVDIRI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "__atomic_write("));
-      break;
+inline bool zydec_IsMemoryOperand(const ZydisDecodedOperand *pOperand)
+{
+  return pOperand->type == ZYDIS_OPERAND_TYPE_MEMORY || pOperand->type == ZYDIS_OPERAND_TYPE_POINTER;
+}
 
-    default:
-      break;
-    }
+inline bool zydec_IsSameRegister(const ZydisDecodedOperand *pA, const ZydisDecodedOperand *pB)
+{
+  return pA->type == ZYDIS_OPERAND_TYPE_REGISTER && pB->type == ZYDIS_OPERAND_TYPE_REGISTER && pA->reg.value == pB->reg.value;
+}
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
+////////////////////////////////////////////////////////////////////////////////
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_MOVBE:
-    case ZYDIS_MNEMONIC_MOVDIR64B:
-    case ZYDIS_MNEMONIC_MOVDIRI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-      break;
+static void zydec_AddToken(ZydecTokenList *pTokenList, const char *tokenStart, const char *tokenEnd, const ZydecTokenKind kind)
+{
+  if (tokenEnd == tokenStart)
+    return;
 
-    case ZYDIS_MNEMONIC_MOVNTI:
-    case ZYDIS_MNEMONIC_MOVNTQ:
-    case ZYDIS_MNEMONIC_MOVNTSD:
-    case ZYDIS_MNEMONIC_MOVNTSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // move with non-temporal hint"));
-      return true;
+  if (pTokenList->tokenCount < pTokenList->tokenCapacity)
+  {
+    ZydecTokenSpan *pSpan = &pTokenList->pTokens[pTokenList->tokenCount];
+    pSpan->offset = (uint32_t)(tokenStart - pTokenList->pLineStart);
+    pSpan->length = (uint16_t)(tokenEnd - tokenStart);
+    pSpan->kind = kind;
+  }
 
-    case ZYDIS_MNEMONIC_MOVSX:
-    case ZYDIS_MNEMONIC_MOVSXD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // move with sign extension"));
-      return true;
+  pTokenList->tokenCount++;
+}
 
-    default:
-      break;
-    }
-  
-    break;
-  }
-  
-  case ZYDIS_MNEMONIC_CMOVB:
-  case ZYDIS_MNEMONIC_CMOVBE:
-  case ZYDIS_MNEMONIC_CMOVL:
-  case ZYDIS_MNEMONIC_CMOVLE:
-  case ZYDIS_MNEMONIC_CMOVNB:
-  case ZYDIS_MNEMONIC_CMOVNBE:
-  case ZYDIS_MNEMONIC_CMOVNL:
-  case ZYDIS_MNEMONIC_CMOVNLE:
-  case ZYDIS_MNEMONIC_CMOVNO:
-  case ZYDIS_MNEMONIC_CMOVNP:
-  case ZYDIS_MNEMONIC_CMOVNS:
-  case ZYDIS_MNEMONIC_CMOVNZ:
-  case ZYDIS_MNEMONIC_CMOVO:
-  case ZYDIS_MNEMONIC_CMOVP:
-  case ZYDIS_MNEMONIC_CMOVS:
-  case ZYDIS_MNEMONIC_CMOVZ:
-  {
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if ("));
+// Finds intrinsic names, constants and comments in the static parts of a translation.
+static void zydec_TokenizeFragment(ZydecTokenList *pTokenList, const char *fragmentStart, const char *fragmentEnd)
+{
+  const char *wordStart = nullptr;
 
-    switch (pInstruction->mnemonic)
+  for (const char *c = fragmentStart; c < fragmentEnd; c++)
+  {
+    if (c[0] == '/' && c + 1 < fragmentEnd && c[1] == '/')
     {
-    case ZYDIS_MNEMONIC_CMOVB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "carry_flag"));
-      break;
+      zydec_AddToken(pTokenList, c, fragmentEnd, ZydecTokenKind::Comment);
+      return;
+    }
 
-    case ZYDIS_MNEMONIC_CMOVBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "carry_flag || zero_flag"));
-      break;
+    const bool isWordChar = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_';
 
-    case ZYDIS_MNEMONIC_CMOVL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag != overflow_flag"));
-      break;
+    if (isWordChar)
+    {
+      if (wordStart == nullptr)
+        wordStart = c;
 
-    case ZYDIS_MNEMONIC_CMOVLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "zero_flag || sign_flag != overflow_flag"));
-      break;
+      continue;
+    }
 
-    case ZYDIS_MNEMONIC_CMOVNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!carry_flag"));
-      break;
+    if (wordStart != nullptr)
+    {
+      if (*wordStart >= '0' && *wordStart <= '9')
+        zydec_AddToken(pTokenList, wordStart, c, ZydecTokenKind::Immediate);
+      else if (*c == '(')
+        zydec_AddToken(pTokenList, wordStart, c, ZydecTokenKind::Intrinsic);
 
-    case ZYDIS_MNEMONIC_CMOVNBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!carry_flag && !zero_flag"));
-      break;
+      wordStart = nullptr;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_CMOVNL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag == overflow_flag"));
-      break;
+  if (wordStart != nullptr && *wordStart >= '0' && *wordStart <= '9')
+    zydec_AddToken(pTokenList, wordStart, fragmentEnd, ZydecTokenKind::Immediate);
+}
 
-    case ZYDIS_MNEMONIC_CMOVNLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!zero_flag && sign_flag == overflow_flag"));
-      break;
+// Marks everything written since `tokenStart` as a single token.
+template <typename TPolicy>
+inline void zydec_EndToken(ZydecFormattingInfo *pInfo, const char *tokenStart, char **pBufferPos, const ZydecTokenKind kind)
+{
+  if (TPolicy::ProducesText && pInfo != nullptr && pInfo->pTokenList != nullptr)
+    zydec_AddToken(pInfo->pTokenList, tokenStart, *pBufferPos, kind);
+}
 
-    case ZYDIS_MNEMONIC_CMOVNO:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!overflow_flag"));
-      break;
+template <typename TPolicy>
+inline void zydec_EndFragment(ZydecFormattingInfo *pInfo, const char *fragmentStart, char **pBufferPos)
+{
+  if (TPolicy::ProducesText && pInfo != nullptr && pInfo->pTokenList != nullptr)
+    zydec_TokenizeFragment(pInfo->pTokenList, fragmentStart, *pBufferPos);
+}
 
-    case ZYDIS_MNEMONIC_CMOVNP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!parity_flag"));
-      break;
+// Writes static text that may contain intrinsic names, constants or comments.
+template <typename TPolicy>
+static bool zydec_WriteFragment(char **pBufferPos, size_t *pRemainingSize, const ZydecString &text, ZydecFormattingInfo *pInfo)
+{
+  const char *fragmentStart = *pBufferPos;
 
-    case ZYDIS_MNEMONIC_CMOVNS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!sign_flag"));
-      break;
+  ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, text));
+  zydec_EndFragment<TPolicy>(pInfo, fragmentStart, pBufferPos);
 
-    case ZYDIS_MNEMONIC_CMOVNZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!zero_flag"));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_CMOVO:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "overflow_flag"));
-      break;
+template <typename TPolicy>
+static bool zydec_WriteToken(char **pBufferPos, size_t *pRemainingSize, const char *text, const size_t length, const ZydecTokenKind kind, ZydecFormattingInfo *pInfo)
+{
+  const char *tokenStart = *pBufferPos;
 
-    case ZYDIS_MNEMONIC_CMOVP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "parity_flag"));
-      break;
+  ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, text, length));
+  zydec_EndToken<TPolicy>(pInfo, tokenStart, pBufferPos, kind);
 
-    case ZYDIS_MNEMONIC_CMOVS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag"));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_CMOVZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "zero_flag"));
-      break;
+template <typename TPolicy>
+static bool zydec_WriteHexToken(char **pBufferPos, size_t *pRemainingSize, const uint64_t value, const ZydecTokenKind kind, ZydecFormattingInfo *pInfo)
+{
+  const char *tokenStart = *pBufferPos;
 
-    default:
-      break;
-    }
+  ERROR_CHECK(zydec_WriteHex<TPolicy>(pBufferPos, pRemainingSize, value));
+  zydec_EndToken<TPolicy>(pInfo, tokenStart, pBufferPos, kind);
 
-    zydec_HintOp(ZydecFormattingInfo::ConditionalMov, pInfo);
-    zydec_HintOperand(&pOperands[1], pInfo);
+  return true;
+}
 
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ") "));
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
+template <typename TPolicy>
+static bool zydec_WriteUIntToken(char **pBufferPos, size_t *pRemainingSize, const uint64_t value, const ZydecTokenKind kind, ZydecFormattingInfo *pInfo)
+{
+  const char *tokenStart = *pBufferPos;
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_CMOVB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if below"));
-      break;
+  ERROR_CHECK(zydec_WriteUInt<TPolicy>(pBufferPos, pRemainingSize, value));
+  zydec_EndToken<TPolicy>(pInfo, tokenStart, pBufferPos, kind);
 
-    case ZYDIS_MNEMONIC_CMOVBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if below or equal"));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_CMOVL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if less"));
-      break;
+template <typename TPolicy>
+static bool zydec_WriteIntToken(char **pBufferPos, size_t *pRemainingSize, const int64_t value, const ZydecTokenKind kind, ZydecFormattingInfo *pInfo)
+{
+  const char *tokenStart = *pBufferPos;
 
-    case ZYDIS_MNEMONIC_CMOVLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if less or equal"));
-      break;
+  ERROR_CHECK(zydec_WriteInt<TPolicy>(pBufferPos, pRemainingSize, value));
+  zydec_EndToken<TPolicy>(pInfo, tokenStart, pBufferPos, kind);
 
-    case ZYDIS_MNEMONIC_CMOVNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not below"));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_CMOVNBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not below or equal"));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_CMOVNL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not less"));
-      break;
+enum ZydecFlagProducerKind : uint8_t
+{
+  zfpk_none,
+  zfpk_compare, // `cmp`: The flags of `operand0 - operand1`.
+  zfpk_test, // `test`: The flags of `operand0 & operand1`.
+  zfpk_logic, // `and`, `or`, `xor`: The flags of the result, with carry & overflow cleared.
+  zfpk_arithmetic, // `add`, `sub`, `inc`, `dec`, `neg`: Only zero & sign describe the result.
+};
 
-    case ZYDIS_MNEMONIC_CMOVNLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not less or equal"));
-      break;
+// The last instruction that set the flags, while its operands still hold the values it set them from.
+struct ZydecFlagProducer
+{
+  ZydecFlagProducerKind kind = zfpk_none;
+  bool isAdjacent = false; // Directly precedes the instruction being translated.
+  bool isFusible = false; // Its operands don't prevent macro-fusion (memory & immediate or rip relative).
+  uint16_t mnemonic = ZYDIS_MNEMONIC_INVALID;
+  size_t virtualAddress = 0;
+  ZydisDecodedOperand operands[2];
+};
 
-    case ZYDIS_MNEMONIC_CMOVNZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not zero / not equal"));
-      break;
+enum ZydecCondition : uint8_t
+{
+  zcc_none,
+  zcc_below,
+  zcc_notBelow,
+  zcc_belowOrEqual,
+  zcc_notBelowOrEqual,
+  zcc_zero,
+  zcc_notZero,
+  zcc_less,
+  zcc_notLess,
+  zcc_lessOrEqual,
+  zcc_notLessOrEqual,
+  zcc_sign,
+  zcc_notSign,
+};
 
-    case ZYDIS_MNEMONIC_CMOVZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if zero / equal"));
-      break;
+struct ZydecConditionDescriptor
+{
+  ZydecString compareOperator; // `operand0 op operand1` after `cmp`, `nullptr` if it can't be expressed that way.
+  bool isUnsigned; // Compares the operands of `cmp` as unsigned integers.
+  ZydecString resultOperator; // `result op 0` after `test` or `and`, `or`, `xor`, `nullptr` if it can't be expressed that way.
+  bool readsCarryOrOverflow; // Can't be expressed with the result of `add`, `sub` (...).
+  bool fusesWithArithmetic; // With `cmp`, `add` & `sub`. `test` & `and` fuse with every condition.
+  bool fusesWithIncDec;
+  ZydecString comment;
+};
 
-    default:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ";"));
-      break;
-    }
+static constexpr ZydecConditionDescriptor ConditionDescriptors[] =
+{
+  { nullptr, false, nullptr, false, false, false, nullptr },
+  { " < ", true, nullptr, true, true, false, "// if below (unsigned)" },
+  { " >= ", true, nullptr, true, true, false, "// if not below (unsigned)" },
+  { " <= ", true, " == ", true, true, false, "// if below or equal (unsigned)" },
+  { " > ", true, " != ", true, true, false, "// if not below or equal (unsigned)" },
+  { " == ", false, " == ", false, true, true, "// if zero / equal" },
+  { " != ", false, " != ", false, true, true, "// if not zero / not equal" },
+  { " < ", false, " < ", true, true, true, "// if less" },
+  { " >= ", false, " >= ", true, true, true, "// if not less" },
+  { " <= ", false, " <= ", true, true, true, "// if less or equal" },
+  { " > ", false, " > ", true, true, true, "// if not less or equal" },
+  { nullptr, false, " < ", false, false, false, "// if sign" },
+  { nullptr, false, " >= ", false, false, false, "// if not sign" },
+};
 
-    return true;
+static_assert(sizeof(ConditionDescriptors) / sizeof(ConditionDescriptors[0]) == zcc_notSign + 1, "Every condition requires a descriptor.");
+
+static ZydecCondition zydec_ResolveCondition(const ZydisMnemonic mnemonic)
+{
+  switch (mnemonic)
+  {
+  case ZYDIS_MNEMONIC_JB: case ZYDIS_MNEMONIC_SETB: case ZYDIS_MNEMONIC_CMOVB: return zcc_below;
+  case ZYDIS_MNEMONIC_JNB: case ZYDIS_MNEMONIC_SETNB: case ZYDIS_MNEMONIC_CMOVNB: return zcc_notBelow;
+  case ZYDIS_MNEMONIC_JBE: case ZYDIS_MNEMONIC_SETBE: case ZYDIS_MNEMONIC_CMOVBE: return zcc_belowOrEqual;
+  case ZYDIS_MNEMONIC_JNBE: case ZYDIS_MNEMONIC_SETNBE: case ZYDIS_MNEMONIC_CMOVNBE: return zcc_notBelowOrEqual;
+  case ZYDIS_MNEMONIC_JZ: case ZYDIS_MNEMONIC_SETZ: case ZYDIS_MNEMONIC_CMOVZ: return zcc_zero;
+  case ZYDIS_MNEMONIC_JNZ: case ZYDIS_MNEMONIC_SETNZ: case ZYDIS_MNEMONIC_CMOVNZ: return zcc_notZero;
+  case ZYDIS_MNEMONIC_JL: case ZYDIS_MNEMONIC_SETL: case ZYDIS_MNEMONIC_CMOVL: return zcc_less;
+  case ZYDIS_MNEMONIC_JNL: case ZYDIS_MNEMONIC_SETNL: case ZYDIS_MNEMONIC_CMOVNL: return zcc_notLess;
+  case ZYDIS_MNEMONIC_JLE: case ZYDIS_MNEMONIC_SETLE: case ZYDIS_MNEMONIC_CMOVLE: return zcc_lessOrEqual;
+  case ZYDIS_MNEMONIC_JNLE: case ZYDIS_MNEMONIC_SETNLE: case ZYDIS_MNEMONIC_CMOVNLE: return zcc_notLessOrEqual;
+  case ZYDIS_MNEMONIC_JS: case ZYDIS_MNEMONIC_SETS: case ZYDIS_MNEMONIC_CMOVS: return zcc_sign;
+  case ZYDIS_MNEMONIC_JNS: case ZYDIS_MNEMONIC_SETNS: case ZYDIS_MNEMONIC_CMOVNS: return zcc_notSign;
+  default: return zcc_none;
   }
+}
 
-  case ZYDIS_MNEMONIC_LEA:
-    zydec_HintOp(ZydecFormattingInfo::AddressOf, pInfo);
-    zydec_HintOperand(&pOperands[1], pInfo);
+inline bool zydec_CanExpressCondition(const ZydecFlagProducer *pProducer, const ZydecCondition condition)
+{
+  const ZydecConditionDescriptor &desc = ConditionDescriptors[condition];
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = &"));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    break;
+  switch (pProducer->kind)
+  {
+  case zfpk_compare: return desc.compareOperator.text != nullptr;
+  case zfpk_test:
+  case zfpk_logic: return desc.resultOperator.text != nullptr;
+  case zfpk_arithmetic: return desc.resultOperator.text != nullptr && !desc.readsCarryOrOverflow;
+  default: return false;
+  }
+}
+
+// Whether the processor may decode the producer & a conditional jump with `condition` into a single uop.
+inline bool zydec_IsMacroFusionCandidate(const ZydecFlagProducer *pProducer, const ZydecCondition condition)
+{
+  if (condition == zcc_none || !pProducer->isAdjacent || !pProducer->isFusible)
+    return false;
 
+  switch (pProducer->mnemonic)
+  {
   case ZYDIS_MNEMONIC_TEST:
+  case ZYDIS_MNEMONIC_AND:
+    return true;
+
   case ZYDIS_MNEMONIC_CMP:
-  {
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "compare("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
+  case ZYDIS_MNEMONIC_ADD:
+  case ZYDIS_MNEMONIC_SUB:
+    return ConditionDescriptors[condition].fusesWithArithmetic;
 
-    if (pInstruction->mnemonic == ZYDIS_MNEMONIC_TEST)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // set flags: carry, parity, zero"));
-    else if (pInstruction->mnemonic == ZYDIS_MNEMONIC_CMP)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // set flags: carry, overflow, signed, zero, aux_carry and parity"));
-    else
-      return false;
+  case ZYDIS_MNEMONIC_INC:
+  case ZYDIS_MNEMONIC_DEC:
+    return ConditionDescriptors[condition].fusesWithIncDec;
 
-    return true;
+  default:
+    return false;
   }
+}
 
-  case ZYDIS_MNEMONIC_CALL:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")()"));
+template <typename TPolicy>
+static bool zydec_WriteFlagCondition(char **pBufferPos, size_t *pRemainingSize, const ZydecFlagProducer *pProducer, const ZydecCondition condition, ZydecFormattingInfo *pInfo)
+{
+  const ZydecConditionDescriptor &desc = ConditionDescriptors[condition];
+  const ZydisDecodedOperand *pOperands = pProducer->operands;
 
-    if (pInfo != nullptr && pInfo->pAfterCall != nullptr)
-      pInfo->pAfterCall(pInfo->pCallUserData);
+  if (pProducer->kind == zfpk_compare && desc.isUnsigned)
+  {
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], pProducer->virtualAddress, pInfo, zof_unsigned));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, desc.compareOperator));
 
-    break;
+    if (pOperands[1].type != ZYDIS_OPERAND_TYPE_IMMEDIATE)
+      return zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], pProducer->virtualAddress, pInfo, zof_unsigned);
 
-  case ZYDIS_MNEMONIC_JMP:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+    // Immediates are sign extended to the width of the comparison.
+    const uint64_t value = pOperands[0].size < 64 ? pOperands[1].imm.value.u & (((uint64_t)1 << pOperands[0].size) - 1) : pOperands[1].imm.value.u;
 
-  case ZYDIS_MNEMONIC_JB:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (carry_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if below"));
-    return true;
+    if (value < 0x10000)
+      return zydec_WriteUIntToken<TPolicy>(pBufferPos, pRemainingSize, value, ZydecTokenKind::Immediate, pInfo);
+    else
+      return zydec_WriteHexToken<TPolicy>(pBufferPos, pRemainingSize, value, ZydecTokenKind::Immediate, pInfo);
+  }
 
-  case ZYDIS_MNEMONIC_JBE:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (carry_flag || zero_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if below or equal"));
+  if (pProducer->kind == zfpk_compare)
+  {
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], pProducer->virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, desc.compareOperator));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], pProducer->virtualAddress, pInfo));
     return true;
+  }
 
-  case ZYDIS_MNEMONIC_JCXZ:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if ((u16)c == 0) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+  if (pProducer->kind == zfpk_test && !zydec_IsSameRegister(&pOperands[0], &pOperands[1]))
+  {
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "("));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], pProducer->virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " & "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], pProducer->virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
+  }
+  else
+  {
+    // The result of logic & arithmetic operations lives on in their first operand.
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], pProducer->virtualAddress, pInfo));
+  }
 
-  case ZYDIS_MNEMONIC_JECXZ:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if ((u32)c == 0) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+  ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, desc.resultOperator));
+  ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "0"));
 
-  case ZYDIS_MNEMONIC_JL:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (sign_flag != overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if less"));
-    return true;
+  return true;
+}
 
-  case ZYDIS_MNEMONIC_JLE:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (zero_flag || sign_flag != overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if less or equal"));
-    return true;
+// Translates `jcc`, `setcc` & `cmovcc` with a condition on the operands of the flag producer rather than on the flags.
+template <typename TPolicy>
+static bool zydec_TranslateFusedCondition(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char **pBufferPos, size_t *pRemainingSize, const ZydecCondition condition, ZydecFormattingInfo *pInfo)
+{
+  const ZydecMnemonicDescriptor &desc = MnemonicDescriptors[pInstruction->mnemonic];
+  const ZydecFlagProducer *pProducer = pInfo->pFlagProducer;
 
-  case ZYDIS_MNEMONIC_JNB:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!carry_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not below"));
-    return true;
+  switch (desc.pattern)
+  {
+  case zpk_operand: // `jcc`
+  {
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "if ("));
+    ERROR_CHECK(zydec_WriteFlagCondition<TPolicy>(pBufferPos, pRemainingSize, pProducer, condition, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ") goto "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "; "));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, ConditionDescriptors[condition].comment, pInfo));
 
-  case ZYDIS_MNEMONIC_JNBE:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!carry_flag && !zero_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not below or equal"));
-    return true;
+    if (zydec_IsMacroFusionCandidate(pProducer, condition))
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, ", macro fusion candidate", pInfo));
 
-  case ZYDIS_MNEMONIC_JNL:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (sign_flag && overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not less"));
-    return true;
+    break;
+  }
 
-  case ZYDIS_MNEMONIC_JNLE:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!zero_flag && sign_flag == overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not less or equal"));
-    return true;
+  case zpk_assignText: // `setcc`
+  {
+    zydec_HintOp<TPolicy>((ZydecFormattingInfo::HintOperation)desc.hint, pInfo);
 
-  case ZYDIS_MNEMONIC_JNO:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = ("));
+    ERROR_CHECK(zydec_WriteFlagCondition<TPolicy>(pBufferPos, pRemainingSize, pProducer, condition, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " ? 1 : 0); "));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, ConditionDescriptors[condition].comment, pInfo));
     break;
+  }
 
-  case ZYDIS_MNEMONIC_JNP:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!parity_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+  case zpk_assign: // `cmovcc`
+  {
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "if ("));
+    ERROR_CHECK(zydec_WriteFlagCondition<TPolicy>(pBufferPos, pRemainingSize, pProducer, condition, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ") "));
 
-  case ZYDIS_MNEMONIC_JNS:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!sign_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+    zydec_HintOp<TPolicy>((ZydecFormattingInfo::HintOperation)desc.hint, pInfo);
 
-  case ZYDIS_MNEMONIC_JNZ:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (!zero_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if not zero / not equal"));
-    return true;
+    if (desc.flags & zmf_hintOperand1)
+      zydec_HintOperand<TPolicy>(&pOperands[1], pInfo);
 
-  case ZYDIS_MNEMONIC_JO:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (overflow_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "; "));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, ConditionDescriptors[condition].comment, pInfo));
     break;
+  }
 
-  case ZYDIS_MNEMONIC_JP:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (parity_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+  default:
+    return false;
+  }
 
-  case ZYDIS_MNEMONIC_JS:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (sign_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    break;
+  return true;
+}
 
-  case ZYDIS_MNEMONIC_JZ:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "if (zero_flag) goto "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // if zero / equal"));
-    return true;
+////////////////////////////////////////////////////////////////////////////////
 
-  case ZYDIS_MNEMONIC_NOP:
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "// nop"));
-    return true;
+// Doesn't terminate the string, `zydec_TranslateInstruction` does so once all fragments have been written.
+template <typename TPolicy>
+static bool zydec_TranslateInstructionToBuffer(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char **pBufferPos, size_t *pRemainingSize, bool *pHasTranslation, ZydecFormattingInfo *pInfo)
+{
+  const bool simplifyShorthands = TPolicy::SimplifyShorthands;
+  const bool simplifySelfModification = TPolicy::SimplifySelfModification;
 
-  case ZYDIS_MNEMONIC_ADD:
-  case ZYDIS_MNEMONIC_ADC:
-  case ZYDIS_MNEMONIC_ADCX:
-  case ZYDIS_MNEMONIC_ADOX:
-  case ZYDIS_MNEMONIC_FADD:
-  case ZYDIS_MNEMONIC_FADDP:
-  case ZYDIS_MNEMONIC_SUB:
-  case ZYDIS_MNEMONIC_AND:
-  case ZYDIS_MNEMONIC_OR:
-  case ZYDIS_MNEMONIC_XOR:
-  case ZYDIS_MNEMONIC_ANDN:
-  case ZYDIS_MNEMONIC_INC:
-  case ZYDIS_MNEMONIC_DEC:
-  case ZYDIS_MNEMONIC_FISUB:
-  case ZYDIS_MNEMONIC_SHL:
-  case ZYDIS_MNEMONIC_SHLX:
-  case ZYDIS_MNEMONIC_SHLD:
-  case ZYDIS_MNEMONIC_SHR:
-  case ZYDIS_MNEMONIC_SHRX:
-  case ZYDIS_MNEMONIC_SHRD:
-  case ZYDIS_MNEMONIC_SALC:
-  case ZYDIS_MNEMONIC_SAR:
-  case ZYDIS_MNEMONIC_SARX:
-  {
-    if (simplifyShorthands)
-    {
-      if (pInstruction->operand_count == 3 /* yes, 3! who knows why. */ && pOperands[0].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[1].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[0].reg.value == pOperands[1].reg.value)
-      {
-        bool match = false;
+  if ((size_t)pInstruction->mnemonic >= sizeof(MnemonicDescriptors) / sizeof(MnemonicDescriptors[0]))
+  {
+    *pHasTranslation = false;
+    return false;
+  }
 
-        switch (pInstruction->mnemonic)
-        {
-        case ZYDIS_MNEMONIC_AND:
-        case ZYDIS_MNEMONIC_OR:
-          match = true;
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "// nop"));
-          break;
+  const ZydecMnemonicDescriptor &desc = MnemonicDescriptors[pInstruction->mnemonic];
+  const ZydecFormattingInfo::HintOperation hint = (ZydecFormattingInfo::HintOperation)desc.hint;
+  const size_t instructionOperandCount = pInstruction->operand_count;
 
-        case ZYDIS_MNEMONIC_XOR:
-          zydec_HintValue(0, pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = 0;"));
-          match = true;
-          break;
+  if (pInfo != nullptr && pInfo->pFlagProducer != nullptr)
+  {
+    const ZydecCondition condition = zydec_ResolveCondition(pInstruction->mnemonic);
 
-        default:
-          break;
-        }
+    if (condition != zcc_none && zydec_CanExpressCondition(pInfo->pFlagProducer, condition))
+      return zydec_TranslateFusedCondition<TPolicy>(pInstruction, pOperands, virtualAddress, pBufferPos, pRemainingSize, condition, pInfo);
+  }
 
-        if (match)
-          return true;
-      }
-    }
+  switch (desc.pattern)
+  {
+  case zpk_text:
+  {
+    if (hint != ZydecFormattingInfo::None)
+      zydec_HintOp<TPolicy>(hint, pInfo);
 
-    switch (pInstruction->mnemonic)
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    break;
+  }
+
+  case zpk_assign:
+  {
+    if (simplifyShorthands && (desc.flags & zmf_nopIfSameRegister) && instructionOperandCount == 2 && zydec_IsSameRegister(&pOperands[0], &pOperands[1]))
     {
-    case ZYDIS_MNEMONIC_ADD:
-    case ZYDIS_MNEMONIC_ADC:
-    case ZYDIS_MNEMONIC_ADCX:
-    case ZYDIS_MNEMONIC_ADOX:
-    case ZYDIS_MNEMONIC_FADD:
-    case ZYDIS_MNEMONIC_FADDP:
-      zydec_HintOp(ZydecFormattingInfo::Add, pInfo);
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, "// nop", pInfo));
       break;
+    }
 
-    case ZYDIS_MNEMONIC_SUB:
-    case ZYDIS_MNEMONIC_FISUB:
-      zydec_HintOp(ZydecFormattingInfo::Sub, pInfo);
+    if (desc.altText.text != nullptr)
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.altText, pInfo));
 
-    case ZYDIS_MNEMONIC_AND:
-      zydec_HintOp(ZydecFormattingInfo::And, pInfo);
-      break;
+    zydec_HintOp<TPolicy>(hint, pInfo);
 
-    case ZYDIS_MNEMONIC_ANDN:
-      zydec_HintOp(ZydecFormattingInfo::AndNot, pInfo);
-      break;
+    if (desc.flags & zmf_hintOperand1)
+      zydec_HintOperand<TPolicy>(&pOperands[1], pInfo);
 
-    case ZYDIS_MNEMONIC_OR:
-      zydec_HintOp(ZydecFormattingInfo::Or, pInfo);
-      break;
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
+  }
 
-    case ZYDIS_MNEMONIC_XOR:
-      zydec_HintOp(ZydecFormattingInfo::XOr, pInfo);
-      break;
+  case zpk_assignText:
+  {
+    zydec_HintOp<TPolicy>(hint, pInfo);
 
-    case ZYDIS_MNEMONIC_INC:
-      zydec_HintOp(ZydecFormattingInfo::Inc, pInfo);
-      return true;
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    break;
+  }
 
-    case ZYDIS_MNEMONIC_DEC:
-      zydec_HintOp(ZydecFormattingInfo::Dec, pInfo);
-      return true;
+  case zpk_compare:
+  {
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
+  }
 
-    case ZYDIS_MNEMONIC_SHL:
-    case ZYDIS_MNEMONIC_SHLX:
-    case ZYDIS_MNEMONIC_SHLD:
-    case ZYDIS_MNEMONIC_SALC:
-      zydec_HintOp(ZydecFormattingInfo::ShL, pInfo);
-      break;
+  case zpk_operand:
+  {
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
 
-    case ZYDIS_MNEMONIC_SHR:
-    case ZYDIS_MNEMONIC_SHRX:
-    case ZYDIS_MNEMONIC_SHRD:
-    case ZYDIS_MNEMONIC_SAR:
-    case ZYDIS_MNEMONIC_SARX:
-      zydec_HintOp(ZydecFormattingInfo::ShR, pInfo);
-      break;
+    // Conditions that can't be fused in the text (e.g. `jle` after `sub`) may still be fused by the processor.
+    if (pInfo != nullptr && pInfo->pFlagProducer != nullptr && pInfo->pFlagProducer->kind != zfpk_none && zydec_IsMacroFusionCandidate(pInfo->pFlagProducer, zydec_ResolveCondition(pInstruction->mnemonic)))
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix.length > 1 ? ZydecString(", macro fusion candidate") : ZydecString(" // macro fusion candidate"), pInfo));
 
-    default:
-      break;
-    }
+    if (desc.flags & zmf_afterCall)
+      TPolicy::AfterCall(pInfo);
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
+    break;
+  }
 
-    if (simplifySelfModification)
-    {
-      switch (pInstruction->mnemonic)
-      {
-      case ZYDIS_MNEMONIC_ADD:
-      case ZYDIS_MNEMONIC_ADC:
-      case ZYDIS_MNEMONIC_ADCX:
-      case ZYDIS_MNEMONIC_ADOX:
-      case ZYDIS_MNEMONIC_FADD:
-      case ZYDIS_MNEMONIC_FADDP:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " += "));
-        break;
-
-      case ZYDIS_MNEMONIC_SUB:
-      case ZYDIS_MNEMONIC_FISUB:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " -= "));
-        break;
-
-      case ZYDIS_MNEMONIC_AND:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " &= "));
-        break;
-
-      case ZYDIS_MNEMONIC_ANDN:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " &= ~"));
-        break;
-
-      case ZYDIS_MNEMONIC_OR:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " |= "));
-        break;
-
-      case ZYDIS_MNEMONIC_XOR:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " ^= "));
-        break;
-
-      case ZYDIS_MNEMONIC_INC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "++;"));
-        return true;
+  case zpk_statement:
+  {
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
 
-      case ZYDIS_MNEMONIC_DEC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "--;"));
-        return true;
+    for (size_t operandIndex = 0; operandIndex < instructionOperandCount; operandIndex++)
+    {
+      if (operandIndex > 0)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
 
-      case ZYDIS_MNEMONIC_SHL:
-      case ZYDIS_MNEMONIC_SHLX:
-      case ZYDIS_MNEMONIC_SHLD:
-      case ZYDIS_MNEMONIC_SALC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " <<= "));
-        break;
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex], virtualAddress, pInfo));
+    }
 
-      case ZYDIS_MNEMONIC_SHR:
-      case ZYDIS_MNEMONIC_SHRX:
-      case ZYDIS_MNEMONIC_SHRD:
-      case ZYDIS_MNEMONIC_SAR:
-      case ZYDIS_MNEMONIC_SARX:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " >>= "));
-        break;
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
+  }
 
-      default:
-        break;
-      }
-    }
-    else
+  case zpk_arithmetic:
+  {
+    if (simplifyShorthands && (desc.flags & (zmf_shorthandNop | zmf_shorthandZero)) && instructionOperandCount == 3 /* yes, 3! who knows why. */ && zydec_IsSameRegister(&pOperands[0], &pOperands[1]))
     {
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-
-      switch (pInstruction->mnemonic)
+      if (desc.flags & zmf_shorthandNop)
       {
-      case ZYDIS_MNEMONIC_ADD:
-      case ZYDIS_MNEMONIC_ADC:
-      case ZYDIS_MNEMONIC_ADCX:
-      case ZYDIS_MNEMONIC_ADOX:
-      case ZYDIS_MNEMONIC_FADD:
-      case ZYDIS_MNEMONIC_FADDP:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " + "));
-        break;
-
-      case ZYDIS_MNEMONIC_SUB:
-      case ZYDIS_MNEMONIC_FISUB:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " - "));
-        break;
-
-      case ZYDIS_MNEMONIC_AND:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " & "));
-        break;
-
-      case ZYDIS_MNEMONIC_ANDN:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " & ~"));
-        break;
-
-      case ZYDIS_MNEMONIC_OR:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " | "));
-        break;
-
-      case ZYDIS_MNEMONIC_XOR:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " ^ "));
-        break;
-
-      case ZYDIS_MNEMONIC_INC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "+ 1;"));
-        return true;
-
-      case ZYDIS_MNEMONIC_DEC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "- 1;"));
-        return true;
-
-      case ZYDIS_MNEMONIC_SHL:
-      case ZYDIS_MNEMONIC_SHLX:
-      case ZYDIS_MNEMONIC_SHLD:
-      case ZYDIS_MNEMONIC_SALC:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " << "));
-        break;
-
-      case ZYDIS_MNEMONIC_SHR:
-      case ZYDIS_MNEMONIC_SHRX:
-      case ZYDIS_MNEMONIC_SHRD:
-      case ZYDIS_MNEMONIC_SAR:
-      case ZYDIS_MNEMONIC_SARX:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " >> "));
-        break;
-
-      default:
-        break;
+        ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, "// nop", pInfo));
+      }
+      else
+      {
+        zydec_HintValue<TPolicy>(0, pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " = 0;", pInfo));
       }
-    }
-
-    if (pInstruction->operand_count > 1)
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_ADC:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " + carry_flag"));
       break;
+    }
 
-    case ZYDIS_MNEMONIC_ADCX:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " + carry_flag; // unsigned integer add with carry_flag"));
-      return true;
+    if (hint != ZydecFormattingInfo::None)
+      zydec_HintOp<TPolicy>(hint, pInfo);
 
-    case ZYDIS_MNEMONIC_ADOX:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " + overflow_flag; // unsigned integer add with overflow_flag"));
-      return true;
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
 
-    default:
-      break;
+    if (simplifySelfModification)
+    {
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    }
+    else
+    {
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.altText, pInfo));
     }
 
+    if (instructionOperandCount > 1)
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
     break;
   }
 
-  case ZYDIS_MNEMONIC_MUL:
-  case ZYDIS_MNEMONIC_IMUL:
+  case zpk_multiply:
   {
-    zydec_HintOp(ZydecFormattingInfo::Mul, pInfo);
+    zydec_HintOp<TPolicy>(hint, pInfo);
 
-    if (pInstruction->operand_count == 1)
+    if (instructionOperandCount == 1)
     {
       if (pOperands[0].element_size < 16)
       {
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AL, pInfo, false));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
-      }
-      else if (pOperands[0].element_size < 32)
-      {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "["));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_DX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "] = "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, false));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
-      }
-      else if (pOperands[0].element_size < 64)
-      {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "["));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EDX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EAX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "] = "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EAX, pInfo, false));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, ZYDIS_REGISTER_AX, pInfo, true));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, ZYDIS_REGISTER_AL, pInfo, false));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
       }
       else
       {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "["));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RDX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RAX, pInfo, true));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "] = "));
-        ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RAX, pInfo, false));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
+        ZydisRegister high, low;
+
+        if (pOperands[0].element_size < 32)
+        {
+          high = ZYDIS_REGISTER_DX;
+          low = ZYDIS_REGISTER_AX;
+        }
+        else if (pOperands[0].element_size < 64)
+        {
+          high = ZYDIS_REGISTER_EDX;
+          low = ZYDIS_REGISTER_EAX;
+        }
+        else
+        {
+          high = ZYDIS_REGISTER_RDX;
+          low = ZYDIS_REGISTER_RAX;
+        }
+
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "["));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, high, pInfo, true));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, low, pInfo, true));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "] = "));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, low, pInfo, false));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
       }
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
     }
-    else if (pInstruction->operand_count == 2)
+    else if (instructionOperandCount == 2)
     {
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-      
+      ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+
       if (simplifySelfModification)
       {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " *= "));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " *= "));
       }
       else
       {
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-        ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+        ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
       }
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
     }
     else
     {
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * "));
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[2], virtualAddress, pInfo));
-    }
-
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_DIV:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // unsigned integer multiply"));
-    case ZYDIS_MNEMONIC_IDIV:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // signed integer multiply"));
-    default:
-      break;
+      ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[2], virtualAddress, pInfo));
     }
 
-    return true;
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
   }
 
-  case ZYDIS_MNEMONIC_DIV:
-  case ZYDIS_MNEMONIC_IDIV:
+  case zpk_divide:
   {
-    zydec_HintOp(ZydecFormattingInfo::Div, pInfo);
+    ZydisRegister quotient, remainder, dividend;
 
     if (pOperands[0].element_size < 16)
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AL, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " / "));
+      quotient = ZYDIS_REGISTER_AL;
+      remainder = ZYDIS_REGISTER_AH;
+      dividend = ZYDIS_REGISTER_AX;
     }
     else if (pOperands[0].element_size < 32)
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " / "));
+      quotient = ZYDIS_REGISTER_AX;
+      remainder = ZYDIS_REGISTER_DX;
+      dividend = ZYDIS_REGISTER_AX;
     }
     else if (pOperands[0].element_size < 64)
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EAX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EAX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " / "));
+      quotient = ZYDIS_REGISTER_EAX;
+      remainder = ZYDIS_REGISTER_EDX;
+      dividend = ZYDIS_REGISTER_EAX;
     }
     else
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RAX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RAX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " / "));
+      quotient = ZYDIS_REGISTER_RAX;
+      remainder = ZYDIS_REGISTER_RDX;
+      dividend = ZYDIS_REGISTER_RAX;
     }
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; "));
+    zydec_HintOp<TPolicy>(hint, pInfo);
 
-    zydec_HintOp(ZydecFormattingInfo::Mod, pInfo);
+    ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, quotient, pInfo, true));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, dividend, pInfo, false));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " / "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "; "));
 
-    if (pOperands[0].element_size < 16)
+    zydec_HintOp<TPolicy>(ZydecFormattingInfo::Mod, pInfo);
+
+    ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, remainder, pInfo, true));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, dividend, pInfo, false));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " % "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
+  }
+
+  case zpk_maskOperation:
+  {
+    zydec_HintOp<TPolicy>(hint, pInfo);
+
+    if (simplifyShorthands && (desc.flags & (zmf_shorthandCopy | zmf_shorthandZero)) && instructionOperandCount == 3 && zydec_IsSameRegister(&pOperands[1], &pOperands[2]))
+    {
+      if (desc.flags & zmf_shorthandCopy)
+      {
+        zydec_HintOperand<TPolicy>(&pOperands[1], pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ";"));
+      }
+      else
+      {
+        zydec_HintValue<TPolicy>(0, pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " = 0;", pInfo));
+      }
+
+      break;
+    }
+
+    ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[1], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.text, pInfo));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[2], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, desc.suffix, pInfo));
+    break;
+  }
+
+  case zpk_alignedMove:
+  case zpk_unalignedMove:
+  {
+    const bool aligned = desc.pattern == zpk_alignedMove;
+
+    zydec_HintOp<TPolicy>(hint, pInfo);
+    zydec_HintOperand<TPolicy>(&pOperands[1], pInfo);
+
+    bool isReg2RegMove = false;
+    size_t operandIndex = 0;
+
+    const char *intrinsicStart = *pBufferPos; // The intrinsic name is completed by `text`.
+
+    if (zydec_IsMemoryOperand(&pOperands[0]))
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AH, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " % "));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, aligned ? ZydecString("_mm_aligned_store") : ZydecString("_mm_unaligned_store")));
     }
-    else if (pOperands[0].element_size < 32)
+    else if (zydec_IsMemoryOperand(&pOperands[1]))
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_DX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_AX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " % "));
+      ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref));
+      intrinsicStart = *pBufferPos;
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, aligned ? ZydecString(" = _mm_aligned_load") : ZydecString(" = _mm_unaligned_load")));
     }
-    else if (pOperands[0].element_size < 64)
+    else if (instructionOperandCount == 2)
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EDX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_EAX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " % "));
+      isReg2RegMove = true;
+    }
+    else if (aligned)
+    {
+      ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref));
+      intrinsicStart = *pBufferPos;
+
+      if (instructionOperandCount == 3)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = _mm_maskz_mov"));
+      else if (instructionOperandCount == 4)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = _mm_mask_mov"));
+      else
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = _mm_mov"));
     }
     else
     {
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RDX, pInfo, true));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-      ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, ZYDIS_REGISTER_RAX, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " % "));
+      if (instructionOperandCount == 3)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "_mm_maskz_mov_unaligned"));
+      else if (instructionOperandCount == 4)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "_mm_mask_mov_unaligned"));
+      else
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "_mm_mov_unaligned"));
+    }
+
+    if (!isReg2RegMove)
+    {
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, desc.text));
+      zydec_EndFragment<TPolicy>(pInfo, intrinsicStart, pBufferPos);
     }
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
+    ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref, isReg2RegMove));
+    const size_t startOperandIndex = operandIndex;
 
-    switch (pInstruction->mnemonic)
+    if (isReg2RegMove)
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    else if (startOperandIndex < instructionOperandCount)
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
+
+    for (; operandIndex < instructionOperandCount; operandIndex++)
     {
-    case ZYDIS_MNEMONIC_DIV:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // unsigned integer divide"));
-    case ZYDIS_MNEMONIC_IDIV:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "; // signed integer divide"));
-    default:
-      break;
+      if (operandIndex > startOperandIndex)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
+
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex], virtualAddress, pInfo, zof_noAddressDeref));
     }
 
-    return true;
-  }
+    if (!isReg2RegMove)
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
 
-  case ZYDIS_MNEMONIC_RET:
-  {
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "return"));
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ";"));
     break;
   }
 
-  case ZYDIS_MNEMONIC_INT3:
+  case zpk_intrinsic:
+  case zpk_intrinsicSized:
   {
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "__builtin_trap(); // __debugbreak();"));
-    return true;
-  }
-
-  case ZYDIS_MNEMONIC_SETB:
-  case ZYDIS_MNEMONIC_SETBE:
-  case ZYDIS_MNEMONIC_SETL:
-  case ZYDIS_MNEMONIC_SETLE:
-  case ZYDIS_MNEMONIC_SETNB:
-  case ZYDIS_MNEMONIC_SETNBE:
-  case ZYDIS_MNEMONIC_SETNL:
-  case ZYDIS_MNEMONIC_SETNLE:
-  case ZYDIS_MNEMONIC_SETNO:
-  case ZYDIS_MNEMONIC_SETNP:
-  case ZYDIS_MNEMONIC_SETNS:
-  case ZYDIS_MNEMONIC_SETNZ:
-  case ZYDIS_MNEMONIC_SETO:
-  case ZYDIS_MNEMONIC_SETP:
-  case ZYDIS_MNEMONIC_SETS:
-  case ZYDIS_MNEMONIC_SETZ:
-  {
-    zydec_HintOp(ZydecFormattingInfo::Set, pInfo);
-
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = ("));
-
-    switch (pInstruction->mnemonic)
+    if (simplifyShorthands && (desc.flags & (zmf_shorthandCopy | zmf_shorthandZero | zmf_shorthandAllOnes)) && instructionOperandCount == 3 && zydec_IsSameRegister(&pOperands[1], &pOperands[2]))
     {
-    case ZYDIS_MNEMONIC_SETB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "carry_flag"));
-      break;
+      if (desc.flags & zmf_shorthandCopy)
+      {
+        zydec_HintOperand<TPolicy>(&pOperands[1], pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+        ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperands[1].reg.value, pInfo, false));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ";"));
+      }
+      else if (desc.flags & zmf_shorthandZero)
+      {
+        zydec_HintValue<TPolicy>(0, pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " = 0;", pInfo));
+      }
+      else
+      {
+        zydec_HintValue<TPolicy>((int64_t)-1, pInfo);
+        ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+        ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " = -1;", pInfo));
+      }
 
-    case ZYDIS_MNEMONIC_SETBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "(carry_flag || zero_flag)"));
       break;
+    }
 
-    case ZYDIS_MNEMONIC_SETL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag != overflow_flag"));
-      break;
+    if (instructionOperandCount > 1)
+    {
+      if (hint != ZydecFormattingInfo::None)
+        zydec_HintOp<TPolicy>(hint, pInfo);
 
-    case ZYDIS_MNEMONIC_SETLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "(zero_flag || sign_flag != overflow_flag)"));
-      break;
+      ERROR_CHECK(zydec_WriteResultOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[0], virtualAddress, pInfo));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " = "));
+    }
 
-    case ZYDIS_MNEMONIC_SETNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!carry_flag"));
-      break;
+    ZydecString name = desc.text;
+    ZydecString suffix = desc.suffix;
 
-    case ZYDIS_MNEMONIC_SETNBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "(!carry_flag && !zero_flag)"));
-      break;
+    if (desc.pattern == zpk_intrinsicSized)
+    {
+      const size_t sizeOperandIndex = (desc.flags & zmf_sizedByOperand0) ? 0 : 2;
 
-    case ZYDIS_MNEMONIC_SETNL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag == overflow_flag"));
-      break;
+      if (instructionOperandCount > sizeOperandIndex && pOperands[sizeOperandIndex].element_size == 4)
+        name = desc.altText;
+      else if (instructionOperandCount > sizeOperandIndex && pOperands[sizeOperandIndex].element_size == 8)
+        name = desc.suffix;
 
-    case ZYDIS_MNEMONIC_SETNLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "(!zero_flag && sign_flag == overflow_flag)"));
-      break;
+      suffix = ");";
+    }
+    else if (((desc.flags & zmf_altTextIfOperand0Memory) && zydec_IsMemoryOperand(&pOperands[0])) || ((desc.flags & zmf_altTextIfOperand1Memory) && zydec_IsMemoryOperand(&pOperands[1])))
+    {
+      name = desc.altText;
+    }
 
-    case ZYDIS_MNEMONIC_SETNO:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!overflow_flag"));
-      break;
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, name, pInfo));
 
-    case ZYDIS_MNEMONIC_SETNP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!parity_flag"));
-      break;
+    const size_t startOperandIndex = instructionOperandCount <= 1 || (instructionOperandCount == 2 && !(desc.flags & zmf_noSelfReference)) ? 0 : 1;
+    const ZydecOperandFlags operandFlags = (desc.flags & zmf_addressParam) ? zof_none : zof_noAddressDeref;
 
-    case ZYDIS_MNEMONIC_SETNS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!sign_flag"));
-      break;
+    for (size_t operandIndex = startOperandIndex; operandIndex < instructionOperandCount; operandIndex++)
+    {
+      if (operandIndex > startOperandIndex)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ", "));
 
-    case ZYDIS_MNEMONIC_SETNZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "!zero_flag"));
-      break;
+      ERROR_CHECK(zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, &pOperands[operandIndex], virtualAddress, pInfo, operandFlags));
+    }
 
-    case ZYDIS_MNEMONIC_SETO:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "overflow_flag"));
-      break;
+    ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, suffix, pInfo));
 
-    case ZYDIS_MNEMONIC_SETP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "parity_flag"));
-      break;
+    if ((desc.flags & zmf_annotateUnalignedStore) && zydec_IsMemoryOperand(&pOperands[0]))
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " // with unaligned store", pInfo));
+    else if ((desc.flags & zmf_annotateUnalignedLoad) && instructionOperandCount > 0 && zydec_IsMemoryOperand(&pOperands[instructionOperandCount - 1]))
+      ERROR_CHECK(zydec_WriteFragment<TPolicy>(pBufferPos, pRemainingSize, " // with unaligned load", pInfo));
 
-    case ZYDIS_MNEMONIC_SETS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "sign_flag"));
-      break;
+    break;
+  }
 
-    case ZYDIS_MNEMONIC_SETZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "zero_flag"));
-      break;
+  default:
+    *pHasTranslation = false;
+    return false;
+  }
 
-    default:
-      break;
-    }
+  return true;
+}
 
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " ? 1 : 0);"));
+// Writes the translation to the buffer.
+struct ZydecTextSink
+{
+  static constexpr bool ProducesText = true;
+  static constexpr bool MeasuresText = true;
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_SETB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if below"));
-      break;
+  static bool Write(char **pBufferPos, size_t *pRemainingSize, const char *text, const size_t length)
+  {
+    return zydec_WriteRaw(pBufferPos, pRemainingSize, text, length);
+  }
 
-    case ZYDIS_MNEMONIC_SETBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if below or equal"));
-      break;
+  static bool Write(char **pBufferPos, size_t *pRemainingSize, const ZydecString &string)
+  {
+    return zydec_WriteRaw(pBufferPos, pRemainingSize, string);
+  }
 
-    case ZYDIS_MNEMONIC_SETL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if less"));
-      break;
+  // Hands out `length` chars of the buffer to be written to directly.
+  static bool Reserve(char **pBufferPos, size_t *pRemainingSize, const size_t length, char **pText)
+  {
+    if (length > *pRemainingSize)
+      return false;
 
-    case ZYDIS_MNEMONIC_SETLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if less or equal"));
-      break;
+    *pText = *pBufferPos;
+    (*pRemainingSize) -= length;
+    (*pBufferPos) += length;
 
-    case ZYDIS_MNEMONIC_SETNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if not below"));
-      break;
+    return true;
+  }
+};
 
-    case ZYDIS_MNEMONIC_SETNBE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if not below or equal"));
-      break;
+// Only runs the translation for its side effects (like the register names of a linear context), without producing any text.
+struct ZydecNullSink
+{
+  static constexpr bool ProducesText = false;
+  static constexpr bool MeasuresText = false;
 
-    case ZYDIS_MNEMONIC_SETNL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if not less"));
-      break;
+  static bool Write(char **, size_t *, const char *, const size_t)
+  {
+    return true;
+  }
 
-    case ZYDIS_MNEMONIC_SETNLE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if not less or equal"));
-      break;
+  static bool Write(char **, size_t *, const ZydecString &)
+  {
+    return true;
+  }
 
-    case ZYDIS_MNEMONIC_SETNZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if not zero / not equal"));
-      break;
+  static bool Reserve(char **, size_t *, const size_t, char **pText)
+  {
+    *pText = nullptr;
+    return true;
+  }
+};
 
-    case ZYDIS_MNEMONIC_SETZ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " // if zero / equal"));
-      break;
+// Only subtracts the length of the translation from the remaining size, without writing anything.
+struct ZydecMeasureSink
+{
+  static constexpr bool ProducesText = false;
+  static constexpr bool MeasuresText = true;
 
-    default:
-      break;
-    }
+  static bool Write(char **, size_t *pRemainingSize, const char *, const size_t length)
+  {
+    if (length > *pRemainingSize)
+      return false;
+
+    *pRemainingSize -= length;
 
     return true;
   }
 
-  case ZYDIS_MNEMONIC_BSF:
+  static bool Write(char **pBufferPos, size_t *pRemainingSize, const ZydecString &string)
   {
-    zydec_HintOp(ZydecFormattingInfo::BitScanF, pInfo);
-
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = __bitscan_forward("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-    break;
+    return Write(pBufferPos, pRemainingSize, string.text, string.length);
   }
 
-  case ZYDIS_MNEMONIC_BSR:
+  static bool Reserve(char **pBufferPos, size_t *pRemainingSize, const size_t length, char **pText)
   {
-    zydec_HintOp(ZydecFormattingInfo::BitScanR, pInfo);
+    *pText = nullptr;
+    return Write(pBufferPos, pRemainingSize, nullptr, length);
+  }
+};
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = __bitscan_reverse("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-    break;
+// The options of a translation kernel are resolved at compile time, so they don't have to be checked for every fragment.
+template <typename TEmitter, bool TSimplifyShorthands, bool TSimplifySelfModification, bool TAcceptHints>
+struct ZydecPolicy : TEmitter
+{
+  static constexpr bool SimplifyShorthands = TSimplifyShorthands;
+  static constexpr bool SimplifySelfModification = TSimplifySelfModification;
+  static constexpr bool AcceptHints = TAcceptHints;
+};
+
+typedef bool ZydecKernelFunc(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo);
+typedef bool ZydecMeasureKernelFunc(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, size_t *pRequiredCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo);
+
+// Forwards register names, hints and calls to the callbacks of the `ZydecFormattingInfo`.
+template <typename TSink>
+struct ZydecCallbackEmitter : TSink
+{
+  static bool AcceptsHints(const ZydecFormattingInfo *pInfo)
+  {
+    return pInfo->acceptHints && (pInfo->pSetHintReg != nullptr || pInfo->pSetHintVal != nullptr || pInfo->pSetHintOp != nullptr);
   }
 
-  case ZYDIS_MNEMONIC_POPCNT:
+  static bool WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
   {
-    zydec_HintOp(ZydecFormattingInfo::PopCnt, pInfo);
+    if (pInfo == nullptr || pInfo->pWriteRegister == nullptr)
+      return zydec_WriteRegisterRaw<TSink>(pBufferPos, pRemainingSize, reg);
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = __popcnt("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-    break;
+    return WriteCallbackRegister(pBufferPos, pRemainingSize, reg, pInfo->pWriteRegister, pInfo);
   }
 
-  case ZYDIS_MNEMONIC_PREFETCH:
-  case ZYDIS_MNEMONIC_PREFETCHNTA:
-  case ZYDIS_MNEMONIC_PREFETCHT0:
-  case ZYDIS_MNEMONIC_PREFETCHT1:
-  case ZYDIS_MNEMONIC_PREFETCHT2:
-  case ZYDIS_MNEMONIC_PREFETCHW:
-  case ZYDIS_MNEMONIC_PREFETCHWT1:
+  static bool WriteResultRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
   {
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-    break;
+    if (pInfo == nullptr || pInfo->pWriteResultRegister == nullptr)
+      return zydec_WriteRegisterRaw<TSink>(pBufferPos, pRemainingSize, reg);
+
+    return WriteCallbackRegister(pBufferPos, pRemainingSize, reg, pInfo->pWriteResultRegister, pInfo);
   }
 
-  case ZYDIS_MNEMONIC_KORTESTB:
-  case ZYDIS_MNEMONIC_KORTESTW:
-  case ZYDIS_MNEMONIC_KORTESTD:
-  case ZYDIS_MNEMONIC_KORTESTQ:
-  case ZYDIS_MNEMONIC_KTESTB:
-  case ZYDIS_MNEMONIC_KTESTW:
-  case ZYDIS_MNEMONIC_KTESTD:
-  case ZYDIS_MNEMONIC_KTESTQ:
+  // The callbacks always write to a buffer, so sinks that don't have one get a temporary one.
+  static bool WriteCallbackRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo::RegisterAppendStringFunc *pFunc, ZydecFormattingInfo *pInfo)
   {
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_KORTESTB:
-    case ZYDIS_MNEMONIC_KORTESTW:
-    case ZYDIS_MNEMONIC_KORTESTD:
-    case ZYDIS_MNEMONIC_KORTESTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kortest"));
-      break;
+    if (TSink::ProducesText)
+      return pFunc(pBufferPos, pRemainingSize, reg, pInfo->pRegUserData);
 
-    case ZYDIS_MNEMONIC_KTESTB:
-    case ZYDIS_MNEMONIC_KTESTW:
-    case ZYDIS_MNEMONIC_KTESTD:
-    case ZYDIS_MNEMONIC_KTESTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_ktest"));
-      break;
+    char name[256];
+    char *namePos = name;
+    size_t nameRemainingSize = sizeof(name);
 
-    default:
-      break;
-    }
+    if (!pFunc(&namePos, &nameRemainingSize, reg, pInfo->pRegUserData))
+      return false;
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_KORTESTB:
-    case ZYDIS_MNEMONIC_KTESTB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_u8"));
-      break;
+    return TSink::Write(pBufferPos, pRemainingSize, name, (size_t)(namePos - name));
+  }
 
-    case ZYDIS_MNEMONIC_KORTESTW:
-    case ZYDIS_MNEMONIC_KTESTW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_u16"));
-      break;
+  static ZydecTokenKind RegisterTokenKind(const ZydecFormattingInfo *pInfo, const bool isNewResult)
+  {
+    if (pInfo == nullptr || (isNewResult ? pInfo->pWriteResultRegister : pInfo->pWriteRegister) == nullptr)
+      return ZydecTokenKind::Register;
 
-    case ZYDIS_MNEMONIC_KORTESTD:
-    case ZYDIS_MNEMONIC_KTESTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_u32"));
-      break;
+    return ZydecTokenKind::RenamedRegister;
+  }
 
-    case ZYDIS_MNEMONIC_KORTESTQ:
-    case ZYDIS_MNEMONIC_KTESTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_u64"));
+  static void HintRegister(const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    if (pInfo->pSetHintReg != nullptr)
+      pInfo->pSetHintReg(reg, pInfo->pRegUserData);
+  }
+
+  static void HintValue(const int64_t value, ZydecFormattingInfo *pInfo)
+  {
+    if (pInfo->pSetHintVal != nullptr)
+      pInfo->pSetHintVal(value, pInfo->pRegUserData);
+  }
+
+  static void HintOperation(const ZydecFormattingInfo::HintOperation op, ZydecFormattingInfo *pInfo)
+  {
+    if (pInfo->pSetHintOp != nullptr)
+      pInfo->pSetHintOp(op, pInfo->pRegUserData);
+  }
+
+  static void AfterCall(ZydecFormattingInfo *pInfo)
+  {
+    if (pInfo != nullptr && pInfo->pAfterCall != nullptr)
+      pInfo->pAfterCall(pInfo->pCallUserData);
+  }
+};
+
+// The number of leading operands `zydec_TranslateInstructionToBuffer` reads for the pattern of the instruction.
+static size_t zydec_RequiredOperandCount(const ZydisDecodedInstruction *pInstruction)
+{
+  if ((size_t)pInstruction->mnemonic >= sizeof(MnemonicDescriptors) / sizeof(MnemonicDescriptors[0]))
+    return 0;
+
+  size_t count;
+
+  switch (MnemonicDescriptors[pInstruction->mnemonic].pattern)
+  {
+  case zpk_none:
+  case zpk_text:
+    return 0;
+
+  case zpk_assignText:
+  case zpk_operand:
+  case zpk_divide:
+    count = 1;
+    break;
+
+  case zpk_assign:
+  case zpk_compare:
+  case zpk_arithmetic:
+    count = 2;
+    break;
+
+  case zpk_multiply:
+  case zpk_maskOperation:
+    count = 3;
+    break;
+
+  default: // Patterns that list all operands.
+    return pInstruction->operand_count;
+  }
+
+  return count < pInstruction->operand_count ? count : pInstruction->operand_count;
+}
+
+static bool zydec_HasRequiredOperands(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount)
+{
+  const size_t requiredOperandCount = zydec_RequiredOperandCount(pInstruction);
+
+  return operandCount >= requiredOperandCount && (pOperands != nullptr || requiredOperandCount == 0);
+}
+
+// Decodes the instruction, but only the operands its translation reads (unless `allOperands` is set, e.g. to keep track of the flags).
+static bool zydec_DecodeInstruction(const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, ZydisDecodedInstruction *pInstruction, ZydisDecodedOperand *pOperands, const bool allOperands = false)
+{
+  ZydisDecoderContext decoderContext;
+
+  if (!ZYAN_SUCCESS(ZydisDecoderDecodeInstruction(pDecoder, &decoderContext, pCode, size, pInstruction)) || pInstruction->length == 0)
+    return false;
+
+  return ZYAN_SUCCESS(ZydisDecoderDecodeOperands(pDecoder, &decoderContext, pInstruction, pOperands, (ZyanU8)(allOperands ? pInstruction->operand_count : zydec_RequiredOperandCount(pInstruction))));
+}
+
+size_t zydec_GetRequiredOperandCount(const ZydisDecodedInstruction *pInstruction)
+{
+  if (pInstruction == nullptr)
+    return 0;
+
+  return zydec_RequiredOperandCount(pInstruction);
+}
+
+template <typename TPolicy>
+static bool zydec_TranslateInstruction(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo)
+{
+  if (pInstruction == nullptr || !zydec_HasRequiredOperands(pInstruction, pOperands, operandCount) || buffer == nullptr || bufferCapacity == 0 || pHasTranslation == nullptr)
+    return false;
+
+  char *bufferPos = buffer;
+  size_t remainingSize = bufferCapacity - 1; // Reserve space for the terminator.
+
+  *pHasTranslation = true;
+
+  if (TPolicy::ProducesText && pInfo != nullptr && pInfo->pTokenList != nullptr)
+  {
+    pInfo->pTokenList->tokenCount = 0;
+    pInfo->pTokenList->pLineStart = buffer;
+  }
+
+  const bool result = zydec_TranslateInstructionToBuffer<TPolicy>(pInstruction, pOperands, virtualAddress, &bufferPos, &remainingSize, pHasTranslation, pInfo);
+
+  *bufferPos = '\0';
+
+  return result;
+}
+
+// Like `zydec_TranslateInstruction`, but only determines the capacity the translation requires (including the terminator).
+template <typename TPolicy>
+static bool zydec_MeasureInstruction(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, size_t *pRequiredCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo)
+{
+  if (pInstruction == nullptr || !zydec_HasRequiredOperands(pInstruction, pOperands, operandCount) || pRequiredCapacity == nullptr || pHasTranslation == nullptr)
+    return false;
+
+  char *bufferPos = nullptr; // Never written to.
+  size_t remainingSize = SIZE_MAX;
+
+  *pHasTranslation = true;
+
+  const bool result = zydec_TranslateInstructionToBuffer<TPolicy>(pInstruction, pOperands, virtualAddress, &bufferPos, &remainingSize, pHasTranslation, pInfo);
+
+  *pRequiredCapacity = SIZE_MAX - remainingSize + 1;
+
+  return result;
+}
+
+template <typename TEmitter>
+static size_t zydec_KernelIndex(const ZydecFormattingInfo *pInfo)
+{
+  if (pInfo == nullptr)
+    return 1 | 2;
+
+  return (pInfo->simplifyCommonShorthands ? 1 : 0) | (pInfo->simplifyValueSelfModification ? 2 : 0) | (TEmitter::AcceptsHints(pInfo) ? 4 : 0);
+}
+
+template <typename TEmitter>
+static ZydecKernelFunc *zydec_SelectKernel(const ZydecFormattingInfo *pInfo)
+{
+  static ZydecKernelFunc *const kernels[] = {
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, false, false, false>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, true, false, false>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, false, true, false>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, true, true, false>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, false, false, true>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, true, false, true>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, false, true, true>>,
+    zydec_TranslateInstruction<ZydecPolicy<TEmitter, true, true, true>>,
+  };
+
+  return kernels[zydec_KernelIndex<TEmitter>(pInfo)];
+}
+
+template <typename TEmitter>
+static ZydecMeasureKernelFunc *zydec_SelectMeasureKernel(const ZydecFormattingInfo *pInfo)
+{
+  static ZydecMeasureKernelFunc *const kernels[] = {
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, false, false, false>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, true, false, false>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, false, true, false>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, true, true, false>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, false, false, true>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, true, false, true>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, false, true, true>>,
+    zydec_MeasureInstruction<ZydecPolicy<TEmitter, true, true, true>>,
+  };
+
+  return kernels[zydec_KernelIndex<TEmitter>(pInfo)];
+}
+
+struct ZydecLinearContextFormatInfo;
+
+static bool zydec_MeasureOverflow(ZydecMeasureKernelFunc *pMeasureKernel, ZydecLinearContextFormatInfo *pFormatContextInfo, const uint64_t hashStateBefore, ZydecFormattingInfo *pInfo, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, const size_t bufferCapacity, size_t *pRequiredCapacity);
+
+bool zydec_TranslateInstructionWithoutContext(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo, size_t *pRequiredCapacity /* = nullptr */)
+{
+  if (pRequiredCapacity != nullptr)
+    *pRequiredCapacity = 0;
+
+  const bool result = zydec_SelectKernel<ZydecCallbackEmitter<ZydecTextSink>>(pInfo)(pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, pInfo);
+
+  if (!result && pRequiredCapacity != nullptr && pHasTranslation != nullptr && *pHasTranslation)
+    zydec_MeasureOverflow(zydec_SelectMeasureKernel<ZydecCallbackEmitter<ZydecMeasureSink>>(pInfo), nullptr, 0, pInfo, pInstruction, pOperands, operandCount, virtualAddress, bufferCapacity, pRequiredCapacity);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum ZydecRegisterSlot_ : size_t
+{
+  zrs_gpr = 0,
+  zrs_vector = zrs_gpr + 16,
+  zrs_mask = zrs_vector + 32,
+  zrs_mmx = zrs_mask + 8,
+  zrs_count = zrs_mmx + 8,
+
+  zrs_none = zrs_count,
+};
+
+static_assert(zrs_count == ZydecLinearContext::RegisterSlotCount, "Every register slot requires an entry in the linear context.");
+
+// Expects the register resolved by `zydec_ResolveBaseRegister`. Returns `zrs_none` for registers that aren't renamed.
+constexpr size_t zydec_LinearContext_RegisterSlot(const ZydisRegister reg)
+{
+  return
+    (reg >= ZYDIS_REGISTER_RAX && reg <= ZYDIS_REGISTER_R15) ? zrs_gpr + (reg - ZYDIS_REGISTER_RAX) :
+    (reg >= ZYDIS_REGISTER_XMM0 && reg <= ZYDIS_REGISTER_XMM31) ? zrs_vector + (reg - ZYDIS_REGISTER_XMM0) :
+    (reg >= ZYDIS_REGISTER_YMM0 && reg <= ZYDIS_REGISTER_YMM31) ? zrs_vector + (reg - ZYDIS_REGISTER_YMM0) :
+    (reg >= ZYDIS_REGISTER_ZMM0 && reg <= ZYDIS_REGISTER_ZMM31) ? zrs_vector + (reg - ZYDIS_REGISTER_ZMM0) :
+    (reg >= ZYDIS_REGISTER_K0 && reg <= ZYDIS_REGISTER_K7) ? zrs_mask + (reg - ZYDIS_REGISTER_K0) :
+    (reg >= ZYDIS_REGISTER_MM0 && reg <= ZYDIS_REGISTER_MM7) ? zrs_mmx + (reg - ZYDIS_REGISTER_MM0) :
+    zrs_none;
+}
+
+// Returns 0 (no name) for registers that aren't renamed.
+inline uint32_t zydec_LinearContext_GetRegisterName(const ZydecLinearContext *pContext, const ZydisRegister reg)
+{
+  const size_t slot = zydec_LinearContext_RegisterSlot(reg);
+
+  return slot == zrs_none ? 0 : pContext->regInfo[slot];
+}
+
+// `_` followed by one syllable per byte of the name.
+static constexpr size_t zydec_LinearContext_RegisterNameLength = 1 + sizeof(uint32_t) * 2;
+
+struct ZydecLinearContextFormatInfo
+{
+  ZydecLinearContext *pContext = nullptr;
+  ZydecFormattingInfo *pOriginalInfo = nullptr;
+  size_t assignedRegisterCount = 0;
+  size_t assignedRegisterSlot[8];
+  uint32_t assignedRegisterValue[8];
+
+  ZydisRegister regHint = ZYDIS_REGISTER_NONE;
+  ZydecFormattingInfo::HintOperation opHint = ZydecFormattingInfo::None;
+
+  bool hasValHint = false;
+  int64_t valHint = 0;
+
+  bool isCall = false;
+  uint64_t virtualAddress = 0; // Of the instruction being translated.
+
+  ZydecBlockIR *pRecordingBlockIR = nullptr; // Only set while building IR.
+
+  uint32_t writtenRegisterName = 0; // Of the last register that was written, so its token can tell renamed registers from plain ones.
+
+  // Register names rendered when they were assigned, by slot. An entry is only valid while its bit is set & it matches the name in the context.
+  uint64_t renderedRegisterSlots = 0;
+  uint32_t renderedRegisterName[zrs_count];
+  char renderedRegisterText[zrs_count][zydec_LinearContext_RegisterNameLength];
+};
+
+constexpr uint64_t zydec_LinearContext_SlotBit(const ZydisRegister reg)
+{
+  return (uint64_t)1 << zydec_LinearContext_RegisterSlot(reg);
+}
+
+static constexpr uint64_t zydec_LinearContext_RetainedAfterCallWindows =
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RBX) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RBP) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RDI) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RSI) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RSP) |
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R12) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R13) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R14) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R15) |
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM6) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM7) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM8) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM9) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM10) |
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM11) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM12) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM13) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM14) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_XMM15);
+
+static constexpr uint64_t zydec_LinearContext_RetainedAfterCallLinux =
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RBX) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RSP) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_RBP) |
+  zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R12) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R13) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R14) | zydec_LinearContext_SlotBit(ZYDIS_REGISTER_R15);
+
+static_assert(zrs_count <= 64, "Register retention masks require a bit per register slot.");
+
+// The register slots that keep their value across calls.
+static uint64_t zydec_LinearContext_RetainedAfterCall(const ZydecFormattingInfo *pOriginalInfo)
+{
+  switch (pOriginalInfo->afterCallRegisterRetentionMode)
+  {
+  case ZydecFormattingInfo::AfterCallRegisterRetentionMode::Windows:
+    return zydec_LinearContext_RetainedAfterCallWindows;
+
+  case ZydecFormattingInfo::AfterCallRegisterRetentionMode::Custom:
+    return pOriginalInfo->afterCallRetainedRegisters;
+
+  default:
+  case ZydecFormattingInfo::AfterCallRegisterRetentionMode::Linux:
+    return zydec_LinearContext_RetainedAfterCallLinux;
+  }
+}
+
+void zydec_LinearContext_AfterCall(void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  const uint64_t retained = zydec_LinearContext_RetainedAfterCall(pInfo->pOriginalInfo);
+
+  // Branchless, so compilers can turn it into a few masked vector clears.
+  uint32_t *pRegInfo = pInfo->pContext->regInfo;
+
+  for (size_t i = 0; i < zrs_count; i++)
+    pRegInfo[i] &= (uint32_t)0 - (uint32_t)((retained >> i) & 1);
+}
+
+uint64_t zydec_GetRegisterRetentionMask(const ZydisRegister *pRegisters, const size_t registerCount)
+{
+  uint64_t mask = 0;
+
+  if (pRegisters == nullptr)
+    return mask;
+
+  for (size_t i = 0; i < registerCount; i++)
+  {
+    const size_t slot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pRegisters[i]));
+
+    if (slot != zrs_none)
+      mask |= (uint64_t)1 << slot;
+  }
+
+  return mask;
+}
+
+uint32_t zydec_LinearContext_NextRegisterName(ZydecLinearContext *pContext)
+{
+  bool firstRun = true;
+  uint32_t ret;
+
+  while (true)
+  {
+    const uint64_t oldState = pContext->hashState;
+    pContext->hashState = oldState * 6364136223846793005ULL | 1;
+
+    const uint32_t xorshifted = (uint32_t)(((oldState >> 18) ^ oldState) >> 27);
+    const uint32_t rot = (uint32_t)(oldState >> 59);
+
+    ret = (xorshifted >> rot) | (xorshifted << (uint32_t)((-(int32_t)rot) & 31));
+
+    if (!firstRun || ret != 0)
+      break;
+
+    firstRun = false;
+  }
+  
+  return ret;
+}
+
+// Derives the name from where the value is defined rather than from the preceding instructions.
+uint32_t zydec_LinearContext_AddressSeededRegisterName(const uint64_t seed, const uint64_t virtualAddress, const size_t slot)
+{
+  uint64_t x = seed ^ (virtualAddress * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)(slot + 1) * 0xC2B2AE3D27D4EB4FULL);
+
+  // SplitMix64 finalizer.
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+
+  const uint32_t ret = (uint32_t)(x >> 32);
+
+  return ret != 0 ? ret : (uint32_t)x | 1;
+}
+
+void zydec_LinearContext_RenderRegisterName(char (&text)[zydec_LinearContext_RegisterNameLength], const uint32_t registerName)
+{
+  static const char syllables[256][3] = {
+    "ba", "ca", "da", "fa", "ga", "ha", "ja", "ka", "la", "ma", "na", "pa", "qa", "ra", "sa", "ta", "va", "wa", "xa", "ya", "za",
+    "be", "ce", "de", "fe", "ge", "he", "je", "ke", "le", "me", "ne", "pe", "qe", "re", "se", "te", "ve", "we", "xe", "ye", "ze",
+    "bi", "ci", "di", "fi", "gi", "hi", "ji", "ki", "li", "mi", "ni", "pi", "qi", "ri", "si", "ti", "vi", "wi", "xi", "yi", "zi",
+    "bo", "co", "do", "fo", "go", "ho", "jo", "ko", "lo", "mo", "no", "po", "qo", "ro", "so", "to", "vo", "wo", "xo", "yo", "zo",
+    "bu", "cu", "du", "fu", "gu", "hu", "ju", "ku", "lu", "mu", "nu", "pu", "qu", "ru", "su", "tu", "vu", "wu", "xu", "yu", "zu",
+    "Ba", "Ca", "Da", "Fa", "Ga", "Ha", "Ja", "Ka", "La", "Ma", "Na", "Pa", "Qa", "Ra", "Sa", "Ta", "Va", "Wa", "Xa", "Ya", "Za",
+    "Be", "Ce", "De", "Fe", "Ge", "He", "Je", "Ke", "Le", "Me", "Ne", "Pe", "Qe", "Re", "Se", "Te", "Ve", "We", "Xe", "Ye", "Ze",
+    "Bi", "Ci", "Di", "Fi", "Gi", "Hi", "Ji", "Ki", "Li", "Mi", "Ni", "Pi", "Qi", "Ri", "Si", "Ti", "Vi", "Wi", "Xi", "Yi", "Zi",
+    "Bo", "Co", "Do", "Fo", "Go", "Ho", "Jo", "Ko", "Lo", "Mo", "No", "Po", "Qo", "Ro", "So", "To", "Vo", "Wo", "Xo", "Yo", "Zo",
+    "Bu", "Cu", "Du", "Fu", "Gu", "Hu", "Ju", "Ku", "Lu", "Mu", "Nu", "Pu", "Qu", "Ru", "Su", "Tu", "Vu", "Wu", "Xu", "Yu", "Zu",
+    "a_", "b_", "c_", "d_", "e_", "f_", "g_", "h_", "i_", "j_", "k_", "l_", "m_", "n_", "o_", "p_", "q_", "r_", "s_", "t_", "u_", "v_", "w_", "x_", "y_", "z_",
+    "Ad", "An", "Sh", "In", "Cm", "Ab", "Bl", "Bs", "Ex", "6i", "7i", "9i", "4o", "6o", "7o", "9o", "4u", "6u", "7u", "9u",
+  };
+
+  constexpr size_t syllableLength = sizeof(syllables[0]) - 1;
+  static_assert(1 + sizeof(uint32_t) * syllableLength == zydec_LinearContext_RegisterNameLength, "Invalid register name length.");
+
+  text[0] = '_';
+
+  uint32_t val = registerName;
+
+  for (size_t i = 0; i < sizeof(uint32_t); i++)
+  {
+    memcpy(text + 1 + i * syllableLength, syllables[(uint8_t)(val & 0xFF)], syllableLength);
+    val >>= 8;
+  }
+}
+
+template <typename TSink>
+bool zydec_LinearContext_WriteRegisterName(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, const uint32_t registerName)
+{
+  if (!zydec_WriteRegisterRaw<TSink>(pBufferPos, pRemainingSize, reg))
+    return false;
+
+  if (registerName != 0)
+  {
+    char name[zydec_LinearContext_RegisterNameLength];
+    zydec_LinearContext_RenderRegisterName(name, registerName);
+
+    if (!TSink::Write(pBufferPos, pRemainingSize, name, sizeof(name)))
+      return false;
+  }
+
+  return true;
+}
+
+// Same as `zydec_LinearContext_WriteRegisterName`, but only renders names that aren't already in the cache of the format info.
+template <typename TSink>
+bool zydec_LinearContext_WriteCachedRegisterName(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, const uint32_t registerName, ZydecLinearContextFormatInfo *pInfo)
+{
+  if (!zydec_WriteRegisterRaw<TSink>(pBufferPos, pRemainingSize, reg))
+    return false;
+
+  pInfo->writtenRegisterName = registerName;
+
+  if (registerName == 0)
+    return true;
+
+  // Names are only ever non-zero for registers that have a slot.
+  const size_t slot = zydec_LinearContext_RegisterSlot(reg);
+
+  // Sinks that don't produce text only need the length.
+  if (TSink::ProducesText && (((pInfo->renderedRegisterSlots >> slot) & 1) == 0 || pInfo->renderedRegisterName[slot] != registerName))
+  {
+    zydec_LinearContext_RenderRegisterName(pInfo->renderedRegisterText[slot], registerName);
+    pInfo->renderedRegisterName[slot] = registerName;
+    pInfo->renderedRegisterSlots |= (uint64_t)1 << slot;
+  }
+
+  return TSink::Write(pBufferPos, pRemainingSize, pInfo->renderedRegisterText[slot], zydec_LinearContext_RegisterNameLength);
+}
+
+bool zydec_LinearContext_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+
+  return zydec_LinearContext_WriteCachedRegisterName<ZydecTextSink>(pBufferPos, pRemainingSize, reg, zydec_LinearContext_GetRegisterName(pInfo->pContext, reg), pInfo);
+}
+
+// Picks the name of a register that's being assigned to & applies it once the instruction has been translated.
+uint32_t zydec_LinearContext_AssignResultRegister(ZydecLinearContextFormatInfo *pInfo, const ZydisRegister reg)
+{
+  const size_t slot = zydec_LinearContext_RegisterSlot(reg);
+  uint32_t newName;
+
+  if (pInfo->pOriginalInfo->registerNaming == ZydecFormattingInfo::RegisterNaming::AddressSeeded)
+    newName = zydec_LinearContext_AddressSeededRegisterName(pInfo->pOriginalInfo->registerNamingSeed, pInfo->virtualAddress, slot);
+  else
+    newName = zydec_LinearContext_NextRegisterName(pInfo->pContext);
+
+  if (pInfo->regHint != ZYDIS_REGISTER_NONE)
+  {
+    ZydisRegister baseRegister = zydec_ResolveBaseRegister(pInfo->regHint);
+    const uint32_t hintedRegName = zydec_LinearContext_GetRegisterName(pInfo->pContext, baseRegister);
+
+    if (hintedRegName != 0)
+      newName = hintedRegName;
+  }
+  else if (pInfo->hasValHint && (pInfo->valHint == 0 || pInfo->valHint == (int64_t)-1))
+  {
+    if (pInfo->valHint == 0)
+    {
+      newName &= 0xFFFF0000;
+      newName |= 0xDDC7; // `Nul_`
+    }
+    else if (pInfo->valHint == (int64_t)-1)
+    {
+      newName &= 0xFFFF0000;
+      newName |= 0xDDC0; // `Ful_`
+    }
+  }
+  else if (pInfo->opHint != ZydecFormattingInfo::None)
+  {
+    switch (pInfo->opHint)
+    {
+    case ZydecFormattingInfo::Add:
+      newName &= 0xFFFF0000;
+      newName |= 0xD5EC; // `Add_`
+      break;
+
+    case ZydecFormattingInfo::Sub:
+      newName &= 0xFFFF0000;
+      newName |= 0xD3CB; // `Sub_`
+      break;
+
+    case ZydecFormattingInfo::Mul:
+      newName &= 0xFFFF0000;
+      newName |= 0xDDC6; // `Mul_`
+      break;
+
+    case ZydecFormattingInfo::Div:
+      newName &= 0xFFFF0000;
+      newName |= 0xE795; // `Div_`
+      break;
+
+    case ZydecFormattingInfo::Mod:
+      newName &= 0xFFFF0000;
+      newName |= 0xD5B1; // `Mod_`
+      break;
+
+    case ZydecFormattingInfo::And:
+      newName &= 0xFFFF0000;
+      newName |= 0xD5ED; // `And_`
+      break;
+
+    case ZydecFormattingInfo::AndNot:
+      newName &= 0xFFFF0000;
+      newName |= 0xE5ED; // `Ant_`
+      break;
+
+    case ZydecFormattingInfo::Or:
+      newName &= 0xFFFF0000;
+      newName |= 0xE33F; // `bor_`
+      break;
+
+    case ZydecFormattingInfo::XOr:
+      newName &= 0xFFFF0000;
+      newName |= 0xE351; // `xor_`
+      break;
+
+    case ZydecFormattingInfo::Neg:
+      newName &= 0xFFFF0000;
+      newName |= 0xD888; // `Neg_`
+      break;
+
+    case ZydecFormattingInfo::ShL:
+      newName &= 0xFFFF0000;
+      newName |= 0xDDEE; // `Shl_`
+      break;
+
+    case ZydecFormattingInfo::ShR:
+      newName &= 0xFFFF0000;
+      newName |= 0xE3EE; // `Shr_`
+      break;
+
+    case ZydecFormattingInfo::Inc:
+      newName &= 0xFFFF0000;
+      newName |= 0xD4EF; // `Inc_`
+      break;
+
+    case ZydecFormattingInfo::Dec:
+      newName &= 0xFFFF0000;
+      newName |= 0xD480; // `Dec_`
+      break;
+
+    case ZydecFormattingInfo::BitScanF:
+      newName &= 0xFFFF0000;
+      newName |= 0xD7F3; // `Bsf_`
+      break;
+
+    case ZydecFormattingInfo::BitScanR:
+      newName &= 0xFFFF0000;
+      newName |= 0xE3F3; // `Bsr_`
+      break;
+
+    case ZydecFormattingInfo::PopCnt:
+      newName &= 0xFFFF0000;
+      newName |= 0xE1B3; // `Pop_`
+      break;
+
+    case ZydecFormattingInfo::AddressOf:
+      newName &= 0xFFFF0000;
+      newName |= 0xD4B0; // `Loc_`
+      break;
+
+    case ZydecFormattingInfo::Mov:
+    case ZydecFormattingInfo::ConditionalMov:
+      newName &= 0xFFFF0000;
+      newName |= 0xE7B1; // `Mov_`
+      break;
+
+    case ZydecFormattingInfo::Set:
+      newName &= 0xFFFF0000;
+      newName |= 0xE58C; // `Set_`
+      break;
+
+    case ZydecFormattingInfo::Cmp:
+      newName &= 0xFFFF0000;
+      newName |= 0xE1F0; // `Cmp_`
+      break;
+
+    case ZydecFormattingInfo::Pack:
+    case ZydecFormattingInfo::Unpack:
+      newName &= 0xFFFF0000;
+      newName |= 0xDC74; // `Pak_`
+      break;
+
+    case ZydecFormattingInfo::Abs:
+      newName &= 0xFFFF0000;
+      newName |= 0xE4F1; // `Abs_`
+      break;
+
+    case ZydecFormattingInfo::Blend:
+      newName &= 0xFFFF0000;
+      newName |= 0xD5F2; // `Bld_`
+      break;
+
+    case ZydecFormattingInfo::Broadcast:
+      newName &= 0xFFFF0000;
+      newName |= 0xE5F3; // `Bst_`
+      break;
+
+    case ZydecFormattingInfo::Shuffle:
+      newName &= 0xFFFF0000;
+      newName |= 0xD7EE; // `Shf_`
+      break;
+
+    case ZydecFormattingInfo::Permute:
+      newName &= 0xFFFF0000;
+      newName |= 0xDE89; // `Pem_`
+      break;
+
+    case ZydecFormattingInfo::Round:
+      newName &= 0xFFFF0000;
+      newName |= 0xD5B5; // `Rod_`
+      break;
+
+    case ZydecFormattingInfo::Convert:
+      newName &= 0xFFFF0000;
+      newName |= 0xE7A9; // `Con_`
+      break;
+
+    case ZydecFormattingInfo::DotProduct:
+      newName &= 0xFFFF0000;
+      newName |= 0xE5AA; // `Dot_`
+      break;
+
+    case ZydecFormattingInfo::Extract:
+      newName &= 0xFFFF0000;
+      newName |= 0xE5F4; // `Ext_`
+      break;
+
+    case ZydecFormattingInfo::Gather:
+      newName &= 0xFFFF0000;
+      newName |= 0xE56D; // `Gat_`
+      break;
+
+    case ZydecFormattingInfo::Max:
+      newName &= 0xFFFF0000;
+      newName |= 0xE972; // `Max_`
+      break;
+
+    case ZydecFormattingInfo::Min:
+      newName &= 0xFFFF0000;
+      newName |= 0xDF9C; // `Min_`
+      break;
+
+    case ZydecFormattingInfo::Mask:
+      newName &= 0xFFFF0000;
+      newName |= 0xE472; // `Mas_`
+      break;
+
+    case ZydecFormattingInfo::Test:
+      newName &= 0xFFFF0000;
+      newName |= 0xE48D; // `Tes_`
+      break;
+
+    case ZydecFormattingInfo::Not:
+      newName &= 0xFFFF0000;
+      newName |= 0xE5B2; // `Not_`
+      break;
+
+    case ZydecFormattingInfo::XNor:
+      newName &= 0xFFFF0000;
+      newName |= 0x49E9; // `x_no`
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  if (slot == zrs_none)
+    return 0;
+
+  pInfo->assignedRegisterSlot[pInfo->assignedRegisterCount] = slot;
+  pInfo->assignedRegisterValue[pInfo->assignedRegisterCount] = newName;
+  pInfo->assignedRegisterCount++;
+
+  return newName;
+}
+
+bool zydec_LinearContext_WriteResultRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+
+  return zydec_LinearContext_WriteCachedRegisterName<ZydecTextSink>(pBufferPos, pRemainingSize, reg, zydec_LinearContext_AssignResultRegister(pInfo, reg), pInfo);
+}
+
+void zydec_LinearContext_HintRegister(const ZydisRegister reg, void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  pInfo->regHint = reg;
+}
+
+void zydec_LinearContext_HintValue(const int64_t value, void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  pInfo->hasValHint = true;
+  pInfo->valHint = value;
+}
+
+void zydec_LinearContext_HintOperation(const ZydecFormattingInfo::HintOperation operation, void *pUserData)
+{
+  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  pInfo->opHint = operation;
+}
+
+// Calls the linear context directly rather than through the callbacks in `ZydecFormattingInfo`.
+template <typename TSink>
+struct ZydecLinearContextEmitter : TSink
+{
+  static bool AcceptsHints(const ZydecFormattingInfo *pInfo)
+  {
+    return pInfo->acceptHints;
+  }
+
+  static bool WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    ZydecLinearContextFormatInfo *pFormatContextInfo = static_cast<ZydecLinearContextFormatInfo *>(pInfo->pRegUserData);
+
+    return zydec_LinearContext_WriteCachedRegisterName<TSink>(pBufferPos, pRemainingSize, reg, zydec_LinearContext_GetRegisterName(pFormatContextInfo->pContext, reg), pFormatContextInfo);
+  }
+
+  static bool WriteResultRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    ZydecLinearContextFormatInfo *pFormatContextInfo = static_cast<ZydecLinearContextFormatInfo *>(pInfo->pRegUserData);
+
+    return zydec_LinearContext_WriteCachedRegisterName<TSink>(pBufferPos, pRemainingSize, reg, zydec_LinearContext_AssignResultRegister(pFormatContextInfo, reg), pFormatContextInfo);
+  }
+
+  // Registers without a slot (like segments) & the ones that haven't been named yet are written as they are.
+  static ZydecTokenKind RegisterTokenKind(const ZydecFormattingInfo *pInfo, const bool)
+  {
+    return static_cast<const ZydecLinearContextFormatInfo *>(pInfo->pRegUserData)->writtenRegisterName != 0 ? ZydecTokenKind::RenamedRegister : ZydecTokenKind::Register;
+  }
+
+  static void HintRegister(const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    zydec_LinearContext_HintRegister(reg, pInfo->pRegUserData);
+  }
+
+  static void HintValue(const int64_t value, ZydecFormattingInfo *pInfo)
+  {
+    zydec_LinearContext_HintValue(value, pInfo->pRegUserData);
+  }
+
+  static void HintOperation(const ZydecFormattingInfo::HintOperation op, ZydecFormattingInfo *pInfo)
+  {
+    zydec_LinearContext_HintOperation(op, pInfo->pRegUserData);
+  }
+
+  static void AfterCall(ZydecFormattingInfo *pInfo)
+  {
+    // Applied with the register assignments once the instruction has been translated.
+    static_cast<ZydecLinearContextFormatInfo *>(pInfo->pCallUserData)->isCall = true;
+  }
+};
+
+static bool zydec_BlockIR_AddRegisterName(ZydecBlockIR *pBlockIR, const uint32_t registerName);
+
+// Records the register names picked by the linear context instead of writing them.
+struct ZydecLinearContextRecordingEmitter : ZydecLinearContextEmitter<ZydecNullSink>
+{
+  static bool WriteRegister(char **, size_t *, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    const ZydecLinearContextFormatInfo *pFormatContextInfo = static_cast<const ZydecLinearContextFormatInfo *>(pInfo->pRegUserData);
+
+    return zydec_BlockIR_AddRegisterName(pFormatContextInfo->pRecordingBlockIR, zydec_LinearContext_GetRegisterName(pFormatContextInfo->pContext, reg));
+  }
+
+  static bool WriteResultRegister(char **, size_t *, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    ZydecLinearContextFormatInfo *pFormatContextInfo = static_cast<ZydecLinearContextFormatInfo *>(pInfo->pRegUserData);
+
+    return zydec_BlockIR_AddRegisterName(pFormatContextInfo->pRecordingBlockIR, zydec_LinearContext_AssignResultRegister(pFormatContextInfo, reg));
+  }
+};
+
+// Returns the kernel to translate instructions with.
+static ZydecKernelFunc *zydec_LinearContext_PrepareFormattingInfo(ZydecLinearContextFormatInfo *pFormatContextInfo, ZydecFormattingInfo *pNewInfo, ZydecLinearContext *pContext, ZydecFormattingInfo *pInfo)
+{
+  pFormatContextInfo->pContext = pContext;
+  pFormatContextInfo->pOriginalInfo = pInfo;
+
+  *pNewInfo = *pInfo;
+  pNewInfo->simplifyValueSelfModification = false;
+  pNewInfo->pRegUserData = pNewInfo->pCallUserData = pFormatContextInfo;
+  pNewInfo->pWriteRegister = zydec_LinearContext_WriteRegister;
+  pNewInfo->pWriteResultRegister = zydec_LinearContext_WriteResultRegister;
+  pNewInfo->pAfterCall = zydec_LinearContext_AfterCall;
+
+  pNewInfo->pSetHintReg = zydec_LinearContext_HintRegister;
+  pNewInfo->pSetHintVal = zydec_LinearContext_HintValue;
+  pNewInfo->pSetHintOp = zydec_LinearContext_HintOperation;
+
+  return zydec_SelectKernel<ZydecLinearContextEmitter<ZydecTextSink>>(pNewInfo);
+}
+
+// Hints and assignments only apply to a single instruction.
+static void zydec_LinearContext_BeginInstruction(ZydecLinearContextFormatInfo *pFormatContextInfo, const uint64_t virtualAddress)
+{
+  pFormatContextInfo->virtualAddress = virtualAddress;
+  pFormatContextInfo->assignedRegisterCount = 0;
+  pFormatContextInfo->regHint = ZYDIS_REGISTER_NONE;
+  pFormatContextInfo->opHint = ZydecFormattingInfo::None;
+  pFormatContextInfo->hasValHint = false;
+  pFormatContextInfo->valHint = 0;
+  pFormatContextInfo->isCall = false;
+}
+
+// Applies the register assignments of the translated instruction to the context.
+static void zydec_LinearContext_EndInstruction(ZydecLinearContextFormatInfo *pFormatContextInfo)
+{
+  for (size_t i = 0; i < pFormatContextInfo->assignedRegisterCount; i++)
+    pFormatContextInfo->pContext->regInfo[pFormatContextInfo->assignedRegisterSlot[i]] = pFormatContextInfo->assignedRegisterValue[i];
+
+  if (pFormatContextInfo->isCall)
+    zydec_LinearContext_AfterCall(pFormatContextInfo);
+}
+
+static bool zydec_LinearContext_TranslateInstruction(ZydecKernelFunc *pKernel, ZydecLinearContextFormatInfo *pFormatContextInfo, ZydecFormattingInfo *pNewInfo, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
+{
+  zydec_LinearContext_BeginInstruction(pFormatContextInfo, virtualAddress);
+
+  const bool result = pKernel(pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, pNewInfo);
+
+  zydec_LinearContext_EndInstruction(pFormatContextInfo);
+
+  return result;
+}
+
+// Finds out whether a failed translation merely didn't fit into the buffer. If so, `*pRequiredCapacity` receives the capacity it requires & the linear context (if any) is left as it was before the instruction.
+// Otherwise the instruction has been translated again without text, so the assignments of the linear context can be applied as usual.
+static bool zydec_MeasureOverflow(ZydecMeasureKernelFunc *pMeasureKernel, ZydecLinearContextFormatInfo *pFormatContextInfo, const uint64_t hashStateBefore, ZydecFormattingInfo *pInfo, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, const size_t bufferCapacity, size_t *pRequiredCapacity)
+{
+  if (pFormatContextInfo != nullptr)
+  {
+    pFormatContextInfo->pContext->hashState = hashStateBefore;
+    zydec_LinearContext_BeginInstruction(pFormatContextInfo, virtualAddress);
+  }
+
+  size_t requiredCapacity = 0;
+  bool hasTranslation = false;
+
+  if (!pMeasureKernel(pInstruction, pOperands, operandCount, virtualAddress, &requiredCapacity, &hasTranslation, pInfo) || requiredCapacity <= bufferCapacity)
+    return false;
+
+  if (pFormatContextInfo != nullptr)
+    pFormatContextInfo->pContext->hashState = hashStateBefore;
+
+  *pRequiredCapacity = requiredCapacity;
+
+  return true;
+}
+
+bool zydec_TranslateInstructionWithLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo, size_t *pRequiredCapacity /* = nullptr */)
+{
+  ZydecLinearContextFormatInfo formatContextInfo;
+  ZydecFormattingInfo newInfo;
+  ZydecKernelFunc *pKernel = zydec_LinearContext_PrepareFormattingInfo(&formatContextInfo, &newInfo, pContext, pInfo);
+
+  if (pRequiredCapacity == nullptr)
+    return zydec_LinearContext_TranslateInstruction(pKernel, &formatContextInfo, &newInfo, pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation);
+
+  *pRequiredCapacity = 0;
+
+  const uint64_t hashStateBefore = pContext->hashState;
+
+  zydec_LinearContext_BeginInstruction(&formatContextInfo, virtualAddress);
+
+  const bool result = pKernel(pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, &newInfo);
+
+  // Leave the context untouched, so the translation can be retried with a large enough buffer.
+  if (!result && pHasTranslation != nullptr && *pHasTranslation && zydec_MeasureOverflow(zydec_SelectMeasureKernel<ZydecLinearContextEmitter<ZydecMeasureSink>>(&newInfo), &formatContextInfo, hashStateBefore, &newInfo, pInstruction, pOperands, operandCount, virtualAddress, bufferCapacity, pRequiredCapacity))
+    return false;
+
+  zydec_LinearContext_EndInstruction(&formatContextInfo);
+
+  return result;
+}
+
+bool zydec_AdvanceLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, ZydecFormattingInfo *pInfo)
+{
+  if (pContext == nullptr || pInfo == nullptr)
+    return false;
+
+  ZydecLinearContextFormatInfo formatContextInfo;
+  ZydecFormattingInfo newInfo;
+  zydec_LinearContext_PrepareFormattingInfo(&formatContextInfo, &newInfo, pContext, pInfo);
+
+  char buffer[1]; // Only receives the terminator.
+  bool hasTranslation = false;
+
+  return zydec_LinearContext_TranslateInstruction(zydec_SelectKernel<ZydecLinearContextEmitter<ZydecNullSink>>(&newInfo), &formatContextInfo, &newInfo, pInstruction, pOperands, operandCount, virtualAddress, buffer, sizeof(buffer), &hasTranslation) || !hasTranslation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static constexpr size_t zydec_Unrolled_MinInstructionCount = 2; // Per copy.
+static constexpr size_t zydec_Unrolled_MaxInstructionCount = 32; // Per copy.
+static constexpr size_t zydec_Unrolled_MinCollapsedInstructionCount = 6; // Over all copies, so two short copies that merely happen to look alike stay as they are.
+
+struct ZydecUnrolledOperand
+{
+  uint8_t type;
+  uint16_t size;
+  uint8_t scale;
+  uint16_t reg; // Of register operands or the base of memory operands.
+  uint16_t index;
+  uint16_t segment;
+  int64_t value; // Of immediates or the displacement of memory operands.
+  size_t sources[2]; // The instructions that last wrote `reg` & `index` in the block if they're read, `SIZE_MAX` otherwise.
+  bool readsRegister; // Register operands that are read, memory operands always read their base & index.
+};
+
+struct ZydecUnrolledInstruction
+{
+  uint16_t mnemonic;
+  uint8_t operandCount;
+  bool isBarrier; // Branches, calls & returns can't be part of a group.
+  ZydecUnrolledOperand operands[ZYDIS_MAX_OPERAND_COUNT_VISIBLE];
+};
+
+struct ZydecUnrolledGroup
+{
+  size_t firstInstruction; // Counted from the start of the code the groups were collected from.
+  size_t instructionCount; // Per copy.
+  size_t copyCount;
+  size_t annotationOffset; // Into `ZydecUnrolledGroups::pAnnotations`.
+  size_t annotationLength;
+};
+
+// The groups of consecutive copies of the same instructions in the blocks of some code, see `ZydecFormattingInfo::collapseUnrolledGroups`.
+struct ZydecUnrolledGroups
+{
+  ZydecUnrolledGroup *pGroups; // Ascending.
+  size_t groupCount;
+  size_t groupCapacity;
+
+  char *pAnnotations; // `// x3 unrolled (lanes: ...)` per group.
+  size_t annotationSize;
+  size_t annotationCapacity;
+
+  ZydecUnrolledInstruction *pInstructions; // Of the block that's currently being collected.
+  size_t instructionCapacity;
+};
+
+enum ZydecUnrolledRole
+{
+  zur_none, // Translated as usual.
+  zur_annotate, // The last instruction of the first copy, which carries the annotation.
+  zur_collapse, // Part of a repeated copy, only applied to the linear context.
+};
+
+// Walks the groups along with the instructions of the code.
+struct ZydecUnrolledCursor
+{
+  const ZydecUnrolledGroups *pGroups = nullptr;
+  size_t nextGroup = 0;
+  size_t instructionIndex = 0;
+};
+
+template <typename T>
+static bool zydec_Unrolled_Reserve(T **ppItems, size_t *pCapacity, const size_t count)
+{
+  if (count <= *pCapacity)
+    return true;
+
+  size_t newCapacity = *pCapacity == 0 ? 64 : *pCapacity * 2;
+
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  T *pItems = reinterpret_cast<T *>(realloc(*ppItems, sizeof(T) * newCapacity));
+
+  if (pItems == nullptr)
+    return false;
+
+  *ppItems = pItems;
+  *pCapacity = newCapacity;
+
+  return true;
+}
+
+static void zydec_Unrolled_DescribeInstruction(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t instructionIndex, size_t *pLastWriters, ZydecUnrolledInstruction *pDescription)
+{
+  pDescription->mnemonic = (uint16_t)pInstruction->mnemonic;
+  pDescription->operandCount = pInstruction->operand_count_visible;
+
+  switch (pInstruction->meta.category)
+  {
+  case ZYDIS_CATEGORY_CALL:
+  case ZYDIS_CATEGORY_RET:
+  case ZYDIS_CATEGORY_COND_BR:
+  case ZYDIS_CATEGORY_UNCOND_BR:
+  case ZYDIS_CATEGORY_SYSCALL:
+  case ZYDIS_CATEGORY_INTERRUPT:
+    pDescription->isBarrier = true;
+    break;
+
+  default:
+    pDescription->isBarrier = false;
+    break;
+  }
+
+  // Sources are resolved before the writes of the instruction itself.
+  for (size_t i = 0; i < pInstruction->operand_count_visible; i++)
+  {
+    const ZydisDecodedOperand *pOperand = &pOperands[i];
+    ZydecUnrolledOperand *pDescribed = &pDescription->operands[i];
+
+    *pDescribed = ZydecUnrolledOperand();
+    pDescribed->type = (uint8_t)pOperand->type;
+    pDescribed->size = pOperand->size;
+    pDescribed->sources[0] = SIZE_MAX;
+    pDescribed->sources[1] = SIZE_MAX;
+
+    switch (pOperand->type)
+    {
+    case ZYDIS_OPERAND_TYPE_REGISTER:
+    {
+      const size_t slot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->reg.value));
+      pDescribed->reg = (uint16_t)pOperand->reg.value;
+
+      pDescribed->readsRegister = (pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_READ) != 0;
+
+      if (pDescribed->readsRegister && slot != zrs_none)
+        pDescribed->sources[0] = pLastWriters[slot];
+
+      break;
+    }
+
+    case ZYDIS_OPERAND_TYPE_MEMORY:
+    {
+      const size_t baseSlot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->mem.base));
+      const size_t indexSlot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->mem.index));
+
+      pDescribed->reg = (uint16_t)pOperand->mem.base;
+      pDescribed->index = (uint16_t)pOperand->mem.index;
+      pDescribed->segment = (uint16_t)pOperand->mem.segment;
+      pDescribed->scale = pOperand->mem.scale;
+      pDescribed->value = pOperand->mem.disp.value;
+      pDescribed->sources[0] = baseSlot != zrs_none ? pLastWriters[baseSlot] : SIZE_MAX;
+      pDescribed->sources[1] = indexSlot != zrs_none ? pLastWriters[indexSlot] : SIZE_MAX;
+      pDescribed->readsRegister = true;
+
+      break;
+    }
+
+    case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+      pDescribed->value = pOperand->imm.value.s;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < pInstruction->operand_count; i++)
+  {
+    const ZydisDecodedOperand *pOperand = &pOperands[i];
+
+    if (pOperand->type != ZYDIS_OPERAND_TYPE_REGISTER || (pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_WRITE) == 0)
+      continue;
+
+    const size_t slot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->reg.value));
+
+    if (slot != zrs_none)
+      pLastWriters[slot] = instructionIndex;
+  }
+}
+
+// Sources within the copy are compared by their position in the copy. Values from before the group are shared inputs, values of earlier copies must continue the register the first copy read from before the group (like an accumulator or a pointer that's advanced).
+// Software pipelined copies, that read what the previous copy produced in another register, therefore don't count as copies.
+inline bool zydec_Unrolled_IsSameSource(const size_t sourceA, const size_t sourceB, const ZydisRegister registerA, const ZydisRegister registerB, const size_t first, const size_t copy)
+{
+  // The first copy can only read from within itself or from before the group.
+  const size_t relativeA = sourceA != SIZE_MAX && sourceA >= first ? sourceA - first : SIZE_MAX;
+
+  if (sourceB != SIZE_MAX && sourceB >= copy)
+    return relativeA == sourceB - copy;
+
+  if (relativeA != SIZE_MAX)
+    return false;
+
+  return sourceB == SIZE_MAX || sourceB < first || zydec_ResolveBaseRegister(registerA) == zydec_ResolveBaseRegister(registerB);
+}
+
+static bool zydec_Unrolled_IsCopy(const ZydecUnrolledInstruction *pInstructions, const size_t first, const size_t copy, const size_t instructionCount)
+{
+  for (size_t i = 0; i < instructionCount; i++)
+  {
+    const ZydecUnrolledInstruction *pA = &pInstructions[first + i];
+    const ZydecUnrolledInstruction *pB = &pInstructions[copy + i];
+
+    if (pA->mnemonic != pB->mnemonic || pA->operandCount != pB->operandCount || pA->isBarrier || pB->isBarrier)
+      return false;
+
+    for (size_t j = 0; j < pA->operandCount; j++)
+    {
+      const ZydecUnrolledOperand *pOperandA = &pA->operands[j];
+      const ZydecUnrolledOperand *pOperandB = &pB->operands[j];
+
+      if (pOperandA->type != pOperandB->type || pOperandA->size != pOperandB->size || pOperandA->scale != pOperandB->scale || pOperandA->segment != pOperandB->segment)
+        return false;
+
+      if (ZydisRegisterGetClass((ZydisRegister)pOperandA->reg) != ZydisRegisterGetClass((ZydisRegister)pOperandB->reg) || (pOperandA->index == ZYDIS_REGISTER_NONE) != (pOperandB->index == ZYDIS_REGISTER_NONE))
+        return false;
+
+      for (size_t k = 0; k < 2; k++)
+        if (!zydec_Unrolled_IsSameSource(pOperandA->sources[k], pOperandB->sources[k], (ZydisRegister)(k == 0 ? pOperandA->reg : pOperandA->index), (ZydisRegister)(k == 0 ? pOperandB->reg : pOperandB->index), first, copy))
+          return false;
+    }
+  }
+
+  return true;
+}
+
+enum ZydecUnrolledLanePart
+{
+  zulp_register,
+  zulp_index,
+  zulp_value,
+};
+
+inline bool zydec_Unrolled_LanePartDiffers(const ZydecUnrolledOperand *pA, const ZydecUnrolledOperand *pB, const ZydecUnrolledLanePart part)
+{
+  switch (part)
+  {
+  case zulp_register: return pA->reg != pB->reg;
+  case zulp_index: return pA->index != pB->index;
+  default: return pA->value != pB->value;
+  }
+}
+
+// What tells the copies of a group apart.
+struct ZydecUnrolledLane
+{
+  size_t instruction = SIZE_MAX; // Within the copy, `SIZE_MAX` if the copies are identical.
+  size_t operand = 0;
+  ZydecUnrolledLanePart part = zulp_register;
+  int64_t stride = 0; // Of the other displacements, 0 if they're the same in every copy.
+};
+
+// Finds the lanes, the first register or constant that tells the copies apart. Every other difference has to follow from them, so nothing is lost by only translating the first copy:
+// Registers may only differ if they're written or hold a value of the copy itself, displacements may only advance by the same stride with every copy. Immediates have to match.
+static bool zydec_Unrolled_FindLane(const ZydecUnrolledInstruction *pInstructions, const size_t first, const size_t instructionCount, const size_t copyCount, ZydecUnrolledLane *pLane)
+{
+  *pLane = ZydecUnrolledLane();
+
+  for (size_t i = 0; i < instructionCount; i++)
+  {
+    const ZydecUnrolledInstruction *pFirst = &pInstructions[first + i];
+
+    for (size_t j = 0; j < pFirst->operandCount; j++)
+    {
+      const ZydecUnrolledOperand *pOperand = &pFirst->operands[j];
+
+      for (size_t part = zulp_register; part <= zulp_value; part++)
+      {
+        bool differs = false;
+
+        for (size_t k = 1; k < copyCount && !differs; k++)
+          differs = zydec_Unrolled_LanePartDiffers(pOperand, &pInstructions[first + k * instructionCount + i].operands[j], (ZydecUnrolledLanePart)part);
+
+        if (!differs)
+          continue;
+
+        if (pLane->instruction == SIZE_MAX)
+        {
+          pLane->instruction = i;
+          pLane->operand = j;
+          pLane->part = (ZydecUnrolledLanePart)part;
+          continue;
+        }
+
+        if (part != zulp_value)
+        {
+          const size_t source = pOperand->sources[part == zulp_register ? 0 : 1];
+
+          if (!pOperand->readsRegister || (source != SIZE_MAX && source >= first))
+            continue;
+
+          return false; // Different inputs.
+        }
+
+        if (pOperand->type != ZYDIS_OPERAND_TYPE_MEMORY)
+          return false;
+
+        // Computed without overflow, just like the address.
+        const uint64_t stride = (uint64_t)pInstructions[first + instructionCount + i].operands[j].value - (uint64_t)pOperand->value;
+
+        for (size_t k = 2; k < copyCount; k++)
+          if ((uint64_t)pInstructions[first + k * instructionCount + i].operands[j].value != (uint64_t)pOperand->value + k * stride)
+            return false;
+
+        if (pLane->stride != 0 && (uint64_t)pLane->stride != stride)
+          return false;
+
+        pLane->stride = (int64_t)stride;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Writes `// x3 unrolled (lanes: ...)` & the stride of the other displacements as ` (stride: 8)`.
+static bool zydec_Unrolled_WriteAnnotation(char **pBufferPos, size_t *pRemainingSize, const ZydecUnrolledInstruction *pInstructions, const ZydecUnrolledGroup *pGroup, const ZydecUnrolledLane *pLane)
+{
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "// x"));
+  ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, pGroup->copyCount));
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " unrolled"));
+
+  if (pLane->instruction == SIZE_MAX)
+    return true; // The copies are identical.
+
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " (lanes: "));
+
+  for (size_t k = 0; k < pGroup->copyCount; k++)
+  {
+    const ZydecUnrolledOperand *pOperand = &pInstructions[pGroup->firstInstruction + k * pGroup->instructionCount + pLane->instruction].operands[pLane->operand];
+
+    if (k != 0)
+      ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, ", "));
+
+    if (pLane->part == zulp_value)
+      ERROR_CHECK(zydec_WriteInt<ZydecTextSink>(pBufferPos, pRemainingSize, pOperand->value));
+    else if ((pLane->part == zulp_register ? pOperand->reg : pOperand->index) == ZYDIS_REGISTER_NONE)
+      ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "-"));
+    else
+      ERROR_CHECK(zydec_WriteRegisterRaw<ZydecTextSink>(pBufferPos, pRemainingSize, (ZydisRegister)(pLane->part == zulp_register ? pOperand->reg : pOperand->index)));
+  }
+
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, ")"));
+
+  if (pLane->stride != 0)
+  {
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " (stride: "));
+    ERROR_CHECK(zydec_WriteInt<ZydecTextSink>(pBufferPos, pRemainingSize, pLane->stride));
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, ")"));
+  }
+
+  return true;
+}
+
+static bool zydec_Unrolled_AddGroup(ZydecUnrolledGroups *pGroups, const size_t instructionOffset, const size_t first, const size_t instructionCount, const size_t copyCount, const ZydecUnrolledLane *pLane)
+{
+  constexpr size_t MaxLaneLength = 24; // A register name or a 64 bit integer & the separator.
+  const size_t maxAnnotationLength = 96 + copyCount * MaxLaneLength;
+
+  if (!zydec_Unrolled_Reserve(&pGroups->pGroups, &pGroups->groupCapacity, pGroups->groupCount + 1) || !zydec_Unrolled_Reserve(&pGroups->pAnnotations, &pGroups->annotationCapacity, pGroups->annotationSize + maxAnnotationLength))
+    return false;
+
+  ZydecUnrolledGroup *pGroup = &pGroups->pGroups[pGroups->groupCount];
+  pGroup->firstInstruction = first;
+  pGroup->instructionCount = instructionCount;
+  pGroup->copyCount = copyCount;
+  pGroup->annotationOffset = pGroups->annotationSize;
+
+  char *bufferPos = pGroups->pAnnotations + pGroups->annotationSize;
+  size_t remainingSize = maxAnnotationLength;
+
+  if (!zydec_Unrolled_WriteAnnotation(&bufferPos, &remainingSize, pGroups->pInstructions, pGroup, pLane))
+    return false;
+
+  pGroup->annotationLength = maxAnnotationLength - remainingSize;
+  pGroup->firstInstruction += instructionOffset;
+  pGroups->annotationSize += pGroup->annotationLength;
+  pGroups->groupCount++;
+
+  return true;
+}
+
+// Collects the groups of a single block of straight line code. Group indices start at `instructionOffset`.
+static bool zydec_Unrolled_CollectBlock(ZydecUnrolledGroups *pGroups, const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const size_t instructionOffset)
+{
+  size_t lastWriters[zrs_count];
+
+  for (size_t i = 0; i < zrs_count; i++)
+    lastWriters[i] = SIZE_MAX;
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t instructionCount = 0;
+  size_t codeOffset = 0;
+
+  while (codeOffset < size)
+  {
+    if (!zydec_DecodeInstruction(pDecoder, pCode + codeOffset, size - codeOffset, &instruction, operands, true))
+      return false;
+
+    if (!zydec_Unrolled_Reserve(&pGroups->pInstructions, &pGroups->instructionCapacity, instructionCount + 1))
+      return false;
+
+    zydec_Unrolled_DescribeInstruction(&instruction, operands, instructionCount, lastWriters, &pGroups->pInstructions[instructionCount]);
+
+    instructionCount++;
+    codeOffset += instruction.length;
+  }
+
+  // Takes the period that covers the most instructions at every position, the shortest one if they cover the same.
+  for (size_t first = 0; first < instructionCount;)
+  {
+    size_t bestInstructionCount = 0;
+    size_t bestCopyCount = 0;
+    ZydecUnrolledLane bestLane;
+
+    for (size_t period = zydec_Unrolled_MinInstructionCount; period <= zydec_Unrolled_MaxInstructionCount && first + period * 2 <= instructionCount; period++)
+    {
+      if (pGroups->pInstructions[first + period - 1].isBarrier)
+        break;
+
+      size_t copyCount = 1;
+
+      while (first + (copyCount + 1) * period <= instructionCount && zydec_Unrolled_IsCopy(pGroups->pInstructions, first, first + copyCount * period, period))
+        copyCount++;
+
+      // Copies that differ in ways the annotation can't express are left as they are.
+      ZydecUnrolledLane lane;
+
+      while (copyCount > 1 && !zydec_Unrolled_FindLane(pGroups->pInstructions, first, period, copyCount, &lane))
+        copyCount--;
+
+      if (copyCount > 1 && copyCount * period >= zydec_Unrolled_MinCollapsedInstructionCount && copyCount * period > bestCopyCount * bestInstructionCount)
+      {
+        bestInstructionCount = period;
+        bestCopyCount = copyCount;
+        bestLane = lane;
+      }
+    }
+
+    if (bestCopyCount == 0)
+    {
+      first++;
+      continue;
+    }
+
+    if (!zydec_Unrolled_AddGroup(pGroups, instructionOffset, first, bestInstructionCount, bestCopyCount, &bestLane))
+      return false;
+
+    first += bestInstructionCount * bestCopyCount;
+  }
+
+  return true;
+}
+
+static void zydec_Unrolled_Destroy(ZydecUnrolledGroups **ppGroups)
+{
+  if (ppGroups == nullptr || *ppGroups == nullptr)
+    return;
+
+  free((*ppGroups)->pGroups);
+  free((*ppGroups)->pAnnotations);
+  free((*ppGroups)->pInstructions);
+
+  delete *ppGroups;
+  *ppGroups = nullptr;
+}
+
+// Collects the groups of all of the code as a single block, branches merely end groups.
+static bool zydec_Unrolled_Create(ZydecUnrolledGroups **ppGroups, const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size)
+{
+  if (ppGroups == nullptr || pDecoder == nullptr || pCode == nullptr)
+    return false;
+
+  ZydecUnrolledGroups *pGroups = new (std::nothrow) ZydecUnrolledGroups();
+
+  if (pGroups == nullptr)
+    return false;
+
+  if (!zydec_Unrolled_CollectBlock(pGroups, pDecoder, pCode, size, 0))
+  {
+    zydec_Unrolled_Destroy(&pGroups);
+    return false;
+  }
+
+  *ppGroups = pGroups;
+
+  return true;
+}
+
+// The role of the next instruction, `pAnnotation` receives the annotation of `zur_annotate`.
+static ZydecUnrolledRole zydec_Unrolled_Next(ZydecUnrolledCursor *pCursor, ZydecString *pAnnotation)
+{
+  const size_t index = pCursor->instructionIndex++;
+
+  if (pCursor->pGroups == nullptr)
+    return zur_none;
+
+  while (pCursor->nextGroup < pCursor->pGroups->groupCount)
+  {
+    const ZydecUnrolledGroup *pGroup = &pCursor->pGroups->pGroups[pCursor->nextGroup];
+
+    if (index < pGroup->firstInstruction)
+      return zur_none;
+
+    const size_t offset = index - pGroup->firstInstruction;
+
+    if (offset >= pGroup->instructionCount * pGroup->copyCount)
+    {
+      pCursor->nextGroup++;
+      continue;
+    }
+
+    if (offset >= pGroup->instructionCount)
+      return zur_collapse;
+
+    if (offset + 1 < pGroup->instructionCount)
+      return zur_none;
+
+    *pAnnotation = ZydecString(pCursor->pGroups->pAnnotations + pGroup->annotationOffset, pGroup->annotationLength);
+
+    return zur_annotate;
+  }
+
+  return zur_none;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Calls `translate` for every instruction and lays out the results in `pArena`.
+template <typename TTranslateFunc>
+static bool zydec_TranslateBlockToArena(const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, const bool allOperands, TTranslateFunc translate)
+{
+  if (pCode == nullptr || pArena == nullptr || arenaCapacity == 0 || pOffsets == nullptr || pInstructionCount == nullptr)
+    return false;
+
+  *pInstructionCount = 0;
+  pArena[0] = '\0';
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t codeOffset = 0;
+  size_t arenaOffset = 0;
+
+  while (codeOffset < size)
+  {
+    if (*pInstructionCount == offsetCapacity || arenaOffset == arenaCapacity)
+      return false;
+
+    if (!zydec_DecodeInstruction(pDecoder, pCode + codeOffset, size - codeOffset, &instruction, operands, allOperands))
+      return false;
+
+    char *line = pArena + arenaOffset;
+    bool hasTranslation = false;
+
+    if (!translate(&instruction, operands, (size_t)(baseAddress + codeOffset), line, arenaCapacity - arenaOffset, &hasTranslation) && hasTranslation)
+      return false; // Out of arena space.
+
+    if (!hasTranslation)
+      line[0] = '\0';
+
+    pOffsets[*pInstructionCount] = arenaOffset;
+    (*pInstructionCount)++;
+
+    arenaOffset += strlen(line) + 1;
+    codeOffset += instruction.length;
+  }
+
+  return true;
+}
+
+// Sums up the arena capacity `zydec_TranslateBlock` requires for the code, advancing the linear context just like the translation.
+static bool zydec_LinearContext_MeasureBlock(const ZydisDecoder *pDecoder, ZydecLinearContextFormatInfo *pFormatContextInfo, ZydecFormattingInfo *pNewInfo, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, size_t *pRequiredArenaCapacity)
+{
+  ZydecMeasureKernelFunc *pMeasureKernel = zydec_SelectMeasureKernel<ZydecLinearContextEmitter<ZydecMeasureSink>>(pNewInfo);
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t codeOffset = 0;
+  *pRequiredArenaCapacity = 0;
+
+  while (codeOffset < size)
+  {
+    if (!zydec_DecodeInstruction(pDecoder, pCode + codeOffset, size - codeOffset, &instruction, operands, false))
+      return false;
+
+    size_t requiredCapacity = 0;
+    bool hasTranslation = false;
+
+    zydec_LinearContext_BeginInstruction(pFormatContextInfo, baseAddress + codeOffset);
+
+    const bool result = pMeasureKernel(&instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset), &requiredCapacity, &hasTranslation, pNewInfo);
+
+    zydec_LinearContext_EndInstruction(pFormatContextInfo);
+
+    if (!result && hasTranslation)
+      return false;
+
+    *pRequiredArenaCapacity += hasTranslation ? requiredCapacity : 1; // Instructions without translation still get an empty string.
+    codeOffset += instruction.length;
+  }
+
+  return true;
+}
+
+bool zydec_TranslateBlock(ZydecLinearContext *pContext, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, ZydecFormattingInfo *pInfo, size_t *pRequiredArenaCapacity /* = nullptr */)
+{
+  if (pContext == nullptr || pInfo == nullptr)
+    return false;
+
+  if (pRequiredArenaCapacity != nullptr)
+    *pRequiredArenaCapacity = 0;
+
+  ZydisDecoder decoder;
+
+  if (!ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)))
+    return false;
+
+  ZydecLinearContextFormatInfo formatContextInfo;
+  ZydecFormattingInfo newInfo;
+  ZydecKernelFunc *pKernel = zydec_LinearContext_PrepareFormattingInfo(&formatContextInfo, &newInfo, pContext, pInfo);
+  ZydecAddressCache *pAddressCache = nullptr;
+
+  if (newInfo.batchAddressResolution && !zydec_AddressCache_Create(&pAddressCache, &decoder, pCode, size, baseAddress, &newInfo))
+    return false;
+
+  newInfo.pAddressCache = pAddressCache;
+
+  ZydecLinearContext contextBefore;
+
+  if (pRequiredArenaCapacity != nullptr)
+    contextBefore = *pContext;
+
+  const bool result = zydec_TranslateBlockToArena(&decoder, pCode, size, baseAddress, pArena, arenaCapacity, pOffsets, offsetCapacity, pInstructionCount, false, [&](const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
+    {
+      return zydec_LinearContext_TranslateInstruction(pKernel, &formatContextInfo, &newInfo, pInstruction, pOperands, ZYDIS_MAX_OPERAND_COUNT, virtualAddress, buffer, bufferCapacity, pHasTranslation);
+    });
+
+  if (!result && pRequiredArenaCapacity != nullptr)
+  {
+    // Find out whether the block merely didn't fit into the arena. Either way the context is left as it was before the block, so it can be translated again.
+    *pContext = contextBefore;
+
+    size_t requiredArenaCapacity = 0;
+
+    if (zydec_LinearContext_MeasureBlock(&decoder, &formatContextInfo, &newInfo, pCode, size, baseAddress, &requiredArenaCapacity) && requiredArenaCapacity > arenaCapacity)
+      *pRequiredArenaCapacity = requiredArenaCapacity;
+
+    *pContext = contextBefore;
+  }
+
+  zydec_AddressCache_Destroy(&pAddressCache);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ZydecTranslator
+{
+  ZydecTranslatorMode mode;
+  ZydecFormattingInfo originalInfo;
+  ZydecFormattingInfo info; // `originalInfo` with the linear context callbacks, if applicable.
+  ZydecLinearContext context;
+  ZydecLinearContextFormatInfo formatContextInfo;
+  ZydisDecoder decoder;
+  ZydecKernelFunc *pKernel; // Selected once for the options of `info`.
+  ZydecMeasureKernelFunc *pMeasureKernel;
+  ZydecKernelFunc *pNamingKernel; // Only advances the linear context, `nullptr` without one.
+  ZydecFlagProducer flagProducer; // Only tracked with `fuseFlagConditions`.
+  uint64_t *pResumeTargets; // Ascending. Targets of the jumps in front of the last restored checkpoint, that lie behind it.
+  size_t resumeTargetCount;
+  size_t resumeTargetCapacity;
+};
+
+// `info` refers to the flag producer of the translator it's part of.
+inline void zydec_Translator_BindFlagProducer(ZydecTranslator *pTranslator)
+{
+  pTranslator->info.pFlagProducer = pTranslator->info.fuseFlagConditions ? &pTranslator->flagProducer : nullptr;
+}
+
+bool zydec_CreateTranslator(ZydecTranslator **ppTranslator, const ZydecTranslatorMode mode, const ZydecFormattingInfo *pInfo)
+{
+  if (ppTranslator == nullptr || pInfo == nullptr)
+    return false;
+
+  ZydecTranslator *pTranslator = new (std::nothrow) ZydecTranslator();
+
+  if (pTranslator == nullptr)
+    return false;
+
+  if (!ZYAN_SUCCESS(ZydisDecoderInit(&pTranslator->decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)))
+  {
+    delete pTranslator;
+    return false;
+  }
+
+  pTranslator->mode = mode;
+  pTranslator->originalInfo = *pInfo;
+
+  if (mode == ZydecTranslatorMode::LinearContext)
+  {
+    pTranslator->pKernel = zydec_LinearContext_PrepareFormattingInfo(&pTranslator->formatContextInfo, &pTranslator->info, &pTranslator->context, &pTranslator->originalInfo);
+    pTranslator->pMeasureKernel = zydec_SelectMeasureKernel<ZydecLinearContextEmitter<ZydecMeasureSink>>(&pTranslator->info);
+    pTranslator->pNamingKernel = zydec_SelectKernel<ZydecLinearContextEmitter<ZydecNullSink>>(&pTranslator->info);
+  }
+  else
+  {
+    pTranslator->info = pTranslator->originalInfo;
+    pTranslator->pKernel = zydec_SelectKernel<ZydecCallbackEmitter<ZydecTextSink>>(&pTranslator->info);
+    pTranslator->pMeasureKernel = zydec_SelectMeasureKernel<ZydecCallbackEmitter<ZydecMeasureSink>>(&pTranslator->info);
+    pTranslator->pNamingKernel = nullptr;
+  }
+
+  zydec_Translator_BindFlagProducer(pTranslator);
+
+  *ppTranslator = pTranslator;
+
+  return true;
+}
+
+void zydec_DestroyTranslator(ZydecTranslator **ppTranslator)
+{
+  if (ppTranslator == nullptr || *ppTranslator == nullptr)
+    return;
+
+  free((*ppTranslator)->pResumeTargets);
+
+  delete *ppTranslator;
+  *ppTranslator = nullptr;
+}
+
+ZydecLinearContext *zydec_Translator_GetLinearContext(ZydecTranslator *pTranslator)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext)
+    return nullptr;
+
+  return &pTranslator->context;
+}
+
+inline bool zydec_FlagProducer_ReadsRegister(const ZydecFlagProducer *pProducer, const ZydisRegister baseRegister)
+{
+  for (size_t i = 0; i < 2; i++)
+  {
+    const ZydisDecodedOperand *pOperand = &pProducer->operands[i];
+
+    if (pOperand->type == ZYDIS_OPERAND_TYPE_REGISTER && zydec_ResolveBaseRegister(pOperand->reg.value) == baseRegister)
+      return true;
+
+    if (pOperand->type == ZYDIS_OPERAND_TYPE_MEMORY && (zydec_ResolveBaseRegister(pOperand->mem.base) == baseRegister || zydec_ResolveBaseRegister(pOperand->mem.index) == baseRegister))
+      return true;
+  }
+
+  return false;
+}
+
+// Remembers `pInstruction` if it sets the flags in a way conditions can be expressed with, or forgets the last producer once the flags or its operands change.
+inline bool zydec_WritesFlags(const ZydisDecodedInstruction *pInstruction)
+{
+  return pInstruction->cpu_flags != nullptr && (pInstruction->cpu_flags->modified | pInstruction->cpu_flags->set_0 | pInstruction->cpu_flags->set_1 | pInstruction->cpu_flags->undefined) != 0;
+}
+
+static void zydec_FlagProducer_Update(ZydecFlagProducer *pProducer, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress)
+{
+  const bool isKnownCondition = zydec_ResolveCondition(pInstruction->mnemonic) != zcc_none;
+  const bool setsFlags = zydec_WritesFlags(pInstruction);
+
+  if (setsFlags)
+  {
+    ZydecFlagProducerKind kind;
+
+    switch (pInstruction->mnemonic)
+    {
+    case ZYDIS_MNEMONIC_CMP: kind = zfpk_compare; break;
+    case ZYDIS_MNEMONIC_TEST: kind = zfpk_test; break;
+    case ZYDIS_MNEMONIC_AND: case ZYDIS_MNEMONIC_OR: case ZYDIS_MNEMONIC_XOR: kind = zfpk_logic; break;
+    case ZYDIS_MNEMONIC_ADD: case ZYDIS_MNEMONIC_SUB: case ZYDIS_MNEMONIC_INC: case ZYDIS_MNEMONIC_DEC: case ZYDIS_MNEMONIC_NEG: kind = zfpk_arithmetic; break;
+    default: kind = zfpk_none; break;
+    }
+
+    const size_t explicitOperandCount = kind == zfpk_arithmetic && pInstruction->operand_count_visible == 1 ? 1 : 2;
+
+    if (kind == zfpk_none || operandCount < explicitOperandCount || pInstruction->operand_count_visible != explicitOperandCount)
+    {
+      pProducer->kind = zfpk_none;
+      return;
+    }
+
+    pProducer->kind = kind;
+    pProducer->isAdjacent = true;
+    pProducer->mnemonic = (uint16_t)pInstruction->mnemonic;
+    pProducer->virtualAddress = virtualAddress;
+    pProducer->operands[0] = pOperands[0];
+    pProducer->operands[1] = explicitOperandCount == 2 ? pOperands[1] : pOperands[0];
+
+    const bool hasMemory = zydec_IsMemoryOperand(&pOperands[0]) || (explicitOperandCount == 2 && zydec_IsMemoryOperand(&pOperands[1]));
+    const bool hasImmediate = explicitOperandCount == 2 && pOperands[1].type == ZYDIS_OPERAND_TYPE_IMMEDIATE;
+    const bool isRipRelative = (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY && pOperands[0].mem.base == ZYDIS_REGISTER_RIP) || (explicitOperandCount == 2 && pOperands[1].type == ZYDIS_OPERAND_TYPE_MEMORY && pOperands[1].mem.base == ZYDIS_REGISTER_RIP);
+
+    pProducer->isFusible = !(hasMemory && hasImmediate) && !isRipRelative;
+
+    return;
+  }
+
+  if (pProducer->kind == zfpk_none)
+    return;
+
+  pProducer->isAdjacent = false;
+
+  switch (pInstruction->meta.category)
+  {
+  case ZYDIS_CATEGORY_COND_BR:
+    if (isKnownCondition)
+      return; // Falls through to the next instruction with the same flags.
+
+    break;
+
+  case ZYDIS_CATEGORY_UNCOND_BR:
+  case ZYDIS_CATEGORY_CALL:
+  case ZYDIS_CATEGORY_RET:
+  case ZYDIS_CATEGORY_INTERRUPT:
+  case ZYDIS_CATEGORY_SYSCALL:
+  case ZYDIS_CATEGORY_SYSRET:
+  case ZYDIS_CATEGORY_SYSTEM:
+    pProducer->kind = zfpk_none;
+    return;
+
+  default:
+    break;
+  }
+
+  // Without all operands it's unknown what the instruction writes. `jcc`, `setcc` & `cmovcc` only hide the flags they read.
+  if (operandCount < pInstruction->operand_count && !(isKnownCondition && operandCount >= pInstruction->operand_count_visible))
+  {
+    pProducer->kind = zfpk_none;
+    return;
+  }
+
+  const bool producerReadsMemory = zydec_IsMemoryOperand(&pProducer->operands[0]) || zydec_IsMemoryOperand(&pProducer->operands[1]);
+  const size_t decodedOperandCount = operandCount < pInstruction->operand_count ? operandCount : pInstruction->operand_count;
+
+  for (size_t i = 0; i < decodedOperandCount; i++)
+  {
+    const ZydisDecodedOperand *pOperand = &pOperands[i];
+
+    if ((pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_WRITE) == 0 || (pOperand->type == ZYDIS_OPERAND_TYPE_REGISTER && pOperand->reg.value >= ZYDIS_REGISTER_FLAGS && pOperand->reg.value <= ZYDIS_REGISTER_RIP))
+      continue; // The flags & instruction pointer aren't rendered as operands.
+
+    if ((pOperand->type == ZYDIS_OPERAND_TYPE_REGISTER && zydec_FlagProducer_ReadsRegister(pProducer, zydec_ResolveBaseRegister(pOperand->reg.value))) || (zydec_IsMemoryOperand(pOperand) && producerReadsMemory))
+    {
+      pProducer->kind = zfpk_none;
+      return;
+    }
+  }
+}
+
+// The offsets of the direct branch targets within some code. The flags at a branch target may come from any of the branches, so the flag producer is forgotten there.
+struct ZydecBranchTargets
+{
+  size_t *pOffsets = nullptr; // Ascending & distinct.
+  size_t count = 0;
+  size_t capacity = 0;
+  size_t next = 0; // The first target that hasn't been passed yet.
+};
+
+static int zydec_BranchTargets_CompareOffsets(const void *pA, const void *pB)
+{
+  const size_t a = *static_cast<const size_t *>(pA);
+  const size_t b = *static_cast<const size_t *>(pB);
+
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static void zydec_BranchTargets_Destroy(ZydecBranchTargets *pTargets)
+{
+  free(pTargets->pOffsets);
+  *pTargets = ZydecBranchTargets();
+}
+
+// Collects the targets of the relative jumps in `pCode` that lie within it. Stops at the first instruction that can't be decoded, so the block function can report it.
+static bool zydec_BranchTargets_Collect(ZydecBranchTargets *pTargets, const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const uint64_t baseAddress)
+{
+  ZydisDecoderContext decoderContext;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t codeOffset = 0;
+
+  while (codeOffset < size)
+  {
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeInstruction(pDecoder, &decoderContext, pCode + codeOffset, size - codeOffset, &instruction)) || instruction.length == 0)
       break;
 
-    default:
-      break;
-    }
+    ZyanU64 target;
+
+    // Just like the control flow graph, only the target operand of relative branches has to be decoded.
+    if ((instruction.meta.category == ZYDIS_CATEGORY_COND_BR || instruction.meta.category == ZYDIS_CATEGORY_UNCOND_BR) && (instruction.attributes & ZYDIS_ATTRIB_IS_RELATIVE) != 0 && instruction.operand_count > 0 && ZYAN_SUCCESS(ZydisDecoderDecodeOperands(pDecoder, &decoderContext, &instruction, operands, 1)) && ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instruction, &operands[0], baseAddress + codeOffset, &target)) && target >= baseAddress && target - baseAddress < size)
+    {
+      if (!zydec_Unrolled_Reserve(&pTargets->pOffsets, &pTargets->capacity, pTargets->count + 1))
+        return false;
+
+      pTargets->pOffsets[pTargets->count++] = (size_t)(target - baseAddress);
+    }
+
+    codeOffset += instruction.length;
+  }
+
+  if (pTargets->count == 0)
+    return true;
+
+  qsort(pTargets->pOffsets, pTargets->count, sizeof(size_t), zydec_BranchTargets_CompareOffsets);
+
+  size_t uniqueCount = 1;
+
+  for (size_t i = 1; i < pTargets->count; i++)
+    if (pTargets->pOffsets[i] != pTargets->pOffsets[uniqueCount - 1])
+      pTargets->pOffsets[uniqueCount++] = pTargets->pOffsets[i];
+
+  pTargets->count = uniqueCount;
+
+  return true;
+}
+
+// Forgets the flag producer if a branch may enter at `codeOffset`. Has to be called for every instruction in ascending order.
+inline void zydec_BranchTargets_Enter(ZydecBranchTargets *pTargets, const size_t codeOffset, ZydecFlagProducer *pProducer)
+{
+  while (pTargets->next < pTargets->count && pTargets->pOffsets[pTargets->next] < codeOffset)
+    pTargets->next++;
+
+  if (pTargets->next < pTargets->count && pTargets->pOffsets[pTargets->next] == codeOffset)
+    pProducer->kind = zfpk_none;
+}
+
+// Forgets the flag producer if a jump in front of the last restored checkpoint enters at `virtualAddress`.
+inline void zydec_Translator_EnterResumeTarget(ZydecTranslator *pTranslator, const uint64_t virtualAddress)
+{
+  size_t first = 0;
+  size_t count = pTranslator->resumeTargetCount;
+
+  while (count > 0)
+  {
+    const size_t half = count / 2;
+
+    if (pTranslator->pResumeTargets[first + half] < virtualAddress)
+    {
+      first += half + 1;
+      count -= half + 1;
+    }
+    else
+    {
+      count = half;
+    }
+  }
+
+  if (first < pTranslator->resumeTargetCount && pTranslator->pResumeTargets[first] == virtualAddress)
+    pTranslator->flagProducer.kind = zfpk_none;
+}
+
+bool zydec_Translator_TranslateInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, size_t *pRequiredCapacity /* = nullptr */)
+{
+  if (pTranslator == nullptr)
+    return false;
+
+  if (pRequiredCapacity != nullptr)
+    *pRequiredCapacity = 0;
+
+  const bool isLinear = pTranslator->mode == ZydecTranslatorMode::LinearContext;
+  const uint64_t hashStateBefore = pTranslator->context.hashState;
+
+  if (pTranslator->info.fuseFlagConditions)
+    zydec_Translator_EnterResumeTarget(pTranslator, virtualAddress);
+
+  if (isLinear)
+    zydec_LinearContext_BeginInstruction(&pTranslator->formatContextInfo, virtualAddress);
+
+  const bool result = pTranslator->pKernel(pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, &pTranslator->info);
+
+  // Leave the context untouched, so the translation can be retried with a large enough buffer.
+  if (!result && pRequiredCapacity != nullptr && pHasTranslation != nullptr && *pHasTranslation && zydec_MeasureOverflow(pTranslator->pMeasureKernel, isLinear ? &pTranslator->formatContextInfo : nullptr, hashStateBefore, &pTranslator->info, pInstruction, pOperands, operandCount, virtualAddress, bufferCapacity, pRequiredCapacity))
+    return false;
+
+  if (isLinear)
+    zydec_LinearContext_EndInstruction(&pTranslator->formatContextInfo);
+
+  if (pTranslator->info.fuseFlagConditions && pInstruction != nullptr)
+    zydec_FlagProducer_Update(&pTranslator->flagProducer, pInstruction, pOperands, operandCount, virtualAddress);
+
+  return result;
+}
+
+bool zydec_Translator_TranslateDecodedInstruction(ZydecTranslator *pTranslator, const ZydisDecoderContext *pDecoderContext, const ZydisDecodedInstruction *pInstruction, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, size_t *pRequiredCapacity /* = nullptr */)
+{
+  if (pTranslator == nullptr || pDecoderContext == nullptr || pInstruction == nullptr)
+    return false;
+
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+  const size_t operandCount = pTranslator->info.fuseFlagConditions ? pInstruction->operand_count : zydec_RequiredOperandCount(pInstruction);
+
+  if (!ZYAN_SUCCESS(ZydisDecoderDecodeOperands(&pTranslator->decoder, pDecoderContext, pInstruction, operands, (ZyanU8)operandCount)))
+    return false;
+
+  return zydec_Translator_TranslateInstruction(pTranslator, pInstruction, operands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, pRequiredCapacity);
+}
+
+bool zydec_Translator_MeasureInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, size_t *pRequiredCapacity, bool *pHasTranslation)
+{
+  if (pTranslator == nullptr)
+    return false;
+
+  const ZydecFlagProducerKind flagProducerKindBefore = pTranslator->flagProducer.kind;
+
+  if (pTranslator->info.fuseFlagConditions)
+    zydec_Translator_EnterResumeTarget(pTranslator, virtualAddress);
+
+  if (pTranslator->mode != ZydecTranslatorMode::LinearContext)
+  {
+    const bool result = pTranslator->pMeasureKernel(pInstruction, pOperands, operandCount, virtualAddress, pRequiredCapacity, pHasTranslation, &pTranslator->info);
+    pTranslator->flagProducer.kind = flagProducerKindBefore;
+
+    return result;
+  }
+
+  const uint64_t hashStateBefore = pTranslator->context.hashState;
+
+  zydec_LinearContext_BeginInstruction(&pTranslator->formatContextInfo, virtualAddress);
+
+  const bool result = pTranslator->pMeasureKernel(pInstruction, pOperands, operandCount, virtualAddress, pRequiredCapacity, pHasTranslation, &pTranslator->info);
+
+  // The assignments are discarded, so only the hash state (& the flags) have to be restored.
+  pTranslator->context.hashState = hashStateBefore;
+  pTranslator->flagProducer.kind = flagProducerKindBefore;
+
+  return result;
+}
+
+// Applies an instruction of a collapsed copy to the linear context & the flags, just like its translation would.
+static bool zydec_Translator_SkipInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress)
+{
+  const bool result = pTranslator->mode != ZydecTranslatorMode::LinearContext || zydec_Translator_AdvanceInstruction(pTranslator, pInstruction, pOperands, operandCount, virtualAddress);
+
+  if (pTranslator->info.fuseFlagConditions)
+  {
+    zydec_Translator_EnterResumeTarget(pTranslator, virtualAddress);
+    zydec_FlagProducer_Update(&pTranslator->flagProducer, pInstruction, pOperands, operandCount, virtualAddress);
+  }
+
+  return result;
+}
+
+// Appends the annotation of a group to the translation in `buffer` (if there's any).
+static bool zydec_Unrolled_Annotate(char *buffer, const size_t bufferCapacity, const bool translated, bool *pHasTranslation, const ZydecString &annotation)
+{
+  if (!translated && *pHasTranslation)
+    return false; // Out of space.
+
+  const size_t length = *pHasTranslation ? strlen(buffer) : 0;
+  char *bufferPos = buffer + length;
+  size_t remainingSize = bufferCapacity - length - 1; // For the terminating zero.
+
+  *pHasTranslation = true;
 
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "("));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // set zero_flag & carry_flag accordingly"));
+  if (length != 0)
+    ERROR_CHECK(ZydecTextSink::Write(&bufferPos, &remainingSize, " "));
 
-    return true;
+  ERROR_CHECK(ZydecTextSink::Write(&bufferPos, &remainingSize, annotation));
+  *bufferPos = '\0';
+
+  return true;
+}
+
+// The capacity `zydec_Unrolled_Annotate` requires for a translation that requires `requiredCapacity` (1 for instructions without translation).
+inline size_t zydec_Unrolled_AnnotatedCapacity(const size_t requiredCapacity, const ZydecString &annotation)
+{
+  return requiredCapacity + (requiredCapacity > 1 ? 1 : 0) + annotation.length;
+}
+
+// Translates the next instruction of a block, unless it's part of a collapsed copy.
+static bool zydec_Translator_TranslateBlockInstruction(ZydecTranslator *pTranslator, ZydecUnrolledCursor *pCursor, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
+{
+  ZydecString annotation;
+
+  switch (zydec_Unrolled_Next(pCursor, &annotation))
+  {
+  case zur_collapse:
+    *pHasTranslation = false;
+    return zydec_Translator_SkipInstruction(pTranslator, pInstruction, pOperands, ZYDIS_MAX_OPERAND_COUNT, virtualAddress);
+
+  case zur_annotate:
+  {
+    const bool translated = zydec_Translator_TranslateInstruction(pTranslator, pInstruction, pOperands, ZYDIS_MAX_OPERAND_COUNT, virtualAddress, buffer, bufferCapacity, pHasTranslation);
+    return zydec_Unrolled_Annotate(buffer, bufferCapacity, translated, pHasTranslation, annotation);
+  }
+
+  default:
+    return zydec_Translator_TranslateInstruction(pTranslator, pInstruction, pOperands, ZYDIS_MAX_OPERAND_COUNT, virtualAddress, buffer, bufferCapacity, pHasTranslation);
   }
+}
+
+bool zydec_Translator_TranslateBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity /* = nullptr */)
+{
+  if (pTranslator == nullptr)
+    return false;
+
+  if (pRequiredArenaCapacity != nullptr)
+    *pRequiredArenaCapacity = 0;
+
+  ZydecAddressCache *pAddressCache = nullptr;
 
-  case ZYDIS_MNEMONIC_VGATHERPF0DPS:
-  case ZYDIS_MNEMONIC_VGATHERPF1DPS:
-  case ZYDIS_MNEMONIC_VGATHERPF0DPD:
-  case ZYDIS_MNEMONIC_VGATHERPF1DPD:
-  case ZYDIS_MNEMONIC_VGATHERPF0QPS:
-  case ZYDIS_MNEMONIC_VGATHERPF1QPS:
-  case ZYDIS_MNEMONIC_VGATHERPF0QPD:
-  case ZYDIS_MNEMONIC_VGATHERPF1QPD:
-  case ZYDIS_MNEMONIC_VSCATTERPF0QPD:
-  case ZYDIS_MNEMONIC_VSCATTERPF1QPD:
-  case ZYDIS_MNEMONIC_VSCATTERPF0QPS:
-  case ZYDIS_MNEMONIC_VSCATTERPF1QPS:
+  if (pTranslator->info.batchAddressResolution && !zydec_AddressCache_Create(&pAddressCache, &pTranslator->decoder, pCode, size, baseAddress, &pTranslator->info))
+    return false;
+
+  ZydecUnrolledGroups *pUnrolledGroups = nullptr;
+
+  if (pTranslator->info.collapseUnrolledGroups && !zydec_Unrolled_Create(&pUnrolledGroups, &pTranslator->decoder, pCode, size))
   {
-    switch (pInstruction->mnemonic)
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return false;
+  }
+
+  ZydecBranchTargets branchTargets;
+
+  if (pTranslator->info.fuseFlagConditions && !zydec_BranchTargets_Collect(&branchTargets, &pTranslator->decoder, pCode, size, baseAddress))
+  {
+    zydec_BranchTargets_Destroy(&branchTargets);
+    zydec_Unrolled_Destroy(&pUnrolledGroups);
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return false;
+  }
+
+  pTranslator->info.pAddressCache = pAddressCache;
+
+  ZydecUnrolledCursor cursor;
+  cursor.pGroups = pUnrolledGroups;
+
+  ZydecLinearContext contextBefore;
+  ZydecFlagProducer flagProducerBefore;
+
+  if (pRequiredArenaCapacity != nullptr)
+  {
+    contextBefore = pTranslator->context;
+    flagProducerBefore = pTranslator->flagProducer;
+  }
+
+  const bool result = zydec_TranslateBlockToArena(&pTranslator->decoder, pCode, size, baseAddress, pArena, arenaCapacity, pOffsets, offsetCapacity, pInstructionCount, pTranslator->info.fuseFlagConditions, [pTranslator, baseAddress, &cursor, &branchTargets](const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
     {
-    case ZYDIS_MNEMONIC_VGATHERPF0DPS:
-    case ZYDIS_MNEMONIC_VGATHERPF1DPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i32extgather_ps("));
-      break;
+      zydec_BranchTargets_Enter(&branchTargets, (size_t)(virtualAddress - baseAddress), &pTranslator->flagProducer);
 
-    case ZYDIS_MNEMONIC_VGATHERPF0DPD:
-    case ZYDIS_MNEMONIC_VGATHERPF1DPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i32extgather_pd("));
-      break;
+      return zydec_Translator_TranslateBlockInstruction(pTranslator, &cursor, pInstruction, pOperands, virtualAddress, buffer, bufferCapacity, pHasTranslation);
+    });
 
-    case ZYDIS_MNEMONIC_VGATHERPF0QPS:
-    case ZYDIS_MNEMONIC_VGATHERPF1QPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i64gather_ps("));
-      break;
+  pTranslator->info.pAddressCache = nullptr;
+  zydec_AddressCache_Destroy(&pAddressCache);
+  zydec_Unrolled_Destroy(&pUnrolledGroups);
+  zydec_BranchTargets_Destroy(&branchTargets);
 
-    case ZYDIS_MNEMONIC_VGATHERPF0QPD:
-    case ZYDIS_MNEMONIC_VGATHERPF1QPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i64gather_pd("));
-      break;
+  if (!result && pRequiredArenaCapacity != nullptr)
+  {
+    // Find out whether the block merely didn't fit into the arena. Either way the translator is left as it was before the block, so it can be translated again.
+    pTranslator->context = contextBefore;
+    pTranslator->flagProducer = flagProducerBefore;
 
-    case ZYDIS_MNEMONIC_VSCATTERPF0QPD:
-    case ZYDIS_MNEMONIC_VSCATTERPF1QPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i64scatter_pd("));
-      break;
+    size_t requiredArenaCapacity = 0;
+    size_t instructionCount = 0;
 
-    case ZYDIS_MNEMONIC_VSCATTERPF0QPS:
-    case ZYDIS_MNEMONIC_VSCATTERPF1QPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_prefetch_i64scatter_ps("));
-      break;
+    if (zydec_Translator_MeasureBlock(pTranslator, pCode, size, baseAddress, &requiredArenaCapacity, &instructionCount) && requiredArenaCapacity > arenaCapacity)
+      *pRequiredArenaCapacity = requiredArenaCapacity;
+  }
 
-    default:
+  return result;
+}
+
+bool zydec_Translator_MeasureBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, size_t *pRequiredArenaCapacity, size_t *pInstructionCount)
+{
+  if (pTranslator == nullptr || pCode == nullptr || pRequiredArenaCapacity == nullptr || pInstructionCount == nullptr)
+    return false;
+
+  *pRequiredArenaCapacity = 0;
+  *pInstructionCount = 0;
+
+  ZydecAddressCache *pAddressCache = nullptr;
+
+  if (pTranslator->info.batchAddressResolution && !zydec_AddressCache_Create(&pAddressCache, &pTranslator->decoder, pCode, size, baseAddress, &pTranslator->info))
+    return false;
+
+  ZydecUnrolledGroups *pUnrolledGroups = nullptr;
+
+  if (pTranslator->info.collapseUnrolledGroups && !zydec_Unrolled_Create(&pUnrolledGroups, &pTranslator->decoder, pCode, size))
+  {
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return false;
+  }
+
+  ZydecBranchTargets branchTargets;
+
+  if (pTranslator->info.fuseFlagConditions && !zydec_BranchTargets_Collect(&branchTargets, &pTranslator->decoder, pCode, size, baseAddress))
+  {
+    zydec_BranchTargets_Destroy(&branchTargets);
+    zydec_Unrolled_Destroy(&pUnrolledGroups);
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return false;
+  }
+
+  pTranslator->info.pAddressCache = pAddressCache;
+
+  ZydecUnrolledCursor cursor;
+  cursor.pGroups = pUnrolledGroups;
+
+  const bool isLinear = pTranslator->mode == ZydecTranslatorMode::LinearContext;
+  const bool fuseFlagConditions = pTranslator->info.fuseFlagConditions;
+  const ZydecLinearContext contextBefore = pTranslator->context; // Names depend on the preceding instructions, so the context is advanced & restored afterwards.
+  const ZydecFlagProducer flagProducerBefore = pTranslator->flagProducer; // Just like the fused conditions.
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t codeOffset = 0;
+  bool success = true;
+
+  while (codeOffset < size)
+  {
+    if (!zydec_DecodeInstruction(&pTranslator->decoder, pCode + codeOffset, size - codeOffset, &instruction, operands, fuseFlagConditions))
+    {
+      success = false;
       break;
     }
 
-    for (size_t operandIndex = 0; operandIndex < pInstruction->operand_count; operandIndex++)
+    zydec_BranchTargets_Enter(&branchTargets, codeOffset, &pTranslator->flagProducer);
+
+    if (fuseFlagConditions)
+      zydec_Translator_EnterResumeTarget(pTranslator, baseAddress + codeOffset);
+
+    ZydecString annotation;
+    const ZydecUnrolledRole role = zydec_Unrolled_Next(&cursor, &annotation);
+
+    if (role == zur_collapse)
     {
-      if (operandIndex > 0)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
+      zydec_Translator_SkipInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex], virtualAddress, pInfo));
+      *pRequiredArenaCapacity += 1;
+      (*pInstructionCount)++;
+      codeOffset += instruction.length;
+      continue;
     }
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_VGATHERPF0DPS:
-    case ZYDIS_MNEMONIC_VGATHERPF0DPD:
-    case ZYDIS_MNEMONIC_VGATHERPF0QPS:
-    case ZYDIS_MNEMONIC_VGATHERPF0QPD:
-    case ZYDIS_MNEMONIC_VSCATTERPF0QPD:
-    case ZYDIS_MNEMONIC_VSCATTERPF0QPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // part 1 / 2"));
-      return true;
+    size_t requiredCapacity = 0;
+    bool hasTranslation = false;
 
-    case ZYDIS_MNEMONIC_VGATHERPF1DPS:
-    case ZYDIS_MNEMONIC_VGATHERPF1DPD:
-    case ZYDIS_MNEMONIC_VGATHERPF1QPS:
-    case ZYDIS_MNEMONIC_VGATHERPF1QPD:
-    case ZYDIS_MNEMONIC_VSCATTERPF1QPD:
-    case ZYDIS_MNEMONIC_VSCATTERPF1QPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // part 2 / 2"));
-      return true;
+    if (isLinear)
+      zydec_LinearContext_BeginInstruction(&pTranslator->formatContextInfo, baseAddress + codeOffset);
 
-    default:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
+    const bool result = pTranslator->pMeasureKernel(&instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset), &requiredCapacity, &hasTranslation, &pTranslator->info);
+
+    if (isLinear)
+      zydec_LinearContext_EndInstruction(&pTranslator->formatContextInfo);
+
+    if (fuseFlagConditions)
+      zydec_FlagProducer_Update(&pTranslator->flagProducer, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
+
+    if (!result && hasTranslation)
+    {
+      success = false;
       break;
     }
+
+    const size_t lineCapacity = hasTranslation ? requiredCapacity : 1; // Instructions without translation still get an empty string.
+
+    *pRequiredArenaCapacity += role == zur_annotate ? zydec_Unrolled_AnnotatedCapacity(lineCapacity, annotation) : lineCapacity;
+    (*pInstructionCount)++;
+    codeOffset += instruction.length;
   }
 
-  case ZYDIS_MNEMONIC_KADDB:
-  case ZYDIS_MNEMONIC_KADDW:
-  case ZYDIS_MNEMONIC_KADDD:
-  case ZYDIS_MNEMONIC_KADDQ:
-  case ZYDIS_MNEMONIC_KANDB:
-  case ZYDIS_MNEMONIC_KANDW:
-  case ZYDIS_MNEMONIC_KANDD:
-  case ZYDIS_MNEMONIC_KANDQ:
-  case ZYDIS_MNEMONIC_KORB:
-  case ZYDIS_MNEMONIC_KORW:
-  case ZYDIS_MNEMONIC_KORD:
-  case ZYDIS_MNEMONIC_KORQ:
-  case ZYDIS_MNEMONIC_KSHIFTLB:
-  case ZYDIS_MNEMONIC_KSHIFTLW:
-  case ZYDIS_MNEMONIC_KSHIFTLD:
-  case ZYDIS_MNEMONIC_KSHIFTLQ:
-  case ZYDIS_MNEMONIC_KSHIFTRB:
-  case ZYDIS_MNEMONIC_KSHIFTRW:
-  case ZYDIS_MNEMONIC_KSHIFTRD:
-  case ZYDIS_MNEMONIC_KSHIFTRQ:
-  case ZYDIS_MNEMONIC_KXORB:
-  case ZYDIS_MNEMONIC_KXORW:
-  case ZYDIS_MNEMONIC_KXORD:
-  case ZYDIS_MNEMONIC_KXORQ:
+  pTranslator->context = contextBefore;
+  pTranslator->flagProducer = flagProducerBefore;
+  pTranslator->info.pAddressCache = nullptr;
+  zydec_AddressCache_Destroy(&pAddressCache);
+  zydec_Unrolled_Destroy(&pUnrolledGroups);
+  zydec_BranchTargets_Destroy(&branchTargets);
+
+  return success;
+}
+
+bool zydec_Translator_AdvanceInstruction(ZydecTranslator *pTranslator, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext)
+    return false;
+
+  char buffer[1]; // Only receives the terminator.
+  bool hasTranslation = false;
+
+  return zydec_LinearContext_TranslateInstruction(pTranslator->pNamingKernel, &pTranslator->formatContextInfo, &pTranslator->info, pInstruction, pOperands, operandCount, virtualAddress, buffer, sizeof(buffer), &hasTranslation) || !hasTranslation;
+}
+
+bool zydec_Translator_AdvanceBlock(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, size_t *pInstructionCount)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext || pCode == nullptr || pInstructionCount == nullptr)
+    return false;
+
+  *pInstructionCount = 0;
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  size_t codeOffset = 0;
+
+  while (codeOffset < size)
   {
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_KSHIFTLB:
-    case ZYDIS_MNEMONIC_KSHIFTLW:
-    case ZYDIS_MNEMONIC_KSHIFTLD:
-    case ZYDIS_MNEMONIC_KSHIFTLQ:
-      zydec_HintOp(ZydecFormattingInfo::ShL, pInfo);
-      break;
+    if (!zydec_DecodeInstruction(&pTranslator->decoder, pCode + codeOffset, size - codeOffset, &instruction, operands))
+      return false;
 
-    case ZYDIS_MNEMONIC_KSHIFTRB:
-    case ZYDIS_MNEMONIC_KSHIFTRW:
-    case ZYDIS_MNEMONIC_KSHIFTRD:
-    case ZYDIS_MNEMONIC_KSHIFTRQ:
-      zydec_HintOp(ZydecFormattingInfo::ShR, pInfo);
-      break;
+    zydec_Translator_AdvanceInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
 
-    case ZYDIS_MNEMONIC_KADDB:
-    case ZYDIS_MNEMONIC_KADDW:
-    case ZYDIS_MNEMONIC_KADDD:
-    case ZYDIS_MNEMONIC_KADDQ:
-      zydec_HintOp(ZydecFormattingInfo::Add, pInfo);
-      break;
+    (*pInstructionCount)++;
+    codeOffset += instruction.length;
+  }
 
-    case ZYDIS_MNEMONIC_KANDB:
-    case ZYDIS_MNEMONIC_KANDW:
-    case ZYDIS_MNEMONIC_KANDD:
-    case ZYDIS_MNEMONIC_KANDQ:
-      zydec_HintOp(ZydecFormattingInfo::And, pInfo);
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_KORB:
-    case ZYDIS_MNEMONIC_KORW:
-    case ZYDIS_MNEMONIC_KORD:
-    case ZYDIS_MNEMONIC_KORQ:
-      zydec_HintOp(ZydecFormattingInfo::Or, pInfo);
-      break;
+void zydec_Translator_ForgetFlags(ZydecTranslator *pTranslator)
+{
+  if (pTranslator != nullptr)
+    pTranslator->flagProducer.kind = zfpk_none;
+}
 
-    case ZYDIS_MNEMONIC_KXORB:
-    case ZYDIS_MNEMONIC_KXORW:
-    case ZYDIS_MNEMONIC_KXORD:
-    case ZYDIS_MNEMONIC_KXORQ:
-      zydec_HintOp(ZydecFormattingInfo::XOr, pInfo);
-      break;
+struct ZydecCheckpoint
+{
+  uint64_t virtualAddress;
+  size_t instructionIndex;
+  ZydecLinearContext context; // Before translating the instruction.
+  ZydecFlagProducer flagProducer;
+  size_t firstPendingTarget; // Into `ZydecCheckpointIndex::pPendingTargets`.
+  size_t pendingTargetCount; // The jumps in front of the checkpoint that enter behind it, as the translation from the checkpoint can't see them.
+};
 
-    default:
+struct ZydecCheckpointIndex
+{
+  ZydecCheckpoint *pCheckpoints; // Ordered by address.
+  size_t checkpointCount;
+  size_t checkpointCapacity;
+  uint64_t *pPendingTargets; // Ascending per checkpoint.
+  size_t pendingTargetCount;
+  size_t pendingTargetCapacity;
+};
+
+bool zydec_Translator_BuildCheckpoints(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const size_t interval, ZydecCheckpointIndex **ppCheckpointIndex)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext || pCode == nullptr || interval == 0 || ppCheckpointIndex == nullptr)
+    return false;
+
+  ZydecCheckpointIndex *pIndex = new (std::nothrow) ZydecCheckpointIndex();
+
+  if (pIndex == nullptr)
+    return false;
+
+  const bool fuseFlagConditions = pTranslator->info.fuseFlagConditions;
+  const ZydecLinearContext contextBefore = pTranslator->context;
+  const ZydecFlagProducer flagProducerBefore = pTranslator->flagProducer;
+
+  ZydecBranchTargets branchTargets;
+
+  if (fuseFlagConditions && !zydec_BranchTargets_Collect(&branchTargets, &pTranslator->decoder, pCode, size, baseAddress))
+  {
+    zydec_BranchTargets_Destroy(&branchTargets);
+    zydec_DestroyCheckpointIndex(&pIndex);
+    return false;
+  }
+
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+
+  uint64_t *pOpenTargets = nullptr; // Ascending. Targets of the jumps so far that haven't been reached yet.
+  size_t openTargetCount = 0;
+  size_t openTargetCapacity = 0;
+
+  size_t codeOffset = 0;
+  size_t instructionIndex = 0;
+  bool success = true;
+
+  while (codeOffset < size)
+  {
+    if (!zydec_DecodeInstruction(&pTranslator->decoder, pCode + codeOffset, size - codeOffset, &instruction, operands, fuseFlagConditions))
+    {
+      success = false;
       break;
     }
 
-    if (simplifyShorthands)
+    zydec_BranchTargets_Enter(&branchTargets, codeOffset, &pTranslator->flagProducer);
+
+    size_t reachedTargetCount = 0;
+
+    while (reachedTargetCount < openTargetCount && pOpenTargets[reachedTargetCount] <= baseAddress + codeOffset)
+      reachedTargetCount++;
+
+    if (reachedTargetCount != 0)
+    {
+      openTargetCount -= reachedTargetCount;
+      memmove(pOpenTargets, pOpenTargets + reachedTargetCount, sizeof(uint64_t) * openTargetCount);
+    }
+
+    if (instructionIndex % interval == 0)
     {
-      if (pInstruction->operand_count == 3 && pOperands[1].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[2].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[1].reg.value == pOperands[2].reg.value)
+      if (pIndex->checkpointCount == pIndex->checkpointCapacity)
       {
-        switch (pInstruction->mnemonic)
+        const size_t newCapacity = pIndex->checkpointCapacity == 0 ? 64 : pIndex->checkpointCapacity * 2;
+        ZydecCheckpoint *pCheckpoints = reinterpret_cast<ZydecCheckpoint *>(realloc(pIndex->pCheckpoints, sizeof(ZydecCheckpoint) * newCapacity));
+
+        if (pCheckpoints == nullptr)
         {
-        case ZYDIS_MNEMONIC_KANDB:
-        case ZYDIS_MNEMONIC_KANDW:
-        case ZYDIS_MNEMONIC_KANDD:
-        case ZYDIS_MNEMONIC_KANDQ:
-        case ZYDIS_MNEMONIC_KORB:
-        case ZYDIS_MNEMONIC_KORW:
-        case ZYDIS_MNEMONIC_KORD:
-        case ZYDIS_MNEMONIC_KORQ:
-          zydec_HintOperand(&pOperands[1], pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ";"));
-          return true;
+          success = false;
           break;
+        }
 
-        case ZYDIS_MNEMONIC_KXORB:
-        case ZYDIS_MNEMONIC_KXORW:
-        case ZYDIS_MNEMONIC_KXORD:
-        case ZYDIS_MNEMONIC_KXORQ:
-          zydec_HintValue(0, pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = 0;"));
-          return true;
+        pIndex->pCheckpoints = pCheckpoints;
+        pIndex->checkpointCapacity = newCapacity;
+      }
 
-        default:
-          break;
-        }
+      if (!zydec_Unrolled_Reserve(&pIndex->pPendingTargets, &pIndex->pendingTargetCapacity, pIndex->pendingTargetCount + openTargetCount))
+      {
+        success = false;
+        break;
+      }
+
+      ZydecCheckpoint *pCheckpoint = &pIndex->pCheckpoints[pIndex->checkpointCount++];
+      pCheckpoint->virtualAddress = baseAddress + codeOffset;
+      pCheckpoint->instructionIndex = instructionIndex;
+      pCheckpoint->context = pTranslator->context;
+      pCheckpoint->flagProducer = pTranslator->flagProducer;
+      pCheckpoint->firstPendingTarget = pIndex->pendingTargetCount;
+      pCheckpoint->pendingTargetCount = openTargetCount;
+
+      if (openTargetCount != 0)
+        memcpy(pIndex->pPendingTargets + pIndex->pendingTargetCount, pOpenTargets, sizeof(uint64_t) * openTargetCount);
+
+      pIndex->pendingTargetCount += openTargetCount;
+    }
+
+    ZyanU64 target;
+
+    // Only forward jumps within the code can enter behind a later checkpoint.
+    if (fuseFlagConditions && (instruction.meta.category == ZYDIS_CATEGORY_COND_BR || instruction.meta.category == ZYDIS_CATEGORY_UNCOND_BR) && (instruction.attributes & ZYDIS_ATTRIB_IS_RELATIVE) != 0 && instruction.operand_count > 0 && ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instruction, &operands[0], baseAddress + codeOffset, &target)) && target > baseAddress + codeOffset && target - baseAddress < size)
+    {
+      if (!zydec_Unrolled_Reserve(&pOpenTargets, &openTargetCapacity, openTargetCount + 1))
+      {
+        success = false;
+        break;
+      }
+
+      size_t insertAt = openTargetCount;
+
+      while (insertAt > 0 && pOpenTargets[insertAt - 1] > target)
+        insertAt--;
+
+      if (insertAt == 0 || pOpenTargets[insertAt - 1] != target)
+      {
+        memmove(pOpenTargets + insertAt + 1, pOpenTargets + insertAt, sizeof(uint64_t) * (openTargetCount - insertAt));
+        pOpenTargets[insertAt] = target;
+        openTargetCount++;
       }
     }
 
-    ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-    ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[1], virtualAddress, pInfo));
-    
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_KSHIFTLB:
-    case ZYDIS_MNEMONIC_KSHIFTLW:
-    case ZYDIS_MNEMONIC_KSHIFTLD:
-    case ZYDIS_MNEMONIC_KSHIFTLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " << "));
-      break;
-      
-    case ZYDIS_MNEMONIC_KSHIFTRB:
-    case ZYDIS_MNEMONIC_KSHIFTRW:
-    case ZYDIS_MNEMONIC_KSHIFTRD:
-    case ZYDIS_MNEMONIC_KSHIFTRQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " >> "));
-      break;
+    zydec_Translator_AdvanceInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
+
+    if (fuseFlagConditions)
+      zydec_FlagProducer_Update(&pTranslator->flagProducer, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
+
+    instructionIndex++;
+    codeOffset += instruction.length;
+  }
+
+  pTranslator->context = contextBefore;
+  pTranslator->flagProducer = flagProducerBefore;
+  zydec_BranchTargets_Destroy(&branchTargets);
+  free(pOpenTargets);
+
+  if (!success)
+  {
+    zydec_DestroyCheckpointIndex(&pIndex);
+    return false;
+  }
+
+  *ppCheckpointIndex = pIndex;
+
+  return true;
+}
+
+void zydec_DestroyCheckpointIndex(ZydecCheckpointIndex **ppCheckpointIndex)
+{
+  if (ppCheckpointIndex == nullptr || *ppCheckpointIndex == nullptr)
+    return;
+
+  free((*ppCheckpointIndex)->pCheckpoints);
+  free((*ppCheckpointIndex)->pPendingTargets);
+
+  delete *ppCheckpointIndex;
+  *ppCheckpointIndex = nullptr;
+}
+
+bool zydec_Translator_RestoreCheckpoint(ZydecTranslator *pTranslator, const ZydecCheckpointIndex *pCheckpointIndex, const uint64_t virtualAddress, uint64_t *pCheckpointAddress, size_t *pInstructionIndex /* = nullptr */)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext || pCheckpointIndex == nullptr || pCheckpointAddress == nullptr)
+    return false;
+
+  // Find the last checkpoint at or before `virtualAddress`.
+  size_t first = 0;
+  size_t count = pCheckpointIndex->checkpointCount;
+
+  while (count > 0)
+  {
+    const size_t half = count / 2;
+
+    if (pCheckpointIndex->pCheckpoints[first + half].virtualAddress <= virtualAddress)
+    {
+      first += half + 1;
+      count -= half + 1;
+    }
+    else
+    {
+      count = half;
+    }
+  }
+
+  if (first == 0)
+    return false;
+
+  const ZydecCheckpoint *pCheckpoint = &pCheckpointIndex->pCheckpoints[first - 1];
+
+  if (!zydec_Unrolled_Reserve(&pTranslator->pResumeTargets, &pTranslator->resumeTargetCapacity, pCheckpoint->pendingTargetCount))
+    return false;
+
+  if (pCheckpoint->pendingTargetCount != 0)
+    memcpy(pTranslator->pResumeTargets, pCheckpointIndex->pPendingTargets + pCheckpoint->firstPendingTarget, sizeof(uint64_t) * pCheckpoint->pendingTargetCount);
+
+  pTranslator->resumeTargetCount = pCheckpoint->pendingTargetCount;
+  pTranslator->context = pCheckpoint->context;
+  pTranslator->flagProducer = pCheckpoint->flagProducer;
+  *pCheckpointAddress = pCheckpoint->virtualAddress;
+
+  if (pInstructionIndex != nullptr)
+    *pInstructionIndex = pCheckpoint->instructionIndex;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// The translation of a single partition, in its own arena.
+struct ZydecPartitionResult
+{
+  char *pText;
+  size_t textSize;
+  size_t textCapacity;
+  size_t *pOffsets;
+  size_t instructionCount;
+  size_t offsetCapacity;
+  bool success;
+};
+
+// Partitions are handed out from both ends of a range: The owner takes them in order from the front, idle workers steal from the back.
+struct ZydecWorkQueue
+{
+  std::mutex mutex;
+  size_t begin = 0;
+  size_t end = 0;
+};
+
+// Sets up `pWorker` to translate just like `pSource`, but with its own linear context.
+static void zydec_Translator_InitWorker(ZydecTranslator *pWorker, const ZydecTranslator *pSource)
+{
+  *pWorker = *pSource;
+  pWorker->originalInfo.pTokenList = nullptr; // Can't be shared between threads.
+  pWorker->originalInfo.pAddressCache = nullptr;
+  pWorker->pResumeTargets = nullptr; // Partitions start without any flags.
+  pWorker->resumeTargetCount = 0;
+  pWorker->resumeTargetCapacity = 0;
+
+  if (pWorker->mode == ZydecTranslatorMode::LinearContext)
+    zydec_LinearContext_PrepareFormattingInfo(&pWorker->formatContextInfo, &pWorker->info, &pWorker->context, &pWorker->originalInfo);
+  else
+    pWorker->info = pWorker->originalInfo;
+
+  zydec_Translator_BindFlagProducer(pWorker);
+}
+
+template <typename T>
+static bool zydec_Partition_Reserve(T **ppItems, size_t *pCapacity, const size_t count)
+{
+  if (count <= *pCapacity)
+    return true;
+
+  size_t newCapacity = *pCapacity == 0 ? 1024 : *pCapacity * 2;
+
+  while (newCapacity < count)
+    newCapacity *= 2;
+
+  T *pItems = reinterpret_cast<T *>(realloc(*ppItems, sizeof(T) * newCapacity));
+
+  if (pItems == nullptr)
+    return false;
+
+  *ppItems = pItems;
+  *pCapacity = newCapacity;
+
+  return true;
+}
+
+static void zydec_Translator_TranslatePartition(ZydecTranslator *pWorker, const ZydecLinearContext *pInitialContext, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, ZydecPartitionResult *pResult)
+{
+  constexpr size_t MinLineCapacity = 256;
+
+  pWorker->context = *pInitialContext;
+  pWorker->flagProducer.kind = zfpk_none;
+  pResult->success = false;
+
+  ZydecAddressCache *pAddressCache = nullptr;
+
+  if (pWorker->info.batchAddressResolution && !zydec_AddressCache_Create(&pAddressCache, &pWorker->decoder, pCode, size, baseAddress, &pWorker->info))
+    return;
+
+  ZydecUnrolledGroups *pUnrolledGroups = nullptr;
+
+  if (pWorker->info.collapseUnrolledGroups && !zydec_Unrolled_Create(&pUnrolledGroups, &pWorker->decoder, pCode, size))
+  {
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return;
+  }
+
+  ZydecBranchTargets branchTargets;
 
-    case ZYDIS_MNEMONIC_KADDB:
-    case ZYDIS_MNEMONIC_KADDW:
-    case ZYDIS_MNEMONIC_KADDD:
-    case ZYDIS_MNEMONIC_KADDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " + "));
-      break;
+  if (pWorker->info.fuseFlagConditions && !zydec_BranchTargets_Collect(&branchTargets, &pWorker->decoder, pCode, size, baseAddress))
+  {
+    zydec_BranchTargets_Destroy(&branchTargets);
+    zydec_Unrolled_Destroy(&pUnrolledGroups);
+    zydec_AddressCache_Destroy(&pAddressCache);
+    return;
+  }
 
-    case ZYDIS_MNEMONIC_KANDB:
-    case ZYDIS_MNEMONIC_KANDW:
-    case ZYDIS_MNEMONIC_KANDD:
-    case ZYDIS_MNEMONIC_KANDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " & "));
-      break;
+  pWorker->info.pAddressCache = pAddressCache;
 
-    case ZYDIS_MNEMONIC_KORB:
-    case ZYDIS_MNEMONIC_KORW:
-    case ZYDIS_MNEMONIC_KORD:
-    case ZYDIS_MNEMONIC_KORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " | "));
-      break;
+  ZydecUnrolledCursor cursor;
+  cursor.pGroups = pUnrolledGroups;
 
-    case ZYDIS_MNEMONIC_KXORB:
-    case ZYDIS_MNEMONIC_KXORW:
-    case ZYDIS_MNEMONIC_KXORD:
-    case ZYDIS_MNEMONIC_KXORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " ^ "));
-      break;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    default:
+  size_t codeOffset = 0;
+
+  while (true)
+  {
+    if (codeOffset == size)
+    {
+      pResult->success = true;
       break;
     }
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[2], virtualAddress, pInfo));
+    if (!zydec_DecodeInstruction(&pWorker->decoder, pCode + codeOffset, size - codeOffset, &instruction, operands, pWorker->info.fuseFlagConditions))
+      break;
 
-    break;
-  }
+    if (!zydec_Partition_Reserve(&pResult->pOffsets, &pResult->offsetCapacity, pResult->instructionCount + 1) || !zydec_Partition_Reserve(&pResult->pText, &pResult->textCapacity, pResult->textSize + MinLineCapacity))
+      break;
 
-  case ZYDIS_MNEMONIC_MOVAPS:
-  case ZYDIS_MNEMONIC_MOVAPD:
-  case ZYDIS_MNEMONIC_MOVDQA:
-  case ZYDIS_MNEMONIC_VMOVAPS:
-  case ZYDIS_MNEMONIC_VMOVAPD:
-  case ZYDIS_MNEMONIC_VMOVDQA:
-  case ZYDIS_MNEMONIC_VMOVDQA32:
-  case ZYDIS_MNEMONIC_VMOVDQA64:
-  case ZYDIS_MNEMONIC_MOVNTDQ:
-  case ZYDIS_MNEMONIC_VMOVNTDQ:
-  case ZYDIS_MNEMONIC_MOVNTPD:
-  case ZYDIS_MNEMONIC_VMOVNTPD:
-  case ZYDIS_MNEMONIC_MOVNTPS:
-  case ZYDIS_MNEMONIC_VMOVNTPS:
-  case ZYDIS_MNEMONIC_MOVNTDQA:
-  case ZYDIS_MNEMONIC_VMOVNTDQA:
-  {
-    zydec_HintOp(ZydecFormattingInfo::Mov, pInfo);
-    zydec_HintOperand(&pOperands[1], pInfo);
+    zydec_BranchTargets_Enter(&branchTargets, codeOffset, &pWorker->flagProducer);
 
-    bool isReg2RegMove = false;
-    size_t operandIndex = 0;
+    ZydecString annotation;
+    const ZydecUnrolledRole role = zydec_Unrolled_Next(&cursor, &annotation);
 
-    if (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[0].type == ZYDIS_OPERAND_TYPE_POINTER)
-    {
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_aligned_store"));
-    }
-    else if (pOperands[1].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[1].type == ZYDIS_OPERAND_TYPE_POINTER)
+    if (role == zur_collapse)
     {
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = _mm_aligned_load"));
-    }
-    else if (pInstruction->operand_count == 2)
-    {
-      isReg2RegMove = true;
-    }
-    else
-    {
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref));
+      zydec_Translator_SkipInstruction(pWorker, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset));
 
-      if (pInstruction->operand_count == 3)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = _mm_maskz_mov"));
-      else if (pInstruction->operand_count == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = _mm_mask_mov"));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = _mm_mov"));
+      pResult->pText[pResult->textSize] = '\0';
+      pResult->pOffsets[pResult->instructionCount++] = pResult->textSize++;
+      codeOffset += instruction.length;
+      continue;
     }
 
-    if (!isReg2RegMove)
-    {
-      switch (pInstruction->mnemonic)
-      {
-      case ZYDIS_MNEMONIC_MOVAPS:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_ps("));
-        break;
-
-      case ZYDIS_MNEMONIC_MOVAPD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_pd("));
-        break;
+    bool hasTranslation = false;
+    size_t requiredCapacity = 0;
 
-      case ZYDIS_MNEMONIC_MOVDQA:
-      case ZYDIS_MNEMONIC_VMOVDQA:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_si("));
-        break;
+    bool result = zydec_Translator_TranslateInstruction(pWorker, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset), pResult->pText + pResult->textSize, pResult->textCapacity - pResult->textSize, &hasTranslation, &requiredCapacity);
 
-      case ZYDIS_MNEMONIC_VMOVDQA32:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi32("));
+    if (!result && requiredCapacity != 0)
+    {
+      if (!zydec_Partition_Reserve(&pResult->pText, &pResult->textCapacity, pResult->textSize + requiredCapacity))
         break;
 
-      case ZYDIS_MNEMONIC_VMOVDQA64:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi64("));
-        break;
+      result = zydec_Translator_TranslateInstruction(pWorker, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(baseAddress + codeOffset), pResult->pText + pResult->textSize, pResult->textCapacity - pResult->textSize, &hasTranslation);
+    }
 
-      case ZYDIS_MNEMONIC_MOVNTDQ:
-      case ZYDIS_MNEMONIC_VMOVNTDQ:
-      case ZYDIS_MNEMONIC_MOVNTDQA:
-      case ZYDIS_MNEMONIC_VMOVNTDQA:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_stream_si("));
-        break;
+    if (!result && hasTranslation)
+      break;
 
-      case ZYDIS_MNEMONIC_MOVNTPD:
-      case ZYDIS_MNEMONIC_VMOVNTPD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_stream_pd("));
-        break;
+    if (role == zur_annotate)
+    {
+      const size_t length = hasTranslation ? strlen(pResult->pText + pResult->textSize) : 0;
 
-      case ZYDIS_MNEMONIC_MOVNTPS:
-      case ZYDIS_MNEMONIC_VMOVNTPS:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_stream_ps("));
+      if (!zydec_Partition_Reserve(&pResult->pText, &pResult->textCapacity, pResult->textSize + zydec_Unrolled_AnnotatedCapacity(length + 1, annotation)))
         break;
 
-      default:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "("));
+      if (!zydec_Unrolled_Annotate(pResult->pText + pResult->textSize, pResult->textCapacity - pResult->textSize, true, &hasTranslation, annotation))
         break;
-      }
     }
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref, isReg2RegMove));
-    const size_t startOperandIndex = operandIndex;
-
-    if (isReg2RegMove)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    else if (startOperandIndex < pInstruction->operand_count)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
-
-    for (; operandIndex < pInstruction->operand_count; operandIndex++)
-    {
-      if (operandIndex > startOperandIndex)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
+    char *line = pResult->pText + pResult->textSize;
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex], virtualAddress, pInfo, zof_noAddressDeref));
-    }
-
-    if (!isReg2RegMove)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
+    if (!hasTranslation)
+      line[0] = '\0';
 
-    break;
+    pResult->pOffsets[pResult->instructionCount++] = pResult->textSize;
+    pResult->textSize += strlen(line) + 1;
+    codeOffset += instruction.length;
   }
 
-  case ZYDIS_MNEMONIC_MOVUPS:
-  case ZYDIS_MNEMONIC_MOVUPD:
-  case ZYDIS_MNEMONIC_MOVQ:
-  case ZYDIS_MNEMONIC_MOVD:
-  case ZYDIS_MNEMONIC_MOVSS:
-  case ZYDIS_MNEMONIC_MOVSD:
-  case ZYDIS_MNEMONIC_MOVDQU:
-  case ZYDIS_MNEMONIC_MOVDQ2Q:
-  case ZYDIS_MNEMONIC_VMOVUPS:
-  case ZYDIS_MNEMONIC_VMOVUPD:
-  case ZYDIS_MNEMONIC_VMOVQ:
-  case ZYDIS_MNEMONIC_VMOVD:
-  case ZYDIS_MNEMONIC_VMOVSS:
-  case ZYDIS_MNEMONIC_VMOVSD:
-  case ZYDIS_MNEMONIC_VMOVSH:
-  case ZYDIS_MNEMONIC_VMOVDQU:
-  case ZYDIS_MNEMONIC_VMOVDQU16:
-  case ZYDIS_MNEMONIC_VMOVDQU32:
-  case ZYDIS_MNEMONIC_VMOVDQU64:
-  case ZYDIS_MNEMONIC_VMOVDQU8:
-  case ZYDIS_MNEMONIC_LDDQU:
-  case ZYDIS_MNEMONIC_VPMASKMOVD:
-  case ZYDIS_MNEMONIC_VPMASKMOVQ:
-  case ZYDIS_MNEMONIC_VMASKMOVPD:
-  case ZYDIS_MNEMONIC_VMASKMOVPS:
-  case ZYDIS_MNEMONIC_MASKMOVQ:
-  case ZYDIS_MNEMONIC_MASKMOVDQU:
-  {
-    zydec_HintOp(ZydecFormattingInfo::Mov, pInfo);
-    zydec_HintOperand(&pOperands[1], pInfo);
+  pWorker->info.pAddressCache = nullptr;
+  zydec_AddressCache_Destroy(&pAddressCache);
+  zydec_Unrolled_Destroy(&pUnrolledGroups);
+  zydec_BranchTargets_Destroy(&branchTargets);
+}
 
-    bool isReg2RegMove = false;
-    size_t operandIndex = 0;
+static void zydec_Translator_RunPartitionWorker(const size_t workerIndex, const size_t workerCount, ZydecTranslator *pWorkers, ZydecWorkQueue *pQueues, const ZydecLinearContext *pInitialContext, const uint8_t *pCode, const uint64_t baseAddress, const ZydecCodePartition *pPartitions, ZydecPartitionResult *pResults)
+{
+  while (true)
+  {
+    size_t partitionIndex = SIZE_MAX;
 
-    if (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[0].type == ZYDIS_OPERAND_TYPE_POINTER)
-    {
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unaligned_store"));
-    }
-    else if (pOperands[1].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[1].type == ZYDIS_OPERAND_TYPE_POINTER)
     {
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = _mm_unaligned_load"));
-    }
-    else if (pInstruction->operand_count == 2)
-    {
-      isReg2RegMove = true;
-    }
-    else
-    {
-      if (pInstruction->operand_count == 3)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_maskz_mov_unaligned"));
-      else if (pInstruction->operand_count == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_mov_unaligned"));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mov_unaligned"));
+      ZydecWorkQueue *pOwnQueue = &pQueues[workerIndex];
+      std::lock_guard<std::mutex> lock(pOwnQueue->mutex);
+
+      if (pOwnQueue->begin < pOwnQueue->end)
+        partitionIndex = pOwnQueue->begin++;
     }
 
-    if (!isReg2RegMove)
+    for (size_t i = 1; i < workerCount && partitionIndex == SIZE_MAX; i++)
     {
-      switch (pInstruction->mnemonic)
-      {
-      case ZYDIS_MNEMONIC_MOVUPS:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_ps("));
-        break;
-
-      case ZYDIS_MNEMONIC_MOVUPD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_pd("));
-        break;
-
-      case ZYDIS_MNEMONIC_MOVD:
-      case ZYDIS_MNEMONIC_VMOVD:
-      case ZYDIS_MNEMONIC_VMOVDQU32:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi32("));
-        break;
+      ZydecWorkQueue *pVictim = &pQueues[(workerIndex + i) % workerCount];
+      std::lock_guard<std::mutex> lock(pVictim->mutex);
 
-      case ZYDIS_MNEMONIC_MOVQ:
-      case ZYDIS_MNEMONIC_VMOVQ:
-      case ZYDIS_MNEMONIC_VMOVDQU64:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi64("));
-        break;
+      if (pVictim->begin < pVictim->end)
+        partitionIndex = --pVictim->end;
+    }
 
-      case ZYDIS_MNEMONIC_VPMASKMOVD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mask_epi32("));
-        break;
+    // Partitions are never added, so there's nothing left to do once every queue is empty.
+    if (partitionIndex == SIZE_MAX)
+      return;
 
-      case ZYDIS_MNEMONIC_VPMASKMOVQ:
-      case ZYDIS_MNEMONIC_MASKMOVQ:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mask_epi64("));
-        break;
+    const ZydecCodePartition *pPartition = &pPartitions[partitionIndex];
+    zydec_Translator_TranslatePartition(&pWorkers[workerIndex], pInitialContext, pCode + pPartition->offset, pPartition->size, baseAddress + pPartition->offset, &pResults[partitionIndex]);
+  }
+}
 
-      case ZYDIS_MNEMONIC_VMASKMOVPD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mask_pd("));
-        break;
+bool zydec_Translator_TranslatePartitions(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const ZydecCodePartition *pPartitions, const size_t partitionCount, const size_t threadCount, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity /* = nullptr */)
+{
+  if (pRequiredArenaCapacity != nullptr)
+    *pRequiredArenaCapacity = 0;
 
-      case ZYDIS_MNEMONIC_VMASKMOVPS:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mask_ps("));
-        break;
+  if (pTranslator == nullptr || pCode == nullptr || (pPartitions == nullptr && partitionCount != 0) || pArena == nullptr || arenaCapacity == 0 || pOffsets == nullptr || pInstructionCount == nullptr)
+    return false;
 
-      case ZYDIS_MNEMONIC_MASKMOVDQU:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mask_si128("));
-        break;
+  *pInstructionCount = 0;
+  pArena[0] = '\0';
 
-      case ZYDIS_MNEMONIC_MOVSS:
-      case ZYDIS_MNEMONIC_VMOVSS:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_ss("));
-        break;
+  for (size_t i = 0; i < partitionCount; i++)
+    if (pPartitions[i].offset > size || pPartitions[i].size > size - pPartitions[i].offset)
+      return false;
 
-      case ZYDIS_MNEMONIC_MOVSD:
-      case ZYDIS_MNEMONIC_VMOVSD:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_sd("));
-        break;
+  size_t workerCount = threadCount != 0 ? threadCount : std::thread::hardware_concurrency();
 
-      case ZYDIS_MNEMONIC_VMOVSH:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_sh("));
-        break;
+  if (workerCount == 0)
+    workerCount = 1;
 
-      case ZYDIS_MNEMONIC_LDDQU:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_cross_cache_line_si("));
-        break;
+  if (workerCount > partitionCount)
+    workerCount = partitionCount;
 
-      case ZYDIS_MNEMONIC_MOVDQU:
-      case ZYDIS_MNEMONIC_VMOVDQU:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_si("));
-        break;
+  ZydecPartitionResult *pResults = reinterpret_cast<ZydecPartitionResult *>(calloc(partitionCount + 1, sizeof(ZydecPartitionResult)));
+  ZydecTranslator *pWorkers = new (std::nothrow) ZydecTranslator[workerCount + 1];
+  ZydecWorkQueue *pQueues = new (std::nothrow) ZydecWorkQueue[workerCount + 1];
+  std::thread *pThreads = new (std::nothrow) std::thread[workerCount + 1];
 
-      case ZYDIS_MNEMONIC_VMOVDQU16:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi16("));
-        break;
+  bool success = pResults != nullptr && pWorkers != nullptr && pQueues != nullptr && pThreads != nullptr;
 
-      case ZYDIS_MNEMONIC_VMOVDQU8:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_epi8("));
-        break;
+  if (success && partitionCount != 0)
+  {
+    const ZydecLinearContext initialContext = pTranslator->context;
 
-      case ZYDIS_MNEMONIC_MOVDQ2Q:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_pi("));
-        break;
+    for (size_t i = 0; i < workerCount; i++)
+    {
+      zydec_Translator_InitWorker(&pWorkers[i], pTranslator);
 
-      default:
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "("));
-        break;
-      }
+      // Start with neighbouring partitions per worker.
+      pQueues[i].begin = partitionCount * i / workerCount;
+      pQueues[i].end = partitionCount * (i + 1) / workerCount;
     }
 
-    ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex++], virtualAddress, pInfo, zof_noAddressDeref, isReg2RegMove));
-    const size_t startOperandIndex = operandIndex;
-
-    if (isReg2RegMove)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    else if (startOperandIndex < pInstruction->operand_count)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
+    for (size_t i = 1; i < workerCount; i++)
+      pThreads[i] = std::thread(zydec_Translator_RunPartitionWorker, i, workerCount, pWorkers, pQueues, &initialContext, pCode, baseAddress, pPartitions, pResults);
 
-    for (; operandIndex < pInstruction->operand_count; operandIndex++)
-    {
-      if (operandIndex > startOperandIndex)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
+    zydec_Translator_RunPartitionWorker(0, workerCount, pWorkers, pQueues, &initialContext, pCode, baseAddress, pPartitions, pResults);
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex], virtualAddress, pInfo, zof_noAddressDeref));
-    }
+    for (size_t i = 1; i < workerCount; i++)
+      pThreads[i].join();
 
-    if (!isReg2RegMove)
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
+    // Stitch the partitions back together in order.
+    size_t arenaOffset = 0;
 
-    break;
-  }
+    for (size_t i = 0; i < partitionCount && success; i++)
+    {
+      const ZydecPartitionResult *pResult = &pResults[i];
 
-  case ZYDIS_MNEMONIC_PAND:
-  case ZYDIS_MNEMONIC_VPAND:
-  case ZYDIS_MNEMONIC_VPANDQ:
-  case ZYDIS_MNEMONIC_VPANDD:
-  case ZYDIS_MNEMONIC_PANDN:
-  case ZYDIS_MNEMONIC_VPANDN:
-  case ZYDIS_MNEMONIC_VPANDNQ:
-  case ZYDIS_MNEMONIC_VPANDND:
-  case ZYDIS_MNEMONIC_PCMPEQB:
-  case ZYDIS_MNEMONIC_PCMPEQW:
-  case ZYDIS_MNEMONIC_PCMPEQD:
-  case ZYDIS_MNEMONIC_PCMPEQQ:
-  case ZYDIS_MNEMONIC_VPCMPEQB:
-  case ZYDIS_MNEMONIC_VPCMPEQW:
-  case ZYDIS_MNEMONIC_VPCMPEQD:
-  case ZYDIS_MNEMONIC_VPCMPEQQ:
-  case ZYDIS_MNEMONIC_PCMPGTB:
-  case ZYDIS_MNEMONIC_PCMPGTW:
-  case ZYDIS_MNEMONIC_PCMPGTD:
-  case ZYDIS_MNEMONIC_PCMPGTQ:
-  case ZYDIS_MNEMONIC_VPCMPGTB:
-  case ZYDIS_MNEMONIC_VPCMPGTW:
-  case ZYDIS_MNEMONIC_VPCMPGTD:
-  case ZYDIS_MNEMONIC_VPCMPGTQ:
-  case ZYDIS_MNEMONIC_PACKUSWB:
-  case ZYDIS_MNEMONIC_PACKUSDW:
-  case ZYDIS_MNEMONIC_VPACKUSWB:
-  case ZYDIS_MNEMONIC_VPACKUSDW:
-  case ZYDIS_MNEMONIC_PACKSSWB:
-  case ZYDIS_MNEMONIC_PACKSSDW:
-  case ZYDIS_MNEMONIC_VPACKSSWB:
-  case ZYDIS_MNEMONIC_VPACKSSDW:
-  case ZYDIS_MNEMONIC_PADDB:
-  case ZYDIS_MNEMONIC_PADDW:
-  case ZYDIS_MNEMONIC_PADDD:
-  case ZYDIS_MNEMONIC_PADDQ:
-  case ZYDIS_MNEMONIC_VPADDB:
-  case ZYDIS_MNEMONIC_VPADDW:
-  case ZYDIS_MNEMONIC_VPADDD:
-  case ZYDIS_MNEMONIC_VPADDQ:
-  case ZYDIS_MNEMONIC_ADDPS:
-  case ZYDIS_MNEMONIC_ADDPD:
-  case ZYDIS_MNEMONIC_ADDSS:
-  case ZYDIS_MNEMONIC_ADDSD:
-  case ZYDIS_MNEMONIC_VADDPS:
-  case ZYDIS_MNEMONIC_VADDPD:
-  case ZYDIS_MNEMONIC_VADDSS:
-  case ZYDIS_MNEMONIC_VADDSD:
-  case ZYDIS_MNEMONIC_PADDSB:
-  case ZYDIS_MNEMONIC_PADDSW:
-  case ZYDIS_MNEMONIC_VPADDSB:
-  case ZYDIS_MNEMONIC_VPADDSW:
-  case ZYDIS_MNEMONIC_EMMS:
-  case ZYDIS_MNEMONIC_PMADDWD:
-  case ZYDIS_MNEMONIC_VPMADDWD:
-  case ZYDIS_MNEMONIC_PMULHW:
-  case ZYDIS_MNEMONIC_VPMULHW:
-  case ZYDIS_MNEMONIC_PMULLW:
-  case ZYDIS_MNEMONIC_VPMULLW:
-  case ZYDIS_MNEMONIC_POR:
-  case ZYDIS_MNEMONIC_VPOR:
-  case ZYDIS_MNEMONIC_VPORD:
-  case ZYDIS_MNEMONIC_VPORQ:
-  case ZYDIS_MNEMONIC_PABSW:
-  case ZYDIS_MNEMONIC_VPABSW:
-  case ZYDIS_MNEMONIC_PABSB:
-  case ZYDIS_MNEMONIC_VPABSB:
-  case ZYDIS_MNEMONIC_PABSD:
-  case ZYDIS_MNEMONIC_VPABSD:
-  case ZYDIS_MNEMONIC_ADDSUBPS:
-  case ZYDIS_MNEMONIC_VADDSUBPS:
-  case ZYDIS_MNEMONIC_ADDSUBPD:
-  case ZYDIS_MNEMONIC_VADDSUBPD:
-  case ZYDIS_MNEMONIC_PALIGNR:
-  case ZYDIS_MNEMONIC_VPALIGNR:
-  case ZYDIS_MNEMONIC_PAVGB:
-  case ZYDIS_MNEMONIC_VPAVGB:
-  case ZYDIS_MNEMONIC_PAVGW:
-  case ZYDIS_MNEMONIC_VPAVGW:
-  case ZYDIS_MNEMONIC_PBLENDW:
-  case ZYDIS_MNEMONIC_VPBLENDW:
-  case ZYDIS_MNEMONIC_PBLENDVB:
-  case ZYDIS_MNEMONIC_VPBLENDVB:
-  case ZYDIS_MNEMONIC_VPBLENDD:
-  case ZYDIS_MNEMONIC_BLENDPS:
-  case ZYDIS_MNEMONIC_VBLENDPS:
-  case ZYDIS_MNEMONIC_BLENDPD:
-  case ZYDIS_MNEMONIC_VBLENDPD:
-  case ZYDIS_MNEMONIC_BLENDVPS:
-  case ZYDIS_MNEMONIC_VBLENDVPS:
-  case ZYDIS_MNEMONIC_BLENDVPD:
-  case ZYDIS_MNEMONIC_VBLENDVPD:
-  case ZYDIS_MNEMONIC_VBROADCASTF128:
-  case ZYDIS_MNEMONIC_VBROADCASTF32X2:
-  case ZYDIS_MNEMONIC_VBROADCASTF32X4:
-  case ZYDIS_MNEMONIC_VBROADCASTF32X8:
-  case ZYDIS_MNEMONIC_VBROADCASTF64X2:
-  case ZYDIS_MNEMONIC_VBROADCASTF64X4:
-  case ZYDIS_MNEMONIC_VBROADCASTI128:
-  case ZYDIS_MNEMONIC_VBROADCASTI32X2:
-  case ZYDIS_MNEMONIC_VBROADCASTI32X4:
-  case ZYDIS_MNEMONIC_VBROADCASTI32X8:
-  case ZYDIS_MNEMONIC_VBROADCASTI64X2:
-  case ZYDIS_MNEMONIC_VBROADCASTI64X4:
-  case ZYDIS_MNEMONIC_VBROADCASTSD:
-  case ZYDIS_MNEMONIC_VBROADCASTSS:
-  case ZYDIS_MNEMONIC_VPBROADCASTB:
-  case ZYDIS_MNEMONIC_VPBROADCASTD:
-  case ZYDIS_MNEMONIC_VPBROADCASTMB2Q:
-  case ZYDIS_MNEMONIC_VPBROADCASTMW2D:
-  case ZYDIS_MNEMONIC_VPBROADCASTQ:
-  case ZYDIS_MNEMONIC_VPBROADCASTW:
-  case ZYDIS_MNEMONIC_PSLLDQ:
-  case ZYDIS_MNEMONIC_VPSLLDQ:
-  case ZYDIS_MNEMONIC_PSRLDQ:
-  case ZYDIS_MNEMONIC_VPSRLDQ:
-  case ZYDIS_MNEMONIC_ROUNDSS:
-  case ZYDIS_MNEMONIC_VROUNDSS:
-  case ZYDIS_MNEMONIC_ROUNDSD:
-  case ZYDIS_MNEMONIC_VROUNDSD:
-  case ZYDIS_MNEMONIC_ROUNDPS:
-  case ZYDIS_MNEMONIC_VROUNDPS:
-  case ZYDIS_MNEMONIC_ROUNDPD:
-  case ZYDIS_MNEMONIC_VROUNDPD:
-  case ZYDIS_MNEMONIC_CLFLUSH:
-  case ZYDIS_MNEMONIC_CLFLUSHOPT:
-  case ZYDIS_MNEMONIC_CMPSS:
-  case ZYDIS_MNEMONIC_VCMPSS:
-  case ZYDIS_MNEMONIC_CMPSD:
-  case ZYDIS_MNEMONIC_VCMPSD:
-  case ZYDIS_MNEMONIC_CMPPS:
-  case ZYDIS_MNEMONIC_VCMPPS:
-  case ZYDIS_MNEMONIC_CMPPD:
-  case ZYDIS_MNEMONIC_VCMPPD:
-  case ZYDIS_MNEMONIC_PCMPESTRI:
-  case ZYDIS_MNEMONIC_PCMPESTRM:
-  case ZYDIS_MNEMONIC_COMISS:
-  case ZYDIS_MNEMONIC_VCOMISS:
-  case ZYDIS_MNEMONIC_COMISD:
-  case ZYDIS_MNEMONIC_VCOMISD:
-  case ZYDIS_MNEMONIC_VCOMISH:
-  case ZYDIS_MNEMONIC_CRC32:
-  case ZYDIS_MNEMONIC_CVTPI2PS:
-  case ZYDIS_MNEMONIC_CVTPS2PI:
-  case ZYDIS_MNEMONIC_CVTSI2SS:
-  case ZYDIS_MNEMONIC_VCVTSI2SS:
-  case ZYDIS_MNEMONIC_CVTSS2SI:
-  case ZYDIS_MNEMONIC_VCVTSS2SI:
-  case ZYDIS_MNEMONIC_PMOVSXWD:
-  case ZYDIS_MNEMONIC_VPMOVSXWD:
-  case ZYDIS_MNEMONIC_PMOVSXWQ:
-  case ZYDIS_MNEMONIC_VPMOVSXWQ:
-  case ZYDIS_MNEMONIC_PMOVSXDQ:
-  case ZYDIS_MNEMONIC_VPMOVSXDQ:
-  case ZYDIS_MNEMONIC_CVTDQ2PS:
-  case ZYDIS_MNEMONIC_VCVTDQ2PS:
-  case ZYDIS_MNEMONIC_CVTDQ2PD:
-  case ZYDIS_MNEMONIC_VCVTDQ2PD:
-  case ZYDIS_MNEMONIC_PMOVSXBW:
-  case ZYDIS_MNEMONIC_VPMOVSXBW:
-  case ZYDIS_MNEMONIC_PMOVSXBD:
-  case ZYDIS_MNEMONIC_VPMOVSXBD:
-  case ZYDIS_MNEMONIC_PMOVSXBQ:
-  case ZYDIS_MNEMONIC_VPMOVSXBQ:
-  case ZYDIS_MNEMONIC_PMOVZXWD:
-  case ZYDIS_MNEMONIC_VPMOVZXWD:
-  case ZYDIS_MNEMONIC_PMOVZXWQ:
-  case ZYDIS_MNEMONIC_VPMOVZXWQ:
-  case ZYDIS_MNEMONIC_PMOVZXDQ:
-  case ZYDIS_MNEMONIC_VPMOVZXDQ:
-  case ZYDIS_MNEMONIC_PMOVZXBW:
-  case ZYDIS_MNEMONIC_VPMOVZXBW:
-  case ZYDIS_MNEMONIC_PMOVZXBD:
-  case ZYDIS_MNEMONIC_VPMOVZXBD:
-  case ZYDIS_MNEMONIC_PMOVZXBQ:
-  case ZYDIS_MNEMONIC_VPMOVZXBQ:
-  case ZYDIS_MNEMONIC_VCVTPH2PS:
-  case ZYDIS_MNEMONIC_VCVTNEPS2BF16:
-  case ZYDIS_MNEMONIC_CVTPD2DQ:
-  case ZYDIS_MNEMONIC_VCVTPD2DQ:
-  case ZYDIS_MNEMONIC_CVTPD2PI:
-  case ZYDIS_MNEMONIC_CVTPD2PS:
-  case ZYDIS_MNEMONIC_VCVTPD2PS:
-  case ZYDIS_MNEMONIC_CVTPI2PD:
-  case ZYDIS_MNEMONIC_CVTPS2DQ:
-  case ZYDIS_MNEMONIC_VCVTPS2DQ:
-  case ZYDIS_MNEMONIC_CVTPS2PD:
-  case ZYDIS_MNEMONIC_VCVTPS2PD:
-  case ZYDIS_MNEMONIC_VCVTPS2PH:
-  case ZYDIS_MNEMONIC_CVTSD2SI:
-  case ZYDIS_MNEMONIC_VCVTSD2SI:
-  case ZYDIS_MNEMONIC_CVTSD2SS:
-  case ZYDIS_MNEMONIC_VCVTSD2SS:
-  case ZYDIS_MNEMONIC_CVTSI2SD:
-  case ZYDIS_MNEMONIC_VCVTSI2SD:
-  case ZYDIS_MNEMONIC_CVTSS2SD:
-  case ZYDIS_MNEMONIC_VCVTSS2SD:
-  case ZYDIS_MNEMONIC_CVTTPS2PI:
-  case ZYDIS_MNEMONIC_CVTTPD2DQ:
-  case ZYDIS_MNEMONIC_VCVTTPD2DQ:
-  case ZYDIS_MNEMONIC_CVTTPD2PI:
-  case ZYDIS_MNEMONIC_CVTTPS2DQ:
-  case ZYDIS_MNEMONIC_VCVTTPS2DQ:
-  case ZYDIS_MNEMONIC_CVTTSD2SI:
-  case ZYDIS_MNEMONIC_DIVPD:
-  case ZYDIS_MNEMONIC_DIVPS:
-  case ZYDIS_MNEMONIC_DIVSD:
-  case ZYDIS_MNEMONIC_DIVSS:
-  case ZYDIS_MNEMONIC_VDIVPD:
-  case ZYDIS_MNEMONIC_VDIVPS:
-  case ZYDIS_MNEMONIC_VDIVSD:
-  case ZYDIS_MNEMONIC_VDIVSS:
-  case ZYDIS_MNEMONIC_DPPD:
-  case ZYDIS_MNEMONIC_VDPPD:
-  case ZYDIS_MNEMONIC_DPPS:
-  case ZYDIS_MNEMONIC_VDPPS:
-  case ZYDIS_MNEMONIC_VPDPWSSD:
-  case ZYDIS_MNEMONIC_VPDPWSSDS:
-  case ZYDIS_MNEMONIC_VPDPBUSD:
-  case ZYDIS_MNEMONIC_VPDPBUSDS:
-  case ZYDIS_MNEMONIC_PEXTRB:
-  case ZYDIS_MNEMONIC_VPEXTRB:
-  case ZYDIS_MNEMONIC_PEXTRW:
-  case ZYDIS_MNEMONIC_VPEXTRW:
-  case ZYDIS_MNEMONIC_PEXTRD:
-  case ZYDIS_MNEMONIC_VPEXTRD:
-  case ZYDIS_MNEMONIC_PEXTRQ:
-  case ZYDIS_MNEMONIC_VPEXTRQ:
-  case ZYDIS_MNEMONIC_EXTRACTPS:
-  case ZYDIS_MNEMONIC_VEXTRACTPS:
-  case ZYDIS_MNEMONIC_VEXTRACTF128:
-  case ZYDIS_MNEMONIC_VEXTRACTI128:
-  case ZYDIS_MNEMONIC_VFMADD132PD:
-  case ZYDIS_MNEMONIC_VFMADD213PD:
-  case ZYDIS_MNEMONIC_VFMADD231PD:
-  case ZYDIS_MNEMONIC_VFMADD132PS:
-  case ZYDIS_MNEMONIC_VFMADD213PS:
-  case ZYDIS_MNEMONIC_VFMADD231PS:
-  case ZYDIS_MNEMONIC_VFMADD132SD:
-  case ZYDIS_MNEMONIC_VFMADD213SD:
-  case ZYDIS_MNEMONIC_VFMADD231SD:
-  case ZYDIS_MNEMONIC_VFMADD132SS:
-  case ZYDIS_MNEMONIC_VFMADD213SS:
-  case ZYDIS_MNEMONIC_VFMADD231SS:
-  case ZYDIS_MNEMONIC_VFMADDSUB132PD:
-  case ZYDIS_MNEMONIC_VFMADDSUB213PD:
-  case ZYDIS_MNEMONIC_VFMADDSUB231PD:
-  case ZYDIS_MNEMONIC_VFMADDSUB132PS:
-  case ZYDIS_MNEMONIC_VFMADDSUB213PS:
-  case ZYDIS_MNEMONIC_VFMADDSUB231PS:
-  case ZYDIS_MNEMONIC_VFMSUB132PD:
-  case ZYDIS_MNEMONIC_VFMSUB213PD:
-  case ZYDIS_MNEMONIC_VFMSUB231PD:
-  case ZYDIS_MNEMONIC_VFMSUB132PS:
-  case ZYDIS_MNEMONIC_VFMSUB213PS:
-  case ZYDIS_MNEMONIC_VFMSUB231PS:
-  case ZYDIS_MNEMONIC_VFMSUB132SD:
-  case ZYDIS_MNEMONIC_VFMSUB213SD:
-  case ZYDIS_MNEMONIC_VFMSUB231SD:
-  case ZYDIS_MNEMONIC_VFMSUB132SS:
-  case ZYDIS_MNEMONIC_VFMSUB213SS:
-  case ZYDIS_MNEMONIC_VFMSUB231SS:
-  case ZYDIS_MNEMONIC_VFMSUBADD132PD:
-  case ZYDIS_MNEMONIC_VFMSUBADD213PD:
-  case ZYDIS_MNEMONIC_VFMSUBADD231PD:
-  case ZYDIS_MNEMONIC_VFMSUBADD132PS:
-  case ZYDIS_MNEMONIC_VFMSUBADD213PS:
-  case ZYDIS_MNEMONIC_VFMSUBADD231PS:
-  case ZYDIS_MNEMONIC_VFNMADD132PD:
-  case ZYDIS_MNEMONIC_VFNMADD213PD:
-  case ZYDIS_MNEMONIC_VFNMADD231PD:
-  case ZYDIS_MNEMONIC_VFNMADD132PS:
-  case ZYDIS_MNEMONIC_VFNMADD213PS:
-  case ZYDIS_MNEMONIC_VFNMADD231PS:
-  case ZYDIS_MNEMONIC_VFNMADD132SD:
-  case ZYDIS_MNEMONIC_VFNMADD213SD:
-  case ZYDIS_MNEMONIC_VFNMADD231SD:
-  case ZYDIS_MNEMONIC_VFNMADD132SS:
-  case ZYDIS_MNEMONIC_VFNMADD213SS:
-  case ZYDIS_MNEMONIC_VFNMADD231SS:
-  case ZYDIS_MNEMONIC_VFNMSUB132PD:
-  case ZYDIS_MNEMONIC_VFNMSUB213PD:
-  case ZYDIS_MNEMONIC_VFNMSUB231PD:
-  case ZYDIS_MNEMONIC_VFNMSUB132PS:
-  case ZYDIS_MNEMONIC_VFNMSUB213PS:
-  case ZYDIS_MNEMONIC_VFNMSUB231PS:
-  case ZYDIS_MNEMONIC_VFNMSUB132SD:
-  case ZYDIS_MNEMONIC_VFNMSUB213SD:
-  case ZYDIS_MNEMONIC_VFNMSUB231SD:
-  case ZYDIS_MNEMONIC_VFNMSUB132SS:
-  case ZYDIS_MNEMONIC_VFNMSUB213SS:
-  case ZYDIS_MNEMONIC_VFNMSUB231SS:
-  case ZYDIS_MNEMONIC_STMXCSR:
-  case ZYDIS_MNEMONIC_PHADDW:
-  case ZYDIS_MNEMONIC_VPHADDW:
-  case ZYDIS_MNEMONIC_PHADDD:
-  case ZYDIS_MNEMONIC_VPHADDD:
-  case ZYDIS_MNEMONIC_HADDPD:
-  case ZYDIS_MNEMONIC_VHADDPD:
-  case ZYDIS_MNEMONIC_HADDPS:
-  case ZYDIS_MNEMONIC_VHADDPS:
-  case ZYDIS_MNEMONIC_PHADDSW:
-  case ZYDIS_MNEMONIC_VPHADDSW:
-  case ZYDIS_MNEMONIC_PHSUBW:
-  case ZYDIS_MNEMONIC_VPHSUBW:
-  case ZYDIS_MNEMONIC_PHSUBD:
-  case ZYDIS_MNEMONIC_VPHSUBD:
-  case ZYDIS_MNEMONIC_HSUBPD:
-  case ZYDIS_MNEMONIC_VHSUBPD:
-  case ZYDIS_MNEMONIC_HSUBPS:
-  case ZYDIS_MNEMONIC_VHSUBPS:
-  case ZYDIS_MNEMONIC_PHSUBSW:
-  case ZYDIS_MNEMONIC_VPHSUBSW:
-  case ZYDIS_MNEMONIC_VPGATHERDD:
-  case ZYDIS_MNEMONIC_VPGATHERDQ:
-  case ZYDIS_MNEMONIC_VGATHERDPD:
-  case ZYDIS_MNEMONIC_VGATHERDPS:
-  case ZYDIS_MNEMONIC_VPGATHERQD:
-  case ZYDIS_MNEMONIC_VPGATHERQQ:
-  case ZYDIS_MNEMONIC_VGATHERQPD:
-  case ZYDIS_MNEMONIC_VGATHERQPS:
-  case ZYDIS_MNEMONIC_PINSRB:
-  case ZYDIS_MNEMONIC_VPINSRB:
-  case ZYDIS_MNEMONIC_PINSRW:
-  case ZYDIS_MNEMONIC_VPINSRW:
-  case ZYDIS_MNEMONIC_PINSRD:
-  case ZYDIS_MNEMONIC_VPINSRD:
-  case ZYDIS_MNEMONIC_PINSRQ:
-  case ZYDIS_MNEMONIC_VPINSRQ:
-  case ZYDIS_MNEMONIC_INSERTPS:
-  case ZYDIS_MNEMONIC_VINSERTPS:
-  case ZYDIS_MNEMONIC_VINSERTF128:
-  case ZYDIS_MNEMONIC_VINSERTI128:
-  case ZYDIS_MNEMONIC_LFENCE:
-  case ZYDIS_MNEMONIC_MOVHPS:
-  case ZYDIS_MNEMONIC_MOVHPD:
-  case ZYDIS_MNEMONIC_VPMADD52HUQ:
-  case ZYDIS_MNEMONIC_VPMADD52LUQ:
-  case ZYDIS_MNEMONIC_PMADDUBSW:
-  case ZYDIS_MNEMONIC_VPMADDUBSW:
-  case ZYDIS_MNEMONIC_PMAXSB:
-  case ZYDIS_MNEMONIC_VPMAXSB:
-  case ZYDIS_MNEMONIC_PMAXSW:
-  case ZYDIS_MNEMONIC_VPMAXSW:
-  case ZYDIS_MNEMONIC_PMAXSD:
-  case ZYDIS_MNEMONIC_VPMAXSD:
-  case ZYDIS_MNEMONIC_VPMAXSQ:
-  case ZYDIS_MNEMONIC_PMAXUB:
-  case ZYDIS_MNEMONIC_VPMAXUB:
-  case ZYDIS_MNEMONIC_PMAXUW:
-  case ZYDIS_MNEMONIC_VPMAXUW:
-  case ZYDIS_MNEMONIC_PMAXUD:
-  case ZYDIS_MNEMONIC_VPMAXUD:
-  case ZYDIS_MNEMONIC_VPMAXUQ:
-  case ZYDIS_MNEMONIC_MAXPD:
-  case ZYDIS_MNEMONIC_VMAXPD:
-  case ZYDIS_MNEMONIC_MAXPS:
-  case ZYDIS_MNEMONIC_VMAXPS:
-  case ZYDIS_MNEMONIC_MAXSD:
-  case ZYDIS_MNEMONIC_VMAXSD:
-  case ZYDIS_MNEMONIC_MAXSS:
-  case ZYDIS_MNEMONIC_VMAXSS:
-  case ZYDIS_MNEMONIC_PMINSB:
-  case ZYDIS_MNEMONIC_VPMINSB:
-  case ZYDIS_MNEMONIC_PMINSW:
-  case ZYDIS_MNEMONIC_VPMINSW:
-  case ZYDIS_MNEMONIC_PMINSD:
-  case ZYDIS_MNEMONIC_VPMINSD:
-  case ZYDIS_MNEMONIC_VPMINSQ:
-  case ZYDIS_MNEMONIC_PMINUB:
-  case ZYDIS_MNEMONIC_VPMINUB:
-  case ZYDIS_MNEMONIC_PMINUW:
-  case ZYDIS_MNEMONIC_VPMINUW:
-  case ZYDIS_MNEMONIC_PMINUD:
-  case ZYDIS_MNEMONIC_VPMINUD:
-  case ZYDIS_MNEMONIC_VPMINUQ:
-  case ZYDIS_MNEMONIC_MINPD:
-  case ZYDIS_MNEMONIC_VMINPD:
-  case ZYDIS_MNEMONIC_MINPS:
-  case ZYDIS_MNEMONIC_VMINPS:
-  case ZYDIS_MNEMONIC_MINSD:
-  case ZYDIS_MNEMONIC_VMINSD:
-  case ZYDIS_MNEMONIC_MINSS:
-  case ZYDIS_MNEMONIC_VMINSS:
-  case ZYDIS_MNEMONIC_PHMINPOSUW:
-  case ZYDIS_MNEMONIC_VPHMINPOSUW:
-  case ZYDIS_MNEMONIC_MOVDDUP:
-  case ZYDIS_MNEMONIC_VMOVDDUP:
-  case ZYDIS_MNEMONIC_MOVSHDUP:
-  case ZYDIS_MNEMONIC_VMOVSHDUP:
-  case ZYDIS_MNEMONIC_MOVHLPS:
-  case ZYDIS_MNEMONIC_VMOVHLPS:
-  case ZYDIS_MNEMONIC_MOVSLDUP:
-  case ZYDIS_MNEMONIC_VMOVSLDUP:
-  case ZYDIS_MNEMONIC_MOVLHPS:
-  case ZYDIS_MNEMONIC_VMOVLHPS:
-  case ZYDIS_MNEMONIC_PMOVMSKB:
-  case ZYDIS_MNEMONIC_VPMOVMSKB:
-  case ZYDIS_MNEMONIC_MOVMSKPD:
-  case ZYDIS_MNEMONIC_VMOVMSKPD:
-  case ZYDIS_MNEMONIC_MOVMSKPS:
-  case ZYDIS_MNEMONIC_VMOVMSKPS:
-  case ZYDIS_MNEMONIC_MPSADBW:
-  case ZYDIS_MNEMONIC_VMPSADBW:
-  case ZYDIS_MNEMONIC_PMULDQ:
-  case ZYDIS_MNEMONIC_VPMULDQ:
-  case ZYDIS_MNEMONIC_PMULUDQ:
-  case ZYDIS_MNEMONIC_VPMULUDQ:
-  case ZYDIS_MNEMONIC_MULPD:
-  case ZYDIS_MNEMONIC_VMULPD:
-  case ZYDIS_MNEMONIC_MULPS:
-  case ZYDIS_MNEMONIC_VMULPS:
-  case ZYDIS_MNEMONIC_MULSD:
-  case ZYDIS_MNEMONIC_VMULSD:
-  case ZYDIS_MNEMONIC_MULSS:
-  case ZYDIS_MNEMONIC_VMULSS:
-  case ZYDIS_MNEMONIC_PMULHRSW:
-  case ZYDIS_MNEMONIC_VPMULHRSW:
-  case ZYDIS_MNEMONIC_PMULLD:
-  case ZYDIS_MNEMONIC_VPMULLD:
-  case ZYDIS_MNEMONIC_ORPD:
-  case ZYDIS_MNEMONIC_VORPD:
-  case ZYDIS_MNEMONIC_ORPS:
-  case ZYDIS_MNEMONIC_VORPS:
-  case ZYDIS_MNEMONIC_PAUSE:
-  case ZYDIS_MNEMONIC_VPERMILPD:
-  case ZYDIS_MNEMONIC_VPERMILPS:
-  case ZYDIS_MNEMONIC_VPERM2F128:
-  case ZYDIS_MNEMONIC_VPERM2I128:
-  case ZYDIS_MNEMONIC_VPERMQ:
-  case ZYDIS_MNEMONIC_VPERMPD:
-  case ZYDIS_MNEMONIC_VPERMPS:
-  case ZYDIS_MNEMONIC_RCPPS:
-  case ZYDIS_MNEMONIC_VRCPPS:
-  case ZYDIS_MNEMONIC_RCPSS:
-  case ZYDIS_MNEMONIC_VRCPSS:
-  case ZYDIS_MNEMONIC_RSQRTPS:
-  case ZYDIS_MNEMONIC_VRSQRTPS:
-  case ZYDIS_MNEMONIC_RSQRTSS:
-  case ZYDIS_MNEMONIC_VRSQRTSS:
-  case ZYDIS_MNEMONIC_PSADBW:
-  case ZYDIS_MNEMONIC_VPSADBW:
-  case ZYDIS_MNEMONIC_SFENCE:
-  case ZYDIS_MNEMONIC_PSHUFB:
-  case ZYDIS_MNEMONIC_PSHUFW:
-  case ZYDIS_MNEMONIC_PSHUFD:
-  case ZYDIS_MNEMONIC_VPSHUFB:
-  case ZYDIS_MNEMONIC_VPSHUFD:
-  case ZYDIS_MNEMONIC_SHUFPS:
-  case ZYDIS_MNEMONIC_VSHUFPS:
-  case ZYDIS_MNEMONIC_SHUFPD:
-  case ZYDIS_MNEMONIC_VSHUFPD:
-  case ZYDIS_MNEMONIC_PSHUFHW:
-  case ZYDIS_MNEMONIC_VPSHUFHW:
-  case ZYDIS_MNEMONIC_PSHUFLW:
-  case ZYDIS_MNEMONIC_VPSHUFLW:
-  case ZYDIS_MNEMONIC_PSIGNB:
-  case ZYDIS_MNEMONIC_VPSIGNB:
-  case ZYDIS_MNEMONIC_PSIGNW:
-  case ZYDIS_MNEMONIC_VPSIGNW:
-  case ZYDIS_MNEMONIC_PSIGND:
-  case ZYDIS_MNEMONIC_VPSIGND:
-  case ZYDIS_MNEMONIC_PSLLW:
-  case ZYDIS_MNEMONIC_VPSLLW:
-  case ZYDIS_MNEMONIC_PSLLD:
-  case ZYDIS_MNEMONIC_VPSLLD:
-  case ZYDIS_MNEMONIC_PSLLQ:
-  case ZYDIS_MNEMONIC_VPSLLQ:
-  case ZYDIS_MNEMONIC_VPSLLVD:
-  case ZYDIS_MNEMONIC_VPSLLVQ:
-  case ZYDIS_MNEMONIC_SQRTPD:
-  case ZYDIS_MNEMONIC_VSQRTPD:
-  case ZYDIS_MNEMONIC_SQRTPS:
-  case ZYDIS_MNEMONIC_VSQRTPS:
-  case ZYDIS_MNEMONIC_SQRTSD:
-  case ZYDIS_MNEMONIC_VSQRTSD:
-  case ZYDIS_MNEMONIC_SQRTSS:
-  case ZYDIS_MNEMONIC_VSQRTSS:
-  case ZYDIS_MNEMONIC_PSRAW:
-  case ZYDIS_MNEMONIC_VPSRAW:
-  case ZYDIS_MNEMONIC_PSRAD:
-  case ZYDIS_MNEMONIC_VPSRAD:
-  case ZYDIS_MNEMONIC_VPSRAQ:
-  case ZYDIS_MNEMONIC_VPSRAVW:
-  case ZYDIS_MNEMONIC_VPSRAVD:
-  case ZYDIS_MNEMONIC_VPSRAVQ:
-  case ZYDIS_MNEMONIC_PSRLW:
-  case ZYDIS_MNEMONIC_VPSRLW:
-  case ZYDIS_MNEMONIC_PSRLD:
-  case ZYDIS_MNEMONIC_VPSRLD:
-  case ZYDIS_MNEMONIC_PSRLQ:
-  case ZYDIS_MNEMONIC_VPSRLQ:
-  case ZYDIS_MNEMONIC_VPSRLVW:
-  case ZYDIS_MNEMONIC_VPSRLVD:
-  case ZYDIS_MNEMONIC_VPSRLVQ:
-  case ZYDIS_MNEMONIC_PSUBB:
-  case ZYDIS_MNEMONIC_VPSUBB:
-  case ZYDIS_MNEMONIC_PSUBW:
-  case ZYDIS_MNEMONIC_VPSUBW:
-  case ZYDIS_MNEMONIC_PSUBD:
-  case ZYDIS_MNEMONIC_VPSUBD:
-  case ZYDIS_MNEMONIC_PSUBQ:
-  case ZYDIS_MNEMONIC_VPSUBQ:
-  case ZYDIS_MNEMONIC_SUBPD:
-  case ZYDIS_MNEMONIC_VSUBPD:
-  case ZYDIS_MNEMONIC_SUBPS:
-  case ZYDIS_MNEMONIC_VSUBPS:
-  case ZYDIS_MNEMONIC_SUBSD:
-  case ZYDIS_MNEMONIC_VSUBSD:
-  case ZYDIS_MNEMONIC_SUBSS:
-  case ZYDIS_MNEMONIC_VSUBSS:
-  case ZYDIS_MNEMONIC_PSUBSB:
-  case ZYDIS_MNEMONIC_VPSUBSB:
-  case ZYDIS_MNEMONIC_PSUBSW:
-  case ZYDIS_MNEMONIC_VPSUBSW:
-  case ZYDIS_MNEMONIC_PTEST:
-  case ZYDIS_MNEMONIC_VPTEST:
-  case ZYDIS_MNEMONIC_VTESTPD:
-  case ZYDIS_MNEMONIC_VTESTPS:
-  case ZYDIS_MNEMONIC_UCOMISD:
-  case ZYDIS_MNEMONIC_UCOMISS:
-  case ZYDIS_MNEMONIC_PUNPCKHBW:
-  case ZYDIS_MNEMONIC_VPUNPCKHBW:
-  case ZYDIS_MNEMONIC_PUNPCKHWD:
-  case ZYDIS_MNEMONIC_VPUNPCKHWD:
-  case ZYDIS_MNEMONIC_PUNPCKHDQ:
-  case ZYDIS_MNEMONIC_VPUNPCKHDQ:
-  case ZYDIS_MNEMONIC_PUNPCKHQDQ:
-  case ZYDIS_MNEMONIC_VPUNPCKHQDQ:
-  case ZYDIS_MNEMONIC_UNPCKHPD:
-  case ZYDIS_MNEMONIC_VUNPCKHPD:
-  case ZYDIS_MNEMONIC_UNPCKHPS:
-  case ZYDIS_MNEMONIC_VUNPCKHPS:
-  case ZYDIS_MNEMONIC_PUNPCKLBW:
-  case ZYDIS_MNEMONIC_VPUNPCKLBW:
-  case ZYDIS_MNEMONIC_PUNPCKLWD:
-  case ZYDIS_MNEMONIC_VPUNPCKLWD:
-  case ZYDIS_MNEMONIC_PUNPCKLDQ:
-  case ZYDIS_MNEMONIC_VPUNPCKLDQ:
-  case ZYDIS_MNEMONIC_PUNPCKLQDQ:
-  case ZYDIS_MNEMONIC_VPUNPCKLQDQ:
-  case ZYDIS_MNEMONIC_UNPCKLPD:
-  case ZYDIS_MNEMONIC_VUNPCKLPD:
-  case ZYDIS_MNEMONIC_UNPCKLPS:
-  case ZYDIS_MNEMONIC_VUNPCKLPS:
-  case ZYDIS_MNEMONIC_PXOR:
-  case ZYDIS_MNEMONIC_VPXOR:
-  case ZYDIS_MNEMONIC_XORPS:
-  case ZYDIS_MNEMONIC_VXORPS:
-  case ZYDIS_MNEMONIC_XORPD:
-  case ZYDIS_MNEMONIC_VXORPD:
-  case ZYDIS_MNEMONIC_VZEROALL:
-  case ZYDIS_MNEMONIC_VZEROUPPER:
-  case ZYDIS_MNEMONIC_VP2INTERSECTD:
-  case ZYDIS_MNEMONIC_VP2INTERSECTQ:
-  case ZYDIS_MNEMONIC_VP4DPWSSD:
-  case ZYDIS_MNEMONIC_VP4DPWSSDS:
-  case ZYDIS_MNEMONIC_V4FMADDPS:
-  case ZYDIS_MNEMONIC_V4FMADDSS:
-  case ZYDIS_MNEMONIC_V4FNMADDPS:
-  case ZYDIS_MNEMONIC_V4FNMADDSS:
-  case ZYDIS_MNEMONIC_VPABSQ:
-  case ZYDIS_MNEMONIC_VADDPH:
-  case ZYDIS_MNEMONIC_VADDSH:
-  case ZYDIS_MNEMONIC_PADDUSW:
-  case ZYDIS_MNEMONIC_VPADDUSW:
-  case ZYDIS_MNEMONIC_PADDUSB:
-  case ZYDIS_MNEMONIC_VPADDUSB:
-  case ZYDIS_MNEMONIC_VALIGND:
-  case ZYDIS_MNEMONIC_VALIGNQ:
-  case ZYDIS_MNEMONIC_VANDNPS:
-  case ZYDIS_MNEMONIC_VANDNPD:
-  case ZYDIS_MNEMONIC_VPSHUFBITQMB:
-  case ZYDIS_MNEMONIC_VPBLENDMB:
-  case ZYDIS_MNEMONIC_VPBLENDMW:
-  case ZYDIS_MNEMONIC_VPBLENDMD:
-  case ZYDIS_MNEMONIC_VPBLENDMQ:
-  case ZYDIS_MNEMONIC_VBLENDMPS:
-  case ZYDIS_MNEMONIC_VBLENDMPD:
-  case ZYDIS_MNEMONIC_VPCMPB:
-  case ZYDIS_MNEMONIC_VPCMPW:
-  case ZYDIS_MNEMONIC_VPCMPD:
-  case ZYDIS_MNEMONIC_VPCMPQ:
-  case ZYDIS_MNEMONIC_VPCMPUB:
-  case ZYDIS_MNEMONIC_VPCMPUW:
-  case ZYDIS_MNEMONIC_VPCMPUD:
-  case ZYDIS_MNEMONIC_VPCMPUQ:
-  case ZYDIS_MNEMONIC_VCMPPH:
-  case ZYDIS_MNEMONIC_VFCMULCPH:
-  case ZYDIS_MNEMONIC_VFCMULCSH:
-  case ZYDIS_MNEMONIC_VPCOMPRESSB:
-  case ZYDIS_MNEMONIC_VPCOMPRESSW:
-  case ZYDIS_MNEMONIC_VPCOMPRESSD:
-  case ZYDIS_MNEMONIC_VPCOMPRESSQ:
-  case ZYDIS_MNEMONIC_VCOMPRESSPD:
-  case ZYDIS_MNEMONIC_VCOMPRESSPS:
-  case ZYDIS_MNEMONIC_VPCONFLICTD:
-  case ZYDIS_MNEMONIC_VPCONFLICTQ:
-  case ZYDIS_MNEMONIC_VCVTW2PH:
-  case ZYDIS_MNEMONIC_VCVTDQ2PH:
-  case ZYDIS_MNEMONIC_VCVTQQ2PH:
-  case ZYDIS_MNEMONIC_VCVTPD2PH:
-  case ZYDIS_MNEMONIC_VCVTUW2PH:
-  case ZYDIS_MNEMONIC_VCVTUDQ2PH:
-  case ZYDIS_MNEMONIC_VCVTUQQ2PH:
-  case ZYDIS_MNEMONIC_VCVTQQ2PS:
-  case ZYDIS_MNEMONIC_VCVTQQ2PD:
-  case ZYDIS_MNEMONIC_VCVTPH2PD:
-  case ZYDIS_MNEMONIC_VCVTPH2W:
-  case ZYDIS_MNEMONIC_VCVTPH2DQ:
-  case ZYDIS_MNEMONIC_VCVTPH2QQ:
-  case ZYDIS_MNEMONIC_VCVTPH2UW:
-  case ZYDIS_MNEMONIC_VCVTPH2UDQ:
-  case ZYDIS_MNEMONIC_VCVTPH2UQQ:
-  case ZYDIS_MNEMONIC_VCVTPD2QQ:
-  case ZYDIS_MNEMONIC_VCVTPS2QQ:
-  case ZYDIS_MNEMONIC_VCVTUDQ2PS:
-  case ZYDIS_MNEMONIC_VCVTUQQ2PS:
-  case ZYDIS_MNEMONIC_VCVTPS2UDQ:
-  case ZYDIS_MNEMONIC_VCVTPS2UQQ:
-  case ZYDIS_MNEMONIC_VCVTUDQ2PD:
-  case ZYDIS_MNEMONIC_VCVTUQQ2PD:
-  case ZYDIS_MNEMONIC_VCVTPD2UDQ:
-  case ZYDIS_MNEMONIC_VCVTPD2UQQ:
-  case ZYDIS_MNEMONIC_VCVTSI2SH:
-  case ZYDIS_MNEMONIC_VCVTUSI2SH:
-  case ZYDIS_MNEMONIC_VCVTSS2SH:
-  case ZYDIS_MNEMONIC_VCVTSD2SH:
-  case ZYDIS_MNEMONIC_VCVTSH2SI:
-  case ZYDIS_MNEMONIC_VCVTSH2USI:
-  case ZYDIS_MNEMONIC_VCVTSH2SS:
-  case ZYDIS_MNEMONIC_VCVTSH2SD:
-  case ZYDIS_MNEMONIC_VPMOVQB:
-  case ZYDIS_MNEMONIC_VPMOVDB:
-  case ZYDIS_MNEMONIC_VPMOVWB:
-  case ZYDIS_MNEMONIC_VPMOVQW:
-  case ZYDIS_MNEMONIC_VPMOVDW:
-  case ZYDIS_MNEMONIC_VPMOVQD:
-  case ZYDIS_MNEMONIC_VCVTNE2PS2BF16:
-  case ZYDIS_MNEMONIC_VCVTSD2USI:
-  case ZYDIS_MNEMONIC_VCVTSS2USI:
-  case ZYDIS_MNEMONIC_VCVTUSI2SD:
-  case ZYDIS_MNEMONIC_VCVTUSI2SS:
-  case ZYDIS_MNEMONIC_VPMOVSWB:
-  case ZYDIS_MNEMONIC_VPMOVSDB:
-  case ZYDIS_MNEMONIC_VPMOVSQB:
-  case ZYDIS_MNEMONIC_VPMOVSDW:
-  case ZYDIS_MNEMONIC_VPMOVSQW:
-  case ZYDIS_MNEMONIC_VPMOVSQD:
-  case ZYDIS_MNEMONIC_VCVTTSD2SI:
-  case ZYDIS_MNEMONIC_VCVTTSD2USI:
-  case ZYDIS_MNEMONIC_CVTTSS2SI:
-  case ZYDIS_MNEMONIC_VCVTTSS2SI:
-  case ZYDIS_MNEMONIC_VCVTTSS2USI:
-  case ZYDIS_MNEMONIC_VCVTTSH2SI:
-  case ZYDIS_MNEMONIC_VCVTTSH2USI:
-  case ZYDIS_MNEMONIC_VCVTTPH2QQ:
-  case ZYDIS_MNEMONIC_VCVTTPS2QQ:
-  case ZYDIS_MNEMONIC_VCVTTPD2QQ:
-  case ZYDIS_MNEMONIC_VCVTTPH2DQ:
-  case ZYDIS_MNEMONIC_VCVTTPH2W:
-  case ZYDIS_MNEMONIC_VCVTTPH2UQQ:
-  case ZYDIS_MNEMONIC_VCVTTPS2UQQ:
-  case ZYDIS_MNEMONIC_VCVTTPD2UQQ:
-  case ZYDIS_MNEMONIC_VCVTTPD2UDQ:
-  case ZYDIS_MNEMONIC_VCVTTPS2UDQ:
-  case ZYDIS_MNEMONIC_VCVTTPH2UDQ:
-  case ZYDIS_MNEMONIC_VCVTTPH2UW:
-  case ZYDIS_MNEMONIC_VPMOVUSWB:
-  case ZYDIS_MNEMONIC_VPMOVUSDB:
-  case ZYDIS_MNEMONIC_VPMOVUSQB:
-  case ZYDIS_MNEMONIC_VPMOVUSDW:
-  case ZYDIS_MNEMONIC_VPMOVUSQW:
-  case ZYDIS_MNEMONIC_VPMOVUSQD:
-  case ZYDIS_MNEMONIC_VCVTPH2PSX:
-  case ZYDIS_MNEMONIC_VCVTPS2PHX:
-  case ZYDIS_MNEMONIC_VDBPSADBW:
-  case ZYDIS_MNEMONIC_VDIVPH:
-  case ZYDIS_MNEMONIC_VDIVSH:
-  case ZYDIS_MNEMONIC_VDPBF16PS:
-  case ZYDIS_MNEMONIC_VEXP2PD:
-  case ZYDIS_MNEMONIC_VEXP2PS:
-  case ZYDIS_MNEMONIC_VPEXPANDB:
-  case ZYDIS_MNEMONIC_VPEXPANDW:
-  case ZYDIS_MNEMONIC_VPEXPANDD:
-  case ZYDIS_MNEMONIC_VPEXPANDQ:
-  case ZYDIS_MNEMONIC_VEXPANDPS:
-  case ZYDIS_MNEMONIC_VEXPANDPD:
-  case ZYDIS_MNEMONIC_VEXTRACTF32X4:
-  case ZYDIS_MNEMONIC_VEXTRACTF32X8:
-  case ZYDIS_MNEMONIC_VEXTRACTF64X2:
-  case ZYDIS_MNEMONIC_VEXTRACTF64X4:
-  case ZYDIS_MNEMONIC_VEXTRACTI32X4:
-  case ZYDIS_MNEMONIC_VEXTRACTI32X8:
-  case ZYDIS_MNEMONIC_VEXTRACTI64X2:
-  case ZYDIS_MNEMONIC_VEXTRACTI64X4:
-  case ZYDIS_MNEMONIC_VFCMADDCPH:
-  case ZYDIS_MNEMONIC_VFCMADDCSH:
-  case ZYDIS_MNEMONIC_VFIXUPIMMPD:
-  case ZYDIS_MNEMONIC_VFIXUPIMMPS:
-  case ZYDIS_MNEMONIC_VFIXUPIMMSD:
-  case ZYDIS_MNEMONIC_VFIXUPIMMSS:
-  case ZYDIS_MNEMONIC_VFMADDCPH:
-  case ZYDIS_MNEMONIC_VFMADDCSH:
-  case ZYDIS_MNEMONIC_VFMADD132PH:
-  case ZYDIS_MNEMONIC_VFMADD213PH:
-  case ZYDIS_MNEMONIC_VFMADD231PH:
-  case ZYDIS_MNEMONIC_VFMADD132SH:
-  case ZYDIS_MNEMONIC_VFMADD213SH:
-  case ZYDIS_MNEMONIC_VFMADD231SH:
-  case ZYDIS_MNEMONIC_VFMADDSUB132PH:
-  case ZYDIS_MNEMONIC_VFMADDSUB213PH:
-  case ZYDIS_MNEMONIC_VFMADDSUB231PH:
-  case ZYDIS_MNEMONIC_VFMSUB132PH:
-  case ZYDIS_MNEMONIC_VFMSUB213PH:
-  case ZYDIS_MNEMONIC_VFMSUB231PH:
-  case ZYDIS_MNEMONIC_VFMSUB132SH:
-  case ZYDIS_MNEMONIC_VFMSUB213SH:
-  case ZYDIS_MNEMONIC_VFMSUB231SH:
-  case ZYDIS_MNEMONIC_VFMSUBADD132PH:
-  case ZYDIS_MNEMONIC_VFMSUBADD213PH:
-  case ZYDIS_MNEMONIC_VFMSUBADD231PH:
-  case ZYDIS_MNEMONIC_VFMULCPH:
-  case ZYDIS_MNEMONIC_VFMULCSH:
-  case ZYDIS_MNEMONIC_VFNMADD132PH:
-  case ZYDIS_MNEMONIC_VFNMADD213PH:
-  case ZYDIS_MNEMONIC_VFNMADD231PH:
-  case ZYDIS_MNEMONIC_VFNMADD132SH:
-  case ZYDIS_MNEMONIC_VFNMADD213SH:
-  case ZYDIS_MNEMONIC_VFNMADD231SH:
-  case ZYDIS_MNEMONIC_VFNMSUB132PH:
-  case ZYDIS_MNEMONIC_VFNMSUB213PH:
-  case ZYDIS_MNEMONIC_VFNMSUB231PH:
-  case ZYDIS_MNEMONIC_VFNMSUB132SH:
-  case ZYDIS_MNEMONIC_VFNMSUB213SH:
-  case ZYDIS_MNEMONIC_VFNMSUB231SH:
-  case ZYDIS_MNEMONIC_VFPCLASSPD:
-  case ZYDIS_MNEMONIC_VFPCLASSPS:
-  case ZYDIS_MNEMONIC_VFPCLASSPH:
-  case ZYDIS_MNEMONIC_VGETEXPPD:
-  case ZYDIS_MNEMONIC_VGETEXPPS:
-  case ZYDIS_MNEMONIC_VGETEXPPH:
-  case ZYDIS_MNEMONIC_VGETEXPSD:
-  case ZYDIS_MNEMONIC_VGETEXPSS:
-  case ZYDIS_MNEMONIC_VGETEXPSH:
-  case ZYDIS_MNEMONIC_VGETMANTPD:
-  case ZYDIS_MNEMONIC_VGETMANTPS:
-  case ZYDIS_MNEMONIC_VGETMANTPH:
-  case ZYDIS_MNEMONIC_VGETMANTSD:
-  case ZYDIS_MNEMONIC_VGETMANTSS:
-  case ZYDIS_MNEMONIC_VGETMANTSH:
-  case ZYDIS_MNEMONIC_VPSCATTERDD:
-  case ZYDIS_MNEMONIC_VPSCATTERDQ:
-  case ZYDIS_MNEMONIC_VPSCATTERQD:
-  case ZYDIS_MNEMONIC_VPSCATTERQQ:
-  case ZYDIS_MNEMONIC_VSCATTERDPS:
-  case ZYDIS_MNEMONIC_VSCATTERDPD:
-  case ZYDIS_MNEMONIC_VSCATTERQPS:
-  case ZYDIS_MNEMONIC_VSCATTERQPD:
-  case ZYDIS_MNEMONIC_VINSERTF32X4:
-  case ZYDIS_MNEMONIC_VINSERTF32X8:
-  case ZYDIS_MNEMONIC_VINSERTF64X2:
-  case ZYDIS_MNEMONIC_VINSERTF64X4:
-  case ZYDIS_MNEMONIC_VINSERTI32X4:
-  case ZYDIS_MNEMONIC_VINSERTI32X8:
-  case ZYDIS_MNEMONIC_VINSERTI64X2:
-  case ZYDIS_MNEMONIC_VINSERTI64X4:
-  case ZYDIS_MNEMONIC_KANDNB:
-  case ZYDIS_MNEMONIC_KANDNW:
-  case ZYDIS_MNEMONIC_KANDND:
-  case ZYDIS_MNEMONIC_KANDNQ:
-  case ZYDIS_MNEMONIC_KNOTB:
-  case ZYDIS_MNEMONIC_KNOTW:
-  case ZYDIS_MNEMONIC_KNOTD:
-  case ZYDIS_MNEMONIC_KNOTQ:
-  case ZYDIS_MNEMONIC_KUNPCKBW:
-  case ZYDIS_MNEMONIC_KUNPCKWD:
-  case ZYDIS_MNEMONIC_KUNPCKDQ:
-  case ZYDIS_MNEMONIC_KXNORB:
-  case ZYDIS_MNEMONIC_KXNORW:
-  case ZYDIS_MNEMONIC_KXNORD:
-  case ZYDIS_MNEMONIC_KXNORQ:
-  case ZYDIS_MNEMONIC_VPLZCNTD:
-  case ZYDIS_MNEMONIC_VPLZCNTQ:
-  case ZYDIS_MNEMONIC_VMAXPH:
-  case ZYDIS_MNEMONIC_VMAXSH:
-  case ZYDIS_MNEMONIC_VMINPH:
-  case ZYDIS_MNEMONIC_VMINSH:
-  case ZYDIS_MNEMONIC_VPMOVB2M:
-  case ZYDIS_MNEMONIC_VPMOVW2M:
-  case ZYDIS_MNEMONIC_VPMOVD2M:
-  case ZYDIS_MNEMONIC_VPMOVQ2M:
-  case ZYDIS_MNEMONIC_VPMOVM2B:
-  case ZYDIS_MNEMONIC_VPMOVM2W:
-  case ZYDIS_MNEMONIC_VPMOVM2D:
-  case ZYDIS_MNEMONIC_VPMOVM2Q:
-  case ZYDIS_MNEMONIC_VMULPH:
-  case ZYDIS_MNEMONIC_VMULSH:
-  case ZYDIS_MNEMONIC_VSUBPH:
-  case ZYDIS_MNEMONIC_VSUBSH:
-  case ZYDIS_MNEMONIC_VCMPSH:
-  case ZYDIS_MNEMONIC_VPMULHUW:
-  case ZYDIS_MNEMONIC_VPMULHUD:
-  case ZYDIS_MNEMONIC_VPMULLQ:
-  case ZYDIS_MNEMONIC_VPMULTISHIFTQB:
-  case ZYDIS_MNEMONIC_VPERMT2B:
-  case ZYDIS_MNEMONIC_VPERMT2W:
-  case ZYDIS_MNEMONIC_VPERMT2D:
-  case ZYDIS_MNEMONIC_VPERMT2Q:
-  case ZYDIS_MNEMONIC_VPERMT2PS:
-  case ZYDIS_MNEMONIC_VPERMT2PD:
-  case ZYDIS_MNEMONIC_VPERMB:
-  case ZYDIS_MNEMONIC_VPERMW:
-  case ZYDIS_MNEMONIC_VPERMD:
-  case ZYDIS_MNEMONIC_VPOPCNTB:
-  case ZYDIS_MNEMONIC_VPOPCNTW:
-  case ZYDIS_MNEMONIC_VPOPCNTD:
-  case ZYDIS_MNEMONIC_VPOPCNTQ:
-  case ZYDIS_MNEMONIC_VRANGEPD:
-  case ZYDIS_MNEMONIC_VRANGEPS:
-  case ZYDIS_MNEMONIC_VRANGESD:
-  case ZYDIS_MNEMONIC_VRANGESS:
-  case ZYDIS_MNEMONIC_VRCPPH:
-  case ZYDIS_MNEMONIC_VRCPSH:
-  case ZYDIS_MNEMONIC_VRCP14PD:
-  case ZYDIS_MNEMONIC_VRCP14PS:
-  case ZYDIS_MNEMONIC_VRCP14SD:
-  case ZYDIS_MNEMONIC_VRCP14SS:
-  case ZYDIS_MNEMONIC_VRCP28PD:
-  case ZYDIS_MNEMONIC_VRCP28PS:
-  case ZYDIS_MNEMONIC_VRCP28SD:
-  case ZYDIS_MNEMONIC_VRCP28SS:
-  case ZYDIS_MNEMONIC_VREDUCEPD:
-  case ZYDIS_MNEMONIC_VREDUCEPS:
-  case ZYDIS_MNEMONIC_VREDUCEPH:
-  case ZYDIS_MNEMONIC_VREDUCESD:
-  case ZYDIS_MNEMONIC_VREDUCESS:
-  case ZYDIS_MNEMONIC_VREDUCESH:
-  case ZYDIS_MNEMONIC_VPROLD:
-  case ZYDIS_MNEMONIC_VPROLQ:
-  case ZYDIS_MNEMONIC_VPROLVD:
-  case ZYDIS_MNEMONIC_VPROLVQ:
-  case ZYDIS_MNEMONIC_VPRORD:
-  case ZYDIS_MNEMONIC_VPRORQ:
-  case ZYDIS_MNEMONIC_VPRORVD:
-  case ZYDIS_MNEMONIC_VPRORVQ:
-  case ZYDIS_MNEMONIC_VRNDSCALEPD:
-  case ZYDIS_MNEMONIC_VRNDSCALEPS:
-  case ZYDIS_MNEMONIC_VRNDSCALEPH:
-  case ZYDIS_MNEMONIC_VRNDSCALESD:
-  case ZYDIS_MNEMONIC_VRNDSCALESS:
-  case ZYDIS_MNEMONIC_VRNDSCALESH:
-  case ZYDIS_MNEMONIC_VRSQRTPH:
-  case ZYDIS_MNEMONIC_VRSQRTSH:
-  case ZYDIS_MNEMONIC_VRSQRT14PD:
-  case ZYDIS_MNEMONIC_VRSQRT14PS:
-  case ZYDIS_MNEMONIC_VRSQRT14SD:
-  case ZYDIS_MNEMONIC_VRSQRT14SS:
-  case ZYDIS_MNEMONIC_VRSQRT28PD:
-  case ZYDIS_MNEMONIC_VRSQRT28PS:
-  case ZYDIS_MNEMONIC_VRSQRT28SD:
-  case ZYDIS_MNEMONIC_VRSQRT28SS:
-  case ZYDIS_MNEMONIC_VSCALEFPD:
-  case ZYDIS_MNEMONIC_VSCALEFPS:
-  case ZYDIS_MNEMONIC_VSCALEFPH:
-  case ZYDIS_MNEMONIC_VSCALEFSD:
-  case ZYDIS_MNEMONIC_VSCALEFSS:
-  case ZYDIS_MNEMONIC_VSCALEFSH:
-  case ZYDIS_MNEMONIC_VPXORQ:
-  case ZYDIS_MNEMONIC_VPXORD:
-  case ZYDIS_MNEMONIC_VPSHLB:
-  case ZYDIS_MNEMONIC_VPSHLW:
-  case ZYDIS_MNEMONIC_VPSHLD:
-  case ZYDIS_MNEMONIC_VPSHLQ:
-  case ZYDIS_MNEMONIC_VPSHLDW:
-  case ZYDIS_MNEMONIC_VPSHLDD:
-  case ZYDIS_MNEMONIC_VPSHLDQ:
-  case ZYDIS_MNEMONIC_VPSHLDVW:
-  case ZYDIS_MNEMONIC_VPSHLDVD:
-  case ZYDIS_MNEMONIC_VPSHLDVQ:
-  case ZYDIS_MNEMONIC_VPSHRDW:
-  case ZYDIS_MNEMONIC_VPSHRDD:
-  case ZYDIS_MNEMONIC_VPSHRDQ:
-  case ZYDIS_MNEMONIC_VPSHRDVW:
-  case ZYDIS_MNEMONIC_VPSHRDVD:
-  case ZYDIS_MNEMONIC_VPSHRDVQ:
-  case ZYDIS_MNEMONIC_VSHUFF32X4:
-  case ZYDIS_MNEMONIC_VSHUFF64X2:
-  case ZYDIS_MNEMONIC_VSHUFI32X4:
-  case ZYDIS_MNEMONIC_VSHUFI64X2:
-  case ZYDIS_MNEMONIC_VPSLLVW:
-  case ZYDIS_MNEMONIC_VSQRTPH:
-  case ZYDIS_MNEMONIC_VSQRTSH:
-  case ZYDIS_MNEMONIC_VPSUBRD:
-  case ZYDIS_MNEMONIC_VPSUBUSB:
-  case ZYDIS_MNEMONIC_VPSUBUSW:
-  case ZYDIS_MNEMONIC_VPTERNLOGD:
-  case ZYDIS_MNEMONIC_VPTERNLOGQ:
-  case ZYDIS_MNEMONIC_VPTESTMB:
-  case ZYDIS_MNEMONIC_VPTESTMW:
-  case ZYDIS_MNEMONIC_VPTESTMD:
-  case ZYDIS_MNEMONIC_VPTESTMQ:
-  case ZYDIS_MNEMONIC_VPTESTNMB:
-  case ZYDIS_MNEMONIC_VPTESTNMW:
-  case ZYDIS_MNEMONIC_VPTESTNMD:
-  case ZYDIS_MNEMONIC_VPTESTNMQ:
-  case ZYDIS_MNEMONIC_VUCOMISH:
-  {
-    bool addressParam = false;
-    bool maySelfReference = true;
-
-    if (simplifyShorthands)
-    {
-      if (pInstruction->operand_count == 3 && pOperands[1].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[2].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[1].reg.value == pOperands[2].reg.value)
+      for (size_t j = 0; j < pResult->instructionCount; j++)
       {
-        switch (pInstruction->mnemonic)
+        const size_t lineStart = pResult->pOffsets[j];
+        const size_t lineSize = (j + 1 < pResult->instructionCount ? pResult->pOffsets[j + 1] : pResult->textSize) - lineStart;
+
+        if (*pInstructionCount == offsetCapacity || lineSize > arenaCapacity - arenaOffset)
         {
-        case ZYDIS_MNEMONIC_PAND:
-        case ZYDIS_MNEMONIC_VPAND:
-        case ZYDIS_MNEMONIC_VPANDQ:
-        case ZYDIS_MNEMONIC_VPANDD:
-        case ZYDIS_MNEMONIC_POR:
-        case ZYDIS_MNEMONIC_VPOR:
-        case ZYDIS_MNEMONIC_VPORD:
-        case ZYDIS_MNEMONIC_VPORQ:
-        case ZYDIS_MNEMONIC_ORPD:
-        case ZYDIS_MNEMONIC_VORPD:
-        case ZYDIS_MNEMONIC_ORPS:
-        case ZYDIS_MNEMONIC_VORPS:
-          zydec_HintOperand(&pOperands[1], pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-          ERROR_CHECK(zydec_WriteRegister(&bufferPos, &remainingSize, pOperands[1].reg.value, pInfo, false));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ";"));
-          return true;
-
-        case ZYDIS_MNEMONIC_PXOR:
-        case ZYDIS_MNEMONIC_VPXOR:
-        case ZYDIS_MNEMONIC_XORPS:
-        case ZYDIS_MNEMONIC_VXORPS:
-        case ZYDIS_MNEMONIC_XORPD:
-        case ZYDIS_MNEMONIC_VXORPD:
-        case ZYDIS_MNEMONIC_VPXORQ:
-        case ZYDIS_MNEMONIC_VPXORD:
-          zydec_HintValue(0, pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = 0;"));
-          return true;
-
-        case ZYDIS_MNEMONIC_PCMPEQB:
-        case ZYDIS_MNEMONIC_VPCMPEQB:
-        case ZYDIS_MNEMONIC_PCMPEQW:
-        case ZYDIS_MNEMONIC_VPCMPEQW:
-        case ZYDIS_MNEMONIC_PCMPEQD:
-        case ZYDIS_MNEMONIC_VPCMPEQD:
-        case ZYDIS_MNEMONIC_PCMPEQQ:
-        case ZYDIS_MNEMONIC_VPCMPEQQ:
-          zydec_HintValue((int64_t)-1, pInfo);
-          ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-          ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = -1;"));
-          return true;
-
-        default:
+          success = false;
           break;
         }
+
+        memcpy(pArena + arenaOffset, pResult->pText + lineStart, lineSize);
+        pOffsets[(*pInstructionCount)++] = arenaOffset;
+        arenaOffset += lineSize;
       }
+
+      success &= pResult->success;
     }
 
-    if (pInstruction->operand_count > 1)
+    if (!success && pRequiredArenaCapacity != nullptr)
     {
-      switch (pInstruction->mnemonic)
-      {
-      case ZYDIS_MNEMONIC_PAND:
-      case ZYDIS_MNEMONIC_VPAND:
-      case ZYDIS_MNEMONIC_VPANDQ:
-      case ZYDIS_MNEMONIC_VPANDD:
-      case ZYDIS_MNEMONIC_KANDB:
-      case ZYDIS_MNEMONIC_KANDW:
-      case ZYDIS_MNEMONIC_KANDD:
-      case ZYDIS_MNEMONIC_KANDQ:
-        zydec_HintOp(ZydecFormattingInfo::And, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PANDN:
-      case ZYDIS_MNEMONIC_VPANDN:
-      case ZYDIS_MNEMONIC_VPANDNQ:
-      case ZYDIS_MNEMONIC_VPANDND:
-      case ZYDIS_MNEMONIC_VANDNPS:
-      case ZYDIS_MNEMONIC_VANDNPD:
-      case ZYDIS_MNEMONIC_KANDNB:
-      case ZYDIS_MNEMONIC_KANDNW:
-      case ZYDIS_MNEMONIC_KANDND:
-      case ZYDIS_MNEMONIC_KANDNQ:
-        zydec_HintOp(ZydecFormattingInfo::AndNot, pInfo);
-        break;
+      size_t requiredArenaCapacity = 0;
+      bool translated = true;
 
-      case ZYDIS_MNEMONIC_PCMPEQB:
-      case ZYDIS_MNEMONIC_VPCMPEQB:
-      case ZYDIS_MNEMONIC_PCMPEQW:
-      case ZYDIS_MNEMONIC_VPCMPEQW:
-      case ZYDIS_MNEMONIC_PCMPEQD:
-      case ZYDIS_MNEMONIC_VPCMPEQD:
-      case ZYDIS_MNEMONIC_PCMPEQQ:
-      case ZYDIS_MNEMONIC_VPCMPEQQ:
-      case ZYDIS_MNEMONIC_PCMPGTB:
-      case ZYDIS_MNEMONIC_VPCMPGTB:
-      case ZYDIS_MNEMONIC_PCMPGTW:
-      case ZYDIS_MNEMONIC_VPCMPGTW:
-      case ZYDIS_MNEMONIC_PCMPGTD:
-      case ZYDIS_MNEMONIC_VPCMPGTD:
-      case ZYDIS_MNEMONIC_PCMPGTQ:
-      case ZYDIS_MNEMONIC_VPCMPGTQ:
-      case ZYDIS_MNEMONIC_CMPSS:
-      case ZYDIS_MNEMONIC_VCMPSS:
-      case ZYDIS_MNEMONIC_CMPSD:
-      case ZYDIS_MNEMONIC_VCMPSD:
-      case ZYDIS_MNEMONIC_CMPPS:
-      case ZYDIS_MNEMONIC_VCMPPS:
-      case ZYDIS_MNEMONIC_CMPPD:
-      case ZYDIS_MNEMONIC_VCMPPD:
-      case ZYDIS_MNEMONIC_VPCMPB:
-      case ZYDIS_MNEMONIC_VPCMPW:
-      case ZYDIS_MNEMONIC_VPCMPD:
-      case ZYDIS_MNEMONIC_VPCMPQ:
-      case ZYDIS_MNEMONIC_VPCMPUB:
-      case ZYDIS_MNEMONIC_VPCMPUW:
-      case ZYDIS_MNEMONIC_VPCMPUD:
-      case ZYDIS_MNEMONIC_VPCMPUQ:
-      case ZYDIS_MNEMONIC_VCMPPH:
-      case ZYDIS_MNEMONIC_VCMPSH:
-        zydec_HintOp(ZydecFormattingInfo::Cmp, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PACKUSWB:
-      case ZYDIS_MNEMONIC_VPACKUSWB:
-      case ZYDIS_MNEMONIC_PACKUSDW:
-      case ZYDIS_MNEMONIC_VPACKUSDW:
-      case ZYDIS_MNEMONIC_PACKSSWB:
-      case ZYDIS_MNEMONIC_VPACKSSWB:
-      case ZYDIS_MNEMONIC_PACKSSDW:
-      case ZYDIS_MNEMONIC_VPACKSSDW:
-        zydec_HintOp(ZydecFormattingInfo::Pack, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PADDB:
-      case ZYDIS_MNEMONIC_VPADDB:
-      case ZYDIS_MNEMONIC_PADDW:
-      case ZYDIS_MNEMONIC_VPADDW:
-      case ZYDIS_MNEMONIC_PADDD:
-      case ZYDIS_MNEMONIC_VPADDD:
-      case ZYDIS_MNEMONIC_PADDQ:
-      case ZYDIS_MNEMONIC_VPADDQ:
-      case ZYDIS_MNEMONIC_ADDPS:
-      case ZYDIS_MNEMONIC_VADDPS:
-      case ZYDIS_MNEMONIC_ADDPD:
-      case ZYDIS_MNEMONIC_VADDPD:
-      case ZYDIS_MNEMONIC_ADDSS:
-      case ZYDIS_MNEMONIC_VADDSS:
-      case ZYDIS_MNEMONIC_ADDSD:
-      case ZYDIS_MNEMONIC_VADDSD:
-      case ZYDIS_MNEMONIC_PADDSB:
-      case ZYDIS_MNEMONIC_PADDSW:
-      case ZYDIS_MNEMONIC_VPADDSB:
-      case ZYDIS_MNEMONIC_VPADDSW:
-      case ZYDIS_MNEMONIC_PHADDW:
-      case ZYDIS_MNEMONIC_VPHADDW:
-      case ZYDIS_MNEMONIC_PHADDD:
-      case ZYDIS_MNEMONIC_VPHADDD:
-      case ZYDIS_MNEMONIC_HADDPD:
-      case ZYDIS_MNEMONIC_VHADDPD:
-      case ZYDIS_MNEMONIC_HADDPS:
-      case ZYDIS_MNEMONIC_VHADDPS:
-      case ZYDIS_MNEMONIC_PHADDSW:
-      case ZYDIS_MNEMONIC_VPHADDSW:
-      case ZYDIS_MNEMONIC_VADDPH:
-      case ZYDIS_MNEMONIC_VADDSH:
-      case ZYDIS_MNEMONIC_PADDUSW:
-      case ZYDIS_MNEMONIC_VPADDUSW:
-      case ZYDIS_MNEMONIC_PADDUSB:
-      case ZYDIS_MNEMONIC_VPADDUSB:
-      case ZYDIS_MNEMONIC_KADDB:
-      case ZYDIS_MNEMONIC_KADDW:
-      case ZYDIS_MNEMONIC_KADDD:
-      case ZYDIS_MNEMONIC_KADDQ:
-        zydec_HintOp(ZydecFormattingInfo::Add, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PMULHW:
-      case ZYDIS_MNEMONIC_VPMULHW:
-      case ZYDIS_MNEMONIC_PMULLW:
-      case ZYDIS_MNEMONIC_VPMULLW:
-      case ZYDIS_MNEMONIC_PMULDQ:
-      case ZYDIS_MNEMONIC_VPMULDQ:
-      case ZYDIS_MNEMONIC_PMULUDQ:
-      case ZYDIS_MNEMONIC_VPMULUDQ:
-      case ZYDIS_MNEMONIC_MULPD:
-      case ZYDIS_MNEMONIC_VMULPD:
-      case ZYDIS_MNEMONIC_MULPS:
-      case ZYDIS_MNEMONIC_VMULPS:
-      case ZYDIS_MNEMONIC_MULSD:
-      case ZYDIS_MNEMONIC_VMULSD:
-      case ZYDIS_MNEMONIC_MULSS:
-      case ZYDIS_MNEMONIC_VMULSS:
-      case ZYDIS_MNEMONIC_PMULHRSW:
-      case ZYDIS_MNEMONIC_VPMULHRSW:
-      case ZYDIS_MNEMONIC_PMULLD:
-      case ZYDIS_MNEMONIC_VPMULLD:
-      case ZYDIS_MNEMONIC_VFCMULCPH:
-      case ZYDIS_MNEMONIC_VFCMULCSH:
-      case ZYDIS_MNEMONIC_VMULPH:
-      case ZYDIS_MNEMONIC_VMULSH:
-      case ZYDIS_MNEMONIC_VPMULHUW:
-      case ZYDIS_MNEMONIC_VPMULHUD:
-      case ZYDIS_MNEMONIC_VPMULLQ:
-        zydec_HintOp(ZydecFormattingInfo::Mul, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_POR:
-      case ZYDIS_MNEMONIC_VPOR:
-      case ZYDIS_MNEMONIC_VPORD:
-      case ZYDIS_MNEMONIC_VPORQ:
-      case ZYDIS_MNEMONIC_ORPD:
-      case ZYDIS_MNEMONIC_VORPD:
-      case ZYDIS_MNEMONIC_ORPS:
-      case ZYDIS_MNEMONIC_VORPS:
-      case ZYDIS_MNEMONIC_KORB:
-      case ZYDIS_MNEMONIC_KORW:
-      case ZYDIS_MNEMONIC_KORD:
-      case ZYDIS_MNEMONIC_KORQ:
-        zydec_HintOp(ZydecFormattingInfo::Or, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PABSB:
-      case ZYDIS_MNEMONIC_VPABSB:
-      case ZYDIS_MNEMONIC_PABSW:
-      case ZYDIS_MNEMONIC_VPABSW:
-      case ZYDIS_MNEMONIC_PABSD:
-      case ZYDIS_MNEMONIC_VPABSD:
-      case ZYDIS_MNEMONIC_PAVGB:
-      case ZYDIS_MNEMONIC_VPAVGB:
-      case ZYDIS_MNEMONIC_PAVGW:
-      case ZYDIS_MNEMONIC_VPAVGW:
-      case ZYDIS_MNEMONIC_VPABSQ:
-        zydec_HintOp(ZydecFormattingInfo::Abs, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_PBLENDW:
-      case ZYDIS_MNEMONIC_VPBLENDW:
-      case ZYDIS_MNEMONIC_VPBLENDD:
-      case ZYDIS_MNEMONIC_BLENDPS:
-      case ZYDIS_MNEMONIC_VBLENDPS:
-      case ZYDIS_MNEMONIC_BLENDPD:
-      case ZYDIS_MNEMONIC_VBLENDPD:
-      case ZYDIS_MNEMONIC_PBLENDVB:
-      case ZYDIS_MNEMONIC_VPBLENDVB:
-      case ZYDIS_MNEMONIC_BLENDVPS:
-      case ZYDIS_MNEMONIC_VBLENDVPS:
-      case ZYDIS_MNEMONIC_BLENDVPD:
-      case ZYDIS_MNEMONIC_VBLENDVPD:
-      case ZYDIS_MNEMONIC_VPBLENDMB:
-      case ZYDIS_MNEMONIC_VPBLENDMW:
-      case ZYDIS_MNEMONIC_VPBLENDMD:
-      case ZYDIS_MNEMONIC_VPBLENDMQ:
-      case ZYDIS_MNEMONIC_VBLENDMPS:
-      case ZYDIS_MNEMONIC_VBLENDMPD:
-        zydec_HintOp(ZydecFormattingInfo::Blend, pInfo);
-        break;
-
-      case ZYDIS_MNEMONIC_VBROADCASTF128:
-      case ZYDIS_MNEMONIC_VBROADCASTF32X2:
-      case ZYDIS_MNEMONIC_VBROADCASTF32X4:
-      case ZYDIS_MNEMONIC_VBROADCASTF32X8:
-      case ZYDIS_MNEMONIC_VBROADCASTF64X2:
-      case ZYDIS_MNEMONIC_VBROADCASTF64X4:
-      case ZYDIS_MNEMONIC_VBROADCASTI128:
-      case ZYDIS_MNEMONIC_VBROADCASTI32X2:
-      case ZYDIS_MNEMONIC_VBROADCASTI32X4:
-      case ZYDIS_MNEMONIC_VBROADCASTI32X8:
-      case ZYDIS_MNEMONIC_VBROADCASTI64X2:
-      case ZYDIS_MNEMONIC_VBROADCASTI64X4:
-      case ZYDIS_MNEMONIC_VBROADCASTSD:
-      case ZYDIS_MNEMONIC_VBROADCASTSS:
-      case ZYDIS_MNEMONIC_VPBROADCASTB:
-      case ZYDIS_MNEMONIC_VPBROADCASTW:
-      case ZYDIS_MNEMONIC_VPBROADCASTD:
-      case ZYDIS_MNEMONIC_VPBROADCASTQ:
-      case ZYDIS_MNEMONIC_VPBROADCASTMB2Q:
-      case ZYDIS_MNEMONIC_VPBROADCASTMW2D:
-        zydec_HintOp(ZydecFormattingInfo::Broadcast, pInfo);
-        break;
+      for (size_t i = 0; i < partitionCount; i++)
+      {
+        requiredArenaCapacity += pResults[i].textSize;
+        translated &= pResults[i].success;
+      }
 
-      case ZYDIS_MNEMONIC_PSLLDQ:
-      case ZYDIS_MNEMONIC_VPSLLDQ:
-      case ZYDIS_MNEMONIC_PSLLW:
-      case ZYDIS_MNEMONIC_VPSLLW:
-      case ZYDIS_MNEMONIC_PSLLD:
-      case ZYDIS_MNEMONIC_VPSLLD:
-      case ZYDIS_MNEMONIC_PSLLQ:
-      case ZYDIS_MNEMONIC_VPSLLQ:
-      case ZYDIS_MNEMONIC_VPSLLVD:
-      case ZYDIS_MNEMONIC_VPSLLVQ:
-      case ZYDIS_MNEMONIC_VPSHLB:
-      case ZYDIS_MNEMONIC_VPSHLW:
-      case ZYDIS_MNEMONIC_VPSHLD:
-      case ZYDIS_MNEMONIC_VPSHLQ:
-      case ZYDIS_MNEMONIC_VPSLLVW:
-        zydec_HintOp(ZydecFormattingInfo::ShL, pInfo);
-        break;
+      if (translated && requiredArenaCapacity > arenaCapacity)
+        *pRequiredArenaCapacity = requiredArenaCapacity;
+    }
+  }
 
-      case ZYDIS_MNEMONIC_PSRLDQ:
-      case ZYDIS_MNEMONIC_VPSRLDQ:
-      case ZYDIS_MNEMONIC_PSRAW:
-      case ZYDIS_MNEMONIC_VPSRAW:
-      case ZYDIS_MNEMONIC_PSRAD:
-      case ZYDIS_MNEMONIC_VPSRAD:
-      case ZYDIS_MNEMONIC_VPSRAQ:
-      case ZYDIS_MNEMONIC_VPSRAVW:
-      case ZYDIS_MNEMONIC_VPSRAVD:
-      case ZYDIS_MNEMONIC_VPSRAVQ:
-      case ZYDIS_MNEMONIC_PSRLW:
-      case ZYDIS_MNEMONIC_VPSRLW:
-      case ZYDIS_MNEMONIC_PSRLD:
-      case ZYDIS_MNEMONIC_VPSRLD:
-      case ZYDIS_MNEMONIC_PSRLQ:
-      case ZYDIS_MNEMONIC_VPSRLQ:
-      case ZYDIS_MNEMONIC_VPSRLVW:
-      case ZYDIS_MNEMONIC_VPSRLVD:
-      case ZYDIS_MNEMONIC_VPSRLVQ:
-        zydec_HintOp(ZydecFormattingInfo::ShR, pInfo);
-        break;
+  if (pResults != nullptr)
+  {
+    for (size_t i = 0; i < partitionCount; i++)
+    {
+      free(pResults[i].pText);
+      free(pResults[i].pOffsets);
+    }
+  }
 
-      case ZYDIS_MNEMONIC_ROUNDSS:
-      case ZYDIS_MNEMONIC_VROUNDSS:
-      case ZYDIS_MNEMONIC_ROUNDSD:
-      case ZYDIS_MNEMONIC_VROUNDSD:
-      case ZYDIS_MNEMONIC_ROUNDPS:
-      case ZYDIS_MNEMONIC_VROUNDPS:
-      case ZYDIS_MNEMONIC_ROUNDPD:
-      case ZYDIS_MNEMONIC_VROUNDPD:
-        zydec_HintOp(ZydecFormattingInfo::Round, pInfo);
-        break;
+  free(pResults);
+  delete[] pWorkers;
+  delete[] pQueues;
+  delete[] pThreads;
 
-      case ZYDIS_MNEMONIC_CVTPI2PS:
-      case ZYDIS_MNEMONIC_CVTPS2PI:
-      case ZYDIS_MNEMONIC_CVTSI2SS:
-      case ZYDIS_MNEMONIC_VCVTSI2SS:
-      case ZYDIS_MNEMONIC_CVTSS2SI:
-      case ZYDIS_MNEMONIC_VCVTSS2SI:
-      case ZYDIS_MNEMONIC_PMOVSXWD:
-      case ZYDIS_MNEMONIC_VPMOVSXWD:
-      case ZYDIS_MNEMONIC_PMOVSXWQ:
-      case ZYDIS_MNEMONIC_VPMOVSXWQ:
-      case ZYDIS_MNEMONIC_PMOVSXDQ:
-      case ZYDIS_MNEMONIC_VPMOVSXDQ:
-      case ZYDIS_MNEMONIC_CVTDQ2PS:
-      case ZYDIS_MNEMONIC_VCVTDQ2PS:
-      case ZYDIS_MNEMONIC_CVTDQ2PD:
-      case ZYDIS_MNEMONIC_VCVTDQ2PD:
-      case ZYDIS_MNEMONIC_PMOVSXBW:
-      case ZYDIS_MNEMONIC_VPMOVSXBW:
-      case ZYDIS_MNEMONIC_PMOVSXBD:
-      case ZYDIS_MNEMONIC_VPMOVSXBD:
-      case ZYDIS_MNEMONIC_PMOVSXBQ:
-      case ZYDIS_MNEMONIC_VPMOVSXBQ:
-      case ZYDIS_MNEMONIC_PMOVZXWD:
-      case ZYDIS_MNEMONIC_VPMOVZXWD:
-      case ZYDIS_MNEMONIC_PMOVZXWQ:
-      case ZYDIS_MNEMONIC_VPMOVZXWQ:
-      case ZYDIS_MNEMONIC_PMOVZXDQ:
-      case ZYDIS_MNEMONIC_VPMOVZXDQ:
-      case ZYDIS_MNEMONIC_PMOVZXBW:
-      case ZYDIS_MNEMONIC_VPMOVZXBW:
-      case ZYDIS_MNEMONIC_PMOVZXBD:
-      case ZYDIS_MNEMONIC_VPMOVZXBD:
-      case ZYDIS_MNEMONIC_PMOVZXBQ:
-      case ZYDIS_MNEMONIC_VPMOVZXBQ:
-      case ZYDIS_MNEMONIC_VCVTPH2PS:
-      case ZYDIS_MNEMONIC_VCVTNEPS2BF16:
-      case ZYDIS_MNEMONIC_CVTPD2DQ:
-      case ZYDIS_MNEMONIC_VCVTPD2DQ:
-      case ZYDIS_MNEMONIC_CVTPD2PI:
-      case ZYDIS_MNEMONIC_CVTPD2PS:
-      case ZYDIS_MNEMONIC_VCVTPD2PS:
-      case ZYDIS_MNEMONIC_CVTPI2PD:
-      case ZYDIS_MNEMONIC_CVTPS2DQ:
-      case ZYDIS_MNEMONIC_VCVTPS2DQ:
-      case ZYDIS_MNEMONIC_CVTPS2PD:
-      case ZYDIS_MNEMONIC_VCVTPS2PD:
-      case ZYDIS_MNEMONIC_VCVTPS2PH:
-      case ZYDIS_MNEMONIC_CVTSD2SI:
-      case ZYDIS_MNEMONIC_VCVTSD2SI:
-      case ZYDIS_MNEMONIC_CVTSD2SS:
-      case ZYDIS_MNEMONIC_VCVTSD2SS:
-      case ZYDIS_MNEMONIC_CVTSI2SD:
-      case ZYDIS_MNEMONIC_VCVTSI2SD:
-      case ZYDIS_MNEMONIC_CVTSS2SD:
-      case ZYDIS_MNEMONIC_VCVTSS2SD:
-      case ZYDIS_MNEMONIC_CVTTPS2PI:
-      case ZYDIS_MNEMONIC_CVTTPD2DQ:
-      case ZYDIS_MNEMONIC_VCVTTPD2DQ:
-      case ZYDIS_MNEMONIC_CVTTPD2PI:
-      case ZYDIS_MNEMONIC_CVTTPS2DQ:
-      case ZYDIS_MNEMONIC_VCVTTPS2DQ:
-      case ZYDIS_MNEMONIC_CVTTSD2SI:
-      case ZYDIS_MNEMONIC_VCVTW2PH:
-      case ZYDIS_MNEMONIC_VCVTDQ2PH:
-      case ZYDIS_MNEMONIC_VCVTQQ2PH:
-      case ZYDIS_MNEMONIC_VCVTPD2PH:
-      case ZYDIS_MNEMONIC_VCVTUW2PH:
-      case ZYDIS_MNEMONIC_VCVTUDQ2PH:
-      case ZYDIS_MNEMONIC_VCVTUQQ2PH:
-      case ZYDIS_MNEMONIC_VCVTQQ2PS:
-      case ZYDIS_MNEMONIC_VCVTQQ2PD:
-      case ZYDIS_MNEMONIC_VCVTPH2PD:
-      case ZYDIS_MNEMONIC_VCVTPH2W:
-      case ZYDIS_MNEMONIC_VCVTPH2DQ:
-      case ZYDIS_MNEMONIC_VCVTPH2QQ:
-      case ZYDIS_MNEMONIC_VCVTPH2UW:
-      case ZYDIS_MNEMONIC_VCVTPH2UDQ:
-      case ZYDIS_MNEMONIC_VCVTPH2UQQ:
-      case ZYDIS_MNEMONIC_VCVTPD2QQ:
-      case ZYDIS_MNEMONIC_VCVTPS2QQ:
-      case ZYDIS_MNEMONIC_VCVTUDQ2PS:
-      case ZYDIS_MNEMONIC_VCVTUQQ2PS:
-      case ZYDIS_MNEMONIC_VCVTPS2UDQ:
-      case ZYDIS_MNEMONIC_VCVTPS2UQQ:
-      case ZYDIS_MNEMONIC_VCVTUDQ2PD:
-      case ZYDIS_MNEMONIC_VCVTUQQ2PD:
-      case ZYDIS_MNEMONIC_VCVTPD2UDQ:
-      case ZYDIS_MNEMONIC_VCVTPD2UQQ:
-      case ZYDIS_MNEMONIC_VCVTSI2SH:
-      case ZYDIS_MNEMONIC_VCVTUSI2SH:
-      case ZYDIS_MNEMONIC_VCVTSS2SH:
-      case ZYDIS_MNEMONIC_VCVTSD2SH:
-      case ZYDIS_MNEMONIC_VCVTSH2SI:
-      case ZYDIS_MNEMONIC_VCVTSH2USI:
-      case ZYDIS_MNEMONIC_VCVTSH2SS:
-      case ZYDIS_MNEMONIC_VCVTSH2SD:
-      case ZYDIS_MNEMONIC_VPMOVQB:
-      case ZYDIS_MNEMONIC_VPMOVDB:
-      case ZYDIS_MNEMONIC_VPMOVWB:
-      case ZYDIS_MNEMONIC_VPMOVQW:
-      case ZYDIS_MNEMONIC_VPMOVDW:
-      case ZYDIS_MNEMONIC_VPMOVQD:
-      case ZYDIS_MNEMONIC_VCVTNE2PS2BF16:
-      case ZYDIS_MNEMONIC_VCVTSD2USI:
-      case ZYDIS_MNEMONIC_VCVTSS2USI:
-      case ZYDIS_MNEMONIC_VCVTUSI2SD:
-      case ZYDIS_MNEMONIC_VCVTUSI2SS:
-      case ZYDIS_MNEMONIC_VPMOVSWB:
-      case ZYDIS_MNEMONIC_VPMOVSDB:
-      case ZYDIS_MNEMONIC_VPMOVSQB:
-      case ZYDIS_MNEMONIC_VPMOVSDW:
-      case ZYDIS_MNEMONIC_VPMOVSQW:
-      case ZYDIS_MNEMONIC_VPMOVSQD:
-      case ZYDIS_MNEMONIC_VCVTTSD2SI:
-      case ZYDIS_MNEMONIC_VCVTTSD2USI:
-      case ZYDIS_MNEMONIC_CVTTSS2SI:
-      case ZYDIS_MNEMONIC_VCVTTSS2USI:
-      case ZYDIS_MNEMONIC_VCVTTSH2SI:
-      case ZYDIS_MNEMONIC_VCVTTSH2USI:
-      case ZYDIS_MNEMONIC_VCVTTPH2QQ:
-      case ZYDIS_MNEMONIC_VCVTTPS2QQ:
-      case ZYDIS_MNEMONIC_VCVTTPD2QQ:
-      case ZYDIS_MNEMONIC_VCVTTPH2DQ:
-      case ZYDIS_MNEMONIC_VCVTTPH2W:
-      case ZYDIS_MNEMONIC_VCVTTPH2UQQ:
-      case ZYDIS_MNEMONIC_VCVTTPS2UQQ:
-      case ZYDIS_MNEMONIC_VCVTTPD2UQQ:
-      case ZYDIS_MNEMONIC_VCVTTPD2UDQ:
-      case ZYDIS_MNEMONIC_VCVTTPH2UDQ:
-      case ZYDIS_MNEMONIC_VCVTTPH2UW:
-      case ZYDIS_MNEMONIC_VPMOVUSWB:
-      case ZYDIS_MNEMONIC_VPMOVUSDB:
-      case ZYDIS_MNEMONIC_VPMOVUSQB:
-      case ZYDIS_MNEMONIC_VPMOVUSDW:
-      case ZYDIS_MNEMONIC_VPMOVUSQW:
-      case ZYDIS_MNEMONIC_VPMOVUSQD:
-      case ZYDIS_MNEMONIC_VCVTPH2PSX:
-      case ZYDIS_MNEMONIC_VCVTPS2PHX:
-        zydec_HintOp(ZydecFormattingInfo::Convert, pInfo);
-        break;
+  return success;
+}
 
-      case ZYDIS_MNEMONIC_DIVPD:
-      case ZYDIS_MNEMONIC_VDIVPD:
-      case ZYDIS_MNEMONIC_DIVPS:
-      case ZYDIS_MNEMONIC_VDIVPS:
-      case ZYDIS_MNEMONIC_DIVSD:
-      case ZYDIS_MNEMONIC_VDIVSD:
-      case ZYDIS_MNEMONIC_DIVSS:
-      case ZYDIS_MNEMONIC_VDIVSS:
-      case ZYDIS_MNEMONIC_VDIVPH:
-      case ZYDIS_MNEMONIC_VDIVSH:
-        zydec_HintOp(ZydecFormattingInfo::Div, pInfo);
-        break;
+bool zydec_Translator_FindPartitions(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const size_t minPartitionSize, ZydecCodePartition *pPartitions, const size_t partitionCapacity, size_t *pPartitionCount)
+{
+  if (pTranslator == nullptr || pCode == nullptr || minPartitionSize == 0 || (pPartitions == nullptr && partitionCapacity != 0) || pPartitionCount == nullptr)
+    return false;
 
-      case ZYDIS_MNEMONIC_DPPD:
-      case ZYDIS_MNEMONIC_VDPPD:
-      case ZYDIS_MNEMONIC_DPPS:
-      case ZYDIS_MNEMONIC_VDPPS:
-        zydec_HintOp(ZydecFormattingInfo::DotProduct, pInfo);
-        break;
+  *pPartitionCount = 0;
 
-      case ZYDIS_MNEMONIC_PEXTRB:
-      case ZYDIS_MNEMONIC_VPEXTRB:
-      case ZYDIS_MNEMONIC_PEXTRW:
-      case ZYDIS_MNEMONIC_VPEXTRW:
-      case ZYDIS_MNEMONIC_PEXTRD:
-      case ZYDIS_MNEMONIC_VPEXTRD:
-      case ZYDIS_MNEMONIC_PEXTRQ:
-      case ZYDIS_MNEMONIC_VPEXTRQ:
-      case ZYDIS_MNEMONIC_EXTRACTPS:
-      case ZYDIS_MNEMONIC_VEXTRACTPS:
-      case ZYDIS_MNEMONIC_VEXTRACTF128:
-      case ZYDIS_MNEMONIC_VEXTRACTI128:
-      case ZYDIS_MNEMONIC_VEXTRACTF32X4:
-      case ZYDIS_MNEMONIC_VEXTRACTF32X8:
-      case ZYDIS_MNEMONIC_VEXTRACTF64X2:
-      case ZYDIS_MNEMONIC_VEXTRACTF64X4:
-      case ZYDIS_MNEMONIC_VEXTRACTI32X4:
-      case ZYDIS_MNEMONIC_VEXTRACTI32X8:
-      case ZYDIS_MNEMONIC_VEXTRACTI64X2:
-      case ZYDIS_MNEMONIC_VEXTRACTI64X4:
-        zydec_HintOp(ZydecFormattingInfo::Extract, pInfo);
-        break;
+  ZydisDecoderContext decoderContext;
+  ZydisDecodedInstruction instruction;
 
-      case ZYDIS_MNEMONIC_PHSUBW:
-      case ZYDIS_MNEMONIC_VPHSUBW:
-      case ZYDIS_MNEMONIC_PHSUBD:
-      case ZYDIS_MNEMONIC_VPHSUBD:
-      case ZYDIS_MNEMONIC_HSUBPD:
-      case ZYDIS_MNEMONIC_VHSUBPD:
-      case ZYDIS_MNEMONIC_HSUBPS:
-      case ZYDIS_MNEMONIC_VHSUBPS:
-      case ZYDIS_MNEMONIC_PHSUBSW:
-      case ZYDIS_MNEMONIC_VPHSUBSW:
-      case ZYDIS_MNEMONIC_PSUBB:
-      case ZYDIS_MNEMONIC_VPSUBB:
-      case ZYDIS_MNEMONIC_PSUBW:
-      case ZYDIS_MNEMONIC_VPSUBW:
-      case ZYDIS_MNEMONIC_PSUBD:
-      case ZYDIS_MNEMONIC_VPSUBD:
-      case ZYDIS_MNEMONIC_PSUBQ:
-      case ZYDIS_MNEMONIC_VPSUBQ:
-      case ZYDIS_MNEMONIC_SUBPD:
-      case ZYDIS_MNEMONIC_VSUBPD:
-      case ZYDIS_MNEMONIC_SUBPS:
-      case ZYDIS_MNEMONIC_VSUBPS:
-      case ZYDIS_MNEMONIC_SUBSD:
-      case ZYDIS_MNEMONIC_VSUBSD:
-      case ZYDIS_MNEMONIC_SUBSS:
-      case ZYDIS_MNEMONIC_VSUBSS:
-      case ZYDIS_MNEMONIC_PSUBSB:
-      case ZYDIS_MNEMONIC_VPSUBSB:
-      case ZYDIS_MNEMONIC_PSUBSW:
-      case ZYDIS_MNEMONIC_VPSUBSW:
-      case ZYDIS_MNEMONIC_VSUBPH:
-      case ZYDIS_MNEMONIC_VSUBSH:
-      case ZYDIS_MNEMONIC_VPSUBUSB:
-      case ZYDIS_MNEMONIC_VPSUBUSW:
-        zydec_HintOp(ZydecFormattingInfo::Sub, pInfo);
-        break;
+  size_t partitionStart = 0;
+  size_t codeOffset = 0;
 
-      case ZYDIS_MNEMONIC_VPGATHERDD:
-      case ZYDIS_MNEMONIC_VPGATHERDQ:
-      case ZYDIS_MNEMONIC_VGATHERDPD:
-      case ZYDIS_MNEMONIC_VGATHERDPS:
-      case ZYDIS_MNEMONIC_VPGATHERQD:
-      case ZYDIS_MNEMONIC_VPGATHERQQ:
-      case ZYDIS_MNEMONIC_VGATHERQPD:
-      case ZYDIS_MNEMONIC_VGATHERQPS:
-        zydec_HintOp(ZydecFormattingInfo::Gather, pInfo);
-        break;
+  while (codeOffset < size)
+  {
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeInstruction(&pTranslator->decoder, &decoderContext, pCode + codeOffset, size - codeOffset, &instruction)) || instruction.length == 0)
+      return false;
 
-      case ZYDIS_MNEMONIC_MOVHPS:
-      case ZYDIS_MNEMONIC_MOVHPD:
-        zydec_HintOp(ZydecFormattingInfo::Mov, pInfo);
-        break;
+    codeOffset += instruction.length;
 
-      case ZYDIS_MNEMONIC_PMAXSB:
-      case ZYDIS_MNEMONIC_VPMAXSB:
-      case ZYDIS_MNEMONIC_PMAXSW:
-      case ZYDIS_MNEMONIC_VPMAXSW:
-      case ZYDIS_MNEMONIC_PMAXSD:
-      case ZYDIS_MNEMONIC_VPMAXSD:
-      case ZYDIS_MNEMONIC_VPMAXSQ:
-      case ZYDIS_MNEMONIC_PMAXUB:
-      case ZYDIS_MNEMONIC_VPMAXUB:
-      case ZYDIS_MNEMONIC_PMAXUW:
-      case ZYDIS_MNEMONIC_VPMAXUW:
-      case ZYDIS_MNEMONIC_PMAXUD:
-      case ZYDIS_MNEMONIC_VPMAXUD:
-      case ZYDIS_MNEMONIC_VPMAXUQ:
-      case ZYDIS_MNEMONIC_MAXPD:
-      case ZYDIS_MNEMONIC_VMAXPD:
-      case ZYDIS_MNEMONIC_MAXPS:
-      case ZYDIS_MNEMONIC_VMAXPS:
-      case ZYDIS_MNEMONIC_MAXSD:
-      case ZYDIS_MNEMONIC_VMAXSD:
-      case ZYDIS_MNEMONIC_MAXSS:
-      case ZYDIS_MNEMONIC_VMAXSS:
-      case ZYDIS_MNEMONIC_VMAXPH:
-      case ZYDIS_MNEMONIC_VMAXSH:
-        zydec_HintOp(ZydecFormattingInfo::Max, pInfo);
-        break;
+    bool fallsThrough;
 
-      case ZYDIS_MNEMONIC_PMINSB:
-      case ZYDIS_MNEMONIC_VPMINSB:
-      case ZYDIS_MNEMONIC_PMINSW:
-      case ZYDIS_MNEMONIC_VPMINSW:
-      case ZYDIS_MNEMONIC_PMINSD:
-      case ZYDIS_MNEMONIC_VPMINSD:
-      case ZYDIS_MNEMONIC_VPMINSQ:
-      case ZYDIS_MNEMONIC_PMINUB:
-      case ZYDIS_MNEMONIC_VPMINUB:
-      case ZYDIS_MNEMONIC_PMINUW:
-      case ZYDIS_MNEMONIC_VPMINUW:
-      case ZYDIS_MNEMONIC_PMINUD:
-      case ZYDIS_MNEMONIC_VPMINUD:
-      case ZYDIS_MNEMONIC_VPMINUQ:
-      case ZYDIS_MNEMONIC_MINPD:
-      case ZYDIS_MNEMONIC_VMINPD:
-      case ZYDIS_MNEMONIC_MINPS:
-      case ZYDIS_MNEMONIC_VMINPS:
-      case ZYDIS_MNEMONIC_MINSD:
-      case ZYDIS_MNEMONIC_VMINSD:
-      case ZYDIS_MNEMONIC_MINSS:
-      case ZYDIS_MNEMONIC_VMINSS:
-      case ZYDIS_MNEMONIC_VMINPH:
-      case ZYDIS_MNEMONIC_VMINSH:
-        zydec_HintOp(ZydecFormattingInfo::Min, pInfo);
-        break;
+    switch (instruction.meta.category)
+    {
+    case ZYDIS_CATEGORY_RET:
+    case ZYDIS_CATEGORY_UNCOND_BR:
+      fallsThrough = false;
+      break;
 
-      case ZYDIS_MNEMONIC_PMOVMSKB:
-      case ZYDIS_MNEMONIC_VPMOVMSKB:
-      case ZYDIS_MNEMONIC_MOVMSKPD:
-      case ZYDIS_MNEMONIC_VMOVMSKPD:
-      case ZYDIS_MNEMONIC_MOVMSKPS:
-      case ZYDIS_MNEMONIC_VMOVMSKPS:
-      case ZYDIS_MNEMONIC_VPMOVB2M:
-      case ZYDIS_MNEMONIC_VPMOVW2M:
-      case ZYDIS_MNEMONIC_VPMOVD2M:
-      case ZYDIS_MNEMONIC_VPMOVQ2M:
-      case ZYDIS_MNEMONIC_VPMOVM2B:
-      case ZYDIS_MNEMONIC_VPMOVM2W:
-      case ZYDIS_MNEMONIC_VPMOVM2D:
-      case ZYDIS_MNEMONIC_VPMOVM2Q:
-        zydec_HintOp(ZydecFormattingInfo::Mask, pInfo);
-        break;
+    default:
+      fallsThrough = instruction.mnemonic != ZYDIS_MNEMONIC_INT3 && instruction.mnemonic != ZYDIS_MNEMONIC_UD2;
+      break;
+    }
 
-      case ZYDIS_MNEMONIC_VPERMILPD:
-      case ZYDIS_MNEMONIC_VPERMILPS:
-      case ZYDIS_MNEMONIC_VPERM2F128:
-      case ZYDIS_MNEMONIC_VPERM2I128:
-      case ZYDIS_MNEMONIC_VPERMQ:
-      case ZYDIS_MNEMONIC_VPERMPD:
-      case ZYDIS_MNEMONIC_VPERMPS:
-        zydec_HintOp(ZydecFormattingInfo::Permute, pInfo);
-        break;
+    if ((fallsThrough || codeOffset - partitionStart < minPartitionSize) && codeOffset < size)
+      continue;
 
-      case ZYDIS_MNEMONIC_PSHUFB:
-      case ZYDIS_MNEMONIC_VPSHUFB:
-      case ZYDIS_MNEMONIC_PSHUFW:
-      case ZYDIS_MNEMONIC_PSHUFD:
-      case ZYDIS_MNEMONIC_VPSHUFD:
-      case ZYDIS_MNEMONIC_SHUFPS:
-      case ZYDIS_MNEMONIC_VSHUFPS:
-      case ZYDIS_MNEMONIC_SHUFPD:
-      case ZYDIS_MNEMONIC_VSHUFPD:
-      case ZYDIS_MNEMONIC_PSHUFHW:
-      case ZYDIS_MNEMONIC_VPSHUFHW:
-      case ZYDIS_MNEMONIC_PSHUFLW:
-      case ZYDIS_MNEMONIC_VPSHUFLW:
-      case ZYDIS_MNEMONIC_VPSHUFBITQMB:
-      case ZYDIS_MNEMONIC_VSHUFF32X4:
-      case ZYDIS_MNEMONIC_VSHUFF64X2:
-      case ZYDIS_MNEMONIC_VSHUFI32X4:
-      case ZYDIS_MNEMONIC_VSHUFI64X2:
-        zydec_HintOp(ZydecFormattingInfo::Shuffle, pInfo);
-        break;
+    if (*pPartitionCount == partitionCapacity)
+      return false;
 
-      case ZYDIS_MNEMONIC_PTEST:
-      case ZYDIS_MNEMONIC_VPTEST:
-      case ZYDIS_MNEMONIC_VTESTPD:
-      case ZYDIS_MNEMONIC_VTESTPS:
-        zydec_HintOp(ZydecFormattingInfo::Test, pInfo);
-        break;
+    pPartitions[*pPartitionCount].offset = partitionStart;
+    pPartitions[*pPartitionCount].size = codeOffset - partitionStart;
+    (*pPartitionCount)++;
 
-      case ZYDIS_MNEMONIC_PUNPCKHBW:
-      case ZYDIS_MNEMONIC_VPUNPCKHBW:
-      case ZYDIS_MNEMONIC_PUNPCKHWD:
-      case ZYDIS_MNEMONIC_VPUNPCKHWD:
-      case ZYDIS_MNEMONIC_PUNPCKHDQ:
-      case ZYDIS_MNEMONIC_VPUNPCKHDQ:
-      case ZYDIS_MNEMONIC_PUNPCKHQDQ:
-      case ZYDIS_MNEMONIC_VPUNPCKHQDQ:
-      case ZYDIS_MNEMONIC_UNPCKHPD:
-      case ZYDIS_MNEMONIC_VUNPCKHPD:
-      case ZYDIS_MNEMONIC_UNPCKHPS:
-      case ZYDIS_MNEMONIC_VUNPCKHPS:
-      case ZYDIS_MNEMONIC_PUNPCKLBW:
-      case ZYDIS_MNEMONIC_VPUNPCKLBW:
-      case ZYDIS_MNEMONIC_PUNPCKLWD:
-      case ZYDIS_MNEMONIC_VPUNPCKLWD:
-      case ZYDIS_MNEMONIC_PUNPCKLDQ:
-      case ZYDIS_MNEMONIC_VPUNPCKLDQ:
-      case ZYDIS_MNEMONIC_PUNPCKLQDQ:
-      case ZYDIS_MNEMONIC_VPUNPCKLQDQ:
-      case ZYDIS_MNEMONIC_UNPCKLPD:
-      case ZYDIS_MNEMONIC_VUNPCKLPD:
-      case ZYDIS_MNEMONIC_UNPCKLPS:
-      case ZYDIS_MNEMONIC_VUNPCKLPS:
-      case ZYDIS_MNEMONIC_KUNPCKBW:
-      case ZYDIS_MNEMONIC_KUNPCKWD:
-      case ZYDIS_MNEMONIC_KUNPCKDQ:
-        zydec_HintOp(ZydecFormattingInfo::Unpack, pInfo);
-        break;
+    partitionStart = codeOffset;
+  }
 
-      case ZYDIS_MNEMONIC_PXOR:
-      case ZYDIS_MNEMONIC_VPXOR:
-      case ZYDIS_MNEMONIC_XORPS:
-      case ZYDIS_MNEMONIC_VXORPS:
-      case ZYDIS_MNEMONIC_XORPD:
-      case ZYDIS_MNEMONIC_VXORPD:
-        zydec_HintOp(ZydecFormattingInfo::XOr, pInfo);
-        break;
+  return true;
+}
 
-      case ZYDIS_MNEMONIC_KNOTB:
-      case ZYDIS_MNEMONIC_KNOTW:
-      case ZYDIS_MNEMONIC_KNOTD:
-      case ZYDIS_MNEMONIC_KNOTQ:
-        zydec_HintOp(ZydecFormattingInfo::Not, pInfo);
-        break;
+////////////////////////////////////////////////////////////////////////////////
 
-      case ZYDIS_MNEMONIC_KXNORB:
-      case ZYDIS_MNEMONIC_KXNORW:
-      case ZYDIS_MNEMONIC_KXNORD:
-      case ZYDIS_MNEMONIC_KXNORQ:
-        zydec_HintOp(ZydecFormattingInfo::XNor, pInfo);
-        break;
+struct ZydecBlockIR
+{
+  ZydecTranslatorMode mode;
+  ZydecFormattingInfo info; // Options & callbacks to render with.
+  ZydecKernelFunc *pRenderKernel;
 
-      case ZYDIS_MNEMONIC_VPERMT2B:
-      case ZYDIS_MNEMONIC_VPERMT2W:
-      case ZYDIS_MNEMONIC_VPERMT2D:
-      case ZYDIS_MNEMONIC_VPERMT2Q:
-      case ZYDIS_MNEMONIC_VPERMT2PS:
-      case ZYDIS_MNEMONIC_VPERMT2PD:
-      case ZYDIS_MNEMONIC_VPERMB:
-      case ZYDIS_MNEMONIC_VPERMW:
-      case ZYDIS_MNEMONIC_VPERMD:
-        zydec_HintOp(ZydecFormattingInfo::Permute, pInfo);
-        break;
+  ZydecInstructionIR *pInstructions = nullptr;
+  size_t instructionCount = 0;
+  size_t instructionCapacity = 0;
 
-      case ZYDIS_MNEMONIC_VPOPCNTB:
-      case ZYDIS_MNEMONIC_VPOPCNTW:
-      case ZYDIS_MNEMONIC_VPOPCNTD:
-      case ZYDIS_MNEMONIC_VPOPCNTQ:
-        zydec_HintOp(ZydecFormattingInfo::PopCnt, pInfo);
-        break;
+  ZydecOperandIR *pOperands = nullptr;
+  size_t operandCount = 0;
+  size_t operandCapacity = 0;
 
-      case ZYDIS_MNEMONIC_VPXORQ:
-      case ZYDIS_MNEMONIC_VPXORD:
-        zydec_HintOp(ZydecFormattingInfo::XOr, pInfo);
-        break;
+  uint32_t *pRegisterNames = nullptr;
+  size_t registerNameCount = 0;
+  size_t registerNameCapacity = 0;
+};
 
-      default:
-        break;
-      }
+// Holds the recorded register names of the instruction that's currently being rendered.
+struct ZydecReplayState
+{
+  const uint32_t *pRegisterNames;
+  size_t registerNameCount;
+  size_t nextRegisterName;
+};
 
-      ERROR_CHECK(zydec_WriteResultOperand(&bufferPos, &remainingSize, &pOperands[0], virtualAddress, pInfo));
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " = "));
-    }
+// Writes the register names recorded in a `ZydecBlockIR`, rather than asking the linear context for new ones.
+struct ZydecReplayEmitter : ZydecTextSink
+{
+  static bool AcceptsHints(const ZydecFormattingInfo *)
+  {
+    return false;
+  }
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_PAND:
-    case ZYDIS_MNEMONIC_VPAND:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_and_si("));
-      break;
+  static bool WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    ZydecReplayState *pState = static_cast<ZydecReplayState *>(pInfo->pRegUserData);
 
-    case ZYDIS_MNEMONIC_VPANDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_and_epi64("));
-      break;
+    if (pState->nextRegisterName == pState->registerNameCount)
+      return false;
 
-    case ZYDIS_MNEMONIC_VPANDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_and_epi32("));
-      break;
+    return zydec_LinearContext_WriteRegisterName<ZydecTextSink>(pBufferPos, pRemainingSize, reg, pState->pRegisterNames[pState->nextRegisterName++]);
+  }
 
-    case ZYDIS_MNEMONIC_PANDN:
-    case ZYDIS_MNEMONIC_VPANDN:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_andnot_si("));
-      break;
+  static bool WriteResultRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo)
+  {
+    return WriteRegister(pBufferPos, pRemainingSize, reg, pInfo);
+  }
 
-    case ZYDIS_MNEMONIC_VPANDNQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_andnot_epi64("));
-      break;
+  static ZydecTokenKind RegisterTokenKind(const ZydecFormattingInfo *pInfo, const bool)
+  {
+    const ZydecReplayState *pState = static_cast<const ZydecReplayState *>(pInfo->pRegUserData);
 
-    case ZYDIS_MNEMONIC_VPANDND:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_andnot_epi32("));
-      break;
+    return pState->pRegisterNames[pState->nextRegisterName - 1] != 0 ? ZydecTokenKind::RenamedRegister : ZydecTokenKind::Register;
+  }
 
-    case ZYDIS_MNEMONIC_VANDNPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_andnot_ps("));
-      break;
+  static void HintRegister(const ZydisRegister, ZydecFormattingInfo *) { }
+  static void HintValue(const int64_t, ZydecFormattingInfo *) { }
+  static void HintOperation(const ZydecFormattingInfo::HintOperation, ZydecFormattingInfo *) { }
+  static void AfterCall(ZydecFormattingInfo *) { }
+};
 
-    case ZYDIS_MNEMONIC_VANDNPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_andnot_pd("));
-      break;
+template <typename T>
+static bool zydec_BlockIR_Reserve(T **ppItems, size_t *pCapacity, const size_t count)
+{
+  if (count <= *pCapacity)
+    return true;
 
-    case ZYDIS_MNEMONIC_PCMPEQB:
-    case ZYDIS_MNEMONIC_VPCMPEQB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpeq_epi8("));
-      break;
+  size_t newCapacity = *pCapacity * 2;
 
-    case ZYDIS_MNEMONIC_PCMPEQW:
-    case ZYDIS_MNEMONIC_VPCMPEQW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpeq_epi16("));
-      break;
+  if (newCapacity < count)
+    newCapacity = count;
 
-    case ZYDIS_MNEMONIC_PCMPEQD:
-    case ZYDIS_MNEMONIC_VPCMPEQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpeq_epi32("));
-      break;
+  if (newCapacity < 64)
+    newCapacity = 64;
 
-    case ZYDIS_MNEMONIC_PCMPEQQ:
-    case ZYDIS_MNEMONIC_VPCMPEQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpeq_epi64("));
-      break;
+  T *pItems = reinterpret_cast<T *>(realloc(*ppItems, sizeof(T) * newCapacity));
 
-    case ZYDIS_MNEMONIC_PCMPGTB:
-    case ZYDIS_MNEMONIC_VPCMPGTB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpgt_epi8("));
-      break;
+  if (pItems == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_PCMPGTW:
-    case ZYDIS_MNEMONIC_VPCMPGTW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpgt_epi16("));
-      break;
+  *ppItems = pItems;
+  *pCapacity = newCapacity;
 
-    case ZYDIS_MNEMONIC_PCMPGTD:
-    case ZYDIS_MNEMONIC_VPCMPGTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpgt_epi32("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_PCMPGTQ:
-    case ZYDIS_MNEMONIC_VPCMPGTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpgt_epi64("));
-      break;
+static bool zydec_BlockIR_AddRegisterName(ZydecBlockIR *pBlockIR, const uint32_t registerName)
+{
+  if (!zydec_BlockIR_Reserve(&pBlockIR->pRegisterNames, &pBlockIR->registerNameCapacity, pBlockIR->registerNameCount + 1))
+    return false;
 
-    case ZYDIS_MNEMONIC_PACKUSWB:
-    case ZYDIS_MNEMONIC_VPACKUSWB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_packus_epu16_to_epi8("));
-      break;
+  pBlockIR->pRegisterNames[pBlockIR->registerNameCount++] = registerName;
 
-    case ZYDIS_MNEMONIC_PACKUSDW:
-    case ZYDIS_MNEMONIC_VPACKUSDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_packus_epu32_to_epi16("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_PACKSSWB:
-    case ZYDIS_MNEMONIC_VPACKSSWB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_packs_epu16_to_epi8("));
-      break;
+static void zydec_OperandToIR(const ZydisDecodedOperand *pOperand, ZydecOperandIR *pOperandIR)
+{
+  *pOperandIR = ZydecOperandIR();
+  pOperandIR->type = (uint8_t)pOperand->type;
+  pOperandIR->elementSize = pOperand->element_size;
 
-    case ZYDIS_MNEMONIC_PACKSSDW:
-    case ZYDIS_MNEMONIC_VPACKSSDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_packs_epu32_to_epi16("));
-      break;
+  switch (pOperand->type)
+  {
+  case ZYDIS_OPERAND_TYPE_REGISTER:
+    pOperandIR->reg = (uint16_t)pOperand->reg.value;
+    break;
 
-    case ZYDIS_MNEMONIC_PADDB:
-    case ZYDIS_MNEMONIC_VPADDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_epi8("));
-      break;
+  case ZYDIS_OPERAND_TYPE_MEMORY:
+    pOperandIR->memoryType = (uint8_t)pOperand->mem.type;
+    pOperandIR->segment = (uint16_t)pOperand->mem.segment;
+    pOperandIR->reg = (uint16_t)pOperand->mem.base;
+    pOperandIR->index = (uint16_t)pOperand->mem.index;
+    pOperandIR->scale = pOperand->mem.scale;
+    pOperandIR->flags = pOperand->mem.disp.has_displacement ? ZydecOperandIR::HasDisplacement : 0;
+    pOperandIR->value = pOperand->mem.disp.value;
+    break;
 
-    case ZYDIS_MNEMONIC_PADDW:
-    case ZYDIS_MNEMONIC_VPADDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_epi16("));
-      break;
+  case ZYDIS_OPERAND_TYPE_POINTER:
+    pOperandIR->segment = pOperand->ptr.segment;
+    pOperandIR->value = pOperand->ptr.offset;
+    break;
 
-    case ZYDIS_MNEMONIC_PADDD:
-    case ZYDIS_MNEMONIC_VPADDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_epi32("));
-      break;
+  case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+    pOperandIR->flags = (pOperand->imm.is_signed ? ZydecOperandIR::IsSigned : 0) | (pOperand->imm.is_relative ? ZydecOperandIR::IsRelative : 0);
+    pOperandIR->value = pOperand->imm.value.s;
+    break;
 
-    case ZYDIS_MNEMONIC_PADDQ:
-    case ZYDIS_MNEMONIC_VPADDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_epi64("));
-      break;
+  default:
+    break;
+  }
+}
 
-    case ZYDIS_MNEMONIC_ADDPS:
-    case ZYDIS_MNEMONIC_VADDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_ps("));
-      break;
+static void zydec_OperandFromIR(const ZydecOperandIR *pOperandIR, ZydisDecodedOperand *pOperand)
+{
+  pOperand->type = (ZydisOperandType)pOperandIR->type;
+  pOperand->element_size = pOperandIR->elementSize;
 
-    case ZYDIS_MNEMONIC_ADDPD:
-    case ZYDIS_MNEMONIC_VADDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_pd("));
-      break;
+  switch (pOperand->type)
+  {
+  case ZYDIS_OPERAND_TYPE_REGISTER:
+    pOperand->reg.value = (ZydisRegister)pOperandIR->reg;
+    break;
 
-    case ZYDIS_MNEMONIC_ADDSS:
-    case ZYDIS_MNEMONIC_VADDSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_ss("));
-      break;
+  case ZYDIS_OPERAND_TYPE_MEMORY:
+    pOperand->mem.type = (ZydisMemoryOperandType)pOperandIR->memoryType;
+    pOperand->mem.segment = (ZydisRegister)pOperandIR->segment;
+    pOperand->mem.base = (ZydisRegister)pOperandIR->reg;
+    pOperand->mem.index = (ZydisRegister)pOperandIR->index;
+    pOperand->mem.scale = pOperandIR->scale;
+    pOperand->mem.disp.has_displacement = !!(pOperandIR->flags & ZydecOperandIR::HasDisplacement);
+    pOperand->mem.disp.value = pOperandIR->value;
+    break;
 
-    case ZYDIS_MNEMONIC_ADDSD:
-    case ZYDIS_MNEMONIC_VADDSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_sd("));
-      break;
+  case ZYDIS_OPERAND_TYPE_POINTER:
+    pOperand->ptr.segment = pOperandIR->segment;
+    pOperand->ptr.offset = (uint32_t)pOperandIR->value;
+    break;
 
-    case ZYDIS_MNEMONIC_PADDSB:
-    case ZYDIS_MNEMONIC_PADDSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_adds_epi8("));
-      break;
+  case ZYDIS_OPERAND_TYPE_IMMEDIATE:
+    pOperand->imm.is_signed = !!(pOperandIR->flags & ZydecOperandIR::IsSigned);
+    pOperand->imm.is_relative = !!(pOperandIR->flags & ZydecOperandIR::IsRelative);
+    pOperand->imm.value.s = pOperandIR->value;
+    break;
 
-    case ZYDIS_MNEMONIC_VPADDSB:
-    case ZYDIS_MNEMONIC_VPADDSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_adds_epi16("));
-      break;
+  default:
+    break;
+  }
+}
 
-    case ZYDIS_MNEMONIC_EMMS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_empty("));
-      break;
+bool zydec_Translator_BuildBlockIR(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, ZydecBlockIR **ppBlockIR)
+{
+  if (pTranslator == nullptr || pCode == nullptr || ppBlockIR == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_PMADDWD:
-    case ZYDIS_MNEMONIC_VPMADDWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_pmadd_epi16("));
-      break;
+  ZydecBlockIR *pBlockIR = new (std::nothrow) ZydecBlockIR();
 
-    case ZYDIS_MNEMONIC_PMULHW:
-    case ZYDIS_MNEMONIC_VPMULHW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mulhi_epi16("));
-      break;
+  if (pBlockIR == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_PMULLW:
-    case ZYDIS_MNEMONIC_VPMULLW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mullo_epi16("));
-      break;
+  pBlockIR->mode = pTranslator->mode;
+  pBlockIR->info = pTranslator->info;
+  pBlockIR->info.pFlagProducer = nullptr; // Recorded & replayed without fused conditions.
 
-    case ZYDIS_MNEMONIC_POR:
-    case ZYDIS_MNEMONIC_VPOR:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_or_si("));
-      break;
+  ZydecKernelFunc *pRecordingKernel = nullptr;
+  pTranslator->info.pFlagProducer = nullptr;
 
-    case ZYDIS_MNEMONIC_VPORD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_or_epi32("));
-      break;
+  if (pTranslator->mode == ZydecTranslatorMode::LinearContext)
+  {
+    pBlockIR->pRenderKernel = zydec_SelectKernel<ZydecReplayEmitter>(&pBlockIR->info);
+    pRecordingKernel = zydec_SelectKernel<ZydecLinearContextRecordingEmitter>(&pTranslator->info);
+    pTranslator->formatContextInfo.pRecordingBlockIR = pBlockIR;
+  }
+  else
+  {
+    pBlockIR->pRenderKernel = pTranslator->pKernel;
+  }
 
-    case ZYDIS_MNEMONIC_VPORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_or_epi64("));
-      break;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_PABSB:
-    case ZYDIS_MNEMONIC_VPABSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_abs_epi16("));
-      break;
+  size_t codeOffset = 0;
+  bool success = true;
 
-    case ZYDIS_MNEMONIC_PABSW:
-    case ZYDIS_MNEMONIC_VPABSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_abs_epi16("));
+  while (codeOffset < size)
+  {
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&pTranslator->decoder, pCode + codeOffset, size - codeOffset, &instruction, operands)) || instruction.length == 0)
+    {
+      success = false;
       break;
+    }
 
-    case ZYDIS_MNEMONIC_PABSD:
-    case ZYDIS_MNEMONIC_VPABSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_abs_epi32("));
+    if (!zydec_BlockIR_Reserve(&pBlockIR->pInstructions, &pBlockIR->instructionCapacity, pBlockIR->instructionCount + 1) || !zydec_BlockIR_Reserve(&pBlockIR->pOperands, &pBlockIR->operandCapacity, pBlockIR->operandCount + instruction.operand_count))
+    {
+      success = false;
       break;
+    }
 
-    case ZYDIS_MNEMONIC_ADDSUBPS:
-    case ZYDIS_MNEMONIC_VADDSUBPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_addsub_ps("));
-      break;
-      
-    case ZYDIS_MNEMONIC_ADDSUBPD:
-    case ZYDIS_MNEMONIC_VADDSUBPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_addsub_pd("));
-      break;
-      
-    case ZYDIS_MNEMONIC_PALIGNR:
-    case ZYDIS_MNEMONIC_VPALIGNR:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_alignr_epi8("));
-      break;
+    ZydecInstructionIR *pInstructionIR = &pBlockIR->pInstructions[pBlockIR->instructionCount];
+    pInstructionIR->virtualAddress = baseAddress + codeOffset;
+    pInstructionIR->firstOperand = (uint32_t)pBlockIR->operandCount;
+    pInstructionIR->firstRegisterName = (uint32_t)pBlockIR->registerNameCount;
+    pInstructionIR->mnemonic = (uint16_t)instruction.mnemonic;
+    pInstructionIR->operandCount = instruction.operand_count;
+    pInstructionIR->length = instruction.length;
 
-    case ZYDIS_MNEMONIC_PAVGB:
-    case ZYDIS_MNEMONIC_VPAVGB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_avg_epu8("));
-      break;
+    for (size_t i = 0; i < instruction.operand_count; i++)
+      zydec_OperandToIR(&operands[i], &pBlockIR->pOperands[pBlockIR->operandCount++]);
 
-    case ZYDIS_MNEMONIC_PAVGW:
-    case ZYDIS_MNEMONIC_VPAVGW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_avg_epu16("));
-      break;
+    if (pTranslator->mode == ZydecTranslatorMode::LinearContext)
+    {
+      char buffer[1];
+      bool hasTranslation = false;
 
-    case ZYDIS_MNEMONIC_PBLENDW:
-    case ZYDIS_MNEMONIC_VPBLENDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blend_epi16("));
-      break;
+      const bool result = zydec_LinearContext_TranslateInstruction(pRecordingKernel, &pTranslator->formatContextInfo, &pTranslator->info, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)pInstructionIR->virtualAddress, buffer, sizeof(buffer), &hasTranslation);
 
-    case ZYDIS_MNEMONIC_VPBLENDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blend_epi32("));
-      break;
+      pInstructionIR->hasTranslation = result && hasTranslation;
+    }
+    else
+    {
+      pInstructionIR->hasTranslation = instruction.mnemonic < sizeof(MnemonicDescriptors) / sizeof(MnemonicDescriptors[0]) && MnemonicDescriptors[instruction.mnemonic].pattern != zpk_none;
+    }
 
-    case ZYDIS_MNEMONIC_BLENDPS:
-    case ZYDIS_MNEMONIC_VBLENDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blend_ps("));
-      break;
+    const size_t registerNameCount = pBlockIR->registerNameCount - pInstructionIR->firstRegisterName;
 
-    case ZYDIS_MNEMONIC_BLENDPD:
-    case ZYDIS_MNEMONIC_VBLENDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blend_pd("));
+    if (registerNameCount > UINT8_MAX)
+    {
+      success = false;
       break;
+    }
 
-    case ZYDIS_MNEMONIC_PBLENDVB:
-    case ZYDIS_MNEMONIC_VPBLENDVB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blendv_epi8("));
-      break;
+    pInstructionIR->registerNameCount = (uint8_t)registerNameCount;
+    pBlockIR->instructionCount++;
+    codeOffset += instruction.length;
+  }
 
-    case ZYDIS_MNEMONIC_BLENDVPS:
-    case ZYDIS_MNEMONIC_VBLENDVPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blendv_ps("));
-      break;
+  pTranslator->formatContextInfo.pRecordingBlockIR = nullptr;
+  zydec_Translator_BindFlagProducer(pTranslator);
 
-    case ZYDIS_MNEMONIC_BLENDVPD:
-    case ZYDIS_MNEMONIC_VBLENDVPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_blendv_pd("));
-      break;
+  if (!success)
+  {
+    zydec_DestroyBlockIR(&pBlockIR);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VBROADCASTF128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f128("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VBROADCASTF32X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f32x2("));
-      break;
+  *ppBlockIR = pBlockIR;
 
-    case ZYDIS_MNEMONIC_VBROADCASTF32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f32x4("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VBROADCASTF32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f32x8("));
-      break;
+void zydec_DestroyBlockIR(ZydecBlockIR **ppBlockIR)
+{
+  if (ppBlockIR == nullptr || *ppBlockIR == nullptr)
+    return;
 
-    case ZYDIS_MNEMONIC_VBROADCASTF64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f64x2("));
-      break;
+  free((*ppBlockIR)->pInstructions);
+  free((*ppBlockIR)->pOperands);
+  free((*ppBlockIR)->pRegisterNames);
 
-    case ZYDIS_MNEMONIC_VBROADCASTF64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_f64x4("));
-      break;
+  delete *ppBlockIR;
+  *ppBlockIR = nullptr;
+}
 
-    case ZYDIS_MNEMONIC_VBROADCASTI128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcastsi128_si256("));
-      break;
+size_t zydec_BlockIR_GetInstructionCount(const ZydecBlockIR *pBlockIR)
+{
+  return pBlockIR == nullptr ? 0 : pBlockIR->instructionCount;
+}
 
-    case ZYDIS_MNEMONIC_VBROADCASTI32X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_i32x2("));
-      break;
+const ZydecInstructionIR *zydec_BlockIR_GetInstruction(const ZydecBlockIR *pBlockIR, const size_t index)
+{
+  if (pBlockIR == nullptr || index >= pBlockIR->instructionCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VBROADCASTI32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_i32x4("));
-      break;
+  return &pBlockIR->pInstructions[index];
+}
 
-    case ZYDIS_MNEMONIC_VBROADCASTI32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_i32x8("));
-      break;
+const ZydecOperandIR *zydec_BlockIR_GetOperands(const ZydecBlockIR *pBlockIR, const size_t index)
+{
+  if (pBlockIR == nullptr || index >= pBlockIR->instructionCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VBROADCASTI64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_i64x2("));
-      break;
+  return pBlockIR->pOperands + pBlockIR->pInstructions[index].firstOperand;
+}
 
-    case ZYDIS_MNEMONIC_VBROADCASTI64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_i64x4("));
-      break;
-    
-    case ZYDIS_MNEMONIC_VBROADCASTSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_sd("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VBROADCASTSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_ss("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPBROADCASTB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_epi8("));
-      break;
+const uint32_t *zydec_BlockIR_GetRegisterNames(const ZydecBlockIR *pBlockIR, const size_t index)
+{
+  if (pBlockIR == nullptr || index >= pBlockIR->instructionCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VPBROADCASTW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_epi16("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPBROADCASTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_epi32("));
-      break;
+  return pBlockIR->pRegisterNames + pBlockIR->pInstructions[index].firstRegisterName;
+}
 
-    case ZYDIS_MNEMONIC_VPBROADCASTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcast_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPBROADCASTMB2Q:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcastmb_epi64("));
-      break;
+bool zydec_BlockIR_RenderInstruction(const ZydecBlockIR *pBlockIR, const size_t index, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
+{
+  if (pBlockIR == nullptr || index >= pBlockIR->instructionCount || buffer == nullptr || bufferCapacity == 0 || pHasTranslation == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPBROADCASTMW2D:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_broadcastmw_epi32("));
-      break;
+  const ZydecInstructionIR *pInstructionIR = &pBlockIR->pInstructions[index];
 
-    case ZYDIS_MNEMONIC_PSLLDQ:
-    case ZYDIS_MNEMONIC_VPSLLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_bslli_epi128("));
-      break;
+  if (!pInstructionIR->hasTranslation)
+  {
+    *pHasTranslation = false;
+    buffer[0] = '\0';
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_PSRLDQ:
-    case ZYDIS_MNEMONIC_VPSRLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_bsrli_epi128("));
-      break;
+  ZydisDecodedInstruction instruction = {};
+  instruction.mnemonic = (ZydisMnemonic)pInstructionIR->mnemonic;
+  instruction.length = pInstructionIR->length;
+  instruction.operand_count = pInstructionIR->operandCount;
 
-    case ZYDIS_MNEMONIC_ROUNDSS:
-    case ZYDIS_MNEMONIC_VROUNDSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_round_ss("));
-      break;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT] = {};
 
-    case ZYDIS_MNEMONIC_ROUNDSD:
-    case ZYDIS_MNEMONIC_VROUNDSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_round_sd("));
-      break;
+  for (size_t i = 0; i < pInstructionIR->operandCount; i++)
+    zydec_OperandFromIR(&pBlockIR->pOperands[pInstructionIR->firstOperand + i], &operands[i]);
 
-    case ZYDIS_MNEMONIC_ROUNDPS:
-    case ZYDIS_MNEMONIC_VROUNDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_round_ps("));
-      break;
+  ZydecFormattingInfo info = pBlockIR->info;
+  ZydecReplayState replayState;
 
-    case ZYDIS_MNEMONIC_ROUNDPD:
-    case ZYDIS_MNEMONIC_VROUNDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_round_pd("));
-      break;
+  if (pBlockIR->mode == ZydecTranslatorMode::LinearContext)
+  {
+    replayState.pRegisterNames = pBlockIR->pRegisterNames + pInstructionIR->firstRegisterName;
+    replayState.registerNameCount = pInstructionIR->registerNameCount;
+    replayState.nextRegisterName = 0;
 
-    case ZYDIS_MNEMONIC_CLFLUSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_clflush("));
-      addressParam = true;
-      break;
+    info.pRegUserData = &replayState;
+  }
 
-    case ZYDIS_MNEMONIC_CLFLUSHOPT:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_clflushopt("));
-      addressParam = true;
-      break;
+  return pBlockIR->pRenderKernel(&instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)pInstructionIR->virtualAddress, buffer, bufferCapacity, pHasTranslation, &info);
+}
 
-    case ZYDIS_MNEMONIC_CMPSS:
-    case ZYDIS_MNEMONIC_VCMPSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_ss("));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_CMPSD:
-    case ZYDIS_MNEMONIC_VCMPSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_sd("));
-      break;
+enum ZydecBranchKind : uint8_t
+{
+  zbk_conditional, // Falls through or continues at the target.
+  zbk_jump, // Only continues at the target (if it's known).
+  zbk_exit, // Returns or jumps somewhere unknown.
+};
 
-    case ZYDIS_MNEMONIC_CMPPS:
-    case ZYDIS_MNEMONIC_VCMPPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_ps("));
-      break;
+struct ZydecBranch
+{
+  size_t instructionIndex;
+  size_t targetOffset; // `SIZE_MAX` if the target isn't the start of an instruction in the code.
+  ZydecBranchKind kind;
+};
 
-    case ZYDIS_MNEMONIC_CMPPD:
-    case ZYDIS_MNEMONIC_VCMPPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_pd("));
-      break;
+enum ZydecBlockState_ : uint8_t
+{
+  zbs_named = 1 << 0, // The exit context holds the names at the end of the block.
+  zbs_seed = 1 << 1, // Starts with the linear context of the translator, like an entry point.
+  zbs_pending = 1 << 2, // The entry context changed since the block was last named.
+};
 
-    case ZYDIS_MNEMONIC_PCMPESTRI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpstr("));
-      break;
+typedef uint8_t ZydecBlockState;
 
-    case ZYDIS_MNEMONIC_PCMPESTRM:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmpestrm("));
-      break;
+struct ZydecControlFlowGraph
+{
+  const uint8_t *pCode;
+  size_t size;
+  uint64_t baseAddress;
 
-    case ZYDIS_MNEMONIC_COMISS:
-    case ZYDIS_MNEMONIC_VCOMISS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_comieq_ss("));
-      break;
+  size_t *pInstructionOffsets; // Ascending.
+  size_t instructionCount;
+  size_t instructionCapacity;
 
-    case ZYDIS_MNEMONIC_COMISD:
-    case ZYDIS_MNEMONIC_VCOMISD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_comieq_sd("));
-      break;
+  ZydecBasicBlock *pBlocks; // Ordered by address.
+  size_t blockCount;
+  size_t blockCapacity;
 
-    case ZYDIS_MNEMONIC_VCOMISH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_comieq_sh("));
-      break;
+  size_t *pPredecessors; // Grouped by block, see `ZydecBasicBlock::firstPredecessor`.
+  ZydecLinearContext *pEntryContexts;
+};
 
-    case ZYDIS_MNEMONIC_CRC32:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_crc32("));
-      break;
+static bool zydec_ControlFlowGraph_FindInstruction(const ZydecControlFlowGraph *pGraph, const size_t offset, size_t *pInstructionIndex)
+{
+  size_t first = 0;
+  size_t last = pGraph->instructionCount;
 
-    case ZYDIS_MNEMONIC_CVTPI2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpi_ps("));
-      break;
+  while (first < last)
+  {
+    const size_t mid = first + (last - first) / 2;
 
-    case ZYDIS_MNEMONIC_CVTPS2PI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_pi("));
-      break;
+    if (pGraph->pInstructionOffsets[mid] < offset)
+      first = mid + 1;
+    else
+      last = mid;
+  }
 
-    case ZYDIS_MNEMONIC_CVTSI2SS:
-    case ZYDIS_MNEMONIC_VCVTSI2SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsi_ss("));
-      break;
+  if (first == pGraph->instructionCount || pGraph->pInstructionOffsets[first] != offset)
+    return false;
 
-    case ZYDIS_MNEMONIC_CVTSS2SI:
-    case ZYDIS_MNEMONIC_VCVTSS2SI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_si("));
-      break;
+  *pInstructionIndex = first;
 
-    case ZYDIS_MNEMONIC_PMOVSXWD:
-    case ZYDIS_MNEMONIC_VPMOVSXWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi16_epi32("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_PMOVSXWQ:
-    case ZYDIS_MNEMONIC_VPMOVSXWQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi16_epi64("));
-      break;
+// The block containing the instruction.
+static size_t zydec_ControlFlowGraph_BlockOfInstruction(const ZydecControlFlowGraph *pGraph, const size_t instructionIndex)
+{
+  size_t first = 0;
+  size_t last = pGraph->blockCount;
 
-    case ZYDIS_MNEMONIC_PMOVSXDQ:
-    case ZYDIS_MNEMONIC_VPMOVSXDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_epi64("));
-      break;
+  while (last - first > 1)
+  {
+    const size_t mid = first + (last - first) / 2;
 
-    case ZYDIS_MNEMONIC_CVTDQ2PS:
-    case ZYDIS_MNEMONIC_VCVTDQ2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_ps("));
-      break;
+    if (pGraph->pBlocks[mid].firstInstruction <= instructionIndex)
+      first = mid;
+    else
+      last = mid;
+  }
 
-    case ZYDIS_MNEMONIC_CVTDQ2PD:
-    case ZYDIS_MNEMONIC_VCVTDQ2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_pd("));
-      break;
+  return first;
+}
 
-    case ZYDIS_MNEMONIC_PMOVSXBW:
-    case ZYDIS_MNEMONIC_VPMOVSXBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi8_epi16("));
-      break;
+// Decodes the code & records where every instruction starts and where control flow leaves the straight line.
+static bool zydec_ControlFlowGraph_Decode(ZydecControlFlowGraph *pGraph, const ZydisDecoder *pDecoder, ZydecBranch **ppBranches, size_t *pBranchCount, size_t *pBranchCapacity)
+{
+  ZydisDecoderContext decoderContext;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_PMOVSXBD:
-    case ZYDIS_MNEMONIC_VPMOVSXBD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi8_epi32("));
-      break;
+  size_t codeOffset = 0;
 
-    case ZYDIS_MNEMONIC_PMOVSXBQ:
-    case ZYDIS_MNEMONIC_VPMOVSXBQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi8_epi64("));
-      break;
+  while (codeOffset < pGraph->size)
+  {
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeInstruction(pDecoder, &decoderContext, pGraph->pCode + codeOffset, pGraph->size - codeOffset, &instruction)) || instruction.length == 0)
+      return false;
 
-    case ZYDIS_MNEMONIC_PMOVZXWD:
-    case ZYDIS_MNEMONIC_VPMOVZXWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu16_epi32("));
-      break;
+    if (!zydec_BlockIR_Reserve(&pGraph->pInstructionOffsets, &pGraph->instructionCapacity, pGraph->instructionCount + 1))
+      return false;
 
-    case ZYDIS_MNEMONIC_PMOVZXWQ:
-    case ZYDIS_MNEMONIC_VPMOVZXWQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu16_epi64("));
-      break;
+    pGraph->pInstructionOffsets[pGraph->instructionCount] = codeOffset;
 
-    case ZYDIS_MNEMONIC_PMOVZXDQ:
-    case ZYDIS_MNEMONIC_VPMOVZXDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu32_epi64("));
-      break;
+    ZydecBranchKind kind;
 
-    case ZYDIS_MNEMONIC_PMOVZXBW:
-    case ZYDIS_MNEMONIC_VPMOVZXBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu8_epi16("));
+    switch (instruction.meta.category)
+    {
+    case ZYDIS_CATEGORY_COND_BR:
+      kind = zbk_conditional;
       break;
 
-    case ZYDIS_MNEMONIC_PMOVZXBD:
-    case ZYDIS_MNEMONIC_VPMOVZXBD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu8_epi32("));
+    case ZYDIS_CATEGORY_UNCOND_BR:
+      kind = zbk_jump;
       break;
 
-    case ZYDIS_MNEMONIC_PMOVZXBQ:
-    case ZYDIS_MNEMONIC_VPMOVZXBQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu8_epi64("));
+    case ZYDIS_CATEGORY_RET:
+      kind = zbk_exit;
       break;
 
-    case ZYDIS_MNEMONIC_VCVTPH2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_ps("));
-      break;
+    default:
+      pGraph->instructionCount++;
+      codeOffset += instruction.length;
+      continue;
+    }
 
-    case ZYDIS_MNEMONIC_VCVTNEPS2BF16:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtneps_pbh("));
-      break;
+    size_t targetOffset = SIZE_MAX;
+    ZyanU64 target;
 
-    case ZYDIS_MNEMONIC_CVTPD2DQ:
-    case ZYDIS_MNEMONIC_VCVTPD2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_epi32("));
-      break;
+    // The target of relative branches is the only operand they have to decode.
+    if ((instruction.attributes & ZYDIS_ATTRIB_IS_RELATIVE) != 0 && instruction.operand_count > 0 && ZYAN_SUCCESS(ZydisDecoderDecodeOperands(pDecoder, &decoderContext, &instruction, operands, 1)) && ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instruction, &operands[0], pGraph->baseAddress + codeOffset, &target)))
+    {
+      if (target >= pGraph->baseAddress && target - pGraph->baseAddress < pGraph->size)
+        targetOffset = (size_t)(target - pGraph->baseAddress);
+    }
 
-    case ZYDIS_MNEMONIC_CVTPD2PI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_pi32("));
-      break;
+    if (kind == zbk_jump && targetOffset == SIZE_MAX)
+      kind = zbk_exit;
 
-    case ZYDIS_MNEMONIC_CVTPD2PS:
-    case ZYDIS_MNEMONIC_VCVTPD2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_ps("));
-      break;
+    if (!zydec_BlockIR_Reserve(ppBranches, pBranchCapacity, *pBranchCount + 1))
+      return false;
 
-    case ZYDIS_MNEMONIC_CVTPI2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpi32_pd("));
-      break;
+    ZydecBranch *pBranch = &(*ppBranches)[(*pBranchCount)++];
+    pBranch->instructionIndex = pGraph->instructionCount;
+    pBranch->targetOffset = targetOffset;
+    pBranch->kind = kind;
 
-    case ZYDIS_MNEMONIC_CVTPS2DQ:
-    case ZYDIS_MNEMONIC_VCVTPS2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_epi32("));
-      break;
+    pGraph->instructionCount++;
+    codeOffset += instruction.length;
+  }
 
-    case ZYDIS_MNEMONIC_CVTPS2PD:
-    case ZYDIS_MNEMONIC_VCVTPS2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_pd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VCVTPS2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_ph("));
-      break;
+// Splits the instructions into blocks at branch targets & after branches and connects them.
+static bool zydec_ControlFlowGraph_Split(ZydecControlFlowGraph *pGraph, ZydecBranch *pBranches, const size_t branchCount)
+{
+  bool *pIsLeader = reinterpret_cast<bool *>(calloc(pGraph->instructionCount, sizeof(bool)));
 
-    case ZYDIS_MNEMONIC_CVTSD2SI:
-    case ZYDIS_MNEMONIC_VCVTSD2SI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_si("));
-      break;
+  if (pIsLeader == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_CVTSD2SS:
-    case ZYDIS_MNEMONIC_VCVTSD2SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_ss("));
-      break;
+  pIsLeader[0] = true;
 
-    case ZYDIS_MNEMONIC_CVTSI2SD:
-    case ZYDIS_MNEMONIC_VCVTSI2SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsi_sd("));
-      break;
+  for (size_t i = 0; i < branchCount; i++)
+  {
+    ZydecBranch *pBranch = &pBranches[i];
 
-    case ZYDIS_MNEMONIC_CVTSS2SD:
-    case ZYDIS_MNEMONIC_VCVTSS2SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_sd("));
-      break;
+    if (pBranch->instructionIndex + 1 < pGraph->instructionCount)
+      pIsLeader[pBranch->instructionIndex + 1] = true;
 
-    case ZYDIS_MNEMONIC_CVTTPS2PI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttps_pi("));
-      break;
+    size_t targetIndex;
 
-    case ZYDIS_MNEMONIC_CVTTPD2DQ:
-    case ZYDIS_MNEMONIC_VCVTTPD2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttpd_epi32("));
-      break;
+    // Targets inside of another instruction don't get an edge.
+    if (pBranch->targetOffset != SIZE_MAX && zydec_ControlFlowGraph_FindInstruction(pGraph, pBranch->targetOffset, &targetIndex))
+      pIsLeader[targetIndex] = true;
+    else
+      pBranch->targetOffset = SIZE_MAX;
+  }
 
-    case ZYDIS_MNEMONIC_CVTTPD2PI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttpd_pi32("));
-      break;
+  bool success = true;
 
-    case ZYDIS_MNEMONIC_CVTTPS2DQ:
-    case ZYDIS_MNEMONIC_VCVTTPS2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttps_epi32("));
-      break;
+  for (size_t i = 0; i < pGraph->instructionCount; i++)
+  {
+    if (pIsLeader[i])
+    {
+      if (!zydec_BlockIR_Reserve(&pGraph->pBlocks, &pGraph->blockCapacity, pGraph->blockCount + 1))
+      {
+        success = false;
+        break;
+      }
 
-    case ZYDIS_MNEMONIC_CVTTSD2SI:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_si("));
-      break;
+      ZydecBasicBlock *pBlock = &pGraph->pBlocks[pGraph->blockCount++];
+      *pBlock = ZydecBasicBlock();
+      pBlock->virtualAddress = pGraph->baseAddress + pGraph->pInstructionOffsets[i];
+      pBlock->offset = pGraph->pInstructionOffsets[i];
+      pBlock->firstInstruction = i;
+    }
 
-    case ZYDIS_MNEMONIC_DIVPD:
-    case ZYDIS_MNEMONIC_VDIVPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_pd("));
-      break;
+    pGraph->pBlocks[pGraph->blockCount - 1].instructionCount++;
+  }
 
-    case ZYDIS_MNEMONIC_DIVPS:
-    case ZYDIS_MNEMONIC_VDIVPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_ps("));
-      break;
+  free(pIsLeader);
 
-    case ZYDIS_MNEMONIC_DIVSD:
-    case ZYDIS_MNEMONIC_VDIVSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_sd("));
-      break;
+  if (!success)
+    return false;
 
-    case ZYDIS_MNEMONIC_DIVSS:
-    case ZYDIS_MNEMONIC_VDIVSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_ss("));
-      break;
+  // Successors.
+  size_t branchIndex = 0;
 
-    case ZYDIS_MNEMONIC_DPPD:
-    case ZYDIS_MNEMONIC_VDPPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dp_pd("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+    const size_t lastInstruction = pBlock->firstInstruction + pBlock->instructionCount - 1;
+    const size_t endOffset = i + 1 < pGraph->blockCount ? pGraph->pBlocks[i + 1].offset : pGraph->size;
 
-    case ZYDIS_MNEMONIC_DPPS:
-    case ZYDIS_MNEMONIC_VDPPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dp_ps("));
-      break;
+    pBlock->size = endOffset - pBlock->offset;
 
-    case ZYDIS_MNEMONIC_VPDPWSSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dpwssd_epi32("));
-      break;
+    while (branchIndex < branchCount && pBranches[branchIndex].instructionIndex < lastInstruction)
+      branchIndex++;
 
-    case ZYDIS_MNEMONIC_VPDPWSSDS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dpwssds_epi32("));
-      break;
+    const ZydecBranch *pBranch = (branchIndex < branchCount && pBranches[branchIndex].instructionIndex == lastInstruction) ? &pBranches[branchIndex] : nullptr;
 
-    case ZYDIS_MNEMONIC_VPDPBUSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dpbusd_epi32("));
-      break;
+    if ((pBranch == nullptr || pBranch->kind == zbk_conditional) && i + 1 < pGraph->blockCount)
+      pBlock->successors[pBlock->successorCount++] = i + 1;
 
-    case ZYDIS_MNEMONIC_VPDPBUSDS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dpbusds_epi32("));
-      break;
+    if (pBranch != nullptr && pBranch->targetOffset != SIZE_MAX)
+    {
+      size_t targetIndex = 0; // Targets are only kept if they start an instruction.
+      zydec_ControlFlowGraph_FindInstruction(pGraph, pBranch->targetOffset, &targetIndex);
 
-    case ZYDIS_MNEMONIC_PEXTRB:
-    case ZYDIS_MNEMONIC_VPEXTRB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_epi8("));
-      break;
+      const size_t targetBlock = zydec_ControlFlowGraph_BlockOfInstruction(pGraph, targetIndex);
 
-    case ZYDIS_MNEMONIC_PEXTRW:
-    case ZYDIS_MNEMONIC_VPEXTRW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_epi16("));
-      break;
+      // A conditional branch to the next instruction only has one successor.
+      if (pBlock->successorCount == 0 || pBlock->successors[0] != targetBlock)
+        pBlock->successors[pBlock->successorCount++] = targetBlock;
+    }
 
-    case ZYDIS_MNEMONIC_PEXTRD:
-    case ZYDIS_MNEMONIC_VPEXTRD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_epi32("));
-      break;
+    for (size_t j = 0; j < pBlock->successorCount; j++)
+      pGraph->pBlocks[pBlock->successors[j]].predecessorCount++;
+  }
 
-    case ZYDIS_MNEMONIC_PEXTRQ:
-    case ZYDIS_MNEMONIC_VPEXTRQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_epi64("));
-      break;
+  // Predecessors.
+  size_t predecessorCount = 0;
 
-    case ZYDIS_MNEMONIC_EXTRACTPS:
-    case ZYDIS_MNEMONIC_VEXTRACTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_ps("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    pGraph->pBlocks[i].firstPredecessor = predecessorCount;
+    predecessorCount += pGraph->pBlocks[i].predecessorCount;
+    pGraph->pBlocks[i].predecessorCount = 0;
+  }
 
-    case ZYDIS_MNEMONIC_VEXTRACTF128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_f128("));
-      break;
+  pGraph->pPredecessors = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (predecessorCount > 0 ? predecessorCount : 1)));
 
-    case ZYDIS_MNEMONIC_VEXTRACTI128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extract_i128("));
-      break;
+  if (pGraph->pPredecessors == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VFMADD132PD:
-    case ZYDIS_MNEMONIC_VFMADD213PD:
-    case ZYDIS_MNEMONIC_VFMADD231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_pd("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VFMADD132PS:
-    case ZYDIS_MNEMONIC_VFMADD213PS:
-    case ZYDIS_MNEMONIC_VFMADD231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_ps("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
 
-    case ZYDIS_MNEMONIC_VFMADD132SD:
-    case ZYDIS_MNEMONIC_VFMADD213SD:
-    case ZYDIS_MNEMONIC_VFMADD231SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_sd("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VFMADD132SS:
-    case ZYDIS_MNEMONIC_VFMADD213SS:
-    case ZYDIS_MNEMONIC_VFMADD231SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_ss("));
-      break;
+    for (size_t j = 0; j < pBlock->successorCount; j++)
+    {
+      ZydecBasicBlock *pSuccessor = &pGraph->pBlocks[pBlock->successors[j]];
+      pGraph->pPredecessors[pSuccessor->firstPredecessor + pSuccessor->predecessorCount++] = i;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VFMADDSUB132PD:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PD:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmaddsub_pd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VFMADDSUB132PS:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PS:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmaddsub_ps("));
-      break;
+// Every block starts its sequential names from its own hash state, so they don't depend on the order the blocks are named in.
+static uint64_t zydec_ControlFlowGraph_BlockHashState(const uint64_t hashState, const uint64_t virtualAddress)
+{
+  return ((uint64_t)zydec_LinearContext_AddressSeededRegisterName(hashState, virtualAddress, zrs_count) << 32) | zydec_LinearContext_AddressSeededRegisterName(hashState, virtualAddress, zrs_count + 1);
+}
 
-    case ZYDIS_MNEMONIC_VFMSUB132PD:
-    case ZYDIS_MNEMONIC_VFMSUB213PD:
-    case ZYDIS_MNEMONIC_VFMSUB231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_pd("));
-      break;
+// The name of a register whose predecessors disagree on its name. Salted, so it differs from an address seeded name assigned by the first instruction of the block.
+static uint32_t zydec_ControlFlowGraph_MergedRegisterName(const uint64_t seed, const uint64_t virtualAddress, const size_t slot)
+{
+  return zydec_LinearContext_AddressSeededRegisterName(seed ^ 0x6A6F696E6A6F696EULL, virtualAddress, slot);
+}
 
-    case ZYDIS_MNEMONIC_VFMSUB132PS:
-    case ZYDIS_MNEMONIC_VFMSUB213PS:
-    case ZYDIS_MNEMONIC_VFMSUB231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_ps("));
-      break;
+// Blocks that are named more often than this only ever change registers to their merged names, so loops whose names keep changing still terminate.
+static constexpr size_t zydec_ControlFlowGraph_MaxPreciseVisits = 8;
 
-    case ZYDIS_MNEMONIC_VFMSUB132SD:
-    case ZYDIS_MNEMONIC_VFMSUB213SD:
-    case ZYDIS_MNEMONIC_VFMSUB231SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_sd("));
-      break;
+struct ZydecNamingState
+{
+  ZydecBlockState *pStates;
+  uint8_t *pVisitCounts;
+  uint64_t *pMergedSlots; // Registers that keep their merged name.
+  ZydecLinearContext *pExitContexts;
+  ZydecLinearContext initialContext;
+  uint64_t seed;
+};
 
-    case ZYDIS_MNEMONIC_VFMSUB132SS:
-    case ZYDIS_MNEMONIC_VFMSUB213SS:
-    case ZYDIS_MNEMONIC_VFMSUB231SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_ss("));
-      break;
+// Recomputes the names at the start of the block from the ends of its named predecessors. Returns whether they changed.
+static bool zydec_ControlFlowGraph_UpdateEntry(ZydecControlFlowGraph *pGraph, const size_t blockIndex, ZydecNamingState *pState)
+{
+  const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
+  const size_t *pPredecessors = pGraph->pPredecessors + pBlock->firstPredecessor;
+  ZydecLinearContext *pEntry = &pGraph->pEntryContexts[blockIndex];
+  const bool isSeed = (pState->pStates[blockIndex] & zbs_seed) != 0;
+  const bool isPrecise = pState->pVisitCounts[blockIndex] < zydec_ControlFlowGraph_MaxPreciseVisits;
 
-    case ZYDIS_MNEMONIC_VFMSUBADD132PD:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PD:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsubadd_pd("));
-      break;
+  bool changed = false;
 
-    case ZYDIS_MNEMONIC_VFMSUBADD132PS:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PS:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsubadd_ps("));
-      break;
+  for (size_t slot = 0; slot < ZydecLinearContext::RegisterSlotCount; slot++)
+  {
+    if ((pState->pMergedSlots[blockIndex] >> slot) & 1)
+      continue;
 
-    case ZYDIS_MNEMONIC_VFNMADD132PD:
-    case ZYDIS_MNEMONIC_VFNMADD213PD:
-    case ZYDIS_MNEMONIC_VFNMADD231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_pd("));
-      break;
+    bool hasName = isSeed;
+    bool isMerged = false;
+    uint32_t name = isSeed ? pState->initialContext.regInfo[slot] : 0;
 
-    case ZYDIS_MNEMONIC_VFNMADD132PS:
-    case ZYDIS_MNEMONIC_VFNMADD213PS:
-    case ZYDIS_MNEMONIC_VFNMADD231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_ps("));
-      break;
+    for (size_t i = 0; i < pBlock->predecessorCount && !isMerged; i++)
+    {
+      if (!(pState->pStates[pPredecessors[i]] & zbs_named))
+        continue;
 
-    case ZYDIS_MNEMONIC_VFNMADD132SD:
-    case ZYDIS_MNEMONIC_VFNMADD213SD:
-    case ZYDIS_MNEMONIC_VFNMADD231SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_sd("));
-      break;
+      const uint32_t predecessorName = pState->pExitContexts[pPredecessors[i]].regInfo[slot];
 
-    case ZYDIS_MNEMONIC_VFNMADD132SS:
-    case ZYDIS_MNEMONIC_VFNMADD213SS:
-    case ZYDIS_MNEMONIC_VFNMADD231SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_ss("));
-      break;
+      if (!hasName)
+        name = predecessorName;
+      else if (name != predecessorName)
+        isMerged = true;
 
-    case ZYDIS_MNEMONIC_VFNMSUB132PD:
-    case ZYDIS_MNEMONIC_VFNMSUB213PD:
-    case ZYDIS_MNEMONIC_VFNMSUB231PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_pd("));
-      break;
+      hasName = true;
+    }
 
-    case ZYDIS_MNEMONIC_VFNMSUB132PS:
-    case ZYDIS_MNEMONIC_VFNMSUB213PS:
-    case ZYDIS_MNEMONIC_VFNMSUB231PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_ps("));
-      break;
+    if (isMerged)
+      name = zydec_ControlFlowGraph_MergedRegisterName(pState->seed, pBlock->virtualAddress, slot);
 
-    case ZYDIS_MNEMONIC_VFNMSUB132SD:
-    case ZYDIS_MNEMONIC_VFNMSUB213SD:
-    case ZYDIS_MNEMONIC_VFNMSUB231SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_sd("));
-      break;
+    if (name != pEntry->regInfo[slot])
+    {
+      if (!isPrecise)
+      {
+        name = zydec_ControlFlowGraph_MergedRegisterName(pState->seed, pBlock->virtualAddress, slot);
+        pState->pMergedSlots[blockIndex] |= (uint64_t)1 << slot;
+      }
 
-    case ZYDIS_MNEMONIC_VFNMSUB132SS:
-    case ZYDIS_MNEMONIC_VFNMSUB213SS:
-    case ZYDIS_MNEMONIC_VFNMSUB231SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_ss("));
-      break;
-      
-    case ZYDIS_MNEMONIC_STMXCSR:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getcsr("));
-      break;
+      pEntry->regInfo[slot] = name;
+      changed = true;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PHADDW:
-    case ZYDIS_MNEMONIC_VPHADDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hadd_epi16("));
-      break;
+  return changed;
+}
 
-    case ZYDIS_MNEMONIC_PHADDD:
-    case ZYDIS_MNEMONIC_VPHADDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hadd_epi32("));
-      break;
+static bool zydec_ControlFlowGraph_PropagateNames(ZydecTranslator *pTranslator, ZydecControlFlowGraph *pGraph)
+{
+  ZydecNamingState state;
+  state.pStates = reinterpret_cast<ZydecBlockState *>(calloc(pGraph->blockCount, sizeof(ZydecBlockState)));
+  state.pVisitCounts = reinterpret_cast<uint8_t *>(calloc(pGraph->blockCount, sizeof(uint8_t)));
+  state.pMergedSlots = reinterpret_cast<uint64_t *>(calloc(pGraph->blockCount, sizeof(uint64_t)));
+  state.pExitContexts = reinterpret_cast<ZydecLinearContext *>(malloc(sizeof(ZydecLinearContext) * pGraph->blockCount));
+  state.initialContext = pTranslator->context;
+  state.seed = pTranslator->originalInfo.registerNamingSeed;
 
-    case ZYDIS_MNEMONIC_HADDPD:
-    case ZYDIS_MNEMONIC_VHADDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hadd_pd("));
-      break;
+  bool success = state.pStates != nullptr && state.pVisitCounts != nullptr && state.pMergedSlots != nullptr && state.pExitContexts != nullptr;
 
-    case ZYDIS_MNEMONIC_HADDPS:
-    case ZYDIS_MNEMONIC_VHADDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hadd_ps("));
-      break;
+  if (success)
+  {
+    for (size_t i = 0; i < pGraph->blockCount; i++)
+    {
+      pGraph->pEntryContexts[i] = ZydecLinearContext();
+      pGraph->pEntryContexts[i].hashState = zydec_ControlFlowGraph_BlockHashState(state.initialContext.hashState, pGraph->pBlocks[i].virtualAddress);
 
-    case ZYDIS_MNEMONIC_PHADDSW:
-    case ZYDIS_MNEMONIC_VPHADDSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hadds_epi16("));
-      break;
+      if (i == 0 || pGraph->pBlocks[i].predecessorCount == 0)
+      {
+        state.pStates[i] = zbs_seed | zbs_pending;
+        memcpy(pGraph->pEntryContexts[i].regInfo, state.initialContext.regInfo, sizeof(state.initialContext.regInfo));
+      }
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PHSUBW:
-    case ZYDIS_MNEMONIC_VPHSUBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hsub_epi16("));
-      break;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_PHSUBD:
-    case ZYDIS_MNEMONIC_VPHSUBD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hsub_epi32("));
-      break;
+  size_t firstUnnamed = 0;
 
-    case ZYDIS_MNEMONIC_HSUBPD:
-    case ZYDIS_MNEMONIC_VHSUBPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hsub_pd("));
-      break;
+  while (success)
+  {
+    bool anyPending = false;
 
-    case ZYDIS_MNEMONIC_HSUBPS:
-    case ZYDIS_MNEMONIC_VHSUBPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hsub_ps("));
-      break;
+    // Sweeps in address order, so straight line code is named in a single pass & loops take another one per change.
+    for (size_t i = 0; i < pGraph->blockCount && success; i++)
+    {
+      if (!(state.pStates[i] & zbs_pending))
+        continue;
 
-    case ZYDIS_MNEMONIC_PHSUBSW:
-    case ZYDIS_MNEMONIC_VPHSUBSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_hsubs_epi16("));
-      break;
+      state.pStates[i] &= ~zbs_pending;
+      anyPending = true;
 
-    case ZYDIS_MNEMONIC_VPGATHERDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32gather_epi32("));
-      addressParam = true;
-      break;
+      if (state.pVisitCounts[i] < UINT8_MAX)
+        state.pVisitCounts[i]++;
 
-    case ZYDIS_MNEMONIC_VPGATHERDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32gather_epi64("));
-      addressParam = true;
-      break;
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+      pTranslator->context = pGraph->pEntryContexts[i];
 
-    case ZYDIS_MNEMONIC_VGATHERDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32gather_pd("));
-      addressParam = true;
-      break;
+      for (size_t j = 0; j < pBlock->instructionCount; j++)
+      {
+        const size_t codeOffset = pGraph->pInstructionOffsets[pBlock->firstInstruction + j];
 
-    case ZYDIS_MNEMONIC_VGATHERDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32gather_ps("));
-      addressParam = true;
-      break;
-      
-    case ZYDIS_MNEMONIC_VPGATHERQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64gather_epi32("));
-      addressParam = true;
-      break;
+        if (!zydec_DecodeInstruction(&pTranslator->decoder, pGraph->pCode + codeOffset, pGraph->size - codeOffset, &instruction, operands))
+        {
+          success = false;
+          break;
+        }
 
-    case ZYDIS_MNEMONIC_VPGATHERQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64gather_epi64("));
-      addressParam = true;
-      break;
+        zydec_Translator_AdvanceInstruction(pTranslator, &instruction, operands, ZYDIS_MAX_OPERAND_COUNT, (size_t)(pGraph->baseAddress + codeOffset));
+      }
 
-    case ZYDIS_MNEMONIC_VGATHERQPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64gather_pd("));
-      addressParam = true;
-      break;
+      const bool exitChanged = !(state.pStates[i] & zbs_named) || memcmp(state.pExitContexts[i].regInfo, pTranslator->context.regInfo, sizeof(pTranslator->context.regInfo)) != 0;
 
-    case ZYDIS_MNEMONIC_VGATHERQPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64gather_ps("));
-      addressParam = true;
-      break;
+      state.pExitContexts[i] = pTranslator->context;
+      state.pStates[i] |= zbs_named;
 
-    case ZYDIS_MNEMONIC_PINSRB:
-    case ZYDIS_MNEMONIC_VPINSRB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_epi8("));
-      break;
+      if (exitChanged)
+        for (size_t j = 0; j < pBlock->successorCount; j++)
+          if (zydec_ControlFlowGraph_UpdateEntry(pGraph, pBlock->successors[j], &state) || !(state.pStates[pBlock->successors[j]] & zbs_named))
+            state.pStates[pBlock->successors[j]] |= zbs_pending;
+    }
 
-    case ZYDIS_MNEMONIC_PINSRW:
-    case ZYDIS_MNEMONIC_VPINSRW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_epi16("));
-      break;
+    if (anyPending)
+      continue;
 
-    case ZYDIS_MNEMONIC_PINSRD:
-    case ZYDIS_MNEMONIC_VPINSRD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_epi32("));
-      break;
+    // Loops that can't be reached from anywhere start like an entry point.
+    while (firstUnnamed < pGraph->blockCount && (state.pStates[firstUnnamed] & zbs_named))
+      firstUnnamed++;
 
-    case ZYDIS_MNEMONIC_PINSRQ:
-    case ZYDIS_MNEMONIC_VPINSRQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_epi64("));
+    if (firstUnnamed == pGraph->blockCount)
       break;
 
-    case ZYDIS_MNEMONIC_INSERTPS:
-    case ZYDIS_MNEMONIC_VINSERTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_ps("));
-      break;
+    state.pStates[firstUnnamed] |= zbs_seed | zbs_pending;
+    zydec_ControlFlowGraph_UpdateEntry(pGraph, firstUnnamed, &state);
+  }
 
-    case ZYDIS_MNEMONIC_VINSERTF128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_f128("));
-      break;
+  pTranslator->context = state.initialContext;
 
-    case ZYDIS_MNEMONIC_VINSERTI128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insert_i128("));
-      break;
+  free(state.pStates);
+  free(state.pVisitCounts);
+  free(state.pMergedSlots);
+  free(state.pExitContexts);
 
-    case ZYDIS_MNEMONIC_LFENCE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_lfence("));
-      break;
+  return success;
+}
 
-    case ZYDIS_MNEMONIC_MOVHPS:
-      if (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[0].type == ZYDIS_OPERAND_TYPE_POINTER)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_storeh_pi("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_loadh_pi("));
-      break;
+bool zydec_Translator_BuildControlFlowGraph(ZydecTranslator *pTranslator, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, ZydecControlFlowGraph **ppGraph)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext || pCode == nullptr || size == 0 || ppGraph == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_MOVHPD:
-      if (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[0].type == ZYDIS_OPERAND_TYPE_POINTER)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_storeh_pd("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_loadh_pd("));
-      break;
+  ZydecControlFlowGraph *pGraph = new (std::nothrow) ZydecControlFlowGraph();
 
-    case ZYDIS_MNEMONIC_VPMADD52HUQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_madd52hi_epu64("));
-      break;
+  if (pGraph == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPMADD52LUQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_madd52lo_epu64("));
-      break;
+  pGraph->pCode = pCode;
+  pGraph->size = size;
+  pGraph->baseAddress = baseAddress;
 
-    case ZYDIS_MNEMONIC_PMADDUBSW:
-    case ZYDIS_MNEMONIC_VPMADDUBSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_maddubs_epi16("));
-      break;
+  ZydecBranch *pBranches = nullptr;
+  size_t branchCount = 0;
+  size_t branchCapacity = 0;
 
-    case ZYDIS_MNEMONIC_PMAXSB:
-    case ZYDIS_MNEMONIC_VPMAXSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epi8("));
-      break;
+  bool success = zydec_ControlFlowGraph_Decode(pGraph, &pTranslator->decoder, &pBranches, &branchCount, &branchCapacity) && zydec_ControlFlowGraph_Split(pGraph, pBranches, branchCount);
 
-    case ZYDIS_MNEMONIC_PMAXSW:
-    case ZYDIS_MNEMONIC_VPMAXSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epi16("));
-      break;
+  free(pBranches);
 
-    case ZYDIS_MNEMONIC_PMAXSD:
-    case ZYDIS_MNEMONIC_VPMAXSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epi32("));
-      break;
+  if (success)
+  {
+    pGraph->pEntryContexts = reinterpret_cast<ZydecLinearContext *>(malloc(sizeof(ZydecLinearContext) * pGraph->blockCount));
+    success = pGraph->pEntryContexts != nullptr && zydec_ControlFlowGraph_PropagateNames(pTranslator, pGraph);
+  }
 
-    case ZYDIS_MNEMONIC_VPMAXSQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epi64("));
-      break;
+  if (!success)
+  {
+    zydec_DestroyControlFlowGraph(&pGraph);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_PMAXUB:
-    case ZYDIS_MNEMONIC_VPMAXUB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epu8("));
-      break;
+  *ppGraph = pGraph;
 
-    case ZYDIS_MNEMONIC_PMAXUW:
-    case ZYDIS_MNEMONIC_VPMAXUW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epu16("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_PMAXUD:
-    case ZYDIS_MNEMONIC_VPMAXUD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epu32("));
-      break;
+void zydec_DestroyControlFlowGraph(ZydecControlFlowGraph **ppGraph)
+{
+  if (ppGraph == nullptr || *ppGraph == nullptr)
+    return;
 
-    case ZYDIS_MNEMONIC_VPMAXUQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_epu64("));
-      break;
+  free((*ppGraph)->pInstructionOffsets);
+  free((*ppGraph)->pBlocks);
+  free((*ppGraph)->pPredecessors);
+  free((*ppGraph)->pEntryContexts);
 
-    case ZYDIS_MNEMONIC_MAXPD:
-    case ZYDIS_MNEMONIC_VMAXPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_pd("));
-      break;
+  delete *ppGraph;
+  *ppGraph = nullptr;
+}
 
-    case ZYDIS_MNEMONIC_MAXPS:
-    case ZYDIS_MNEMONIC_VMAXPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_ps("));
-      break;
+size_t zydec_ControlFlowGraph_GetBlockCount(const ZydecControlFlowGraph *pGraph)
+{
+  return pGraph == nullptr ? 0 : pGraph->blockCount;
+}
 
-    case ZYDIS_MNEMONIC_MAXSD:
-    case ZYDIS_MNEMONIC_VMAXSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_sd("));
-      break;
+const ZydecBasicBlock *zydec_ControlFlowGraph_GetBlock(const ZydecControlFlowGraph *pGraph, const size_t index)
+{
+  if (pGraph == nullptr || index >= pGraph->blockCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_MAXSS:
-    case ZYDIS_MNEMONIC_VMAXSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_ss("));
-      break;
+  return &pGraph->pBlocks[index];
+}
 
-    case ZYDIS_MNEMONIC_PMINSB:
-    case ZYDIS_MNEMONIC_VPMINSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epi8("));
-      break;
+const size_t *zydec_ControlFlowGraph_GetPredecessors(const ZydecControlFlowGraph *pGraph, const size_t index)
+{
+  if (pGraph == nullptr || index >= pGraph->blockCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_PMINSW:
-    case ZYDIS_MNEMONIC_VPMINSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epi16("));
-      break;
+  return pGraph->pPredecessors + pGraph->pBlocks[index].firstPredecessor;
+}
 
-    case ZYDIS_MNEMONIC_PMINSD:
-    case ZYDIS_MNEMONIC_VPMINSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epi32("));
-      break;
+const ZydecLinearContext *zydec_ControlFlowGraph_GetEntryContext(const ZydecControlFlowGraph *pGraph, const size_t index)
+{
+  if (pGraph == nullptr || index >= pGraph->blockCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VPMINSQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epi64("));
-      break;
+  return &pGraph->pEntryContexts[index];
+}
 
-    case ZYDIS_MNEMONIC_PMINUB:
-    case ZYDIS_MNEMONIC_VPMINUB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epu8("));
-      break;
+size_t zydec_ControlFlowGraph_GetInstructionCount(const ZydecControlFlowGraph *pGraph)
+{
+  return pGraph == nullptr ? 0 : pGraph->instructionCount;
+}
 
-    case ZYDIS_MNEMONIC_PMINUW:
-    case ZYDIS_MNEMONIC_VPMINUW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epu16("));
-      break;
+const size_t *zydec_ControlFlowGraph_GetInstructionOffsets(const ZydecControlFlowGraph *pGraph)
+{
+  return pGraph == nullptr ? nullptr : pGraph->pInstructionOffsets;
+}
 
-    case ZYDIS_MNEMONIC_PMINUD:
-    case ZYDIS_MNEMONIC_VPMINUD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epu32("));
-      break;
+bool zydec_ControlFlowGraph_FindBlock(const ZydecControlFlowGraph *pGraph, const uint64_t virtualAddress, size_t *pBlockIndex)
+{
+  if (pGraph == nullptr || pBlockIndex == nullptr || virtualAddress < pGraph->baseAddress || virtualAddress - pGraph->baseAddress >= pGraph->size)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPMINUQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_epu64("));
-      break;
+  const size_t offset = (size_t)(virtualAddress - pGraph->baseAddress);
+  size_t first = 0;
+  size_t last = pGraph->blockCount;
 
-    case ZYDIS_MNEMONIC_MINPD:
-    case ZYDIS_MNEMONIC_VMINPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_pd("));
-      break;
+  while (last - first > 1)
+  {
+    const size_t mid = first + (last - first) / 2;
 
-    case ZYDIS_MNEMONIC_MINPS:
-    case ZYDIS_MNEMONIC_VMINPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_ps("));
-      break;
+    if (pGraph->pBlocks[mid].offset <= offset)
+      first = mid;
+    else
+      last = mid;
+  }
 
-    case ZYDIS_MNEMONIC_MINSD:
-    case ZYDIS_MNEMONIC_VMINSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_sd("));
-      break;
+  *pBlockIndex = first;
 
-    case ZYDIS_MNEMONIC_MINSS:
-    case ZYDIS_MNEMONIC_VMINSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_ss("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_PHMINPOSUW:
-    case ZYDIS_MNEMONIC_VPHMINPOSUW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_minpos_epu16("));
-      break;
+bool zydec_Translator_TranslateControlFlowGraph(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, char *pArena, const size_t arenaCapacity, size_t *pOffsets, const size_t offsetCapacity, size_t *pInstructionCount, size_t *pRequiredArenaCapacity /* = nullptr */)
+{
+  if (pTranslator == nullptr || pTranslator->mode != ZydecTranslatorMode::LinearContext || pGraph == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_MOVDDUP:
-    case ZYDIS_MNEMONIC_VMOVDDUP:
-    {
-      if (pOperands[1].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[1].type == ZYDIS_OPERAND_TYPE_POINTER)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_loaddup_pd("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movedup_pd("));
+  if (pRequiredArenaCapacity != nullptr)
+    *pRequiredArenaCapacity = 0;
 
-      addressParam = true;
+  ZydecAddressCache *pAddressCache = nullptr;
 
-      break;
-    }
+  if (pTranslator->info.batchAddressResolution && !zydec_AddressCache_Create(&pAddressCache, &pTranslator->decoder, pGraph->pCode, pGraph->size, pGraph->baseAddress, &pTranslator->info))
+    return false;
 
-    case ZYDIS_MNEMONIC_MOVSHDUP:
-    case ZYDIS_MNEMONIC_VMOVSHDUP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movehdup_ps("));
-      break;
+  ZydecUnrolledGroups *pUnrolledGroups = nullptr;
 
-    case ZYDIS_MNEMONIC_MOVHLPS:
-    case ZYDIS_MNEMONIC_VMOVHLPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movehl_ps("));
-      break;
+  if (pTranslator->info.collapseUnrolledGroups)
+  {
+    bool success = (pUnrolledGroups = new (std::nothrow) ZydecUnrolledGroups()) != nullptr;
 
-    case ZYDIS_MNEMONIC_MOVSLDUP:
-    case ZYDIS_MNEMONIC_VMOVSLDUP:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_moveldup_ps("));
-      break;
+    for (size_t i = 0; i < pGraph->blockCount && success; i++)
+      success = zydec_Unrolled_CollectBlock(pUnrolledGroups, &pTranslator->decoder, pGraph->pCode + pGraph->pBlocks[i].offset, pGraph->pBlocks[i].size, pGraph->pBlocks[i].firstInstruction);
 
-    case ZYDIS_MNEMONIC_MOVLHPS:
-    case ZYDIS_MNEMONIC_VMOVLHPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movelh_ps("));
-      break;
+    if (!success)
+    {
+      zydec_Unrolled_Destroy(&pUnrolledGroups);
+      zydec_AddressCache_Destroy(&pAddressCache);
+      return false;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PMOVMSKB:
-    case ZYDIS_MNEMONIC_VPMOVMSKB:
-      maySelfReference = false;
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movemask_epi8("));
-      break;
+  pTranslator->info.pAddressCache = pAddressCache;
 
-    case ZYDIS_MNEMONIC_MOVMSKPD:
-    case ZYDIS_MNEMONIC_VMOVMSKPD:
-      maySelfReference = false;
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movemask_pd("));
-      break;
+  ZydecUnrolledCursor cursor;
+  cursor.pGroups = pUnrolledGroups;
+  size_t nextBlock = 0;
 
-    case ZYDIS_MNEMONIC_MOVMSKPS:
-    case ZYDIS_MNEMONIC_VMOVMSKPS:
-      maySelfReference = false;
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movemask_ps("));
-      break;
+  const bool result = zydec_TranslateBlockToArena(&pTranslator->decoder, pGraph->pCode, pGraph->size, pGraph->baseAddress, pArena, arenaCapacity, pOffsets, offsetCapacity, pInstructionCount, pTranslator->info.fuseFlagConditions, [pTranslator, pGraph, &nextBlock, &cursor](const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation)
+    {
+      if (nextBlock < pGraph->blockCount && virtualAddress == pGraph->pBlocks[nextBlock].virtualAddress)
+      {
+        pTranslator->context = pGraph->pEntryContexts[nextBlock++];
+        pTranslator->flagProducer.kind = zfpk_none; // The flags may come from any predecessor.
+      }
 
-    case ZYDIS_MNEMONIC_MPSADBW:
-    case ZYDIS_MNEMONIC_VMPSADBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mpsadbw_epu8("));
-      break;
+      return zydec_Translator_TranslateBlockInstruction(pTranslator, &cursor, pInstruction, pOperands, virtualAddress, buffer, bufferCapacity, pHasTranslation);
+    });
 
-    case ZYDIS_MNEMONIC_PMULDQ:
-    case ZYDIS_MNEMONIC_VPMULDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_epi32("));
-      break;
+  pTranslator->info.pAddressCache = nullptr;
+  zydec_AddressCache_Destroy(&pAddressCache);
+  zydec_Unrolled_Destroy(&pUnrolledGroups);
 
-    case ZYDIS_MNEMONIC_PMULUDQ:
-    case ZYDIS_MNEMONIC_VPMULUDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_epu32("));
-      break;
+  if (!result && pRequiredArenaCapacity != nullptr)
+  {
+    // Every block starts from its entry context without flags, so measuring them one by one lays them out just like the translation (which collapses per block as well).
+    const ZydecLinearContext contextAfter = pTranslator->context;
+    const ZydecFlagProducer flagProducerAfter = pTranslator->flagProducer;
 
-    case ZYDIS_MNEMONIC_MULPD:
-    case ZYDIS_MNEMONIC_VMULPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_pd("));
-      break;
+    size_t requiredArenaCapacity = 0;
+    bool measured = true;
 
-    case ZYDIS_MNEMONIC_MULPS:
-    case ZYDIS_MNEMONIC_VMULPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_ps("));
-      break;
+    for (size_t i = 0; i < pGraph->blockCount && measured; i++)
+    {
+      size_t blockCapacity = 0;
+      size_t instructionCount = 0;
 
-    case ZYDIS_MNEMONIC_MULSD:
-    case ZYDIS_MNEMONIC_VMULSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_sd("));
-      break;
+      pTranslator->context = pGraph->pEntryContexts[i];
+      pTranslator->flagProducer.kind = zfpk_none;
 
-    case ZYDIS_MNEMONIC_MULSS:
-    case ZYDIS_MNEMONIC_VMULSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_ss("));
-      break;
+      measured = zydec_Translator_MeasureBlock(pTranslator, pGraph->pCode + pGraph->pBlocks[i].offset, pGraph->pBlocks[i].size, pGraph->pBlocks[i].virtualAddress, &blockCapacity, &instructionCount);
+      requiredArenaCapacity += blockCapacity;
+    }
 
-    case ZYDIS_MNEMONIC_PMULHRSW:
-    case ZYDIS_MNEMONIC_VPMULHRSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mulhrs_epi16("));
-      break;
+    pTranslator->context = contextAfter;
+    pTranslator->flagProducer = flagProducerAfter;
 
-    case ZYDIS_MNEMONIC_PMULLD:
-    case ZYDIS_MNEMONIC_VPMULLD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mullo_epi32("));
-      break;
+    if (measured && requiredArenaCapacity > arenaCapacity)
+      *pRequiredArenaCapacity = requiredArenaCapacity;
+  }
 
-    case ZYDIS_MNEMONIC_ORPD:
-    case ZYDIS_MNEMONIC_VORPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_or_pd("));
-      break;
+  return result;
+}
 
-    case ZYDIS_MNEMONIC_ORPS:
-    case ZYDIS_MNEMONIC_VORPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_or_ps("));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_PAUSE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_pause("));
-      break;
+inline size_t zydec_PopCount64(const uint64_t value)
+{
+#ifdef _MSC_VER
+  return (size_t)__popcnt64(value);
+#else
+  return (size_t)__builtin_popcountll(value);
+#endif
+}
 
-    case ZYDIS_MNEMONIC_VPERMILPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute_pd("));
-      break;
+// The number of bits set in `mask` below the bit of `slot`.
+inline size_t zydec_SSA_MaskIndex(const uint64_t mask, const size_t slot)
+{
+  return zydec_PopCount64(mask & (((uint64_t)1 << slot) - 1));
+}
 
-    case ZYDIS_MNEMONIC_VPERMILPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute_ps("));
-      break;
+inline size_t zydec_SSA_LowestSlot(const uint64_t mask)
+{
+  return zydec_PopCount64((mask & (0 - mask)) - 1);
+}
 
-    case ZYDIS_MNEMONIC_VPERM2F128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute_2f128("));
-      break;
+// Values are referred to by what defines them until their final index is known. Zero is no value.
+typedef uint64_t ZydecEncodedValue;
 
-    case ZYDIS_MNEMONIC_VPERM2I128:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute_2i128("));
-      break;
+static constexpr ZydecEncodedValue zydec_SSA_LiveInTag = (uint64_t)1 << 62; // Block & slot.
+static constexpr ZydecEncodedValue zydec_SSA_PhiTag = (uint64_t)2 << 62; // Block & slot.
+static constexpr ZydecEncodedValue zydec_SSA_DefinitionTag = (uint64_t)3 << 62; // Instruction & slot.
+static constexpr ZydecEncodedValue zydec_SSA_TagMask = (uint64_t)3 << 62;
 
-    case ZYDIS_MNEMONIC_VPERMQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute4x64_epi64("));
-      break;
+inline ZydecEncodedValue zydec_SSA_EncodeValue(const ZydecEncodedValue tag, const size_t index, const size_t slot)
+{
+  return tag | ((uint64_t)index << 6) | (uint64_t)slot;
+}
 
-    case ZYDIS_MNEMONIC_VPERMPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permute4x64_pd("));
-      break;
+struct ZydecSSAInstruction
+{
+  uint64_t useMask; // Register slots that are read.
+  uint64_t defMask; // Register slots that are written.
+  uint64_t clobberMask; // Register slots a call doesn't retain. Only defined where they're still live afterwards.
+  uint64_t liveAfter;
+  size_t firstOperand; // Into `pOperands`, one per bit of `useMask`.
+  size_t firstDefinition; // The value of the lowest bit of `defMask`, followed by the others.
+};
 
-    case ZYDIS_MNEMONIC_VPERMPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutevar8x32_ps("));
-      break;
+struct ZydecSSABlock
+{
+  uint64_t useMask; // Register slots that are read before they're written in the block.
+  uint64_t defMask;
+  uint64_t liveIn;
+  uint64_t liveOut;
+  uint64_t liveInValueMask; // Entry blocks define a value for every live register.
+  uint64_t phiMask;
+  uint64_t lockedPhiMask; // Register slots that keep their phi, see `zydec_ControlFlowGraph_MaxPreciseVisits`.
+  size_t firstEntry; // Into the entry values, one per bit of `liveIn`.
+  size_t firstExit; // Into the last writers, one per bit of `liveOut & defMask`.
+  size_t firstValue;
+  ZydecBlockState state;
+  uint8_t visitCount;
+};
 
-    case ZYDIS_MNEMONIC_RCPPS:
-    case ZYDIS_MNEMONIC_VRCPPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp_ps("));
-      break;
+struct ZydecSSA
+{
+  ZydecValue *pValues;
+  size_t valueCount;
 
-    case ZYDIS_MNEMONIC_RCPSS:
-    case ZYDIS_MNEMONIC_VRCPSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp_ss("));
-      break;
+  size_t *pPhiOperands; // See `ZydecValue::firstOperand`.
+  ZydecValueUse *pUses; // See `ZydecValue::firstUse`.
 
-    case ZYDIS_MNEMONIC_RSQRTPS:
-    case ZYDIS_MNEMONIC_VRSQRTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt_ps("));
-      break;
+  ZydecSSAInstruction *pInstructions;
+  size_t instructionCount;
+  size_t *pOperands; // Value indices, see `ZydecSSAInstruction::firstOperand`.
+};
 
-    case ZYDIS_MNEMONIC_RSQRTSS:
-    case ZYDIS_MNEMONIC_VRSQRTSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt_ss("));
-      break;
+// Whether writing the operand keeps parts of the previous value of the register.
+static bool zydec_SSA_IsPartialWrite(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperand, const size_t slot)
+{
+  if (slot < zrs_vector)
+    return pOperand->size < 32; // 32 bit writes clear the upper half.
 
-    case ZYDIS_MNEMONIC_PSADBW:
-    case ZYDIS_MNEMONIC_VPSADBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sad_epu8("));
-      break;
+  if (slot < zrs_mask)
+    return pInstruction->encoding == ZYDIS_INSTRUCTION_ENCODING_LEGACY || pInstruction->avx.mask.mode == ZYDIS_MASK_MODE_MERGING;
 
-    case ZYDIS_MNEMONIC_SFENCE:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sfence("));
-      break;
+  return false;
+}
 
-    case ZYDIS_MNEMONIC_PSHUFB:
-    case ZYDIS_MNEMONIC_VPSHUFB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_epi8("));
-      break;
+// `xor eax, eax` & friends don't depend on the previous value.
+static bool zydec_SSA_IsZeroIdiom(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands)
+{
+  switch (pInstruction->mnemonic)
+  {
+  case ZYDIS_MNEMONIC_XOR:
+  case ZYDIS_MNEMONIC_SUB:
+  case ZYDIS_MNEMONIC_PXOR:
+  case ZYDIS_MNEMONIC_XORPS:
+  case ZYDIS_MNEMONIC_XORPD:
+  case ZYDIS_MNEMONIC_VPXOR:
+  case ZYDIS_MNEMONIC_VPXORD:
+  case ZYDIS_MNEMONIC_VPXORQ:
+  case ZYDIS_MNEMONIC_VXORPS:
+  case ZYDIS_MNEMONIC_VXORPD:
+    break;
 
-    case ZYDIS_MNEMONIC_PSHUFW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_epi16("));
-      break;
+  default:
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_PSHUFD:
-    case ZYDIS_MNEMONIC_VPSHUFD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_epi32("));
-      break;
+  if (pInstruction->avx.mask.mode == ZYDIS_MASK_MODE_MERGING)
+    return false;
 
-    case ZYDIS_MNEMONIC_SHUFPS:
-    case ZYDIS_MNEMONIC_VSHUFPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_ps("));
-      break;
+  const size_t first = pInstruction->operand_count_visible == 3 ? 1 : 0;
 
-    case ZYDIS_MNEMONIC_SHUFPD:
-    case ZYDIS_MNEMONIC_VSHUFPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_pd("));
-      break;
+  return pInstruction->operand_count_visible == first + 2 && pOperands[first].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[first + 1].type == ZYDIS_OPERAND_TYPE_REGISTER && pOperands[first].reg.value == pOperands[first + 1].reg.value;
+}
 
-    case ZYDIS_MNEMONIC_PSHUFHW:
-    case ZYDIS_MNEMONIC_VPSHUFHW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shufflehi_epi16("));
-      break;
+static void zydec_SSA_InstructionRegisters(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const uint64_t clobberedByCall, ZydecSSAInstruction *pSSAInstruction)
+{
+  const bool isZeroIdiom = zydec_SSA_IsZeroIdiom(pInstruction, pOperands);
 
-    case ZYDIS_MNEMONIC_PSHUFLW:
-    case ZYDIS_MNEMONIC_VPSHUFLW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shufflelo_epi16("));
-      break;
+  uint64_t useMask = 0;
+  uint64_t defMask = 0;
 
-    case ZYDIS_MNEMONIC_PSIGNB:
-    case ZYDIS_MNEMONIC_VPSIGNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sign_epi8("));
-      break;
+  for (size_t i = 0; i < pInstruction->operand_count; i++)
+  {
+    const ZydisDecodedOperand *pOperand = &pOperands[i];
 
-    case ZYDIS_MNEMONIC_PSIGNW:
-    case ZYDIS_MNEMONIC_VPSIGNW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sign_epi16("));
-      break;
+    if (pOperand->type == ZYDIS_OPERAND_TYPE_MEMORY)
+    {
+      const size_t baseSlot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->mem.base));
+      const size_t indexSlot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->mem.index));
 
-    case ZYDIS_MNEMONIC_PSIGND:
-    case ZYDIS_MNEMONIC_VPSIGND:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sign_epi32("));
-      break;
+      if (baseSlot != zrs_none)
+        useMask |= (uint64_t)1 << baseSlot;
 
-    case ZYDIS_MNEMONIC_PSLLW:
-    case ZYDIS_MNEMONIC_VPSLLW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sll_epi16("));
-      break;
+      if (indexSlot != zrs_none)
+        useMask |= (uint64_t)1 << indexSlot;
 
-    case ZYDIS_MNEMONIC_PSLLD:
-    case ZYDIS_MNEMONIC_VPSLLD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sll_epi32("));
-      break;
+      continue;
+    }
 
-    case ZYDIS_MNEMONIC_PSLLQ:
-    case ZYDIS_MNEMONIC_VPSLLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sll_epi64("));
-      break;
+    if (pOperand->type != ZYDIS_OPERAND_TYPE_REGISTER)
+      continue;
 
-    case ZYDIS_MNEMONIC_VPSLLVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sllv_epi32("));
-      break;
+    const size_t slot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->reg.value));
 
-    case ZYDIS_MNEMONIC_VPSLLVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sllv_epi64("));
-      break;
+    if (slot == zrs_none)
+      continue;
 
-    case ZYDIS_MNEMONIC_SQRTPD:
-    case ZYDIS_MNEMONIC_VSQRTPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_pd("));
-      break;
+    const uint64_t bit = (uint64_t)1 << slot;
 
-    case ZYDIS_MNEMONIC_SQRTPS:
-    case ZYDIS_MNEMONIC_VSQRTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_ps("));
-      break;
+    if ((pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_READ) != 0 && !(isZeroIdiom && pOperand->visibility == ZYDIS_OPERAND_VISIBILITY_EXPLICIT))
+      useMask |= bit;
 
-    case ZYDIS_MNEMONIC_SQRTSD:
-    case ZYDIS_MNEMONIC_VSQRTSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_sd("));
-      break;
+    if ((pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_WRITE) != 0)
+    {
+      defMask |= bit;
 
-    case ZYDIS_MNEMONIC_SQRTSS:
-    case ZYDIS_MNEMONIC_VSQRTSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_ss("));
-      break;
+      if ((pOperand->actions & ZYDIS_OPERAND_ACTION_CONDWRITE) != 0 || zydec_SSA_IsPartialWrite(pInstruction, pOperand, slot))
+        useMask |= bit;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PSRAW:
-    case ZYDIS_MNEMONIC_VPSRAW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sra_epi16("));
-      break;
+  pSSAInstruction->useMask = useMask;
+  pSSAInstruction->defMask = defMask;
+  pSSAInstruction->clobberMask = pInstruction->meta.category == ZYDIS_CATEGORY_CALL ? (clobberedByCall & ~defMask) : 0;
+}
 
-    case ZYDIS_MNEMONIC_PSRAD:
-    case ZYDIS_MNEMONIC_VPSRAD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sra_epi32("));
-      break;
+// Decodes every instruction of the graph & records which register slots it reads and writes.
+static bool zydec_SSA_CollectRegisters(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, ZydecSSA *pSSA, ZydecSSABlock *pBlocks)
+{
+  const uint64_t clobberedByCall = ~zydec_LinearContext_RetainedAfterCall(&pTranslator->originalInfo);
 
-    case ZYDIS_MNEMONIC_VPSRAQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sra_epi64("));
-      break;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_VPSRAVW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srav_epi16("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+    ZydecSSABlock *pSSABlock = &pBlocks[i];
 
-    case ZYDIS_MNEMONIC_VPSRAVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srav_epi32("));
-      break;
+    for (size_t j = pBlock->firstInstruction; j < pBlock->firstInstruction + pBlock->instructionCount; j++)
+    {
+      const size_t codeOffset = pGraph->pInstructionOffsets[j];
 
-    case ZYDIS_MNEMONIC_VPSRAVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srav_epi64("));
-      break;
+      if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&pTranslator->decoder, pGraph->pCode + codeOffset, pGraph->size - codeOffset, &instruction, operands)))
+        return false;
 
-    case ZYDIS_MNEMONIC_PSRLW:
-    case ZYDIS_MNEMONIC_VPSRLW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srl_epi16("));
-      break;
+      ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[j];
+      zydec_SSA_InstructionRegisters(&instruction, operands, clobberedByCall, pInstruction);
 
-    case ZYDIS_MNEMONIC_PSRLD:
-    case ZYDIS_MNEMONIC_VPSRLD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srl_epi32("));
-      break;
+      pSSABlock->useMask |= pInstruction->useMask & ~pSSABlock->defMask;
+      pSSABlock->defMask |= pInstruction->defMask | pInstruction->clobberMask;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PSRLQ:
-    case ZYDIS_MNEMONIC_VPSRLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srl_epi64("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VPSRLVW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srlv_epi16("));
-      break;
+static void zydec_SSA_ComputeLiveness(const ZydecControlFlowGraph *pGraph, ZydecSSA *pSSA, ZydecSSABlock *pBlocks)
+{
+  bool changed = true;
 
-    case ZYDIS_MNEMONIC_VPSRLVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srlv_epi32("));
-      break;
+  // Sweeps against the address order, so most loops only take one additional sweep.
+  while (changed)
+  {
+    changed = false;
 
-    case ZYDIS_MNEMONIC_VPSRLVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_srlv_epi64("));
-      break;
+    for (size_t i = pGraph->blockCount; i-- > 0;)
+    {
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+      ZydecSSABlock *pSSABlock = &pBlocks[i];
 
-    case ZYDIS_MNEMONIC_PSUBB:
-    case ZYDIS_MNEMONIC_VPSUBB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_epi8("));
-      break;
+      uint64_t liveOut = 0;
 
-    case ZYDIS_MNEMONIC_PSUBW:
-    case ZYDIS_MNEMONIC_VPSUBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_epi16("));
-      break;
+      for (size_t j = 0; j < pBlock->successorCount; j++)
+        liveOut |= pBlocks[pBlock->successors[j]].liveIn;
 
-    case ZYDIS_MNEMONIC_PSUBD:
-    case ZYDIS_MNEMONIC_VPSUBD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_epi32("));
-      break;
+      const uint64_t liveIn = pSSABlock->useMask | (liveOut & ~pSSABlock->defMask);
 
-    case ZYDIS_MNEMONIC_PSUBQ:
-    case ZYDIS_MNEMONIC_VPSUBQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_epi64("));
-      break;
+      if (liveIn != pSSABlock->liveIn || liveOut != pSSABlock->liveOut)
+      {
+        pSSABlock->liveIn = liveIn;
+        pSSABlock->liveOut = liveOut;
+        changed = true;
+      }
+    }
+  }
 
-    case ZYDIS_MNEMONIC_SUBPD:
-    case ZYDIS_MNEMONIC_VSUBPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_pd("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+    uint64_t live = pBlocks[i].liveOut;
 
-    case ZYDIS_MNEMONIC_SUBPS:
-    case ZYDIS_MNEMONIC_VSUBPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_ps("));
-      break;
+    for (size_t j = pBlock->firstInstruction + pBlock->instructionCount; j-- > pBlock->firstInstruction;)
+    {
+      ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[j];
 
-    case ZYDIS_MNEMONIC_SUBSD:
-    case ZYDIS_MNEMONIC_VSUBSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_sd("));
-      break;
+      // Registers a call clobbers only get a new value if somebody reads it.
+      pInstruction->clobberMask &= live;
+      pInstruction->liveAfter = live;
 
-    case ZYDIS_MNEMONIC_SUBSS:
-    case ZYDIS_MNEMONIC_VSUBSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_ss("));
-      break;
+      live = (live & ~(pInstruction->defMask | pInstruction->clobberMask)) | pInstruction->useMask;
+    }
+  }
+}
 
-    case ZYDIS_MNEMONIC_PSUBSB:
-    case ZYDIS_MNEMONIC_VPSUBSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_subs_epi8("));
-      break;
+// Expects the slot to be live at the end of the block.
+static ZydecEncodedValue zydec_SSA_ExitValue(const ZydecSSABlock *pBlocks, const ZydecEncodedValue *pEntryValues, const size_t *pLastWriters, const size_t blockIndex, const size_t slot)
+{
+  const ZydecSSABlock *pBlock = &pBlocks[blockIndex];
 
-    case ZYDIS_MNEMONIC_PSUBSW:
-    case ZYDIS_MNEMONIC_VPSUBSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_subs_epi16("));
-      break;
+  if ((pBlock->defMask >> slot) & 1)
+    return zydec_SSA_EncodeValue(zydec_SSA_DefinitionTag, pLastWriters[pBlock->firstExit + zydec_SSA_MaskIndex(pBlock->liveOut & pBlock->defMask, slot)], slot);
+  else
+    return pEntryValues[pBlock->firstEntry + zydec_SSA_MaskIndex(pBlock->liveIn, slot)];
+}
 
-    case ZYDIS_MNEMONIC_PTEST:
-    case ZYDIS_MNEMONIC_VPTEST:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test("));
-      break;
+// Recomputes the values of the live registers at the start of the block from the ends of its predecessors. Returns whether they changed.
+static bool zydec_SSA_UpdateEntry(const ZydecControlFlowGraph *pGraph, ZydecSSABlock *pBlocks, ZydecEncodedValue *pEntryValues, const size_t *pLastWriters, const size_t blockIndex)
+{
+  const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
+  const size_t *pPredecessors = pGraph->pPredecessors + pBlock->firstPredecessor;
+  ZydecSSABlock *pSSABlock = &pBlocks[blockIndex];
+  const bool isSeed = (pSSABlock->state & zbs_seed) != 0;
+  const bool isPrecise = pSSABlock->visitCount < zydec_ControlFlowGraph_MaxPreciseVisits;
 
-    case ZYDIS_MNEMONIC_VTESTPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_pd("));
-      break;
+  bool changed = false;
 
-    case ZYDIS_MNEMONIC_VTESTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_ps("));
-      break;
+  for (uint64_t remaining = pSSABlock->liveIn & ~pSSABlock->lockedPhiMask; remaining != 0; remaining &= remaining - 1)
+  {
+    const size_t slot = zydec_SSA_LowestSlot(remaining);
+    const ZydecEncodedValue phi = zydec_SSA_EncodeValue(zydec_SSA_PhiTag, blockIndex, slot);
 
-    case ZYDIS_MNEMONIC_UCOMISD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ucomi_sd("));
-      break;
+    bool hasValue = isSeed;
+    bool isMerged = false;
+    ZydecEncodedValue value = isSeed ? zydec_SSA_EncodeValue(zydec_SSA_LiveInTag, blockIndex, slot) : 0;
 
-    case ZYDIS_MNEMONIC_UCOMISS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ucomi_ss("));
-      break;
+    for (size_t i = 0; i < pBlock->predecessorCount && !isMerged; i++)
+    {
+      if (!(pBlocks[pPredecessors[i]].state & zbs_named))
+        continue;
 
-    case ZYDIS_MNEMONIC_PUNPCKHBW:
-    case ZYDIS_MNEMONIC_VPUNPCKHBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_epi8("));
-      break;
+      const ZydecEncodedValue predecessorValue = zydec_SSA_ExitValue(pBlocks, pEntryValues, pLastWriters, pPredecessors[i], slot);
 
-    case ZYDIS_MNEMONIC_PUNPCKHWD:
-    case ZYDIS_MNEMONIC_VPUNPCKHWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_epi16("));
-      break;
+      // Loops that don't write the register pass the phi back to it.
+      if (predecessorValue == phi)
+        continue;
 
-    case ZYDIS_MNEMONIC_PUNPCKHDQ:
-    case ZYDIS_MNEMONIC_VPUNPCKHDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_epi32("));
-      break;
+      if (!hasValue)
+        value = predecessorValue;
+      else if (value != predecessorValue)
+        isMerged = true;
 
-    case ZYDIS_MNEMONIC_PUNPCKHQDQ:
-    case ZYDIS_MNEMONIC_VPUNPCKHQDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_epi64("));
-      break;
+      hasValue = true;
+    }
 
-    case ZYDIS_MNEMONIC_UNPCKHPD:
-    case ZYDIS_MNEMONIC_VUNPCKHPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_pd("));
-      break;
+    if (!hasValue)
+      continue;
 
-    case ZYDIS_MNEMONIC_UNPCKHPS:
-    case ZYDIS_MNEMONIC_VUNPCKHPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpackhi_ps("));
-      break;
+    if (isMerged)
+      value = phi;
 
-    case ZYDIS_MNEMONIC_PUNPCKLBW:
-    case ZYDIS_MNEMONIC_VPUNPCKLBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_epi8("));
-      break;
+    ZydecEncodedValue *pEntry = &pEntryValues[pSSABlock->firstEntry + zydec_SSA_MaskIndex(pSSABlock->liveIn, slot)];
 
-    case ZYDIS_MNEMONIC_PUNPCKLWD:
-    case ZYDIS_MNEMONIC_VPUNPCKLWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_epi16("));
-      break;
+    if (value != *pEntry)
+    {
+      if (!isPrecise)
+      {
+        value = phi;
+        pSSABlock->lockedPhiMask |= (uint64_t)1 << slot;
+      }
 
-    case ZYDIS_MNEMONIC_PUNPCKLDQ:
-    case ZYDIS_MNEMONIC_VPUNPCKLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_epi32("));
-      break;
+      *pEntry = value;
+      changed = true;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_PUNPCKLQDQ:
-    case ZYDIS_MNEMONIC_VPUNPCKLQDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_epi64("));
-      break;
+  return changed;
+}
 
-    case ZYDIS_MNEMONIC_UNPCKLPD:
-    case ZYDIS_MNEMONIC_VUNPCKLPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_pd("));
-      break;
+static void zydec_SSA_PropagateValues(const ZydecControlFlowGraph *pGraph, ZydecSSABlock *pBlocks, ZydecEncodedValue *pEntryValues, const size_t *pLastWriters)
+{
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+    if (i == 0 || pGraph->pBlocks[i].predecessorCount == 0)
+      pBlocks[i].state = zbs_seed | zbs_pending;
 
-    case ZYDIS_MNEMONIC_UNPCKLPS:
-    case ZYDIS_MNEMONIC_VUNPCKLPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_unpacklo_ps("));
-      break;
+  size_t firstUnnamed = 0;
 
-    case ZYDIS_MNEMONIC_PXOR:
-    case ZYDIS_MNEMONIC_VPXOR:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_xor_si("));
-      break;
+  while (true)
+  {
+    bool anyPending = false;
 
-    case ZYDIS_MNEMONIC_XORPS:
-    case ZYDIS_MNEMONIC_VXORPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_xor_ps("));
-      break;
+    // The values at the end of a block only depend on the ones at its start, so blocks are never decoded again.
+    for (size_t i = 0; i < pGraph->blockCount; i++)
+    {
+      ZydecSSABlock *pBlock = &pBlocks[i];
 
-    case ZYDIS_MNEMONIC_XORPD:
-    case ZYDIS_MNEMONIC_VXORPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_xor_pd("));
-      break;
+      if (!(pBlock->state & zbs_pending))
+        continue;
 
-    case ZYDIS_MNEMONIC_VZEROALL:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_zeroall("));
-      break;
+      pBlock->state &= ~zbs_pending;
+      anyPending = true;
 
-    case ZYDIS_MNEMONIC_VZEROUPPER:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_zeroupper("));
-      break;
+      if (pBlock->visitCount < UINT8_MAX)
+        pBlock->visitCount++;
 
-    case ZYDIS_MNEMONIC_VP2INTERSECTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_2intersect_epi32("));
-      break;
+      const bool changed = zydec_SSA_UpdateEntry(pGraph, pBlocks, pEntryValues, pLastWriters, i) || !(pBlock->state & zbs_named);
+      pBlock->state |= zbs_named;
 
-    case ZYDIS_MNEMONIC_VP2INTERSECTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_2intersect_epi64("));
-      break;
+      if (changed)
+        for (size_t j = 0; j < pGraph->pBlocks[i].successorCount; j++)
+          pBlocks[pGraph->pBlocks[i].successors[j]].state |= zbs_pending;
+    }
 
-    case ZYDIS_MNEMONIC_VP4DPWSSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4dpwssd_epi32("));
-      break;
+    if (anyPending)
+      continue;
 
-    case ZYDIS_MNEMONIC_VP4DPWSSDS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4dpwssds_epi32("));
-      break;
+    // Loops that can't be reached from anywhere start like an entry point.
+    while (firstUnnamed < pGraph->blockCount && (pBlocks[firstUnnamed].state & zbs_named))
+      firstUnnamed++;
 
-    case ZYDIS_MNEMONIC_V4FMADDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4fmadd_ps("));
+    if (firstUnnamed == pGraph->blockCount)
       break;
 
-    case ZYDIS_MNEMONIC_V4FMADDSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4fmadd_ss("));
-      break;
+    pBlocks[firstUnnamed].state |= zbs_seed | zbs_pending;
+  }
+}
 
-    case ZYDIS_MNEMONIC_V4FNMADDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4fnmadd_ps("));
-      break;
+static size_t zydec_SSA_ValueIndex(const ZydecSSA *pSSA, const ZydecSSABlock *pBlocks, const ZydecEncodedValue value)
+{
+  const size_t index = (size_t)((value & ~zydec_SSA_TagMask) >> 6);
+  const size_t slot = (size_t)(value & 63);
 
-    case ZYDIS_MNEMONIC_V4FNMADDSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_4fnmadd_ss("));
-      break;
+  switch (value & zydec_SSA_TagMask)
+  {
+  case zydec_SSA_LiveInTag:
+    return pBlocks[index].firstValue + zydec_SSA_MaskIndex(pBlocks[index].liveInValueMask, slot);
 
-    case ZYDIS_MNEMONIC_VPABSQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_abs_epi64("));
-      break;
+  case zydec_SSA_PhiTag:
+    return pBlocks[index].firstValue + zydec_PopCount64(pBlocks[index].liveInValueMask) + zydec_SSA_MaskIndex(pBlocks[index].phiMask, slot);
 
-    case ZYDIS_MNEMONIC_VADDPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_ph("));
-      break;
+  case zydec_SSA_DefinitionTag:
+    return pSSA->pInstructions[index].firstDefinition + zydec_SSA_MaskIndex(pSSA->pInstructions[index].defMask, slot);
 
-    case ZYDIS_MNEMONIC_VADDSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_add_sh("));
-      break;
+  default:
+    return SIZE_MAX;
+  }
+}
 
-    case ZYDIS_MNEMONIC_PADDUSW:
-    case ZYDIS_MNEMONIC_VPADDUSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_adds_epu16("));
-      break;
+// Numbers the values, resolves the operands of instructions & phis and links every value to its uses.
+static bool zydec_SSA_AssignValues(const ZydecControlFlowGraph *pGraph, ZydecSSA *pSSA, ZydecSSABlock *pBlocks, const ZydecEncodedValue *pEntryValues, const size_t *pLastWriters)
+{
+  size_t valueCount = 0;
+  size_t operandCount = 0;
+  size_t phiOperandCount = 0;
 
-    case ZYDIS_MNEMONIC_PADDUSB:
-    case ZYDIS_MNEMONIC_VPADDUSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_adds_epu8("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+    ZydecSSABlock *pSSABlock = &pBlocks[i];
 
-    case ZYDIS_MNEMONIC_VALIGND:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_alignr_epi32("));
-      break;
+    pSSABlock->liveInValueMask = (pSSABlock->state & zbs_seed) ? pSSABlock->liveIn : 0;
 
-    case ZYDIS_MNEMONIC_VALIGNQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_alignr_epi64("));
-      break;
+    for (uint64_t remaining = pSSABlock->liveIn; remaining != 0; remaining &= remaining - 1)
+    {
+      const size_t slot = zydec_SSA_LowestSlot(remaining);
 
-    case ZYDIS_MNEMONIC_VPSHUFBITQMB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_bitshuffle_epi64_mask("));
-      break;
+      if (pEntryValues[pSSABlock->firstEntry + zydec_SSA_MaskIndex(pSSABlock->liveIn, slot)] == zydec_SSA_EncodeValue(zydec_SSA_PhiTag, i, slot))
+        pSSABlock->phiMask |= (uint64_t)1 << slot;
+    }
 
-    case ZYDIS_MNEMONIC_VPBLENDMB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_epi8("));
-      break;
+    pSSABlock->firstValue = valueCount;
+    valueCount += zydec_PopCount64(pSSABlock->liveInValueMask) + zydec_PopCount64(pSSABlock->phiMask);
+    phiOperandCount += zydec_PopCount64(pSSABlock->phiMask) * (pBlock->predecessorCount + ((pSSABlock->state & zbs_seed) ? 1 : 0));
 
-    case ZYDIS_MNEMONIC_VPBLENDMW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_epi16("));
-      break;
+    for (size_t j = pBlock->firstInstruction; j < pBlock->firstInstruction + pBlock->instructionCount; j++)
+    {
+      ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[j];
+      pInstruction->defMask |= pInstruction->clobberMask;
+      pInstruction->firstDefinition = valueCount;
+      pInstruction->firstOperand = operandCount;
 
-    case ZYDIS_MNEMONIC_VPBLENDMD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_epi32("));
-      break;
+      valueCount += zydec_PopCount64(pInstruction->defMask);
+      operandCount += zydec_PopCount64(pInstruction->useMask);
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VPBLENDMQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_epi64("));
-      break;
+  pSSA->valueCount = valueCount;
+  pSSA->pValues = reinterpret_cast<ZydecValue *>(malloc(sizeof(ZydecValue) * (valueCount > 0 ? valueCount : 1)));
+  pSSA->pOperands = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (operandCount > 0 ? operandCount : 1)));
+  pSSA->pPhiOperands = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (phiOperandCount > 0 ? phiOperandCount : 1)));
+  pSSA->pUses = reinterpret_cast<ZydecValueUse *>(malloc(sizeof(ZydecValueUse) * (operandCount + phiOperandCount > 0 ? operandCount + phiOperandCount : 1)));
 
-    case ZYDIS_MNEMONIC_VBLENDMPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_ps("));
-      break;
+  if (pSSA->pValues == nullptr || pSSA->pOperands == nullptr || pSSA->pPhiOperands == nullptr || pSSA->pUses == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VBLENDMPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_blend_pd("));
-      break;
+  // Values & operands.
+  ZydecEncodedValue currentValues[zrs_count];
+  size_t nextPhiOperand = 0;
 
-    case ZYDIS_MNEMONIC_VPCMPB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epi8_mask("));
-      break;
+  for (size_t i = 0; i < pGraph->blockCount; i++)
+  {
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+    const ZydecSSABlock *pSSABlock = &pBlocks[i];
+    const bool isSeed = (pSSABlock->state & zbs_seed) != 0;
+    ZydecValue *pValue = &pSSA->pValues[pSSABlock->firstValue];
 
-    case ZYDIS_MNEMONIC_VPCMPW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epi16_mask("));
-      break;
+    for (uint64_t remaining = pSSABlock->liveIn; remaining != 0; remaining &= remaining - 1)
+    {
+      const size_t slot = zydec_SSA_LowestSlot(remaining);
+      currentValues[slot] = pEntryValues[pSSABlock->firstEntry + zydec_SSA_MaskIndex(pSSABlock->liveIn, slot)];
+    }
 
-    case ZYDIS_MNEMONIC_VPCMPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epi32_mask("));
-      break;
+    for (uint64_t remaining = pSSABlock->liveInValueMask; remaining != 0; remaining &= remaining - 1)
+    {
+      *pValue = ZydecValue();
+      pValue->kind = ZydecValueKind::LiveIn;
+      pValue->registerSlot = (uint8_t)zydec_SSA_LowestSlot(remaining);
+      pValue->block = i;
+      pValue->instruction = SIZE_MAX;
+      pValue++;
+    }
 
-    case ZYDIS_MNEMONIC_VPCMPQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epi64_mask("));
-      break;
+    for (uint64_t remaining = pSSABlock->phiMask; remaining != 0; remaining &= remaining - 1)
+    {
+      const size_t slot = zydec_SSA_LowestSlot(remaining);
 
-    case ZYDIS_MNEMONIC_VPCMPUB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epu8_mask("));
-      break;
+      *pValue = ZydecValue();
+      pValue->kind = ZydecValueKind::Phi;
+      pValue->registerSlot = (uint8_t)slot;
+      pValue->block = i;
+      pValue->instruction = SIZE_MAX;
+      pValue->firstOperand = nextPhiOperand;
 
-    case ZYDIS_MNEMONIC_VPCMPUW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epu16_mask("));
-      break;
+      for (size_t j = 0; j < pBlock->predecessorCount; j++)
+        pSSA->pPhiOperands[nextPhiOperand++] = zydec_SSA_ValueIndex(pSSA, pBlocks, zydec_SSA_ExitValue(pBlocks, pEntryValues, pLastWriters, pGraph->pPredecessors[pBlock->firstPredecessor + j], slot));
 
-    case ZYDIS_MNEMONIC_VPCMPUD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epu32_mask("));
-      break;
+      if (isSeed)
+        pSSA->pPhiOperands[nextPhiOperand++] = zydec_SSA_ValueIndex(pSSA, pBlocks, zydec_SSA_EncodeValue(zydec_SSA_LiveInTag, i, slot));
 
-    case ZYDIS_MNEMONIC_VPCMPUQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_epu64_mask("));
-      break;
+      pValue->operandCount = nextPhiOperand - pValue->firstOperand;
+      pValue++;
+    }
 
-    case ZYDIS_MNEMONIC_VCMPPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_ph_mask("));
-      break;
+    for (size_t j = pBlock->firstInstruction; j < pBlock->firstInstruction + pBlock->instructionCount; j++)
+    {
+      const ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[j];
+      size_t *pOperand = &pSSA->pOperands[pInstruction->firstOperand];
 
-    case ZYDIS_MNEMONIC_VFCMULCPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmul_pch("));
-      break;
+      for (uint64_t remaining = pInstruction->useMask; remaining != 0; remaining &= remaining - 1)
+      {
+        const size_t slot = zydec_SSA_LowestSlot(remaining);
+        *pOperand = zydec_SSA_ValueIndex(pSSA, pBlocks, currentValues[slot]);
 
-    case ZYDIS_MNEMONIC_VFCMULCSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmul_sch("));
-      break;
+        if (*pOperand == SIZE_MAX)
+          return false;
 
-    case ZYDIS_MNEMONIC_VPCOMPRESSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_epi8("));
-      break;
+        pOperand++;
+      }
 
-    case ZYDIS_MNEMONIC_VPCOMPRESSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_epi16("));
-      break;
+      for (uint64_t remaining = pInstruction->defMask; remaining != 0; remaining &= remaining - 1)
+      {
+        const size_t slot = zydec_SSA_LowestSlot(remaining);
+        currentValues[slot] = zydec_SSA_EncodeValue(zydec_SSA_DefinitionTag, j, slot);
+
+        *pValue = ZydecValue();
+        pValue->kind = ZydecValueKind::Definition;
+        pValue->registerSlot = (uint8_t)slot;
+        pValue->block = i;
+        pValue->instruction = j;
+        pValue++;
+      }
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VPCOMPRESSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_epi32("));
-      break;
+  // Uses.
+  for (size_t i = 0; i < operandCount; i++)
+    pSSA->pValues[pSSA->pOperands[i]].useCount++;
 
-    case ZYDIS_MNEMONIC_VPCOMPRESSQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_epi64("));
-      break;
+  for (size_t i = 0; i < phiOperandCount; i++)
+  {
+    if (pSSA->pPhiOperands[i] == SIZE_MAX)
+      return false;
 
-    case ZYDIS_MNEMONIC_VCOMPRESSPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_pd("));
-      break;
+    pSSA->pValues[pSSA->pPhiOperands[i]].useCount++;
+  }
 
-    case ZYDIS_MNEMONIC_VCOMPRESSPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_compress_ps("));
-      break;
+  size_t useCount = 0;
 
-    case ZYDIS_MNEMONIC_VPCONFLICTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_conflict_epi32("));
-      break;
+  for (size_t i = 0; i < valueCount; i++)
+  {
+    pSSA->pValues[i].firstUse = useCount;
+    useCount += pSSA->pValues[i].useCount;
+    pSSA->pValues[i].useCount = 0;
+  }
 
-    case ZYDIS_MNEMONIC_VPCONFLICTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_conflict_epi64("));
-      break;
+  for (size_t i = 0; i < pSSA->instructionCount; i++)
+  {
+    const ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[i];
+    const size_t count = zydec_PopCount64(pInstruction->useMask);
 
-    case ZYDIS_MNEMONIC_VCVTW2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi16_ph("));
-      break;
+    for (size_t j = 0; j < count; j++)
+    {
+      ZydecValue *pUsed = &pSSA->pValues[pSSA->pOperands[pInstruction->firstOperand + j]];
+      ZydecValueUse *pUse = &pSSA->pUses[pUsed->firstUse + pUsed->useCount++];
+      pUse->index = i;
+      pUse->isPhi = false;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VCVTDQ2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_ph("));
-      break;
+  for (size_t i = 0; i < valueCount; i++)
+  {
+    const ZydecValue *pPhi = &pSSA->pValues[i];
 
-    case ZYDIS_MNEMONIC_VCVTQQ2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_ph("));
-      break;
+    if (pPhi->kind != ZydecValueKind::Phi)
+      continue;
 
-    case ZYDIS_MNEMONIC_VCVTPD2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_ph("));
-      break;
+    for (size_t j = 0; j < pPhi->operandCount; j++)
+    {
+      ZydecValue *pUsed = &pSSA->pValues[pSSA->pPhiOperands[pPhi->firstOperand + j]];
+      ZydecValueUse *pUse = &pSSA->pUses[pUsed->firstUse + pUsed->useCount++];
+      pUse->index = i;
+      pUse->isPhi = true;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VCVTUW2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu16_ph("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VCVTUDQ2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu32_ph("));
-      break;
+bool zydec_Translator_BuildSSA(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, ZydecSSA **ppSSA)
+{
+  if (pTranslator == nullptr || pGraph == nullptr || ppSSA == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VCVTUQQ2PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu64_ph("));
-      break;
+  ZydecSSA *pSSA = new (std::nothrow) ZydecSSA();
 
-    case ZYDIS_MNEMONIC_VCVTQQ2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_ps("));
-      break;
+  if (pSSA == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VCVTQQ2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_pd("));
-      break;
+  pSSA->instructionCount = pGraph->instructionCount;
+  pSSA->pInstructions = reinterpret_cast<ZydecSSAInstruction *>(calloc(pGraph->instructionCount, sizeof(ZydecSSAInstruction)));
 
-    case ZYDIS_MNEMONIC_VCVTPH2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_pd("));
-      break;
+  ZydecSSABlock *pBlocks = reinterpret_cast<ZydecSSABlock *>(calloc(pGraph->blockCount, sizeof(ZydecSSABlock)));
+  ZydecEncodedValue *pEntryValues = nullptr;
+  size_t *pLastWriters = nullptr;
 
-    case ZYDIS_MNEMONIC_VCVTPH2W:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epi16("));
-      break;
+  bool success = pSSA->pInstructions != nullptr && pBlocks != nullptr && zydec_SSA_CollectRegisters(pTranslator, pGraph, pSSA, pBlocks);
 
-    case ZYDIS_MNEMONIC_VCVTPH2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epi32("));
-      break;
+  if (success)
+  {
+    zydec_SSA_ComputeLiveness(pGraph, pSSA, pBlocks);
 
-    case ZYDIS_MNEMONIC_VCVTPH2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epi64("));
-      break;
+    size_t entryCount = 0;
+    size_t exitCount = 0;
 
-    case ZYDIS_MNEMONIC_VCVTPH2UW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epu16("));
-      break;
+    for (size_t i = 0; i < pGraph->blockCount; i++)
+    {
+      ZydecSSABlock *pBlock = &pBlocks[i];
+      pBlock->firstEntry = entryCount;
+      pBlock->firstExit = exitCount;
 
-    case ZYDIS_MNEMONIC_VCVTPH2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epu32("));
-      break;
+      entryCount += zydec_PopCount64(pBlock->liveIn);
+      exitCount += zydec_PopCount64(pBlock->liveOut & pBlock->defMask);
+    }
 
-    case ZYDIS_MNEMONIC_VCVTPH2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtph_epu64("));
-      break;
+    pEntryValues = reinterpret_cast<ZydecEncodedValue *>(calloc(entryCount > 0 ? entryCount : 1, sizeof(ZydecEncodedValue)));
+    pLastWriters = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (exitCount > 0 ? exitCount : 1)));
+    success = pEntryValues != nullptr && pLastWriters != nullptr;
+  }
 
-    case ZYDIS_MNEMONIC_VCVTPD2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_epi64("));
-      break;
+  if (success)
+  {
+    for (size_t i = 0; i < pGraph->blockCount; i++)
+    {
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[i];
+      const ZydecSSABlock *pSSABlock = &pBlocks[i];
+      const uint64_t exitMask = pSSABlock->liveOut & pSSABlock->defMask;
 
-    case ZYDIS_MNEMONIC_VCVTPS2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_epi64("));
-      break;
+      for (size_t j = pBlock->firstInstruction; j < pBlock->firstInstruction + pBlock->instructionCount; j++)
+        for (uint64_t remaining = (pSSA->pInstructions[j].defMask | pSSA->pInstructions[j].clobberMask) & exitMask; remaining != 0; remaining &= remaining - 1)
+          pLastWriters[pSSABlock->firstExit + zydec_SSA_MaskIndex(exitMask, zydec_SSA_LowestSlot(remaining))] = j;
+    }
 
-    case ZYDIS_MNEMONIC_VCVTUDQ2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu32_ps("));
-      break;
+    zydec_SSA_PropagateValues(pGraph, pBlocks, pEntryValues, pLastWriters);
+    success = zydec_SSA_AssignValues(pGraph, pSSA, pBlocks, pEntryValues, pLastWriters);
+  }
 
-    case ZYDIS_MNEMONIC_VCVTUQQ2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu64_ps("));
-      break;
+  free(pBlocks);
+  free(pEntryValues);
+  free(pLastWriters);
 
-    case ZYDIS_MNEMONIC_VCVTPS2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_epu32("));
-      break;
+  if (!success)
+  {
+    zydec_DestroySSA(&pSSA);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VCVTPS2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtps_epu64("));
-      break;
+  *ppSSA = pSSA;
 
-    case ZYDIS_MNEMONIC_VCVTUDQ2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu32_pd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VCVTUQQ2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepu64_pd("));
-      break;
+void zydec_DestroySSA(ZydecSSA **ppSSA)
+{
+  if (ppSSA == nullptr || *ppSSA == nullptr)
+    return;
 
-    case ZYDIS_MNEMONIC_VCVTPD2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_epu32("));
-      break;
+  free((*ppSSA)->pValues);
+  free((*ppSSA)->pPhiOperands);
+  free((*ppSSA)->pUses);
+  free((*ppSSA)->pInstructions);
+  free((*ppSSA)->pOperands);
 
-    case ZYDIS_MNEMONIC_VCVTPD2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtpd_epu64("));
-      break;
+  delete *ppSSA;
+  *ppSSA = nullptr;
+}
 
-    case ZYDIS_MNEMONIC_VCVTSI2SH:
-      if (pInstruction->operand_count > 2 && pOperands[2].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvti32_sh("));
-      else if (pInstruction->operand_count > 2 && pOperands[2].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvti64_sh("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvti_sh("));
-      break;
+size_t zydec_SSA_GetValueCount(const ZydecSSA *pSSA)
+{
+  return pSSA == nullptr ? 0 : pSSA->valueCount;
+}
 
-    case ZYDIS_MNEMONIC_VCVTUSI2SH:
-      if (pInstruction->operand_count > 2 && pOperands[2].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu32_sh("));
-      else if (pInstruction->operand_count > 2 && pOperands[2].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu64_sh("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu_sh("));
-      break;
+const ZydecValue *zydec_SSA_GetValue(const ZydecSSA *pSSA, const size_t index)
+{
+  if (pSSA == nullptr || index >= pSSA->valueCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VCVTSS2SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_sh("));
-      break;
+  return &pSSA->pValues[index];
+}
 
-    case ZYDIS_MNEMONIC_VCVTSD2SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_sh("));
-      break;
+const size_t *zydec_SSA_GetPhiOperands(const ZydecSSA *pSSA, const size_t valueIndex)
+{
+  if (pSSA == nullptr || valueIndex >= pSSA->valueCount || pSSA->pValues[valueIndex].kind != ZydecValueKind::Phi)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VCVTSH2SI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_i32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_i64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_i("));
-      break;
+  return pSSA->pPhiOperands + pSSA->pValues[valueIndex].firstOperand;
+}
 
-    case ZYDIS_MNEMONIC_VCVTSH2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_u("));
-      break;
+const ZydecValueUse *zydec_SSA_GetUses(const ZydecSSA *pSSA, const size_t valueIndex)
+{
+  if (pSSA == nullptr || valueIndex >= pSSA->valueCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VCVTSH2SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_ss("));
-      break;
+  return pSSA->pUses + pSSA->pValues[valueIndex].firstUse;
+}
 
-    case ZYDIS_MNEMONIC_VCVTSH2SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsh_sd("));
-      break;
+bool zydec_SSA_GetDefinitions(const ZydecSSA *pSSA, const size_t instructionIndex, size_t *pFirstValue, size_t *pCount)
+{
+  if (pSSA == nullptr || instructionIndex >= pSSA->instructionCount || pFirstValue == nullptr || pCount == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPMOVQB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_epi8("));
-      break;
+  *pFirstValue = pSSA->pInstructions[instructionIndex].firstDefinition;
+  *pCount = zydec_PopCount64(pSSA->pInstructions[instructionIndex].defMask);
 
-    case ZYDIS_MNEMONIC_VPMOVDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_epi8("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VPMOVWB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi16_epi8("));
-      break;
+const size_t *zydec_SSA_GetOperands(const ZydecSSA *pSSA, const size_t instructionIndex, size_t *pCount)
+{
+  if (pSSA == nullptr || instructionIndex >= pSSA->instructionCount || pCount == nullptr)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VPMOVQW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_epi16("));
-      break;
+  *pCount = zydec_PopCount64(pSSA->pInstructions[instructionIndex].useMask);
 
-    case ZYDIS_MNEMONIC_VPMOVDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi32_epi16("));
-      break;
+  return pSSA->pOperands + pSSA->pInstructions[instructionIndex].firstOperand;
+}
 
-    case ZYDIS_MNEMONIC_VPMOVQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtepi64_epi32("));
-      break;
+uint64_t zydec_SSA_GetLiveAfter(const ZydecSSA *pSSA, const size_t instructionIndex)
+{
+  if (pSSA == nullptr || instructionIndex >= pSSA->instructionCount)
+    return 0;
 
-    case ZYDIS_MNEMONIC_VCVTNE2PS2BF16:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtne2ps_pbh("));
-      break;
+  return pSSA->pInstructions[instructionIndex].liveAfter;
+}
 
-    case ZYDIS_MNEMONIC_VCVTSD2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsd_u("));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_VCVTSS2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtss_u("));
-      break;
+struct ZydecLoopNest
+{
+  ZydecLoop *pLoops; // Ordered by the address of their header.
+  size_t loopCount;
+  size_t loopCapacity;
 
-    case ZYDIS_MNEMONIC_VCVTUSI2SD:
-      if (pInstruction->operand_count > 2 && pOperands[2].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu32_sd("));
-      else if (pInstruction->operand_count > 2 && pOperands[2].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu64_sd("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu_sd("));
-      break;
+  size_t *pBlocks; // Grouped by loop, see `ZydecLoop::firstBlock`.
+  size_t blockCount;
+  size_t blockCapacity;
 
-    case ZYDIS_MNEMONIC_VCVTUSI2SS:
-      if (pInstruction->operand_count > 2 && pOperands[2].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu32_ss("));
-      else if (pInstruction->operand_count > 2 && pOperands[2].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu64_ss("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtu_ss("));
-      break;
+  size_t *pInnermostLoops; // Per block of the graph.
+  size_t graphBlockCount;
+};
 
-    case ZYDIS_MNEMONIC_VPMOVSWB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi16_epi8("));
-      break;
+static constexpr size_t zydec_LoopNest_MaxStepCount = 16; // Per induction variable & iteration.
 
-    case ZYDIS_MNEMONIC_VPMOVSDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi32_epi8("));
-      break;
+inline ZydisRegister zydec_LoopNest_SlotRegister(const size_t slot)
+{
+  return (ZydisRegister)(ZYDIS_REGISTER_RAX + (slot - zrs_gpr));
+}
 
-    case ZYDIS_MNEMONIC_VPMOVSQB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi64_epi8("));
-      break;
+// The slot of a general purpose register operand that's at least 32 bits wide, `zrs_none` otherwise.
+inline size_t zydec_LoopNest_RegisterOperandSlot(const ZydisDecodedOperand *pOperand)
+{
+  if (pOperand->type != ZYDIS_OPERAND_TYPE_REGISTER || pOperand->size < 32)
+    return zrs_none;
 
-    case ZYDIS_MNEMONIC_VPMOVSDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi32_epi16("));
-      break;
+  const size_t slot = zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperand->reg.value));
 
-    case ZYDIS_MNEMONIC_VPMOVSQW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi64_epi16("));
-      break;
+  return slot < zrs_vector ? slot : zrs_none;
+}
 
-    case ZYDIS_MNEMONIC_VPMOVSQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtsepi64_epi32("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VCVTTSD2SI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_i32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_i64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_si("));
-      break;
+static bool zydec_LoopNest_DecodeInstruction(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const size_t instructionIndex, ZydisDecodedInstruction *pInstruction, ZydisDecodedOperand *pOperands)
+{
+  const size_t codeOffset = pGraph->pInstructionOffsets[instructionIndex];
 
-    case ZYDIS_MNEMONIC_VCVTTSD2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsd_u("));
-      break;
+  return ZYAN_SUCCESS(ZydisDecoderDecodeFull(&pTranslator->decoder, pGraph->pCode + codeOffset, pGraph->size - codeOffset, pInstruction, pOperands));
+}
 
-    case ZYDIS_MNEMONIC_CVTTSS2SI:
-    case ZYDIS_MNEMONIC_VCVTTSS2SI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_si32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_si64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_si("));
-      break;
+// The value of `slot` read by the instruction, which has to read it.
+inline size_t zydec_LoopNest_OperandValue(const ZydecSSA *pSSA, const size_t instructionIndex, const size_t slot)
+{
+  const ZydecSSAInstruction *pInstruction = &pSSA->pInstructions[instructionIndex];
 
-    case ZYDIS_MNEMONIC_VCVTTSS2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttss_u("));
-      break;
+  return pSSA->pOperands[pInstruction->firstOperand + zydec_SSA_MaskIndex(pInstruction->useMask, slot)];
+}
 
-    case ZYDIS_MNEMONIC_VCVTTSH2SI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_si32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_si64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_si("));
-      break;
+static size_t zydec_LoopNest_FirstValue(const ZydecSSA *pSSA, const size_t blockIndex)
+{
+  size_t first = 0;
+  size_t last = pSSA->valueCount;
 
-    case ZYDIS_MNEMONIC_VCVTTSH2USI:
-      if (pInstruction->operand_count > 0 && pOperands[0].element_size == 4)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_u32("));
-      else if (pInstruction->operand_count > 0 && pOperands[0].element_size == 8)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_u64("));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttsh_u("));
-      break;
+  while (first < last)
+  {
+    const size_t middle = first + (last - first) / 2;
 
-    case ZYDIS_MNEMONIC_VCVTTPH2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epi64("));
-      break;
+    if (pSSA->pValues[middle].block < blockIndex)
+      first = middle + 1;
+    else
+      last = middle;
+  }
 
-    case ZYDIS_MNEMONIC_VCVTTPS2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttps_epi64("));
-      break;
+  return first;
+}
 
-    case ZYDIS_MNEMONIC_VCVTTPD2QQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttpd_epi64("));
-      break;
+// Reverse postorder & immediate dominators of the blocks. The blocks every depth first search starts at are dominated by a virtual root with the index `blockCount` only.
+static bool zydec_LoopNest_ComputeDominators(const ZydecControlFlowGraph *pGraph, size_t *pPostorderIndices, size_t *pDominators)
+{
+  const size_t blockCount = pGraph->blockCount;
+  const size_t visited = SIZE_MAX - 1;
 
-    case ZYDIS_MNEMONIC_VCVTTPH2DQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epi32("));
-      break;
+  size_t *pStack = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * 2 * (blockCount > 0 ? blockCount : 1))); // Block & next successor.
+  size_t *pPostorder = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (blockCount > 0 ? blockCount : 1)));
 
-    case ZYDIS_MNEMONIC_VCVTTPH2W:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epi16("));
-      break;
+  if (pStack == nullptr || pPostorder == nullptr)
+  {
+    free(pStack);
+    free(pPostorder);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VCVTTPH2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epu64("));
-      break;
+  for (size_t i = 0; i < blockCount; i++)
+  {
+    pPostorderIndices[i] = SIZE_MAX;
+    pDominators[i] = SIZE_MAX;
+  }
 
-    case ZYDIS_MNEMONIC_VCVTTPS2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttps_epu64("));
-      break;
+  pPostorderIndices[blockCount] = blockCount;
+  pDominators[blockCount] = blockCount;
 
-    case ZYDIS_MNEMONIC_VCVTTPD2UQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttpd_epu64("));
-      break;
+  size_t postorderCount = 0;
 
-    case ZYDIS_MNEMONIC_VCVTTPD2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttpd_epu64("));
-      break;
+  for (size_t root = 0; root < blockCount; root++)
+  {
+    if (pPostorderIndices[root] != SIZE_MAX)
+      continue;
 
-    case ZYDIS_MNEMONIC_VCVTTPS2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttps_epu64("));
-      break;
+    pDominators[root] = blockCount;
+    pPostorderIndices[root] = visited;
+    pStack[0] = root;
+    pStack[1] = 0;
+    size_t depth = 1;
 
-    case ZYDIS_MNEMONIC_VCVTTPH2UDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epu32("));
-      break;
+    while (depth > 0)
+    {
+      size_t *pEntry = &pStack[(depth - 1) * 2];
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[pEntry[0]];
 
-    case ZYDIS_MNEMONIC_VCVTTPH2UW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvttph_epu16("));
-      break;
+      if (pEntry[1] < pBlock->successorCount)
+      {
+        const size_t successor = pBlock->successors[pEntry[1]++];
 
-    case ZYDIS_MNEMONIC_VPMOVUSWB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi16_epi8("));
-      break;
+        if (pPostorderIndices[successor] == SIZE_MAX)
+        {
+          pPostorderIndices[successor] = visited;
+          pStack[depth * 2] = successor;
+          pStack[depth * 2 + 1] = 0;
+          depth++;
+        }
+      }
+      else
+      {
+        pPostorderIndices[pEntry[0]] = postorderCount;
+        pPostorder[postorderCount++] = pEntry[0];
+        depth--;
+      }
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VPMOVUSDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi32_epi8("));
-      break;
+  // Cooper, Harvey & Kennedy, "A Simple, Fast Dominance Algorithm".
+  bool changed = true;
 
-    case ZYDIS_MNEMONIC_VPMOVUSQB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi64_epi8("));
-      break;
+  while (changed)
+  {
+    changed = false;
 
-    case ZYDIS_MNEMONIC_VPMOVUSDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi32_epi16("));
-      break;
+    for (size_t i = blockCount; i-- > 0;)
+    {
+      const size_t blockIndex = pPostorder[i];
 
-    case ZYDIS_MNEMONIC_VPMOVUSQW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi64_epi16("));
-      break;
+      // Dominator sets only shrink, so blocks that are only dominated by the virtual root (like the roots themselves) are done.
+      if (pDominators[blockIndex] == blockCount)
+        continue;
 
-    case ZYDIS_MNEMONIC_VPMOVUSQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtusepi64_epi32("));
-      break;
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
+      const size_t *pPredecessors = pGraph->pPredecessors + pBlock->firstPredecessor;
+      size_t dominator = SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_VCVTPH2PSX:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtxph_ps("));
-      break;
+      for (size_t j = 0; j < pBlock->predecessorCount; j++)
+      {
+        size_t finger = pPredecessors[j];
 
-    case ZYDIS_MNEMONIC_VCVTPS2PHX:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cvtxps_ph("));
-      break;
+        if (pDominators[finger] == SIZE_MAX)
+          continue;
 
-    case ZYDIS_MNEMONIC_VDBPSADBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dbsad_epu8("));
-      break;
+        if (dominator == SIZE_MAX)
+        {
+          dominator = finger;
+          continue;
+        }
 
-    case ZYDIS_MNEMONIC_VDIVPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_ph("));
-      break;
+        while (finger != dominator)
+        {
+          while (pPostorderIndices[finger] < pPostorderIndices[dominator])
+            finger = pDominators[finger];
 
-    case ZYDIS_MNEMONIC_VDIVSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_div_sh("));
-      break;
+          while (pPostorderIndices[dominator] < pPostorderIndices[finger])
+            dominator = pDominators[dominator];
+        }
+      }
 
-    case ZYDIS_MNEMONIC_VDPBF16PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_dpbf16_ps("));
-      break;
+      if (dominator != SIZE_MAX && dominator != pDominators[blockIndex])
+      {
+        pDominators[blockIndex] = dominator;
+        changed = true;
+      }
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VEXP2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_exp2a23_pd("));
-      break;
+  free(pStack);
+  free(pPostorder);
 
-    case ZYDIS_MNEMONIC_VEXP2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_exp2a23_ps("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VPEXPANDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_epi8("));
-      break;
+inline bool zydec_LoopNest_Dominates(const size_t *pDominators, const size_t virtualRoot, const size_t dominator, size_t blockIndex)
+{
+  while (blockIndex != dominator && blockIndex != virtualRoot)
+    blockIndex = pDominators[blockIndex];
 
-    case ZYDIS_MNEMONIC_VPEXPANDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_epi16("));
-      break;
+  return blockIndex == dominator;
+}
 
-    case ZYDIS_MNEMONIC_VPEXPANDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_epi32("));
-      break;
+static int zydec_LoopNest_CompareIndices(const void *pA, const void *pB)
+{
+  const size_t a = *static_cast<const size_t *>(pA);
+  const size_t b = *static_cast<const size_t *>(pB);
 
-    case ZYDIS_MNEMONIC_VPEXPANDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VEXPANDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_ps("));
-      break;
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
 
-    case ZYDIS_MNEMONIC_VEXPANDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mask_expand_pd("));
-      break;
+// Back edges to the same header form a single loop. `pStamps` marks the blocks of the loop with the header index + 1.
+static bool zydec_LoopNest_FindLoops(const ZydecControlFlowGraph *pGraph, ZydecLoopNest *pNest, const size_t *pPostorderIndices, const size_t *pDominators, size_t *pStamps, size_t *pWorklist)
+{
+  for (size_t header = 0; header < pGraph->blockCount; header++)
+  {
+    const ZydecBasicBlock *pHeader = &pGraph->pBlocks[header];
+    const size_t *pPredecessors = pGraph->pPredecessors + pHeader->firstPredecessor;
+    const size_t stamp = header + 1;
+    size_t backEdgeCount = 0;
+    size_t worklistCount = 0;
 
-    case ZYDIS_MNEMONIC_VEXTRACTF32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extractf32x4_ps("));
-      break;
+    pStamps[header] = stamp;
 
-    case ZYDIS_MNEMONIC_VEXTRACTF32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extractf32x8_ps("));
-      break;
+    for (size_t i = 0; i < pHeader->predecessorCount; i++)
+    {
+      const size_t latch = pPredecessors[i];
 
-    case ZYDIS_MNEMONIC_VEXTRACTF64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extractf64x2_pd("));
-      break;
+      // Back edges retreat in the depth first search, which is cheaper to check than walking up the dominator tree.
+      if (pPostorderIndices[latch] > pPostorderIndices[header] || !zydec_LoopNest_Dominates(pDominators, pGraph->blockCount, header, latch))
+        continue;
 
-    case ZYDIS_MNEMONIC_VEXTRACTF64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extractf64x4_pd("));
-      break;
+      backEdgeCount++;
 
-    case ZYDIS_MNEMONIC_VEXTRACTI32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extracti32x4_epi32("));
-      break;
+      if (pStamps[latch] != stamp)
+      {
+        pStamps[latch] = stamp;
+        pWorklist[worklistCount++] = latch;
+      }
+    }
 
-    case ZYDIS_MNEMONIC_VEXTRACTI32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extracti32x8_epi32("));
-      break;
+    if (backEdgeCount == 0)
+      continue;
 
-    case ZYDIS_MNEMONIC_VEXTRACTI64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extracti64x2_epi64("));
-      break;
+    const size_t firstBlock = pNest->blockCount;
 
-    case ZYDIS_MNEMONIC_VEXTRACTI64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_extracti64x4_epi64("));
-      break;
+    if (!zydec_BlockIR_Reserve(&pNest->pBlocks, &pNest->blockCapacity, pNest->blockCount + 1))
+      return false;
 
-    case ZYDIS_MNEMONIC_VFCMADDCPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fcmadd_pch("));
-      break;
+    pNest->pBlocks[pNest->blockCount++] = header;
 
-    case ZYDIS_MNEMONIC_VFCMADDCSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fcmadd_sch("));
-      break;
+    // Every block that reaches a back edge without passing the header.
+    while (worklistCount > 0)
+    {
+      const size_t blockIndex = pWorklist[--worklistCount];
+      const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
+      const size_t *pBlockPredecessors = pGraph->pPredecessors + pBlock->firstPredecessor;
 
-    case ZYDIS_MNEMONIC_VFIXUPIMMPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fixupimm_pd("));
-      break;
+      if (!zydec_BlockIR_Reserve(&pNest->pBlocks, &pNest->blockCapacity, pNest->blockCount + 1))
+        return false;
 
-    case ZYDIS_MNEMONIC_VFIXUPIMMPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fixupimm_ps("));
-      break;
+      pNest->pBlocks[pNest->blockCount++] = blockIndex;
 
-    case ZYDIS_MNEMONIC_VFIXUPIMMSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fixupimm_sd("));
-      break;
+      for (size_t i = 0; i < pBlock->predecessorCount; i++)
+      {
+        if (pStamps[pBlockPredecessors[i]] != stamp)
+        {
+          pStamps[pBlockPredecessors[i]] = stamp;
+          pWorklist[worklistCount++] = pBlockPredecessors[i];
+        }
+      }
+    }
 
-    case ZYDIS_MNEMONIC_VFIXUPIMMSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fixupimm_ss("));
-      break;
+    if (!zydec_BlockIR_Reserve(&pNest->pLoops, &pNest->loopCapacity, pNest->loopCount + 1))
+      return false;
 
-    case ZYDIS_MNEMONIC_VFMADDCPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_pch("));
-      break;
+    ZydecLoop *pLoop = &pNest->pLoops[pNest->loopCount++];
+    *pLoop = ZydecLoop();
+    pLoop->header = header;
+    pLoop->parent = SIZE_MAX;
+    pLoop->depth = 1;
+    pLoop->blockCount = pNest->blockCount - firstBlock;
+    pLoop->firstBlock = firstBlock;
+    pLoop->backEdgeCount = backEdgeCount;
 
-    case ZYDIS_MNEMONIC_VFMADDCSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_sch("));
-      break;
+    qsort(pNest->pBlocks + firstBlock, pLoop->blockCount, sizeof(size_t), zydec_LoopNest_CompareIndices);
+  }
 
-    case ZYDIS_MNEMONIC_VFMADD132PH:
-    case ZYDIS_MNEMONIC_VFMADD213PH:
-    case ZYDIS_MNEMONIC_VFMADD231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_ph("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VFMADD132SH:
-    case ZYDIS_MNEMONIC_VFMADD213SH:
-    case ZYDIS_MNEMONIC_VFMADD231SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmadd_sh("));
-      break;
+struct ZydecLoopOrder
+{
+  size_t blockCount;
+  size_t loop;
+};
 
-    case ZYDIS_MNEMONIC_VFMADDSUB132PH:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PH:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmaddsub_ph("));
-      break;
+static int zydec_LoopNest_CompareOrder(const void *pA, const void *pB)
+{
+  const ZydecLoopOrder *pOrderA = static_cast<const ZydecLoopOrder *>(pA);
+  const ZydecLoopOrder *pOrderB = static_cast<const ZydecLoopOrder *>(pB);
 
-    case ZYDIS_MNEMONIC_VFMSUB132PH:
-    case ZYDIS_MNEMONIC_VFMSUB213PH:
-    case ZYDIS_MNEMONIC_VFMSUB231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_ph("));
-      break;
+  if (pOrderA->blockCount != pOrderB->blockCount)
+    return pOrderA->blockCount > pOrderB->blockCount ? -1 : 1;
 
-    case ZYDIS_MNEMONIC_VFMSUB132SH:
-    case ZYDIS_MNEMONIC_VFMSUB213SH:
-    case ZYDIS_MNEMONIC_VFMSUB231SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsub_sh("));
-      break;
+  return pOrderA->loop < pOrderB->loop ? -1 : (pOrderA->loop > pOrderB->loop ? 1 : 0);
+}
 
-    case ZYDIS_MNEMONIC_VFMSUBADD132PH:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PH:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmsubadd_ph("));
-      break;
+// Natural loops with different headers are either disjoint or nested, so visiting them from the largest to the smallest leaves the innermost one last at every block.
+static bool zydec_LoopNest_NestLoops(ZydecLoopNest *pNest)
+{
+  for (size_t i = 0; i < pNest->graphBlockCount; i++)
+    pNest->pInnermostLoops[i] = SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_VFMULCPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmul_pch("));
-      break;
+  if (pNest->loopCount == 0)
+    return true;
 
-    case ZYDIS_MNEMONIC_VFMULCSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fmul_sch("));
-      break;
+  ZydecLoopOrder *pOrder = reinterpret_cast<ZydecLoopOrder *>(malloc(sizeof(ZydecLoopOrder) * pNest->loopCount));
 
-    case ZYDIS_MNEMONIC_VFNMADD132PH:
-    case ZYDIS_MNEMONIC_VFNMADD213PH:
-    case ZYDIS_MNEMONIC_VFNMADD231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_ph("));
-      break;
+  if (pOrder == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VFNMADD132SH:
-    case ZYDIS_MNEMONIC_VFNMADD213SH:
-    case ZYDIS_MNEMONIC_VFNMADD231SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmadd_sh("));
-      break;
+  for (size_t i = 0; i < pNest->loopCount; i++)
+  {
+    pOrder[i].blockCount = pNest->pLoops[i].blockCount;
+    pOrder[i].loop = i;
+  }
 
-    case ZYDIS_MNEMONIC_VFNMSUB132PH:
-    case ZYDIS_MNEMONIC_VFNMSUB213PH:
-    case ZYDIS_MNEMONIC_VFNMSUB231PH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_ph("));
-      break;
+  qsort(pOrder, pNest->loopCount, sizeof(ZydecLoopOrder), zydec_LoopNest_CompareOrder);
 
-    case ZYDIS_MNEMONIC_VFNMSUB132SH:
-    case ZYDIS_MNEMONIC_VFNMSUB213SH:
-    case ZYDIS_MNEMONIC_VFNMSUB231SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fnmsub_sh("));
-      break;
+  for (size_t i = 0; i < pNest->loopCount; i++)
+  {
+    ZydecLoop *pLoop = &pNest->pLoops[pOrder[i].loop];
+    pLoop->parent = pNest->pInnermostLoops[pLoop->header];
 
-    case ZYDIS_MNEMONIC_VFPCLASSPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fpclass_pd_mask("));
-      break;
+    if (pLoop->parent != SIZE_MAX)
+      pLoop->depth = pNest->pLoops[pLoop->parent].depth + 1;
 
-    case ZYDIS_MNEMONIC_VFPCLASSPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fpclass_ps_mask("));
-      break;
+    for (size_t j = 0; j < pLoop->blockCount; j++)
+      pNest->pInnermostLoops[pNest->pBlocks[pLoop->firstBlock + j]] = pOrder[i].loop;
+  }
 
-    case ZYDIS_MNEMONIC_VFPCLASSPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_fpclass_ph_mask("));
-      break;
+  free(pOrder);
 
-    case ZYDIS_MNEMONIC_VGETEXPPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_pd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VGETEXPPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_ps("));
-      break;
+static void zydec_LoopNest_CountBytes(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecLoopNest *pNest, const size_t loopIndex, ZydecLoop *pLoop)
+{
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_VGETEXPPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_ph("));
-      break;
+  for (size_t i = 0; i < pLoop->blockCount; i++)
+  {
+    const size_t blockIndex = pNest->pBlocks[pLoop->firstBlock + i];
 
-    case ZYDIS_MNEMONIC_VGETEXPSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_sd("));
-      break;
+    if (pNest->pInnermostLoops[blockIndex] != loopIndex)
+      continue;
 
-    case ZYDIS_MNEMONIC_VGETEXPSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_ss("));
-      break;
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
 
-    case ZYDIS_MNEMONIC_VGETEXPSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getexp_sh("));
-      break;
+    for (size_t j = pBlock->firstInstruction; j < pBlock->firstInstruction + pBlock->instructionCount; j++)
+    {
+      if (!zydec_LoopNest_DecodeInstruction(pTranslator, pGraph, j, &instruction, operands))
+        continue;
 
-    case ZYDIS_MNEMONIC_VGETMANTPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_pd("));
-      break;
+      if (instruction.meta.category == ZYDIS_CATEGORY_NOP || instruction.meta.category == ZYDIS_CATEGORY_WIDENOP || instruction.meta.category == ZYDIS_CATEGORY_PREFETCH)
+        continue;
 
-    case ZYDIS_MNEMONIC_VGETMANTPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_ps("));
-      break;
+      for (size_t k = 0; k < instruction.operand_count; k++)
+      {
+        const ZydisDecodedOperand *pOperand = &operands[k];
 
-    case ZYDIS_MNEMONIC_VGETMANTPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_ph("));
-      break;
+        if (pOperand->type != ZYDIS_OPERAND_TYPE_MEMORY || pOperand->mem.type != ZYDIS_MEMOP_TYPE_MEM)
+          continue;
 
-    case ZYDIS_MNEMONIC_VGETMANTSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_sd("));
-      break;
+        if (pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_READ)
+          pLoop->bytesRead += pOperand->size / 8;
 
-    case ZYDIS_MNEMONIC_VGETMANTSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_ss("));
-      break;
+        if (pOperand->actions & ZYDIS_OPERAND_ACTION_MASK_WRITE)
+          pLoop->bytesWritten += pOperand->size / 8;
+      }
+    }
+  }
+}
 
-    case ZYDIS_MNEMONIC_VGETMANTSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_getmant_sh("));
-      break;
+// The change of the register by `add` or `sub` with an immediate, `inc`, `dec` or `lea` of the register with a displacement.
+static bool zydec_LoopNest_ConstantStep(const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t slot, int64_t *pDelta)
+{
+  if (pInstruction->operand_count_visible == 0 || zydec_LoopNest_RegisterOperandSlot(&pOperands[0]) != slot)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPSCATTERDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32scatter_epi32("));
-      break;
+  switch (pInstruction->mnemonic)
+  {
+  case ZYDIS_MNEMONIC_ADD:
+  case ZYDIS_MNEMONIC_SUB:
+    if (pInstruction->operand_count_visible != 2 || pOperands[1].type != ZYDIS_OPERAND_TYPE_IMMEDIATE)
+      return false;
 
-    case ZYDIS_MNEMONIC_VPSCATTERDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32scatter_epi64("));
-      break;
+    *pDelta = pInstruction->mnemonic == ZYDIS_MNEMONIC_ADD ? pOperands[1].imm.value.s : -pOperands[1].imm.value.s;
+    return true;
 
-    case ZYDIS_MNEMONIC_VPSCATTERQD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64scatter_epi32("));
-      break;
+  case ZYDIS_MNEMONIC_INC:
+    *pDelta = 1;
+    return true;
 
-    case ZYDIS_MNEMONIC_VPSCATTERQQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64scatter_epi64("));
-      break;
+  case ZYDIS_MNEMONIC_DEC:
+    *pDelta = -1;
+    return true;
 
-    case ZYDIS_MNEMONIC_VSCATTERDPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32scatter_ps("));
-      break;
+  case ZYDIS_MNEMONIC_LEA:
+    if (pOperands[1].mem.index != ZYDIS_REGISTER_NONE || zydec_LinearContext_RegisterSlot(zydec_ResolveBaseRegister(pOperands[1].mem.base)) != slot)
+      return false;
 
-    case ZYDIS_MNEMONIC_VSCATTERDPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i32scatter_pd("));
-      break;
+    *pDelta = pOperands[1].mem.disp.value;
+    return true;
 
-    case ZYDIS_MNEMONIC_VSCATTERQPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64scatter_ps("));
-      break;
+  default:
+    return false;
+  }
+}
 
-    case ZYDIS_MNEMONIC_VSCATTERQPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_i64scatter_pd("));
-      break;
+// Follows the value that flows back to the header until it reaches the phi, as long as every step adds a constant.
+static bool zydec_LoopNest_FollowSteps(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, const size_t phi, size_t value, size_t *pSteps, size_t *pStepCount, int64_t *pStride)
+{
+  const size_t slot = pSSA->pValues[phi].registerSlot;
 
-    case ZYDIS_MNEMONIC_VINSERTF32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insertf32x4("));
-      break;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+  size_t stepCount = 0;
+  int64_t stride = 0;
 
-    case ZYDIS_MNEMONIC_VINSERTF32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insertf32x8("));
-      break;
+  while (value != phi)
+  {
+    const ZydecValue *pValue = &pSSA->pValues[value];
+    int64_t delta;
 
-    case ZYDIS_MNEMONIC_VINSERTF64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insertf64x2("));
-      break;
+    if (pValue->kind != ZydecValueKind::Definition || stepCount == zydec_LoopNest_MaxStepCount || ((pSSA->pInstructions[pValue->instruction].useMask >> slot) & 1) == 0)
+      return false;
 
-    case ZYDIS_MNEMONIC_VINSERTF64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_insertf64x4("));
-      break;
+    if (!zydec_LoopNest_DecodeInstruction(pTranslator, pGraph, pValue->instruction, &instruction, operands) || !zydec_LoopNest_ConstantStep(&instruction, operands, slot, &delta))
+      return false;
 
-    case ZYDIS_MNEMONIC_VINSERTI32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_inserti32x4("));
-      break;
+    pSteps[stepCount++] = value;
+    stride += delta;
+    value = zydec_LoopNest_OperandValue(pSSA, pValue->instruction, slot);
+  }
 
-    case ZYDIS_MNEMONIC_VINSERTI32X8:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_inserti32x8("));
-      break;
+  *pStepCount = stepCount;
+  *pStride = stride;
 
-    case ZYDIS_MNEMONIC_VINSERTI64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_inserti64x2("));
-      break;
+  return stride != 0;
+}
 
-    case ZYDIS_MNEMONIC_VINSERTI64X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_inserti64x4("));
-      break;
+// Conditions come in pairs, every condition is followed by its negation.
+inline ZydecCondition zydec_NegateCondition(const ZydecCondition condition)
+{
+  return (ZydecCondition)(((condition - 1) ^ 1) + 1);
+}
 
-    case ZYDIS_MNEMONIC_KADDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kadd_mask8("));
-      break;
+// The relation of the left operand of `cmp` to the right one (or of the result to zero) that holds while the condition does.
+static bool zydec_LoopNest_ResolveRelation(const ZydecCondition condition, ZydecLoopRelation *pRelation, bool *pIsUnsigned)
+{
+  *pIsUnsigned = condition >= zcc_below && condition <= zcc_notBelowOrEqual;
 
-    case ZYDIS_MNEMONIC_KADDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kadd_mask16("));
-      break;
+  switch (condition)
+  {
+  case zcc_below: case zcc_less: case zcc_sign: *pRelation = ZydecLoopRelation::Less; return true;
+  case zcc_notBelow: case zcc_notLess: case zcc_notSign: *pRelation = ZydecLoopRelation::GreaterOrEqual; return true;
+  case zcc_belowOrEqual: case zcc_lessOrEqual: *pRelation = ZydecLoopRelation::LessOrEqual; return true;
+  case zcc_notBelowOrEqual: case zcc_notLessOrEqual: *pRelation = ZydecLoopRelation::Greater; return true;
+  case zcc_zero: *pRelation = ZydecLoopRelation::Equal; return true;
+  case zcc_notZero: *pRelation = ZydecLoopRelation::NotEqual; return true;
+  default: return false;
+  }
+}
 
-    case ZYDIS_MNEMONIC_KADDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kadd_mask32("));
-      break;
+inline ZydecLoopRelation zydec_LoopNest_MirrorRelation(const ZydecLoopRelation relation)
+{
+  switch (relation)
+  {
+  case ZydecLoopRelation::Less: return ZydecLoopRelation::Greater;
+  case ZydecLoopRelation::LessOrEqual: return ZydecLoopRelation::GreaterOrEqual;
+  case ZydecLoopRelation::Greater: return ZydecLoopRelation::Less;
+  case ZydecLoopRelation::GreaterOrEqual: return ZydecLoopRelation::LessOrEqual;
+  default: return relation;
+  }
+}
 
-    case ZYDIS_MNEMONIC_KADDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kadd_mask64("));
-      break;
+inline bool zydec_LoopNest_IsInChain(const size_t *pChain, const size_t chainLength, const size_t value)
+{
+  for (size_t i = 0; i < chainLength; i++)
+    if (pChain[i] == value)
+      return true;
 
-    case ZYDIS_MNEMONIC_KANDB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kand_mask8("));
-      break;
+  return false;
+}
 
-    case ZYDIS_MNEMONIC_KANDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kand_mask16("));
-      break;
+// Whether the flags `producer` sets relate the induction variable (any value of `pChain`) to a loop invariant value or constant.
+// Values defined outside of the loop & phis the loop only ever passes back to themselves (like a header phi that merges values from different paths into the loop) don't change while it runs.
+static bool zydec_LoopNest_IsInvariant(const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, const size_t value, const size_t *pStamps, const size_t stamp)
+{
+  const ZydecValue *pValue = &pSSA->pValues[value];
 
-    case ZYDIS_MNEMONIC_KANDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kand_mask32("));
-      break;
+  if (pStamps[pValue->block] != stamp)
+    return true;
 
-    case ZYDIS_MNEMONIC_KANDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kand_mask64("));
-      break;
+  if (pValue->kind != ZydecValueKind::Phi)
+    return false;
 
-    case ZYDIS_MNEMONIC_KANDNB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kandn_mask8("));
-      break;
+  // The live in operand (if any) comes after the ones of the predecessors & is always from outside of the loop.
+  const ZydecBasicBlock *pBlock = &pGraph->pBlocks[pValue->block];
+  const size_t *pPredecessors = pGraph->pPredecessors + pBlock->firstPredecessor;
 
-    case ZYDIS_MNEMONIC_KANDNW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kandn_mask16("));
-      break;
+  for (size_t i = 0; i < pBlock->predecessorCount; i++)
+    if (pStamps[pPredecessors[i]] == stamp && pSSA->pPhiOperands[pValue->firstOperand + i] != value)
+      return false;
 
-    case ZYDIS_MNEMONIC_KANDND:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kandn_mask32("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_KANDNQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kandn_mask64("));
-      break;
+static bool zydec_LoopNest_MatchBound(const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, const size_t producer, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const ZydecCondition condition, const size_t *pStamps, const size_t stamp, const size_t *pChain, const size_t chainLength, ZydecInductionVariable *pVariable)
+{
+  ZydecLoopRelation relation;
+  bool isUnsigned;
 
-    case ZYDIS_MNEMONIC_KNOTB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_knot_mask8("));
-      break;
+  if (!zydec_LoopNest_ResolveRelation(condition, &relation, &isUnsigned))
+    return false;
 
-    case ZYDIS_MNEMONIC_KNOTW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_knot_mask16("));
-      break;
+  const size_t slot = pVariable->registerSlot;
+  bool comparesResult = false;
 
-    case ZYDIS_MNEMONIC_KNOTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_knot_mask32("));
-      break;
+  // The flags of the step itself or `test` of the variable with itself compare the variable to zero.
+  if (pInstruction->mnemonic == ZYDIS_MNEMONIC_TEST)
+    comparesResult = pInstruction->operand_count_visible == 2 && zydec_LoopNest_RegisterOperandSlot(&pOperands[0]) == slot && zydec_LoopNest_RegisterOperandSlot(&pOperands[1]) == slot && zydec_LoopNest_IsInChain(pChain, chainLength, zydec_LoopNest_OperandValue(pSSA, producer, slot));
+  else
+    for (size_t i = 1; i < chainLength; i++)
+      comparesResult |= pSSA->pValues[pChain[i]].instruction == producer;
 
-    case ZYDIS_MNEMONIC_KNOTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_knot_mask64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_KORB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kor_mask8("));
-      break;
+  if (comparesResult)
+  {
+    // Other conditions also depend on carry & overflow.
+    if (condition != zcc_zero && condition != zcc_notZero && condition != zcc_sign && condition != zcc_notSign)
+      return false;
 
-    case ZYDIS_MNEMONIC_KORW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kor_mask16("));
-      break;
+    pVariable->relation = relation;
+    pVariable->isUnsigned = false;
+    pVariable->boundValue = SIZE_MAX;
+    pVariable->boundImmediate = 0;
 
-    case ZYDIS_MNEMONIC_KORD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kor_mask32("));
-      break;
+    return true;
+  }
 
-    case ZYDIS_MNEMONIC_KORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kor_mask64("));
-      break;
+  if (pInstruction->mnemonic != ZYDIS_MNEMONIC_CMP || pInstruction->operand_count_visible != 2 || condition == zcc_sign || condition == zcc_notSign)
+    return false;
 
-    case ZYDIS_MNEMONIC_KUNPCKBW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_kunpackepi8_epi16("));
-      break;
+  const size_t leftSlot = zydec_LoopNest_RegisterOperandSlot(&pOperands[0]);
 
-    case ZYDIS_MNEMONIC_KUNPCKWD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_kunpackepi16_epi32("));
-      break;
+  if (leftSlot == zrs_none)
+    return false;
 
-    case ZYDIS_MNEMONIC_KUNPCKDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_kunpackepi32_epi64("));
-      break;
+  const size_t leftValue = zydec_LoopNest_OperandValue(pSSA, producer, leftSlot);
+  size_t rightSlot = zrs_none;
+  size_t rightValue = SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_KXNORB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kxnor_mask8("));
-      break;
+  if (pOperands[1].type != ZYDIS_OPERAND_TYPE_IMMEDIATE)
+  {
+    rightSlot = zydec_LoopNest_RegisterOperandSlot(&pOperands[1]);
 
-    case ZYDIS_MNEMONIC_KXNORW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kxnor_mask16("));
-      break;
+    if (rightSlot == zrs_none)
+      return false;
 
-    case ZYDIS_MNEMONIC_KXNORD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kxnor_mask32("));
-      break;
+    rightValue = zydec_LoopNest_OperandValue(pSSA, producer, rightSlot);
+  }
 
-    case ZYDIS_MNEMONIC_KXNORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_kxnor_mask64("));
-      break;
+  size_t boundSlot = rightSlot;
+  size_t boundValue = rightValue;
 
-    case ZYDIS_MNEMONIC_VPLZCNTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_lzcnt_epi32("));
-      break;
+  if (!zydec_LoopNest_IsInChain(pChain, chainLength, leftValue))
+  {
+    if (rightValue == SIZE_MAX || !zydec_LoopNest_IsInChain(pChain, chainLength, rightValue))
+      return false;
 
-    case ZYDIS_MNEMONIC_VPLZCNTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_lzcnt_epi64("));
-      break;
+    boundSlot = leftSlot;
+    boundValue = leftValue;
+    relation = zydec_LoopNest_MirrorRelation(relation);
+  }
 
-    case ZYDIS_MNEMONIC_VMAXPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_ph("));
-      break;
+  // The bound has to be invariant.
+  if (boundValue != SIZE_MAX && !zydec_LoopNest_IsInvariant(pGraph, pSSA, boundValue, pStamps, stamp))
+    return false;
 
-    case ZYDIS_MNEMONIC_VMAXSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_max_sh("));
-      break;
+  pVariable->relation = relation;
+  pVariable->isUnsigned = isUnsigned;
+  pVariable->boundValue = boundValue;
+  pVariable->boundRegisterSlot = boundValue == SIZE_MAX ? 0 : (uint8_t)boundSlot;
+  pVariable->boundImmediate = boundValue == SIZE_MAX ? pOperands[1].imm.value.s : 0;
 
-    case ZYDIS_MNEMONIC_VMINPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_ph("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VMINSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_min_sh("));
-      break;
+// Looks for a conditional jump that leaves the loop depending on the induction variable.
+static bool zydec_LoopNest_FindBound(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, const ZydecLoopNest *pNest, const ZydecLoop *pLoop, const size_t *pStamps, const size_t stamp, const size_t *pChain, const size_t chainLength, ZydecInductionVariable *pVariable)
+{
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-    case ZYDIS_MNEMONIC_VPMOVB2M:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movepi8_mask("));
-      break;
+  for (size_t i = 0; i < pLoop->blockCount; i++)
+  {
+    const size_t blockIndex = pNest->pBlocks[pLoop->firstBlock + i];
+    const ZydecBasicBlock *pBlock = &pGraph->pBlocks[blockIndex];
 
-    case ZYDIS_MNEMONIC_VPMOVW2M:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movepi16_mask("));
-      break;
+    if (pBlock->instructionCount == 0)
+      continue;
 
-    case ZYDIS_MNEMONIC_VPMOVD2M:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movepi32_mask("));
-      break;
+    const size_t last = pBlock->firstInstruction + pBlock->instructionCount - 1;
 
-    case ZYDIS_MNEMONIC_VPMOVQ2M:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movepi64_mask("));
-      break;
+    if (!zydec_LoopNest_DecodeInstruction(pTranslator, pGraph, last, &instruction, operands) || instruction.meta.category != ZYDIS_CATEGORY_COND_BR)
+      continue;
 
-    case ZYDIS_MNEMONIC_VPMOVM2B:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movm_epi8("));
-      break;
+    const ZydecCondition condition = zydec_ResolveCondition(instruction.mnemonic);
+    const uint64_t address = pGraph->baseAddress + pGraph->pInstructionOffsets[last];
+    uint64_t target;
 
-    case ZYDIS_MNEMONIC_VPMOVM2W:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movm_epi16("));
-      break;
+    if (condition == zcc_none || !ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&instruction, &operands[0], address, &target)))
+      continue;
 
-    case ZYDIS_MNEMONIC_VPMOVM2D:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movm_epi32("));
-      break;
+    const uint64_t fallThrough = address + instruction.length;
+    bool takenStays = false;
+    bool fallThroughStays = false;
 
-    case ZYDIS_MNEMONIC_VPMOVM2Q:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_movm_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VMULPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_ph("));
-      break;
+    for (size_t j = 0; j < pBlock->successorCount; j++)
+    {
+      const ZydecBasicBlock *pSuccessor = &pGraph->pBlocks[pBlock->successors[j]];
 
-    case ZYDIS_MNEMONIC_VMULSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mul_sh("));
-      break;
+      if (pStamps[pBlock->successors[j]] != stamp)
+        continue;
 
-    case ZYDIS_MNEMONIC_VSUBPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_ph("));
-      break;
+      takenStays |= pSuccessor->virtualAddress == target;
+      fallThroughStays |= pSuccessor->virtualAddress == fallThrough;
+    }
 
-    case ZYDIS_MNEMONIC_VSUBSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sub_sh("));
-      break;
+    if (takenStays == fallThroughStays)
+      continue;
 
-    case ZYDIS_MNEMONIC_VCMPSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_cmp_sh("));
-      break;
+    const ZydecCondition continueCondition = takenStays ? condition : zydec_NegateCondition(condition);
+    size_t producer = SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_VPMULHUW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mulhi_epu16("));
-      break;
+    for (size_t j = last; j-- > pBlock->firstInstruction;)
+    {
+      if (!zydec_LoopNest_DecodeInstruction(pTranslator, pGraph, j, &instruction, operands))
+        break;
 
-    case ZYDIS_MNEMONIC_VPMULHUD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mulhi_epu32("));
-      break;
+      if (zydec_WritesFlags(&instruction))
+      {
+        producer = j;
+        break;
+      }
+    }
 
-    case ZYDIS_MNEMONIC_VPMULLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_mullo_epi64("));
-      break;
+    if (producer != SIZE_MAX && zydec_LoopNest_MatchBound(pGraph, pSSA, producer, &instruction, operands, continueCondition, pStamps, stamp, pChain, chainLength, pVariable))
+    {
+      pVariable->hasBound = true;
+      pVariable->exitBlock = blockIndex;
 
-    case ZYDIS_MNEMONIC_VPMULTISHIFTQB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_multishift_epi64_epi8("));
-      break;
+      return true;
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VPERMT2B:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_epi8("));
-      break;
+  return false;
+}
 
-    case ZYDIS_MNEMONIC_VPERMT2W:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_epi16("));
-      break;
+// Prefers the first induction variable that bounds the loop, otherwise takes the first one.
+static void zydec_LoopNest_FindInductionVariable(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, const ZydecLoopNest *pNest, ZydecLoop *pLoop, const size_t *pStamps, const size_t stamp)
+{
+  const ZydecBasicBlock *pHeader = &pGraph->pBlocks[pLoop->header];
+  const size_t *pPredecessors = pGraph->pPredecessors + pHeader->firstPredecessor;
+  size_t chain[zydec_LoopNest_MaxStepCount + 1]; // The phi followed by the steps.
 
-    case ZYDIS_MNEMONIC_VPERMT2D:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_epi32("));
-      break;
+  for (size_t phi = zydec_LoopNest_FirstValue(pSSA, pLoop->header); phi < pSSA->valueCount && pSSA->pValues[phi].block == pLoop->header && pSSA->pValues[phi].kind != ZydecValueKind::Definition; phi++)
+  {
+    const ZydecValue *pPhi = &pSSA->pValues[phi];
 
-    case ZYDIS_MNEMONIC_VPERMT2Q:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_epi64("));
-      break;
+    if (pPhi->kind != ZydecValueKind::Phi || pPhi->registerSlot >= zrs_vector)
+      continue;
 
-    case ZYDIS_MNEMONIC_VPERMT2PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_ps("));
-      break;
+    // Every back edge has to pass on the same value.
+    size_t latchValue = SIZE_MAX;
+    bool isConsistent = true;
 
-    case ZYDIS_MNEMONIC_VPERMT2PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutex2var_pd("));
-      break;
+    for (size_t i = 0; i < pHeader->predecessorCount && isConsistent; i++)
+    {
+      if (pStamps[pPredecessors[i]] != stamp)
+        continue;
 
-    case ZYDIS_MNEMONIC_VPERMB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutexvar_epi8("));
-      break;
+      const size_t value = pSSA->pPhiOperands[pPhi->firstOperand + i];
+      isConsistent = latchValue == SIZE_MAX || latchValue == value;
+      latchValue = value;
+    }
 
-    case ZYDIS_MNEMONIC_VPERMW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutexvar_epi16("));
-      break;
+    size_t stepCount;
+    int64_t stride;
 
-    case ZYDIS_MNEMONIC_VPERMD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_permutevar_epi32("));
-      break;
+    if (!isConsistent || latchValue == SIZE_MAX || !zydec_LoopNest_FollowSteps(pTranslator, pGraph, pSSA, phi, latchValue, chain + 1, &stepCount, &stride))
+      continue;
 
-    case ZYDIS_MNEMONIC_VPOPCNTB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_popcnt_epi8("));
-      break;
+    chain[0] = phi;
 
-    case ZYDIS_MNEMONIC_VPOPCNTW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_popcnt_epi16("));
-      break;
+    ZydecInductionVariable variable = ZydecInductionVariable();
+    variable.value = phi;
+    variable.registerSlot = pPhi->registerSlot;
+    variable.stride = stride;
+    variable.exitBlock = SIZE_MAX;
+    variable.boundValue = SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_VPOPCNTD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_popcnt_epi32("));
-      break;
+    const bool hasBound = zydec_LoopNest_FindBound(pTranslator, pGraph, pSSA, pNest, pLoop, pStamps, stamp, chain, stepCount + 1, &variable);
 
-    case ZYDIS_MNEMONIC_VPOPCNTQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_popcnt_epi64("));
-      break;
+    if (hasBound || !pLoop->hasInductionVariable)
+    {
+      pLoop->hasInductionVariable = true;
+      pLoop->inductionVariable = variable;
+    }
 
-    case ZYDIS_MNEMONIC_VRANGEPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_range_pd("));
-      break;
+    if (hasBound)
+      return;
+  }
+}
 
-    case ZYDIS_MNEMONIC_VRANGEPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_range_ps("));
-      break;
+bool zydec_Translator_BuildLoopNest(ZydecTranslator *pTranslator, const ZydecControlFlowGraph *pGraph, const ZydecSSA *pSSA, ZydecLoopNest **ppLoopNest)
+{
+  if (pTranslator == nullptr || pGraph == nullptr || pSSA == nullptr || ppLoopNest == nullptr || pSSA->instructionCount != pGraph->instructionCount)
+    return false;
 
-    case ZYDIS_MNEMONIC_VRANGESD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_range_sd("));
-      break;
+  ZydecLoopNest *pNest = new (std::nothrow) ZydecLoopNest();
 
-    case ZYDIS_MNEMONIC_VRANGESS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_range_ss("));
-      break;
+  if (pNest == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VRCPPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp_ph("));
-      break;
+  const size_t blockCount = pGraph->blockCount;
+  pNest->graphBlockCount = blockCount;
+  pNest->pInnermostLoops = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (blockCount > 0 ? blockCount : 1)));
 
-    case ZYDIS_MNEMONIC_VRCPSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp_sh("));
-      break;
+  // The virtual root comes after the blocks.
+  size_t *pPostorderIndices = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (blockCount + 1)));
+  size_t *pDominators = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (blockCount + 1)));
+  size_t *pStamps = reinterpret_cast<size_t *>(calloc(blockCount > 0 ? blockCount : 1, sizeof(size_t)));
+  size_t *pWorklist = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (blockCount > 0 ? blockCount : 1)));
 
-    case ZYDIS_MNEMONIC_VRCP14PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp14_pd("));
-      break;
+  bool success = pNest->pInnermostLoops != nullptr && pPostorderIndices != nullptr && pDominators != nullptr && pStamps != nullptr && pWorklist != nullptr;
+  success = success && zydec_LoopNest_ComputeDominators(pGraph, pPostorderIndices, pDominators);
+  success = success && zydec_LoopNest_FindLoops(pGraph, pNest, pPostorderIndices, pDominators, pStamps, pWorklist);
+  success = success && zydec_LoopNest_NestLoops(pNest);
 
-    case ZYDIS_MNEMONIC_VRCP14PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp14_ps("));
-      break;
+  if (success)
+  {
+    for (size_t i = 0; i < pNest->loopCount; i++)
+    {
+      ZydecLoop *pLoop = &pNest->pLoops[i];
 
-    case ZYDIS_MNEMONIC_VRCP14SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp14_sd("));
-      break;
+      // Above the stamps of `zydec_LoopNest_FindLoops`.
+      const size_t stamp = blockCount + 1 + i;
 
-    case ZYDIS_MNEMONIC_VRCP14SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp14_ss("));
-      break;
+      for (size_t j = 0; j < pLoop->blockCount; j++)
+        pStamps[pNest->pBlocks[pLoop->firstBlock + j]] = stamp;
 
-    case ZYDIS_MNEMONIC_VRCP28PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp28_pd("));
-      break;
+      zydec_LoopNest_CountBytes(pTranslator, pGraph, pNest, i, pLoop);
+      zydec_LoopNest_FindInductionVariable(pTranslator, pGraph, pSSA, pNest, pLoop, pStamps, stamp);
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VRCP28PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp28_ps("));
-      break;
+  free(pPostorderIndices);
+  free(pDominators);
+  free(pStamps);
+  free(pWorklist);
 
-    case ZYDIS_MNEMONIC_VRCP28SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp28_sd("));
-      break;
+  if (!success)
+  {
+    zydec_DestroyLoopNest(&pNest);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VRCP28SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rcp28_ss("));
-      break;
+  *ppLoopNest = pNest;
 
-    case ZYDIS_MNEMONIC_VREDUCEPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_pd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VREDUCEPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_ps("));
-      break;
+void zydec_DestroyLoopNest(ZydecLoopNest **ppLoopNest)
+{
+  if (ppLoopNest == nullptr || *ppLoopNest == nullptr)
+    return;
 
-    case ZYDIS_MNEMONIC_VREDUCEPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_ph("));
-      break;
+  free((*ppLoopNest)->pLoops);
+  free((*ppLoopNest)->pBlocks);
+  free((*ppLoopNest)->pInnermostLoops);
 
-    case ZYDIS_MNEMONIC_VREDUCESD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_sd("));
-      break;
+  delete *ppLoopNest;
+  *ppLoopNest = nullptr;
+}
 
-    case ZYDIS_MNEMONIC_VREDUCESS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_ss("));
-      break;
+size_t zydec_LoopNest_GetLoopCount(const ZydecLoopNest *pLoopNest)
+{
+  return pLoopNest == nullptr ? 0 : pLoopNest->loopCount;
+}
 
-    case ZYDIS_MNEMONIC_VREDUCESH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_reduce_sh("));
-      break;
+const ZydecLoop *zydec_LoopNest_GetLoop(const ZydecLoopNest *pLoopNest, const size_t index)
+{
+  if (pLoopNest == nullptr || index >= pLoopNest->loopCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VPROLD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rol_epi32("));
-      break;
+  return &pLoopNest->pLoops[index];
+}
 
-    case ZYDIS_MNEMONIC_VPROLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rol_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPROLVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rolv_epi32("));
-      break;
+const size_t *zydec_LoopNest_GetBlocks(const ZydecLoopNest *pLoopNest, const size_t index)
+{
+  if (pLoopNest == nullptr || index >= pLoopNest->loopCount)
+    return nullptr;
 
-    case ZYDIS_MNEMONIC_VPROLVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rolv_epi64("));
-      break;
+  return pLoopNest->pBlocks + pLoopNest->pLoops[index].firstBlock;
+}
 
-    case ZYDIS_MNEMONIC_VPRORD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ror_epi32("));
-      break;
+size_t zydec_LoopNest_GetInnermostLoop(const ZydecLoopNest *pLoopNest, const size_t blockIndex)
+{
+  if (pLoopNest == nullptr || blockIndex >= pLoopNest->graphBlockCount)
+    return SIZE_MAX;
 
-    case ZYDIS_MNEMONIC_VPRORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ror_epi64("));
-      break;
+  return pLoopNest->pInnermostLoops[blockIndex];
+}
 
-    case ZYDIS_MNEMONIC_VPRORVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rorv_epi32("));
-      break;
+static constexpr ZydecString LoopRelationOperators[] = { " < ", " <= ", " > ", " >= ", " == ", " != " };
 
-    case ZYDIS_MNEMONIC_VPRORVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rorv_epi64("));
-      break;
+static_assert(sizeof(LoopRelationOperators) / sizeof(LoopRelationOperators[0]) == (size_t)ZydecLoopRelation::NotEqual + 1, "Every relation requires an operator.");
 
-    case ZYDIS_MNEMONIC_VRNDSCALEPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_pd("));
-      break;
+static bool zydec_LoopNest_WriteTerm(char **pBufferPos, size_t *pRemainingSize, const ZydecInductionVariable *pVariable, const bool isBound)
+{
+  if (!isBound)
+    return zydec_WriteRegisterRaw<ZydecTextSink>(pBufferPos, pRemainingSize, zydec_LoopNest_SlotRegister(pVariable->registerSlot));
 
-    case ZYDIS_MNEMONIC_VRNDSCALEPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_ps("));
-      break;
+  if (pVariable->boundValue == SIZE_MAX)
+    return zydec_WriteInt<ZydecTextSink>(pBufferPos, pRemainingSize, pVariable->boundImmediate);
 
-    case ZYDIS_MNEMONIC_VRNDSCALEPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_ph("));
-      break;
+  return zydec_WriteRegisterRaw<ZydecTextSink>(pBufferPos, pRemainingSize, zydec_LoopNest_SlotRegister(pVariable->boundRegisterSlot));
+}
 
-    case ZYDIS_MNEMONIC_VRNDSCALESD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_sd("));
-      break;
+static bool zydec_LoopNest_WriteLoop(char **pBufferPos, size_t *pRemainingSize, const ZydecLoop *pLoop)
+{
+  if (!pLoop->hasInductionVariable)
+  {
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "for (;;) // "));
+  }
+  else
+  {
+    const ZydecInductionVariable *pVariable = &pLoop->inductionVariable;
+    const uint64_t step = pVariable->stride < 0 ? (uint64_t)0 - (uint64_t)pVariable->stride : (uint64_t)pVariable->stride;
 
-    case ZYDIS_MNEMONIC_VRNDSCALESS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_ss("));
-      break;
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "for ("));
+    ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, false));
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "; "));
 
-    case ZYDIS_MNEMONIC_VRNDSCALESH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_roundscale_sh("));
-      break;
+    if (pVariable->hasBound)
+    {
+      ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, false));
+      ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, LoopRelationOperators[(size_t)pVariable->relation]));
+      ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, true));
+    }
 
-    case ZYDIS_MNEMONIC_VRSQRTPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt_ph("));
-      break;
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, "; "));
+    ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, false));
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, pVariable->stride < 0 ? ZydecString(" -= ") : ZydecString(" += ")));
+    ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, step));
+    ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, ") // "));
 
-    case ZYDIS_MNEMONIC_VRSQRTSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt_sh("));
-      break;
+    const ZydecLoopRelation relation = pVariable->relation;
+    const bool countsUp = pVariable->stride > 0 && (relation == ZydecLoopRelation::Less || relation == ZydecLoopRelation::LessOrEqual || relation == ZydecLoopRelation::NotEqual);
+    const bool countsDown = pVariable->stride < 0 && (relation == ZydecLoopRelation::Greater || relation == ZydecLoopRelation::GreaterOrEqual || relation == ZydecLoopRelation::NotEqual);
 
-    case ZYDIS_MNEMONIC_VRSQRT14PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt14_pd("));
-      break;
+    // The distance to the bound over the stride.
+    if (pVariable->hasBound && (countsUp || countsDown))
+    {
+      const bool isDistanceToZero = countsDown && pVariable->boundValue == SIZE_MAX && pVariable->boundImmediate == 0;
 
-    case ZYDIS_MNEMONIC_VRSQRT14PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt14_ps("));
-      break;
+      ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, isDistanceToZero ? ZydecString("~ ") : ZydecString("~ (")));
+      ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, countsUp));
 
-    case ZYDIS_MNEMONIC_VRSQRT14SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt14_sd("));
-      break;
+      if (!isDistanceToZero)
+      {
+        ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " - "));
+        ERROR_CHECK(zydec_LoopNest_WriteTerm(pBufferPos, pRemainingSize, pVariable, countsDown));
+        ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, ")"));
+      }
 
-    case ZYDIS_MNEMONIC_VRSQRT14SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt14_ss("));
-      break;
+      if (step != 1)
+      {
+        ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " / "));
+        ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, step));
+      }
 
-    case ZYDIS_MNEMONIC_VRSQRT28PD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt28_pd("));
-      break;
+      ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " iterations, "));
+    }
+  }
 
-    case ZYDIS_MNEMONIC_VRSQRT28PS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt28_ps("));
-      break;
+  ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, pLoop->bytesRead + pLoop->bytesWritten));
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " bytes per iteration ("));
+  ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, pLoop->bytesRead));
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " read & "));
+  ERROR_CHECK(zydec_WriteUInt<ZydecTextSink>(pBufferPos, pRemainingSize, pLoop->bytesWritten));
+  ERROR_CHECK(ZydecTextSink::Write(pBufferPos, pRemainingSize, " written)"));
 
-    case ZYDIS_MNEMONIC_VRSQRT28SD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt28_sd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VRSQRT28SS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_rsqrt28_ss("));
-      break;
+bool zydec_LoopNest_FormatLoop(const ZydecLoopNest *pLoopNest, const size_t index, char *buffer, const size_t bufferCapacity)
+{
+  if (pLoopNest == nullptr || index >= pLoopNest->loopCount || buffer == nullptr || bufferCapacity == 0)
+    return false;
 
-    case ZYDIS_MNEMONIC_VSCALEFPD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_pd("));
-      break;
+  char *bufferPos = buffer;
+  size_t remainingSize = bufferCapacity - 1; // For the terminating zero.
 
-    case ZYDIS_MNEMONIC_VSCALEFPS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_ps("));
-      break;
+  if (!zydec_LoopNest_WriteLoop(&bufferPos, &remainingSize, &pLoopNest->pLoops[index]))
+  {
+    buffer[0] = '\0';
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VSCALEFPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_ph("));
-      break;
+  *bufferPos = '\0';
 
-    case ZYDIS_MNEMONIC_VSCALEFSD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_sd("));
-      break;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VSCALEFSS:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_ss("));
-      break;
+////////////////////////////////////////////////////////////////////////////////
 
-    case ZYDIS_MNEMONIC_VSCALEFSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_scalef_sh("));
-      break;
+struct ZydecSymbolTableEntry
+{
+  uint64_t address;
+  uint64_t size;
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  uint32_t parent; // The closest symbol before this one that contains its address, 0 if none.
+};
 
-    case ZYDIS_MNEMONIC_VPXORQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_xor_epi64("));
-      break;
+// Symbols are stored in Eytzinger order (the implicit binary search tree in breadth first order, starting at index 1), so every step of a lookup only touches the next level of the tree and the first few levels share a handful of cache lines.
+struct ZydecSymbolTable
+{
+  size_t symbolCount;
+  uint64_t *pAddresses; // Searched on their own, so more of them fit into a cache line.
+  ZydecSymbolTableEntry *pEntries;
+  char *pNames; // Zero terminated, every distinct name is only stored once.
+};
 
-    case ZYDIS_MNEMONIC_VPXORD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_xor_epi32("));
-      break;
+static int zydec_SymbolTable_CompareSymbols(const void *pA, const void *pB)
+{
+  const ZydecSymbol *pSymbolA = static_cast<const ZydecSymbol *>(pA);
+  const ZydecSymbol *pSymbolB = static_cast<const ZydecSymbol *>(pB);
 
-    case ZYDIS_MNEMONIC_VPSHLB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shl_epi8("));
-      break;
+  if (pSymbolA->address != pSymbolB->address)
+    return pSymbolA->address < pSymbolB->address ? -1 : 1;
 
-    case ZYDIS_MNEMONIC_VPSHLW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shl_epi16("));
-      break;
+  return strcmp(pSymbolA->name, pSymbolB->name);
+}
 
-    case ZYDIS_MNEMONIC_VPSHLD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shl_epi32("));
-      break;
+static int zydec_SymbolTable_CompareNames(const void *pA, const void *pB)
+{
+  return strcmp((*static_cast<const ZydecSymbol *const *>(pA))->name, (*static_cast<const ZydecSymbol *const *>(pB))->name);
+}
 
-    case ZYDIS_MNEMONIC_VPSHLQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shl_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPSHLDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldi_epi16("));
-      break;
+static size_t zydec_SymbolTable_Layout(ZydecSymbolTable *pSymbolTable, const ZydecSymbolTableEntry *pSortedEntries, uint32_t *pEytzingerIndices, size_t sortedIndex, const size_t eytzingerIndex)
+{
+  if (eytzingerIndex > pSymbolTable->symbolCount)
+    return sortedIndex;
 
-    case ZYDIS_MNEMONIC_VPSHLDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldi_epi32("));
-      break;
+  sortedIndex = zydec_SymbolTable_Layout(pSymbolTable, pSortedEntries, pEytzingerIndices, sortedIndex, eytzingerIndex * 2);
 
-    case ZYDIS_MNEMONIC_VPSHLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldi_epi64("));
-      break;
+  pSymbolTable->pEntries[eytzingerIndex] = pSortedEntries[sortedIndex];
+  pSymbolTable->pAddresses[eytzingerIndex] = pSortedEntries[sortedIndex].address;
+  pEytzingerIndices[sortedIndex] = (uint32_t)eytzingerIndex;
 
-    case ZYDIS_MNEMONIC_VPSHLDVW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldv_epi16("));
-      break;
+  return zydec_SymbolTable_Layout(pSymbolTable, pSortedEntries, pEytzingerIndices, sortedIndex + 1, eytzingerIndex * 2 + 1);
+}
 
-    case ZYDIS_MNEMONIC_VPSHLDVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldv_epi32("));
-      break;
+// Symbols of known size can contain later ones. Every symbol containing an address is on the parent chain of the closest symbol before it, as the symbols still open at a symbol are exactly those on its chain.
+static void zydec_SymbolTable_LinkParents(ZydecSymbolTableEntry *pSortedEntries, const size_t count, uint32_t *pOpen)
+{
+  size_t openCount = 0;
 
-    case ZYDIS_MNEMONIC_VPSHLDVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shldv_epi64("));
-      break;
+  for (size_t i = 0; i < count; i++)
+  {
+    const uint64_t address = pSortedEntries[i].address;
 
-    case ZYDIS_MNEMONIC_VPSHRDW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdi_epi16("));
-      break;
+    while (openCount != 0 && address - pSortedEntries[pOpen[openCount - 1]].address >= pSortedEntries[pOpen[openCount - 1]].size)
+      openCount--;
 
-    case ZYDIS_MNEMONIC_VPSHRDD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdi_epi32("));
-      break;
+    pSortedEntries[i].parent = openCount == 0 ? UINT32_MAX : pOpen[openCount - 1];
 
-    case ZYDIS_MNEMONIC_VPSHRDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdi_epi64("));
-      break;
+    if (pSortedEntries[i].size != 0)
+      pOpen[openCount++] = (uint32_t)i;
+  }
+}
 
-    case ZYDIS_MNEMONIC_VPSHRDVW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdv_epi16("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPSHRDVD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdv_epi32("));
-      break;
+bool zydec_CreateSymbolTable(ZydecSymbolTable **ppSymbolTable, const ZydecSymbol *pSymbols, const size_t symbolCount)
+{
+  if (ppSymbolTable == nullptr || (pSymbols == nullptr && symbolCount != 0) || symbolCount > UINT32_MAX)
+    return false;
 
-    case ZYDIS_MNEMONIC_VPSHRDVQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shrdv_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VSHUFF32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_f32x4("));
-      break;
+  for (size_t i = 0; i < symbolCount; i++)
+    if (pSymbols[i].name == nullptr)
+      return false;
 
-    case ZYDIS_MNEMONIC_VSHUFF64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_f64x2("));
-      break;
+  ZydecSymbolTable *pSymbolTable = new (std::nothrow) ZydecSymbolTable();
 
-    case ZYDIS_MNEMONIC_VSHUFI32X4:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_i32x4("));
-      break;
+  if (pSymbolTable == nullptr)
+    return false;
 
-    case ZYDIS_MNEMONIC_VSHUFI64X2:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_shuffle_i64x2("));
-      break;
+  ZydecSymbol *pSorted = reinterpret_cast<ZydecSymbol *>(malloc(sizeof(ZydecSymbol) * (symbolCount + 1)));
+  const ZydecSymbol **ppByName = reinterpret_cast<const ZydecSymbol **>(malloc(sizeof(ZydecSymbol *) * (symbolCount + 1)));
+  ZydecSymbolTableEntry *pSortedEntries = reinterpret_cast<ZydecSymbolTableEntry *>(malloc(sizeof(ZydecSymbolTableEntry) * (symbolCount + 1)));
+  uint32_t *pIndices = reinterpret_cast<uint32_t *>(malloc(sizeof(uint32_t) * (symbolCount + 1)));
 
-    case ZYDIS_MNEMONIC_VPSLLVW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sllv_epi16("));
-      break;
+  bool success = pSorted != nullptr && ppByName != nullptr && pSortedEntries != nullptr && pIndices != nullptr;
 
-    case ZYDIS_MNEMONIC_VSQRTPH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_ph("));
-      break;
+  if (success)
+  {
+    if (symbolCount != 0)
+      memcpy(pSorted, pSymbols, sizeof(ZydecSymbol) * symbolCount);
 
-    case ZYDIS_MNEMONIC_VSQRTSH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_sqrt_sh("));
-      break;
+    qsort(pSorted, symbolCount, sizeof(ZydecSymbol), zydec_SymbolTable_CompareSymbols);
 
-    case ZYDIS_MNEMONIC_VPSUBUSB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_subs_epu8("));
-      break;
+    // Only keep the first symbol of every address.
+    size_t uniqueCount = 0;
 
-    case ZYDIS_MNEMONIC_VPSUBUSW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_subs_epu16("));
-      break;
+    for (size_t i = 0; i < symbolCount; i++)
+      if (uniqueCount == 0 || pSorted[uniqueCount - 1].address != pSorted[i].address)
+        pSorted[uniqueCount++] = pSorted[i];
 
-    case ZYDIS_MNEMONIC_VPTERNLOGD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ternarylogic_epi32("));
-      break;
+    // Intern the names.
+    for (size_t i = 0; i < uniqueCount; i++)
+      ppByName[i] = &pSorted[i];
 
-    case ZYDIS_MNEMONIC_VPTERNLOGQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ternarylogic_epi64("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPTESTMB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_epi8_mask("));
-      break;
+    qsort(ppByName, uniqueCount, sizeof(ZydecSymbol *), zydec_SymbolTable_CompareNames);
 
-    case ZYDIS_MNEMONIC_VPTESTMW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_epi16_mask("));
-      break;
+    size_t namesSize = 0;
 
-    case ZYDIS_MNEMONIC_VPTESTMD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_epi32_mask("));
-      break;
+    for (size_t i = 0; i < uniqueCount; i++)
+    {
+      if (i == 0 || strcmp(ppByName[i - 1]->name, ppByName[i]->name) != 0)
+        namesSize += strlen(ppByName[i]->name) + 1;
 
-    case ZYDIS_MNEMONIC_VPTESTMQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_test_epi64_mask("));
-      break;
-      
-    case ZYDIS_MNEMONIC_VPTESTNMB:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_testn_epi8_mask("));
-      break;
+      success &= namesSize <= UINT32_MAX;
+    }
 
-    case ZYDIS_MNEMONIC_VPTESTNMW:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_testn_epi16_mask("));
-      break;
+    pSymbolTable->symbolCount = uniqueCount;
+    pSymbolTable->pNames = reinterpret_cast<char *>(malloc(namesSize + 1));
+    pSymbolTable->pAddresses = reinterpret_cast<uint64_t *>(malloc(sizeof(uint64_t) * (uniqueCount + 1)));
+    pSymbolTable->pEntries = reinterpret_cast<ZydecSymbolTableEntry *>(malloc(sizeof(ZydecSymbolTableEntry) * (uniqueCount + 1)));
 
-    case ZYDIS_MNEMONIC_VPTESTNMD:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_testn_epi32_mask("));
-      break;
+    success &= pSymbolTable->pNames != nullptr && pSymbolTable->pAddresses != nullptr && pSymbolTable->pEntries != nullptr;
 
-    case ZYDIS_MNEMONIC_VPTESTNMQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_testn_epi64_mask("));
-      break;
+    if (success)
+    {
+      size_t nameOffset = 0;
 
-    case ZYDIS_MNEMONIC_VUCOMISH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_ucomi_sh("));
-      break;
+      for (size_t i = 0; i < uniqueCount; i++)
+      {
+        const size_t sortedIndex = (size_t)(ppByName[i] - pSorted);
+        const size_t nameLength = strlen(ppByName[i]->name);
 
-    default:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "_mm_??_("));
-      break;
-    }
+        if (i == 0 || strcmp(ppByName[i - 1]->name, ppByName[i]->name) != 0)
+        {
+          memcpy(pSymbolTable->pNames + nameOffset, ppByName[i]->name, nameLength + 1);
+          nameOffset += nameLength + 1;
+        }
 
-    const size_t startOperandIndex = pInstruction->operand_count <= 1 || (pInstruction->operand_count == 2 && maySelfReference) ? 0 : 1;
+        pSortedEntries[sortedIndex].address = pSorted[sortedIndex].address;
+        pSortedEntries[sortedIndex].size = pSorted[sortedIndex].size;
+        pSortedEntries[sortedIndex].nameOffset = (uint32_t)(nameOffset - nameLength - 1);
+        pSortedEntries[sortedIndex].nameLength = (uint32_t)nameLength;
+      }
 
-    for (size_t operandIndex = startOperandIndex; operandIndex < pInstruction->operand_count; operandIndex++)
-    {
-      if (operandIndex > startOperandIndex)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ", "));
+      zydec_SymbolTable_LinkParents(pSortedEntries, uniqueCount, pIndices);
+      zydec_SymbolTable_Layout(pSymbolTable, pSortedEntries, pIndices, 0, 1);
 
-      ERROR_CHECK(zydec_WriteOperand(&bufferPos, &remainingSize, &pOperands[operandIndex], virtualAddress, pInfo, !addressParam));
+      // The parents are still sorted indices.
+      for (size_t i = 1; i <= uniqueCount; i++)
+        if (pSymbolTable->pEntries[i].parent != UINT32_MAX)
+          pSymbolTable->pEntries[i].parent = pIndices[pSymbolTable->pEntries[i].parent];
+        else
+          pSymbolTable->pEntries[i].parent = 0;
     }
+  }
 
-    switch (pInstruction->mnemonic)
-    {
-    case ZYDIS_MNEMONIC_PSLLDQ:
-    case ZYDIS_MNEMONIC_VPSLLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * 8); // byte shift left in 128 bit lanes"));
-      return true;
+  free(pSorted);
+  free(ppByName);
+  free(pSortedEntries);
+  free(pIndices);
 
-    case ZYDIS_MNEMONIC_PSRLDQ:
-    case ZYDIS_MNEMONIC_VPSRLDQ:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, " * 8); // byte shift right in 128 bit lanes"));
-      return true;
+  if (!success)
+  {
+    zydec_DestroySymbolTable(&pSymbolTable);
+    return false;
+  }
 
-    case ZYDIS_MNEMONIC_VPCOMPRESSB:
-    case ZYDIS_MNEMONIC_VPCOMPRESSW:
-    case ZYDIS_MNEMONIC_VPCOMPRESSD:
-    case ZYDIS_MNEMONIC_VPCOMPRESSQ:
-    case ZYDIS_MNEMONIC_VCOMPRESSPD:
-    case ZYDIS_MNEMONIC_VCOMPRESSPS:
-    case ZYDIS_MNEMONIC_VPMOVQB:
-    case ZYDIS_MNEMONIC_VPMOVDB:
-    case ZYDIS_MNEMONIC_VPMOVWB:
-    case ZYDIS_MNEMONIC_VPMOVQW:
-    case ZYDIS_MNEMONIC_VPMOVDW:
-    case ZYDIS_MNEMONIC_VPMOVQD:
-    case ZYDIS_MNEMONIC_VPMOVSWB:
-    case ZYDIS_MNEMONIC_VPMOVSDB:
-    case ZYDIS_MNEMONIC_VPMOVSQB:
-    case ZYDIS_MNEMONIC_VPMOVSDW:
-    case ZYDIS_MNEMONIC_VPMOVSQW:
-    case ZYDIS_MNEMONIC_VPMOVSQD:
-      if (pOperands[0].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[0].type == ZYDIS_OPERAND_TYPE_POINTER)
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // with unaligned store"));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ");"));
-      return true;
+  *ppSymbolTable = pSymbolTable;
 
-    case ZYDIS_MNEMONIC_VPEXPANDB:
-    case ZYDIS_MNEMONIC_VPEXPANDW:
-    case ZYDIS_MNEMONIC_VPEXPANDD:
-    case ZYDIS_MNEMONIC_VPEXPANDQ:
-      if (pInstruction->operand_count > 0 && (pOperands[pInstruction->operand_count - 1].type == ZYDIS_OPERAND_TYPE_MEMORY || pOperands[pInstruction->operand_count - 1].type == ZYDIS_OPERAND_TYPE_POINTER))
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // with unaligned load"));
-      else
-        ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ");"));
-      return true;
+  return true;
+}
 
-    case ZYDIS_MNEMONIC_VFMADD132PD:
-    case ZYDIS_MNEMONIC_VFMADD132PS:
-    case ZYDIS_MNEMONIC_VFMADD132SD:
-    case ZYDIS_MNEMONIC_VFMADD132SS:
-    case ZYDIS_MNEMONIC_VFMADDSUB132PD:
-    case ZYDIS_MNEMONIC_VFMADDSUB132PS:
-    case ZYDIS_MNEMONIC_VFMSUB132PD:
-    case ZYDIS_MNEMONIC_VFMSUB132PS:
-    case ZYDIS_MNEMONIC_VFMSUB132SD:
-    case ZYDIS_MNEMONIC_VFMSUB132SS:
-    case ZYDIS_MNEMONIC_VFMSUBADD132PD:
-    case ZYDIS_MNEMONIC_VFMSUBADD132PS:
-    case ZYDIS_MNEMONIC_VFNMADD132PD:
-    case ZYDIS_MNEMONIC_VFNMADD132PS:
-    case ZYDIS_MNEMONIC_VFNMADD132SD:
-    case ZYDIS_MNEMONIC_VFNMADD132SS:
-    case ZYDIS_MNEMONIC_VFNMSUB132PD:
-    case ZYDIS_MNEMONIC_VFNMSUB132PS:
-    case ZYDIS_MNEMONIC_VFNMSUB132SD:
-    case ZYDIS_MNEMONIC_VFNMSUB132SS:
-    case ZYDIS_MNEMONIC_VFMADD132PH:
-    case ZYDIS_MNEMONIC_VFMADD132SH:
-    case ZYDIS_MNEMONIC_VFMADDSUB132PH:
-    case ZYDIS_MNEMONIC_VFMSUB132PH:
-    case ZYDIS_MNEMONIC_VFMSUB132SH:
-    case ZYDIS_MNEMONIC_VFMSUBADD132PH:
-    case ZYDIS_MNEMONIC_VFNMADD132PH:
-    case ZYDIS_MNEMONIC_VFNMADD132SH:
-    case ZYDIS_MNEMONIC_VFNMSUB132PH:
-    case ZYDIS_MNEMONIC_VFNMSUB132SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // part 1 / 3"));
-      return true;
+void zydec_DestroySymbolTable(ZydecSymbolTable **ppSymbolTable)
+{
+  if (ppSymbolTable == nullptr || *ppSymbolTable == nullptr)
+    return;
 
-    case ZYDIS_MNEMONIC_VFMADD213PD:
-    case ZYDIS_MNEMONIC_VFMADD213PS:
-    case ZYDIS_MNEMONIC_VFMADD213SD:
-    case ZYDIS_MNEMONIC_VFMADD213SS:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PD:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PS:
-    case ZYDIS_MNEMONIC_VFMSUB213PD:
-    case ZYDIS_MNEMONIC_VFMSUB213PS:
-    case ZYDIS_MNEMONIC_VFMSUB213SD:
-    case ZYDIS_MNEMONIC_VFMSUB213SS:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PD:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PS:
-    case ZYDIS_MNEMONIC_VFNMADD213PD:
-    case ZYDIS_MNEMONIC_VFNMADD213PS:
-    case ZYDIS_MNEMONIC_VFNMADD213SD:
-    case ZYDIS_MNEMONIC_VFNMADD213SS:
-    case ZYDIS_MNEMONIC_VFNMSUB213PD:
-    case ZYDIS_MNEMONIC_VFNMSUB213PS:
-    case ZYDIS_MNEMONIC_VFNMSUB213SD:
-    case ZYDIS_MNEMONIC_VFNMSUB213SS:
-    case ZYDIS_MNEMONIC_VFMADD213PH:
-    case ZYDIS_MNEMONIC_VFMADD213SH:
-    case ZYDIS_MNEMONIC_VFMADDSUB213PH:
-    case ZYDIS_MNEMONIC_VFMSUB213PH:
-    case ZYDIS_MNEMONIC_VFMSUB213SH:
-    case ZYDIS_MNEMONIC_VFMSUBADD213PH:
-    case ZYDIS_MNEMONIC_VFNMADD213PH:
-    case ZYDIS_MNEMONIC_VFNMADD213SH:
-    case ZYDIS_MNEMONIC_VFNMSUB213PH:
-    case ZYDIS_MNEMONIC_VFNMSUB213SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // part 2 / 3"));
-      return true;
+  free((*ppSymbolTable)->pAddresses);
+  free((*ppSymbolTable)->pEntries);
+  free((*ppSymbolTable)->pNames);
 
-    case ZYDIS_MNEMONIC_VFMADD231PD:
-    case ZYDIS_MNEMONIC_VFMADD231PS:
-    case ZYDIS_MNEMONIC_VFMADD231SD:
-    case ZYDIS_MNEMONIC_VFMADD231SS:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PD:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PS:
-    case ZYDIS_MNEMONIC_VFMSUB231PD:
-    case ZYDIS_MNEMONIC_VFMSUB231PS:
-    case ZYDIS_MNEMONIC_VFMSUB231SD:
-    case ZYDIS_MNEMONIC_VFMSUB231SS:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PD:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PS:
-    case ZYDIS_MNEMONIC_VFNMADD231PD:
-    case ZYDIS_MNEMONIC_VFNMADD231PS:
-    case ZYDIS_MNEMONIC_VFNMADD231SD:
-    case ZYDIS_MNEMONIC_VFNMADD231SS:
-    case ZYDIS_MNEMONIC_VFNMSUB231PD:
-    case ZYDIS_MNEMONIC_VFNMSUB231PS:
-    case ZYDIS_MNEMONIC_VFNMSUB231SD:
-    case ZYDIS_MNEMONIC_VFNMSUB231SS:
-    case ZYDIS_MNEMONIC_VFMADD231PH:
-    case ZYDIS_MNEMONIC_VFMADD231SH:
-    case ZYDIS_MNEMONIC_VFMADDSUB231PH:
-    case ZYDIS_MNEMONIC_VFMSUB231PH:
-    case ZYDIS_MNEMONIC_VFMSUB231SH:
-    case ZYDIS_MNEMONIC_VFMSUBADD231PH:
-    case ZYDIS_MNEMONIC_VFNMADD231PH:
-    case ZYDIS_MNEMONIC_VFNMADD231SH:
-    case ZYDIS_MNEMONIC_VFNMSUB231PH:
-    case ZYDIS_MNEMONIC_VFNMSUB231SH:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, "); // part 3 / 3"));
-      return true;
+  delete *ppSymbolTable;
+  *ppSymbolTable = nullptr;
+}
 
-    default:
-      ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ")"));
-      break;
-    }
+bool zydec_SymbolTable_Find(const ZydecSymbolTable *pSymbolTable, const uint64_t address, const char **pName, size_t *pNameLength, uint64_t *pOffsetFromStart)
+{
+  if (pSymbolTable == nullptr || pName == nullptr || pNameLength == nullptr || pOffsetFromStart == nullptr)
+    return false;
 
-    break;
+  // Find the last symbol at or before `address` without branching on the comparison.
+  const uint64_t *pAddresses = pSymbolTable->pAddresses;
+  const size_t symbolCount = pSymbolTable->symbolCount;
+  size_t index = 1;
+  size_t match = 0;
+
+  while (index <= symbolCount)
+  {
+    const bool isAtOrBefore = pAddresses[index] <= address;
+    match = isAtOrBefore ? index : match;
+    index = index * 2 + (isAtOrBefore ? 1 : 0);
   }
 
-  default:
-    *pHasTranslation = false;
+  // Past the end of a nested symbol, the address may still be part of an enclosing one.
+  while (match != 0 && pSymbolTable->pEntries[match].size != 0 && address - pSymbolTable->pEntries[match].address >= pSymbolTable->pEntries[match].size)
+    match = pSymbolTable->pEntries[match].parent;
+
+  if (match == 0)
     return false;
-  }
 
-  ERROR_CHECK(zydec_WriteRaw(&bufferPos, &remainingSize, ";"));
+  const ZydecSymbolTableEntry *pEntry = &pSymbolTable->pEntries[match];
+  const uint64_t offset = address - pEntry->address;
+
+  *pName = pSymbolTable->pNames + pEntry->nameOffset;
+  *pNameLength = pEntry->nameLength;
+  *pOffsetFromStart = offset;
 
   return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-struct ZydecLinearContextFormatInfo
+struct ZydecAddressCacheEntry
 {
-  ZydecLinearContext *pContext = nullptr;
-  ZydecFormattingInfo *pOriginalInfo = nullptr;
-  size_t assignedRegisterCount = 0;
-  ZydisRegister assignedRegister[8];
-  uint32_t assignedRegisterValue[8];
-
-  ZydisRegister regHint = ZYDIS_REGISTER_NONE;
-  ZydecFormattingInfo::HintOperation opHint = ZydecFormattingInfo::None;
+  const char *name; // `nullptr` if the address couldn't be resolved.
+  size_t nameLength;
+  uint64_t offsetFromStart;
+};
 
-  bool hasValHint = false;
-  int64_t valHint = 0;
+// The resolved addresses of a block. Looked up by hash, so resolving an operand only costs a single probe in the common case.
+struct ZydecAddressCache
+{
+  size_t addressCount;
+  uint64_t *pAddresses; // Sorted & distinct.
+  ZydecAddressCacheEntry *pEntries;
+  uint32_t *pSlots; // Index into `pAddresses` + 1, 0 for empty slots.
+  size_t slotShift;
+  char *pNames; // Copies of the names returned by `pResolveAddressToFriendlyName`.
 };
 
-void zydec_LinearContext_AfterCall(void *pUserData)
+static int zydec_AddressCache_CompareAddresses(const void *pA, const void *pB)
 {
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  const uint64_t a = *static_cast<const uint64_t *>(pA);
+  const uint64_t b = *static_cast<const uint64_t *>(pB);
+
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+inline size_t zydec_AddressCache_Slot(const uint64_t address, const size_t slotShift)
+{
+  return (size_t)((address * 0x9E3779B97F4A7C15ULL) >> slotShift);
+}
 
-  switch (pInfo->pOriginalInfo->afterCallRegisterRetentionMode)
+// Retrieves the address `zydec_WriteOperand` resolves for the operand, if any.
+static bool zydec_GetOperandAddress(const ZydisDecodedOperand *pOperand, const uint64_t virtualAddress, uint64_t *pAddress)
+{
+  switch (pOperand->type)
   {
-  case ZydecFormattingInfo::AfterCallRegisterRetentionMode::Windows:
+  case ZYDIS_OPERAND_TYPE_MEMORY:
   {
-    for (size_t i = 0; i < ZYDIS_REGISTER_MAX_VALUE; i++)
+    if (pOperand->mem.base != ZYDIS_REGISTER_RIP)
+      return false;
+
+    switch (pOperand->mem.type)
     {
-      switch (i)
-      {
-      case ZYDIS_REGISTER_RBX:
-      case ZYDIS_REGISTER_RBP:
-      case ZYDIS_REGISTER_RDI:
-      case ZYDIS_REGISTER_RSI:
-      case ZYDIS_REGISTER_RSP:
-      case ZYDIS_REGISTER_R12:
-      case ZYDIS_REGISTER_R13:
-      case ZYDIS_REGISTER_R14:
-      case ZYDIS_REGISTER_R15:
-      case ZYDIS_REGISTER_XMM6:
-      case ZYDIS_REGISTER_XMM7:
-      case ZYDIS_REGISTER_XMM8:
-      case ZYDIS_REGISTER_XMM9:
-      case ZYDIS_REGISTER_XMM10:
-      case ZYDIS_REGISTER_XMM11:
-      case ZYDIS_REGISTER_XMM12:
-      case ZYDIS_REGISTER_XMM13:
-      case ZYDIS_REGISTER_XMM14:
-      case ZYDIS_REGISTER_XMM15:
-        break;
+    case ZYDIS_MEMOP_TYPE_MEM:
+    case ZYDIS_MEMOP_TYPE_VSIB:
+      if (!pOperand->mem.disp.has_displacement && pOperand->mem.index != ZYDIS_REGISTER_NONE)
+        return false;
+      break;
 
-      default:
-        pInfo->pContext->regInfo[i] = 0;
-        break;
-      }
+    case ZYDIS_MEMOP_TYPE_MIB:
+    case ZYDIS_MEMOP_TYPE_AGEN:
+      break;
+
+    default:
+      return false;
     }
 
-    break;
+    *pAddress = virtualAddress + (pOperand->mem.disp.has_displacement ? pOperand->mem.disp.value : 0);
+    return true;
   }
 
-  default:
-  case ZydecFormattingInfo::AfterCallRegisterRetentionMode::Linux:
+  case ZYDIS_OPERAND_TYPE_IMMEDIATE:
   {
-    for (size_t i = 0; i < ZYDIS_REGISTER_MAX_VALUE; i++)
-    {
-      switch (i)
-      {
-      case ZYDIS_REGISTER_RBX:
-      case ZYDIS_REGISTER_RSP:
-      case ZYDIS_REGISTER_RBP:
-      case ZYDIS_REGISTER_R12:
-      case ZYDIS_REGISTER_R13:
-      case ZYDIS_REGISTER_R14:
-      case ZYDIS_REGISTER_R15:
-        break;
-
-      default:
-        pInfo->pContext->regInfo[i] = 0;
-        break;
-      }
-    }
+    if (!pOperand->imm.is_relative)
+      return false;
 
-    break;
+    *pAddress = virtualAddress + pOperand->imm.value.u;
+    return true;
   }
+
+  default:
+    return false;
   }
 }
 
-uint32_t zydec_LinearContext_NextRegisterName(ZydecLinearContext *pContext)
+static size_t zydec_SymbolTable_Next(size_t index, const size_t symbolCount)
 {
-  bool firstRun = true;
-  uint32_t ret;
-
-  while (true)
+  if (index * 2 + 1 <= symbolCount)
   {
-    const uint64_t oldState = pContext->hashState;
-    pContext->hashState = oldState * 6364136223846793005ULL | 1;
+    index = index * 2 + 1;
 
-    const uint32_t xorshifted = (uint32_t)(((oldState >> 18) ^ oldState) >> 27);
-    const uint32_t rot = (uint32_t)(oldState >> 59);
+    while (index * 2 <= symbolCount)
+      index *= 2;
 
-    ret = (xorshifted >> rot) | (xorshifted << (uint32_t)((-(int32_t)rot) & 31));
+    return index;
+  }
 
-    if (!firstRun || ret != 0)
-      break;
+  // Ascend until coming from a left child. Yields 0 after the last symbol.
+  while (index & 1)
+    index >>= 1;
 
-    firstRun = false;
-  }
-  
-  return ret;
+  return index >> 1;
 }
 
-bool zydec_LinearContext_WriteRegisterName(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, const uint32_t registerName)
+// Resolves the sorted `pAddresses` with a single in order walk over the symbols, unless the table is so much larger that individual lookups touch less memory.
+static void zydec_SymbolTable_FindSorted(const ZydecSymbolTable *pSymbolTable, const uint64_t *pAddresses, const size_t addressCount, ZydecAddressCacheEntry *pEntries)
 {
-  if (!zydec_WriteRegisterRaw(pBufferPos, pRemainingSize, reg))
-    return false;
+  const size_t symbolCount = pSymbolTable->symbolCount;
+  size_t depth = 1;
 
-  if (registerName != 0)
+  while ((symbolCount >> depth) != 0)
+    depth++;
+
+  if (addressCount * depth < symbolCount)
   {
-    if (!zydec_WriteRaw(pBufferPos, pRemainingSize, "_"))
-      return false;
+    for (size_t i = 0; i < addressCount; i++)
+      zydec_SymbolTable_Find(pSymbolTable, pAddresses[i], &pEntries[i].name, &pEntries[i].nameLength, &pEntries[i].offsetFromStart);
+
+    return;
+  }
 
-    static const char syllables[256][3] = {
-      "ba", "ca", "da", "fa", "ga", "ha", "ja", "ka", "la", "ma", "na", "pa", "qa", "ra", "sa", "ta", "va", "wa", "xa", "ya", "za",
-      "be", "ce", "de", "fe", "ge", "he", "je", "ke", "le", "me", "ne", "pe", "qe", "re", "se", "te", "ve", "we", "xe", "ye", "ze",
-      "bi", "ci", "di", "fi", "gi", "hi", "ji", "ki", "li", "mi", "ni", "pi", "qi", "ri", "si", "ti", "vi", "wi", "xi", "yi", "zi",
-      "bo", "co", "do", "fo", "go", "ho", "jo", "ko", "lo", "mo", "no", "po", "qo", "ro", "so", "to", "vo", "wo", "xo", "yo", "zo",
-      "bu", "cu", "du", "fu", "gu", "hu", "ju", "ku", "lu", "mu", "nu", "pu", "qu", "ru", "su", "tu", "vu", "wu", "xu", "yu", "zu",
-      "Ba", "Ca", "Da", "Fa", "Ga", "Ha", "Ja", "Ka", "La", "Ma", "Na", "Pa", "Qa", "Ra", "Sa", "Ta", "Va", "Wa", "Xa", "Ya", "Za",
-      "Be", "Ce", "De", "Fe", "Ge", "He", "Je", "Ke", "Le", "Me", "Ne", "Pe", "Qe", "Re", "Se", "Te", "Ve", "We", "Xe", "Ye", "Ze",
-      "Bi", "Ci", "Di", "Fi", "Gi", "Hi", "Ji", "Ki", "Li", "Mi", "Ni", "Pi", "Qi", "Ri", "Si", "Ti", "Vi", "Wi", "Xi", "Yi", "Zi",
-      "Bo", "Co", "Do", "Fo", "Go", "Ho", "Jo", "Ko", "Lo", "Mo", "No", "Po", "Qo", "Ro", "So", "To", "Vo", "Wo", "Xo", "Yo", "Zo",
-      "Bu", "Cu", "Du", "Fu", "Gu", "Hu", "Ju", "Ku", "Lu", "Mu", "Nu", "Pu", "Qu", "Ru", "Su", "Tu", "Vu", "Wu", "Xu", "Yu", "Zu",
-      "a_", "b_", "c_", "d_", "e_", "f_", "g_", "h_", "i_", "j_", "k_", "l_", "m_", "n_", "o_", "p_", "q_", "r_", "s_", "t_", "u_", "v_", "w_", "x_", "y_", "z_",
-      "Ad", "An", "Sh", "In", "Cm", "Ab", "Bl", "Bs", "Ex", "6i", "7i", "9i", "4o", "6o", "7o", "9o", "4u", "6u", "7u", "9u",
-    };
+  size_t current = 0; // The last symbol at or before the current address.
+  size_t next = symbolCount != 0 ? 1 : 0;
 
-    uint32_t val = registerName;
+  while (next * 2 <= symbolCount && next != 0)
+    next *= 2;
 
-    for (size_t i = 0; i < sizeof(uint32_t); i += sizeof(uint8_t))
+  for (size_t i = 0; i < addressCount; i++)
+  {
+    while (next != 0 && pSymbolTable->pAddresses[next] <= pAddresses[i])
     {
-      const uint8_t seg = (uint8_t)(val & 0xFF);
+      current = next;
+      next = zydec_SymbolTable_Next(next, symbolCount);
+    }
 
-      if (!zydec_WriteRaw(pBufferPos, pRemainingSize, syllables[seg]))
-        return false;
+    size_t match = current;
 
-      val >>= 8;
-    }
-  }
+    while (match != 0 && pSymbolTable->pEntries[match].size != 0 && pAddresses[i] - pSymbolTable->pEntries[match].address >= pSymbolTable->pEntries[match].size)
+      match = pSymbolTable->pEntries[match].parent;
 
-  return true;
-}
+    if (match == 0)
+      continue;
 
-bool zydec_LinearContext_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, void *pUserData)
-{
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+    const ZydecSymbolTableEntry *pSymbol = &pSymbolTable->pEntries[match];
+    const uint64_t offset = pAddresses[i] - pSymbol->address;
 
-  return zydec_LinearContext_WriteRegisterName(pBufferPos, pRemainingSize, reg, pInfo->pContext->regInfo[reg]);
+    pEntries[i].name = pSymbolTable->pNames + pSymbol->nameOffset;
+    pEntries[i].nameLength = pSymbol->nameLength;
+    pEntries[i].offsetFromStart = offset;
+  }
 }
 
-bool zydec_LinearContext_WriteResultRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, void *pUserData)
+// Collects the addresses of all relative operands in `pCode`. Stops at the first instruction that can't be decoded, so the block function can report it.
+static bool zydec_AddressCache_Collect(const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, uint64_t **ppAddresses, size_t *pAddressCount)
 {
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
+  ZydisDecoderContext decoderContext;
+  ZydisDecodedInstruction instruction;
+  ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
 
-  uint32_t newName = zydec_LinearContext_NextRegisterName(pInfo->pContext);
+  size_t addressCapacity = 0;
+  size_t codeOffset = 0;
 
-  if (pInfo->regHint != ZYDIS_REGISTER_NONE)
+  while (codeOffset < size)
   {
-    ZydisRegister baseRegister = zydec_ResolveBaseRegister(pInfo->regHint);
-    const uint32_t hintedRegName = pInfo->pContext->regInfo[baseRegister];
+    if (!ZYAN_SUCCESS(ZydisDecoderDecodeInstruction(pDecoder, &decoderContext, pCode + codeOffset, size - codeOffset, &instruction)) || instruction.length == 0)
+      break;
 
-    if (hintedRegName != 0)
-      newName = hintedRegName;
-  }
-  else if (pInfo->hasValHint && (pInfo->valHint == 0 || pInfo->valHint == (int64_t)-1))
-  {
-    if (pInfo->valHint == 0)
-    {
-      newName &= 0xFFFF0000;
-      newName |= 0xDDC7; // `Nul_`
-    }
-    else if (pInfo->valHint == (int64_t)-1)
+    // Only instructions with relative operands need their operands decoded.
+    if ((instruction.attributes & ZYDIS_ATTRIB_IS_RELATIVE) != 0 && ZYAN_SUCCESS(ZydisDecoderDecodeOperands(pDecoder, &decoderContext, &instruction, operands, instruction.operand_count)))
     {
-      newName &= 0xFFFF0000;
-      newName |= 0xDDC0; // `Ful_`
+      for (size_t i = 0; i < instruction.operand_count; i++)
+      {
+        uint64_t address;
+
+        if (!zydec_GetOperandAddress(&operands[i], baseAddress + codeOffset, &address))
+          continue;
+
+        if (*pAddressCount == addressCapacity)
+        {
+          addressCapacity = addressCapacity == 0 ? 256 : addressCapacity * 2;
+          uint64_t *pAddresses = reinterpret_cast<uint64_t *>(realloc(*ppAddresses, sizeof(uint64_t) * addressCapacity));
+
+          if (pAddresses == nullptr)
+            return false;
+
+          *ppAddresses = pAddresses;
+        }
+
+        (*ppAddresses)[(*pAddressCount)++] = address;
+      }
     }
+
+    codeOffset += instruction.length;
   }
-  else if (pInfo->opHint != ZydecFormattingInfo::None)
+
+  return true;
+}
+
+// Resolves the addresses that aren't covered by the symbol table with the callbacks of `pInfo`.
+static bool zydec_AddressCache_ResolveRemaining(ZydecAddressCache *pCache, const ZydecFormattingInfo *pInfo)
+{
+  if (pInfo->pResolveAddressesToFriendlyNames != nullptr)
   {
-    switch (pInfo->opHint)
-    {
-    case ZydecFormattingInfo::Add:
-      newName &= 0xFFFF0000;
-      newName |= 0xD5EC; // `Add_`
-      break;
+    size_t remainingCount = 0;
 
-    case ZydecFormattingInfo::Sub:
-      newName &= 0xFFFF0000;
-      newName |= 0xD3CB; // `Sub_`
-      break;
+    for (size_t i = 0; i < pCache->addressCount; i++)
+      remainingCount += pCache->pEntries[i].name == nullptr;
 
-    case ZydecFormattingInfo::Mul:
-      newName &= 0xFFFF0000;
-      newName |= 0xDDC6; // `Mul_`
-      break;
+    if (remainingCount == 0)
+      return true;
 
-    case ZydecFormattingInfo::Div:
-      newName &= 0xFFFF0000;
-      newName |= 0xE795; // `Div_`
-      break;
+    uint64_t *pAddresses = reinterpret_cast<uint64_t *>(malloc(sizeof(uint64_t) * remainingCount));
+    ZydecFormattingInfo::ResolvedAddress *pResolved = reinterpret_cast<ZydecFormattingInfo::ResolvedAddress *>(calloc(remainingCount, sizeof(ZydecFormattingInfo::ResolvedAddress)));
+    bool success = pAddresses != nullptr && pResolved != nullptr;
 
-    case ZydecFormattingInfo::Mod:
-      newName &= 0xFFFF0000;
-      newName |= 0xD5B1; // `Mod_`
-      break;
+    if (success)
+    {
+      for (size_t i = 0, j = 0; i < pCache->addressCount; i++)
+        if (pCache->pEntries[i].name == nullptr)
+          pAddresses[j++] = pCache->pAddresses[i];
 
-    case ZydecFormattingInfo::And:
-      newName &= 0xFFFF0000;
-      newName |= 0xD5ED; // `And_`
-      break;
+      success = pInfo->pResolveAddressesToFriendlyNames(pAddresses, pResolved, remainingCount, pInfo->pUserData);
+    }
 
-    case ZydecFormattingInfo::AndNot:
-      newName &= 0xFFFF0000;
-      newName |= 0xE5ED; // `Ant_`
-      break;
+    if (success)
+    {
+      for (size_t i = 0, j = 0; i < pCache->addressCount; i++)
+      {
+        ZydecAddressCacheEntry *pEntry = &pCache->pEntries[i];
 
-    case ZydecFormattingInfo::Or:
-      newName &= 0xFFFF0000;
-      newName |= 0xE33F; // `bor_`
-      break;
+        if (pEntry->name != nullptr)
+          continue;
 
-    case ZydecFormattingInfo::XOr:
-      newName &= 0xFFFF0000;
-      newName |= 0xE351; // `xor_`
-      break;
+        if (pResolved[j].name != nullptr)
+        {
+          pEntry->name = pResolved[j].name;
+          pEntry->nameLength = strlen(pResolved[j].name);
+          pEntry->offsetFromStart = pResolved[j].offsetFromStart;
+        }
 
-    case ZydecFormattingInfo::Neg:
-      newName &= 0xFFFF0000;
-      newName |= 0xD888; // `Neg_`
-      break;
+        j++;
+      }
+    }
 
-    case ZydecFormattingInfo::ShL:
-      newName &= 0xFFFF0000;
-      newName |= 0xDDEE; // `Shl_`
-      break;
+    free(pAddresses);
+    free(pResolved);
 
-    case ZydecFormattingInfo::ShR:
-      newName &= 0xFFFF0000;
-      newName |= 0xE3EE; // `Shr_`
-      break;
+    return success;
+  }
 
-    case ZydecFormattingInfo::Inc:
-      newName &= 0xFFFF0000;
-      newName |= 0xD4EF; // `Inc_`
-      break;
+  if (pInfo->pResolveAddressToFriendlyName == nullptr)
+    return true;
 
-    case ZydecFormattingInfo::Dec:
-      newName &= 0xFFFF0000;
-      newName |= 0xD480; // `Dec_`
-      break;
+  // The names are copied, so they're only pointed to once all of them are in place.
+  size_t *pNameOffsets = reinterpret_cast<size_t *>(malloc(sizeof(size_t) * (pCache->addressCount + 1)));
+  size_t namesSize = 0;
+  size_t namesCapacity = 0;
+  bool success = pNameOffsets != nullptr;
 
-    case ZydecFormattingInfo::BitScanF:
-      newName &= 0xFFFF0000;
-      newName |= 0xD7F3; // `Bsf_`
-      break;
+  for (size_t i = 0; success && i < pCache->addressCount; i++)
+  {
+    ZydecAddressCacheEntry *pEntry = &pCache->pEntries[i];
+    pNameOffsets[i] = SIZE_MAX;
 
-    case ZydecFormattingInfo::BitScanR:
-      newName &= 0xFFFF0000;
-      newName |= 0xE3F3; // `Bsr_`
-      break;
+    if (pEntry->name != nullptr)
+      continue;
 
-    case ZydecFormattingInfo::PopCnt:
-      newName &= 0xFFFF0000;
-      newName |= 0xE1B3; // `Pop_`
-      break;
+    char friendlyName[1024];
+    size_t friendlyNameOffset = 0;
 
-    case ZydecFormattingInfo::AddressOf:
-      newName &= 0xFFFF0000;
-      newName |= 0xD4B0; // `Loc_`
-      break;
+    if (!pInfo->pResolveAddressToFriendlyName((size_t)pCache->pAddresses[i], friendlyName, sizeof(friendlyName), &friendlyNameOffset, pInfo->pUserData))
+      continue;
 
-    case ZydecFormattingInfo::Mov:
-    case ZydecFormattingInfo::ConditionalMov:
-      newName &= 0xFFFF0000;
-      newName |= 0xE7B1; // `Mov_`
-      break;
+    const size_t nameLength = strlen(friendlyName);
+
+    if (namesSize + nameLength + 1 > namesCapacity)
+    {
+      namesCapacity = (namesSize + nameLength + 1) * 2;
+      char *pNames = reinterpret_cast<char *>(realloc(pCache->pNames, namesCapacity));
+
+      if (pNames == nullptr)
+      {
+        success = false;
+        break;
+      }
+
+      pCache->pNames = pNames;
+    }
 
-    case ZydecFormattingInfo::Set:
-      newName &= 0xFFFF0000;
-      newName |= 0xE58C; // `Set_`
-      break;
+    memcpy(pCache->pNames + namesSize, friendlyName, nameLength + 1);
+    pNameOffsets[i] = namesSize;
+    pEntry->nameLength = nameLength;
+    pEntry->offsetFromStart = friendlyNameOffset;
+    namesSize += nameLength + 1;
+  }
 
-    case ZydecFormattingInfo::Cmp:
-      newName &= 0xFFFF0000;
-      newName |= 0xE1F0; // `Cmp_`
-      break;
+  if (success)
+    for (size_t i = 0; i < pCache->addressCount; i++)
+      if (pNameOffsets[i] != SIZE_MAX)
+        pCache->pEntries[i].name = pCache->pNames + pNameOffsets[i];
 
-    case ZydecFormattingInfo::Pack:
-    case ZydecFormattingInfo::Unpack:
-      newName &= 0xFFFF0000;
-      newName |= 0xDC74; // `Pak_`
-      break;
+  free(pNameOffsets);
 
-    case ZydecFormattingInfo::Abs:
-      newName &= 0xFFFF0000;
-      newName |= 0xE4F1; // `Abs_`
-      break;
+  return success;
+}
 
-    case ZydecFormattingInfo::Blend:
-      newName &= 0xFFFF0000;
-      newName |= 0xD5F2; // `Bld_`
-      break;
+static void zydec_AddressCache_Destroy(ZydecAddressCache **ppAddressCache)
+{
+  if (ppAddressCache == nullptr || *ppAddressCache == nullptr)
+    return;
 
-    case ZydecFormattingInfo::Broadcast:
-      newName &= 0xFFFF0000;
-      newName |= 0xE5F3; // `Bst_`
-      break;
+  free((*ppAddressCache)->pAddresses);
+  free((*ppAddressCache)->pEntries);
+  free((*ppAddressCache)->pSlots);
+  free((*ppAddressCache)->pNames);
 
-    case ZydecFormattingInfo::Shuffle:
-      newName &= 0xFFFF0000;
-      newName |= 0xD7EE; // `Shf_`
-      break;
+  delete *ppAddressCache;
+  *ppAddressCache = nullptr;
+}
 
-    case ZydecFormattingInfo::Permute:
-      newName &= 0xFFFF0000;
-      newName |= 0xDE89; // `Pem_`
-      break;
+static bool zydec_AddressCache_Create(ZydecAddressCache **ppAddressCache, const ZydisDecoder *pDecoder, const uint8_t *pCode, const size_t size, const uint64_t baseAddress, const ZydecFormattingInfo *pInfo)
+{
+  if (ppAddressCache == nullptr || pDecoder == nullptr || pCode == nullptr || pInfo == nullptr)
+    return false;
 
-    case ZydecFormattingInfo::Round:
-      newName &= 0xFFFF0000;
-      newName |= 0xD5B5; // `Rod_`
-      break;
+  ZydecAddressCache *pCache = new (std::nothrow) ZydecAddressCache();
 
-    case ZydecFormattingInfo::Convert:
-      newName &= 0xFFFF0000;
-      newName |= 0xE7A9; // `Con_`
-      break;
+  if (pCache == nullptr)
+    return false;
 
-    case ZydecFormattingInfo::DotProduct:
-      newName &= 0xFFFF0000;
-      newName |= 0xE5AA; // `Dot_`
-      break;
+  bool success = zydec_AddressCache_Collect(pDecoder, pCode, size, baseAddress, &pCache->pAddresses, &pCache->addressCount);
 
-    case ZydecFormattingInfo::Extract:
-      newName &= 0xFFFF0000;
-      newName |= 0xE5F4; // `Ext_`
-      break;
+  if (success && pCache->addressCount > UINT32_MAX)
+    success = false;
 
-    case ZydecFormattingInfo::Gather:
-      newName &= 0xFFFF0000;
-      newName |= 0xE56D; // `Gat_`
-      break;
+  if (success && pCache->addressCount != 0)
+  {
+    qsort(pCache->pAddresses, pCache->addressCount, sizeof(uint64_t), zydec_AddressCache_CompareAddresses);
 
-    case ZydecFormattingInfo::Max:
-      newName &= 0xFFFF0000;
-      newName |= 0xE972; // `Max_`
-      break;
+    size_t uniqueCount = 1;
 
-    case ZydecFormattingInfo::Min:
-      newName &= 0xFFFF0000;
-      newName |= 0xDF9C; // `Min_`
-      break;
+    for (size_t i = 1; i < pCache->addressCount; i++)
+      if (pCache->pAddresses[i] != pCache->pAddresses[uniqueCount - 1])
+        pCache->pAddresses[uniqueCount++] = pCache->pAddresses[i];
 
-    case ZydecFormattingInfo::Mask:
-      newName &= 0xFFFF0000;
-      newName |= 0xE472; // `Mas_`
-      break;
+    pCache->addressCount = uniqueCount;
 
-    case ZydecFormattingInfo::Test:
-      newName &= 0xFFFF0000;
-      newName |= 0xE48D; // `Tes_`
-      break;
+    // At least twice as many slots as addresses, to keep the probe sequences short.
+    size_t slotCountLog2 = 1;
 
-    case ZydecFormattingInfo::Not:
-      newName &= 0xFFFF0000;
-      newName |= 0xE5B2; // `Not_`
-      break;
+    while (((size_t)1 << slotCountLog2) < uniqueCount * 2)
+      slotCountLog2++;
 
-    case ZydecFormattingInfo::XNor:
-      newName &= 0xFFFF0000;
-      newName |= 0x49E9; // `x_no`
-      break;
+    const size_t slotCount = (size_t)1 << slotCountLog2;
+    pCache->slotShift = 64 - slotCountLog2;
+    pCache->pEntries = reinterpret_cast<ZydecAddressCacheEntry *>(calloc(uniqueCount, sizeof(ZydecAddressCacheEntry)));
+    pCache->pSlots = reinterpret_cast<uint32_t *>(calloc(slotCount, sizeof(uint32_t)));
 
-    default:
-      break;
+    success = pCache->pEntries != nullptr && pCache->pSlots != nullptr;
+
+    if (success)
+    {
+      if (pInfo->pSymbolTable != nullptr)
+        zydec_SymbolTable_FindSorted(pInfo->pSymbolTable, pCache->pAddresses, uniqueCount, pCache->pEntries);
+
+      success = zydec_AddressCache_ResolveRemaining(pCache, pInfo);
     }
-  }
 
-  const bool result = zydec_LinearContext_WriteRegisterName(pBufferPos, pRemainingSize, reg, newName);
+    if (success)
+    {
+      for (size_t i = 0; i < uniqueCount; i++)
+      {
+        size_t slot = zydec_AddressCache_Slot(pCache->pAddresses[i], pCache->slotShift);
 
-  pInfo->assignedRegister[pInfo->assignedRegisterCount] = reg;
-  pInfo->assignedRegisterValue[pInfo->assignedRegisterCount] = newName;
-  pInfo->assignedRegisterCount++;
+        while (pCache->pSlots[slot] != 0)
+          slot = (slot + 1) & (slotCount - 1);
 
-  return result;
-}
+        pCache->pSlots[slot] = (uint32_t)(i + 1);
+      }
+    }
+  }
 
-void zydec_LinearContext_HintRegister(const ZydisRegister reg, void *pUserData)
-{
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
-  pInfo->regHint = reg;
-}
+  if (!success)
+  {
+    zydec_AddressCache_Destroy(&pCache);
+    return false;
+  }
 
-void zydec_LinearContext_HintValue(const int64_t value, void *pUserData)
-{
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
-  pInfo->hasValHint = true;
-  pInfo->valHint = value;
-}
+  *ppAddressCache = pCache;
 
-void zydec_LinearContext_HintOperation(const ZydecFormattingInfo::HintOperation operation, void *pUserData)
-{
-  ZydecLinearContextFormatInfo *pInfo = static_cast<ZydecLinearContextFormatInfo *>(pUserData);
-  pInfo->opHint = operation;
+  return true;
 }
 
-bool zydec_TranslateInstructionWithLinearContext(ZydecLinearContext *pContext, const ZydisDecodedInstruction *pInstruction, const ZydisDecodedOperand *pOperands, const size_t operandCount, const size_t virtualAddress, char *buffer, const size_t bufferCapacity, bool *pHasTranslation, ZydecFormattingInfo *pInfo)
+// Returns `nullptr` if the address wasn't collected.
+static const ZydecAddressCacheEntry *zydec_AddressCache_Find(const ZydecAddressCache *pCache, const uint64_t address)
 {
-  ZydecLinearContextFormatInfo formatContextInfo;
-  formatContextInfo.pContext = pContext;
-  formatContextInfo.pOriginalInfo = pInfo;
+  if (pCache->addressCount == 0)
+    return nullptr;
 
-  ZydecFormattingInfo newInfo = *pInfo;
-  newInfo.simplifyValueSelfModification = false;
-  newInfo.pRegUserData = newInfo.pCallUserData = &formatContextInfo;
-  newInfo.pWriteRegister = zydec_LinearContext_WriteRegister;
-  newInfo.pWriteResultRegister = zydec_LinearContext_WriteResultRegister;
-  newInfo.pAfterCall = zydec_LinearContext_AfterCall;
+  const size_t slotMask = ((size_t)1 << (64 - pCache->slotShift)) - 1;
+  size_t slot = zydec_AddressCache_Slot(address, pCache->slotShift);
 
-  newInfo.pSetHintReg = zydec_LinearContext_HintRegister;
-  newInfo.pSetHintVal = zydec_LinearContext_HintValue;
-  newInfo.pSetHintOp = zydec_LinearContext_HintOperation;
+  while (pCache->pSlots[slot] != 0)
+  {
+    const size_t index = pCache->pSlots[slot] - 1;
 
-  const bool result = zydec_TranslateInstructionWithoutContext(pInstruction, pOperands, operandCount, virtualAddress, buffer, bufferCapacity, pHasTranslation, &newInfo);
+    if (pCache->pAddresses[index] == address)
+      return &pCache->pEntries[index];
 
-  for (size_t i = 0; i < formatContextInfo.assignedRegisterCount; i++)
-    pContext->regInfo[formatContextInfo.assignedRegister[i]] = formatContextInfo.assignedRegisterValue[i];
+    slot = (slot + 1) & slotMask;
+  }
 
-  return result;
+  return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-static const char RegisterNameLut[][32] = {
+static constexpr ZydecString RegisterNameLut[] = {
 
     "",
 
@@ -7273,7 +9304,7 @@ static const char RegisterNameLut[][32] = {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-const char *zydec_ResolveRegisterPrefix(const ZydisRegister reg)
+ZydecString zydec_ResolveRegisterPrefix(const ZydisRegister reg)
 {
   switch (reg)
   {
@@ -7496,7 +9527,20 @@ const char *zydec_ResolveRegisterPrefix(const ZydisRegister reg)
   }
 }
 
-const char *zydec_ResolveRegisterPostfix(const ZydisRegister reg)
+// The cast that reads an integer of `bitCount` bits as unsigned value.
+ZydecString zydec_ResolveUnsignedCast(const size_t bitCount)
+{
+  switch (bitCount)
+  {
+  case 8: return "(u8)";
+  case 16: return "(u16)";
+  case 32: return "(u32)";
+  case 64: return "(u64)";
+  default: return nullptr;
+  }
+}
+
+ZydecString zydec_ResolveRegisterPostfix(const ZydisRegister reg)
 {
   switch (reg)
   {
@@ -7634,92 +9678,192 @@ ZydisRegister zydec_ResolveBaseRegister(const ZydisRegister reg)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+inline uint64_t zydec_ByteSwap64(const uint64_t value)
+{
+#ifdef _MSC_VER
+  return _byteswap_uint64(value);
+#else
+  return __builtin_bswap64(value);
+#endif
+}
+
+// The number of significant bits of a non-zero value.
+inline size_t zydec_BitWidth64(const uint64_t value)
+{
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return (size_t)index + 1;
+#else
+  return 64 - (size_t)__builtin_clzll(value);
+#endif
+}
+
+inline size_t zydec_DecimalDigitCount(const uint64_t value)
+{
+  static const uint64_t powersOfTen[] = { 1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL };
+
+  // `1233 / 4096` approximates `log10(2)`, so this is the digit count or one more than that. Powers of ten are even, so setting the lowest bit doesn't change the result & makes zero a single digit.
+  const size_t estimate = (zydec_BitWidth64(value | 1) * 1233) >> 12;
+
+  return estimate + (size_t)((value | 1) >= powersOfTen[estimate]);
+}
+
+// Turns the eight nibbles of the value into uppercase hex digits, one per byte, with the most significant digit first in memory.
+inline uint64_t zydec_HexDigits32(const uint32_t value)
+{
+  uint64_t x = value;
+  x = ((x & 0x00000000FFFF0000ULL) << 16) | (x & 0x000000000000FFFFULL);
+  x = ((x & 0x0000FF000000FF00ULL) << 8) | (x & 0x000000FF000000FFULL);
+  x = ((x & 0x00F000F000F000F0ULL) << 4) | (x & 0x000F000F000F000FULL);
+
+  // Nibbles above 9 carry into the fifth bit of their byte when adding 6.
+  const uint64_t letters = ((x + 0x0606060606060606ULL) >> 4) & 0x0101010101010101ULL;
+  x += 0x3030303030303030ULL + letters * ('A' - '0' - 10);
+
+  return zydec_ByteSwap64(x);
+}
+
+template <typename TSink>
 bool zydec_WriteUInt(char **pBufferPos, size_t *pRemainingSize, const uint64_t value)
 {
-  if (value == 0)
-    return zydec_WriteRaw(pBufferPos, pRemainingSize, "0");
+  static const char digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+  const size_t length = zydec_DecimalDigitCount(value);
+  char *text;
+
+  ERROR_CHECK(TSink::Reserve(pBufferPos, pRemainingSize, length, &text));
+
+  if (text == nullptr)
+    return true;
 
-  char buffer[20];
-  buffer[sizeof(buffer) - 1] = '\0';
-  char *bufFromEnd = buffer + sizeof(buffer) - 2;
+  char *textFromEnd = text + length;
   uint64_t tmp = value;
 
-  while (tmp >= 10)
+  while (tmp >= 100)
   {
-    *bufFromEnd = (char)('0' + (tmp % 10));
-    bufFromEnd--;
-    tmp /= 10;
+    textFromEnd -= 2;
+    memcpy(textFromEnd, digitPairs + (tmp % 100) * 2, 2);
+    tmp /= 100;
   }
 
-  if (tmp != 0)
-    *bufFromEnd = (char)('0' + (tmp % 10));
+  if (tmp >= 10)
+    memcpy(text, digitPairs + tmp * 2, 2);
   else
-    bufFromEnd++;
+    *text = (char)('0' + tmp);
 
-  return zydec_WriteRaw(pBufferPos, pRemainingSize, bufFromEnd);
+  return true;
 }
 
+template <typename TSink>
 bool zydec_WriteHex(char **pBufferPos, size_t *pRemainingSize, const uint64_t value)
 {
-  if (value == 0)
-    return zydec_WriteRaw(pBufferPos, pRemainingSize, "0x0");
+  const size_t digitCount = (zydec_BitWidth64(value | 1) + 3) / 4;
+  char *text;
 
-  char buffer[2 + 2 * 8 + 1];
-  buffer[sizeof(buffer) - 1] = '\0';
-  char *bufFromEnd = buffer + sizeof(buffer) - 2;
-  uint64_t tmp = value;
+  ERROR_CHECK(TSink::Reserve(pBufferPos, pRemainingSize, 2 + digitCount, &text));
+
+  if (text == nullptr)
+    return true;
+
+  const uint64_t digits[2] = { zydec_HexDigits32((uint32_t)(value >> 32)), zydec_HexDigits32((uint32_t)value) };
+  const char *digitText = reinterpret_cast<const char *>(digits) + sizeof(digits) - digitCount;
 
-  const char lut[] = "0123456789ABCDEF";
+  text[0] = '0';
+  text[1] = 'x';
+  text += 2;
 
-  while (tmp >= 0xF)
+  // Two overlapping fixed size copies rather than one of variable size.
+  if (digitCount >= 8)
   {
-    *bufFromEnd = lut[tmp & 0xF];
-    bufFromEnd--;
-    tmp >>= 4;
+    memcpy(text, digitText, 8);
+    memcpy(text + digitCount - 8, digitText + digitCount - 8, 8);
   }
-
-  if (tmp != 0)
+  else if (digitCount >= 4)
   {
-    *bufFromEnd = lut[tmp & 0xF];
-    bufFromEnd--;
+    memcpy(text, digitText, 4);
+    memcpy(text + digitCount - 4, digitText + digitCount - 4, 4);
+  }
+  else
+  {
+    text[0] = digitText[0];
+    text[digitCount / 2] = digitText[digitCount / 2];
+    text[digitCount - 1] = digitText[digitCount - 1];
   }
 
-  *bufFromEnd = 'x';
-  bufFromEnd--;
-  *bufFromEnd = '0';
-
-  return zydec_WriteRaw(pBufferPos, pRemainingSize, bufFromEnd);
+  return true;
 }
 
+template <typename TSink>
 bool zydec_WriteInt(char **pBufferPos, size_t *pRemainingSize, const int64_t value)
 {
   if (value < 0)
   {
-    ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "-"));
-    return zydec_WriteUInt(pBufferPos, pRemainingSize, (uint64_t)-value);
+    ERROR_CHECK(TSink::Write(pBufferPos, pRemainingSize, "-"));
+    return zydec_WriteUInt<TSink>(pBufferPos, pRemainingSize, (uint64_t)-value);
   }
   else
   {
-    return zydec_WriteUInt(pBufferPos, pRemainingSize, (uint64_t)value);
+    return zydec_WriteUInt<TSink>(pBufferPos, pRemainingSize, (uint64_t)value);
+  }
+}
+
+static bool zydec_FormatNumber(bool (*write)(char **, size_t *, const uint64_t), const uint64_t value, char *buffer, const size_t bufferCapacity)
+{
+  if (buffer == nullptr || bufferCapacity == 0)
+    return false;
+
+  char *bufferPos = buffer;
+  size_t remainingSize = bufferCapacity - 1; // For the terminating zero.
+
+  if (!write(&bufferPos, &remainingSize, value))
+  {
+    buffer[0] = '\0';
+    return false;
   }
+
+  *bufferPos = '\0';
+
+  return true;
+}
+
+bool zydec_FormatUInt(const uint64_t value, char *buffer, const size_t bufferCapacity)
+{
+  return zydec_FormatNumber(zydec_WriteUInt<ZydecTextSink>, value, buffer, bufferCapacity);
+}
+
+bool zydec_FormatHex(const uint64_t value, char *buffer, const size_t bufferCapacity)
+{
+  return zydec_FormatNumber(zydec_WriteHex<ZydecTextSink>, value, buffer, bufferCapacity);
 }
 
+template <typename TPolicy>
 bool zydec_WriteResultOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags /* = zof_none */)
 {
-  return zydec_WriteOperand(pBufferPos, pRemainingSize, pOperand, virtualAddress, pInfo, flags, true);
+  return zydec_WriteOperand<TPolicy>(pBufferPos, pRemainingSize, pOperand, virtualAddress, pInfo, flags, true);
 }
 
+template <typename TPolicy>
 void zydec_HintOperand(const ZydisDecodedOperand *pOperand, ZydecFormattingInfo *pInfo)
 {
-  if (!pInfo->acceptHints)
+  if (!TPolicy::AcceptHints)
     return;
 
   switch (pOperand->type)
   {
   case ZYDIS_OPERAND_TYPE_REGISTER:
   {
-    if (pInfo->pSetHintReg != nullptr)
-      pInfo->pSetHintReg(pOperand->reg.value, pInfo->pRegUserData);
+    TPolicy::HintRegister(pOperand->reg.value, pInfo);
 
     return;
   }
@@ -7729,43 +9873,121 @@ void zydec_HintOperand(const ZydisDecodedOperand *pOperand, ZydecFormattingInfo
   }
 }
 
+template <typename TPolicy>
 void zydec_HintValue(const int64_t value, ZydecFormattingInfo *pInfo)
 {
-  if (!pInfo->acceptHints || pInfo->pSetHintVal == nullptr)
+  if (!TPolicy::AcceptHints)
     return;
 
-  pInfo->pSetHintVal(value, pInfo->pRegUserData);
+  TPolicy::HintValue(value, pInfo);
 }
 
+template <typename TPolicy>
 void zydec_HintOp(const ZydecFormattingInfo::HintOperation op, ZydecFormattingInfo *pInfo)
 {
-  if (!pInfo->acceptHints || pInfo->pSetHintOp == nullptr)
+  if (!TPolicy::AcceptHints)
     return;
 
-  pInfo->pSetHintOp(op, pInfo->pRegUserData);
+  TPolicy::HintOperation(op, pInfo);
+}
+
+// Writes `symbol`, `(symbol + offset)` or just the address, if no symbol could be found.
+template <typename TPolicy>
+static bool zydec_WriteAddress(char **pBufferPos, size_t *pRemainingSize, const uint64_t address, ZydecFormattingInfo *pInfo)
+{
+  if (TPolicy::MeasuresText)
+  {
+    const char *name = nullptr;
+    size_t nameLength = 0;
+    uint64_t offset = 0;
+    char friendlyName[1024];
+
+    const ZydecAddressCacheEntry *pCached = pInfo->pAddressCache != nullptr ? zydec_AddressCache_Find(pInfo->pAddressCache, address) : nullptr;
+
+    if (pCached != nullptr)
+    {
+      name = pCached->name;
+      nameLength = pCached->nameLength;
+      offset = pCached->offsetFromStart;
+    }
+    else if (pInfo->pSymbolTable != nullptr && zydec_SymbolTable_Find(pInfo->pSymbolTable, address, &name, &nameLength, &offset))
+    {
+      // `name` points into the symbol table.
+    }
+    else if (pInfo->pResolveAddressToFriendlyName != nullptr)
+    {
+      size_t friendlyNameOffset = 0;
+
+      if (pInfo->pResolveAddressToFriendlyName((size_t)address, friendlyName, sizeof(friendlyName), &friendlyNameOffset, pInfo->pUserData))
+      {
+        name = friendlyName;
+        nameLength = strlen(friendlyName);
+        offset = friendlyNameOffset;
+      }
+    }
+    else if (pInfo->pResolveAddressesToFriendlyNames != nullptr)
+    {
+      ZydecFormattingInfo::ResolvedAddress resolved = { nullptr, 0 };
+
+      if (pInfo->pResolveAddressesToFriendlyNames(&address, &resolved, 1, pInfo->pUserData) && resolved.name != nullptr)
+      {
+        name = resolved.name;
+        nameLength = strlen(resolved.name);
+        offset = resolved.offsetFromStart;
+      }
+    }
+
+    if (name != nullptr)
+    {
+      if (offset != 0)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "("));
+
+      ERROR_CHECK(zydec_WriteToken<TPolicy>(pBufferPos, pRemainingSize, name, nameLength, ZydecTokenKind::Symbol, pInfo));
+
+      if (offset != 0)
+      {
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " + "));
+        ERROR_CHECK(zydec_WriteHexToken<TPolicy>(pBufferPos, pRemainingSize, offset, ZydecTokenKind::Immediate, pInfo));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
+      }
+
+      return true;
+    }
+  }
+
+  return zydec_WriteHexToken<TPolicy>(pBufferPos, pRemainingSize, address, ZydecTokenKind::Address, pInfo);
 }
 
+template <typename TPolicy>
 bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDecodedOperand *pOperand, const size_t virtualAddress, ZydecFormattingInfo *pInfo, const ZydecOperandFlags flags /* = zof_none */, const bool isNewResult /* = false */)
 {
   switch (pOperand->type)
   {
   case ZYDIS_OPERAND_TYPE_REGISTER:
   {
-    ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->reg.value, pInfo, isNewResult));
+    ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->reg.value, pInfo, isNewResult, !!(flags & zof_unsigned)));
     break;
   }
 
   case ZYDIS_OPERAND_TYPE_MEMORY:
   {
-    ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, (pOperand->mem.type == ZYDIS_MEMOP_TYPE_AGEN || !!(flags & zof_noAddressDeref)) ? "(" : "*("));
+    if (!!(flags & zof_unsigned) && pOperand->mem.type == ZYDIS_MEMOP_TYPE_MEM && !(flags & zof_noAddressDeref))
+    {
+      const ZydecString cast = zydec_ResolveUnsignedCast(pOperand->size);
+
+      if (cast.length != 0)
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, cast));
+    }
+
+    ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, (pOperand->mem.type == ZYDIS_MEMOP_TYPE_AGEN || !!(flags & zof_noAddressDeref)) ? ZydecString("(") : ZydecString("*(")));
 
     switch (pOperand->mem.type)
     {
     case ZYDIS_MEMOP_TYPE_MEM:
     case ZYDIS_MEMOP_TYPE_VSIB:
     {
-      ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.segment, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ": "));
+      ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.segment, pInfo, false));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ": "));
 
       if (pOperand->mem.base == ZYDIS_REGISTER_RIP && (pOperand->mem.disp.has_displacement || pOperand->mem.index == ZYDIS_REGISTER_NONE))
       {
@@ -7774,63 +9996,43 @@ bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDe
         if (pOperand->mem.disp.has_displacement)
           ptr += pOperand->mem.disp.value;
 
-        char friendlyName[1024];
-        size_t friendlyNameOffset = 0;
-
-        if (pInfo->pResolveAddressToFriendlyName != nullptr && pInfo->pResolveAddressToFriendlyName(ptr, friendlyName, sizeof(friendlyName), &friendlyNameOffset, pInfo->pUserData))
-        {
-          if (friendlyNameOffset != 0)
-            zydec_WriteRaw(pBufferPos, pRemainingSize, "(");
-
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, friendlyName));
-
-          if (friendlyNameOffset != 0)
-          {
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " + "));
-            ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, friendlyNameOffset));
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
-          }
-        }
-        else
-        {
-          ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, ptr));
-        }
+        ERROR_CHECK(zydec_WriteAddress<TPolicy>(pBufferPos, pRemainingSize, ptr, pInfo));
       }
       else
       {
         if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-          ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.base, pInfo, false));
+          ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.base, pInfo, false));
 
         if (pOperand->mem.disp.has_displacement && pOperand->mem.disp.value != 0)
         {
           if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " "));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " "));
 
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "+ "));
-          ERROR_CHECK(zydec_WriteInt(pBufferPos, pRemainingSize, pOperand->mem.disp.value));
+          ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "+ "));
+          ERROR_CHECK(zydec_WriteIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.disp.value, ZydecTokenKind::Immediate, pInfo));
         }
         else if (pOperand->mem.index != ZYDIS_REGISTER_NONE)
         {
           if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " "));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " "));
 
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "+ "));
+          ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "+ "));
 
           if (pOperand->mem.scale != 1)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "("));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "("));
 
-          ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.index, pInfo, false));
+          ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.index, pInfo, false));
 
           if (pOperand->mem.scale != 1)
           {
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " * "));
-            ERROR_CHECK(zydec_WriteUInt(pBufferPos, pRemainingSize, pOperand->mem.scale));
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
+            ERROR_CHECK(zydec_WriteUIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.scale, ZydecTokenKind::Immediate, pInfo));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
           }
         }
       }
 
-      ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
 
       break;
     }
@@ -7838,8 +10040,8 @@ bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDe
     case ZYDIS_MEMOP_TYPE_MIB:
     case ZYDIS_MEMOP_TYPE_AGEN:
     {
-      ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.segment, pInfo, false));
-      ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ": "));
+      ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.segment, pInfo, false));
+      ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ": "));
 
       if (pOperand->mem.base == ZYDIS_REGISTER_RIP)
       {
@@ -7848,64 +10050,44 @@ bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDe
         if (pOperand->mem.disp.has_displacement)
           ptr += pOperand->mem.disp.value;
 
-        char friendlyName[1024];
-        size_t friendlyNameOffset = 0;
-
-        if (pInfo->pResolveAddressToFriendlyName != nullptr && pInfo->pResolveAddressToFriendlyName(ptr, friendlyName, sizeof(friendlyName), &friendlyNameOffset, pInfo->pUserData))
-        {
-          if (friendlyNameOffset != 0)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "("));
-
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, friendlyName));
-
-          if (friendlyNameOffset != 0)
-          {
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " + "));
-            ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, friendlyNameOffset));
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
-          }
-        }
-        else
-        {
-          ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, ptr));
-        }
+        ERROR_CHECK(zydec_WriteAddress<TPolicy>(pBufferPos, pRemainingSize, ptr, pInfo));
         
-        ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
       }
       else
       {
         if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-          ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.base, pInfo, false));
+          ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.base, pInfo, false));
 
         if (pOperand->mem.disp.has_displacement && pOperand->mem.disp.value != 0)
         {
           if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " "));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " "));
 
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "+ "));
-          ERROR_CHECK(zydec_WriteInt(pBufferPos, pRemainingSize, pOperand->mem.disp.value));
+          ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "+ "));
+          ERROR_CHECK(zydec_WriteIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.disp.value, ZydecTokenKind::Immediate, pInfo));
         }
         else if (pOperand->mem.index != ZYDIS_REGISTER_NONE)
         {
           if (pOperand->mem.base != ZYDIS_REGISTER_NONE)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " "));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " "));
 
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "+ "));
+          ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "+ "));
 
           if (pOperand->mem.scale != 1)
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "("));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, "("));
 
-          ERROR_CHECK(zydec_WriteRegister(pBufferPos, pRemainingSize, pOperand->mem.index, pInfo, false));
+          ERROR_CHECK(zydec_WriteRegister<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.index, pInfo, false));
 
           if (pOperand->mem.scale != 1)
           {
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " * "));
-            ERROR_CHECK(zydec_WriteUInt(pBufferPos, pRemainingSize, pOperand->mem.scale));
-            ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, " * "));
+            ERROR_CHECK(zydec_WriteUIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->mem.scale, ZydecTokenKind::Immediate, pInfo));
+            ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
           }
         }
 
-        ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
+        ERROR_CHECK(TPolicy::Write(pBufferPos, pRemainingSize, ")"));
       }
 
       break;
@@ -7922,34 +10104,14 @@ bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDe
   {
     if (pOperand->imm.is_relative)
     {
-      char friendlyName[1024];
-      size_t friendlyNameOffset = 0;
-
-      if (pInfo->pResolveAddressToFriendlyName != nullptr && pInfo->pResolveAddressToFriendlyName(virtualAddress + pOperand->imm.value.u, friendlyName, sizeof(friendlyName), &friendlyNameOffset, pInfo->pUserData))
-      {
-        if (friendlyNameOffset != 0)
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, "("));
-
-        ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, friendlyName));
-
-        if (friendlyNameOffset != 0)
-        {
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, " + "));
-          ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, friendlyNameOffset));
-          ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, ")"));
-        }
-      }
-      else
-      {
-        ERROR_CHECK(zydec_WriteHex(pBufferPos, pRemainingSize, virtualAddress + pOperand->imm.value.u));
-      }
+      ERROR_CHECK(zydec_WriteAddress<TPolicy>(pBufferPos, pRemainingSize, virtualAddress + pOperand->imm.value.u, pInfo));
     }
     else
     {
       if (pOperand->imm.is_signed)
-        ERROR_CHECK(zydec_WriteInt(pBufferPos, pRemainingSize, pOperand->imm.value.s));
+        ERROR_CHECK(zydec_WriteIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->imm.value.s, ZydecTokenKind::Immediate, pInfo));
       else
-        ERROR_CHECK(zydec_WriteUInt(pBufferPos, pRemainingSize, pOperand->imm.value.u));
+        ERROR_CHECK(zydec_WriteUIntToken<TPolicy>(pBufferPos, pRemainingSize, pOperand->imm.value.u, ZydecTokenKind::Immediate, pInfo));
     }
 
     break;
@@ -7962,57 +10124,70 @@ bool zydec_WriteOperand(char **pBufferPos, size_t *pRemainingSize, const ZydisDe
   return true;
 }
 
+template <typename TSink>
 bool zydec_WriteRegisterRaw(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg)
 {
   if (reg >= sizeof(RegisterNameLut) / sizeof(RegisterNameLut[0]))
     return false;
 
-  ERROR_CHECK(zydec_WriteRaw(pBufferPos, pRemainingSize, RegisterNameLut[reg]));
+  ERROR_CHECK(TSink::Write(pBufferPos, pRemainingSize, RegisterNameLut[reg]));
 
   return true;
 }
 
-bool zydec_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo, const bool isNewResult)
+template <typename TPolicy>
+bool zydec_WriteRegister(char **pBufferPos, size_t *pRemainingSize, const ZydisRegister reg, ZydecFormattingInfo *pInfo, const bool isNewResult, const bool isUnsigned /* = false */)
 {
-  const char *pre = zydec_ResolveRegisterPrefix(reg);
-  const char *post = zydec_ResolveRegisterPostfix(reg);
+  const ZydecString pre = zydec_ResolveRegisterPrefix(reg);
+  const ZydecString post = zydec_ResolveRegisterPostfix(reg);
   const ZydisRegister baseReg = zydec_ResolveBaseRegister(reg);
 
-  if (pre != nullptr && !zydec_WriteRaw(pBufferPos, pRemainingSize, pre))
+  // Integer prefixes (`(i64)`, `(i8)(`, ...) turn into their unsigned counterpart (`(u64)`, `(u8)(`, ...).
+  if (isUnsigned && pre.length > 2 && pre.text[1] == 'i')
+  {
+    if (!TPolicy::Write(pBufferPos, pRemainingSize, "(u") || !TPolicy::Write(pBufferPos, pRemainingSize, pre.text + 2, pre.length - 2))
+      return false;
+  }
+  else if (pre.length != 0 && !TPolicy::Write(pBufferPos, pRemainingSize, pre))
+  {
     return false;
+  }
 
-  if (pInfo == nullptr || (isNewResult && pInfo->pWriteResultRegister == nullptr) || (!isNewResult && pInfo->pWriteRegister == nullptr))
-    if (!zydec_WriteRegisterRaw(pBufferPos, pRemainingSize, baseReg))
-      return false;
+  const char *tokenStart = *pBufferPos;
 
   if (isNewResult)
   {
-    if (!pInfo->pWriteResultRegister(pBufferPos, pRemainingSize, baseReg, pInfo->pRegUserData))
+    if (!TPolicy::WriteResultRegister(pBufferPos, pRemainingSize, baseReg, pInfo))
       return false;
   }
   else
   {
-    if (!pInfo->pWriteRegister(pBufferPos, pRemainingSize, baseReg, pInfo->pRegUserData))
+    if (!TPolicy::WriteRegister(pBufferPos, pRemainingSize, baseReg, pInfo))
       return false;
   }
 
-  if (post != nullptr && !zydec_WriteRaw(pBufferPos, pRemainingSize, post))
+  zydec_EndToken<TPolicy>(pInfo, tokenStart, pBufferPos, TPolicy::RegisterTokenKind(pInfo, isNewResult));
+
+  if (post.length != 0 && !TPolicy::Write(pBufferPos, pRemainingSize, post))
     return false;
 
   return true;
 }
 
-bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const char *text)
+bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const char *text, const size_t length)
 {
-  const size_t length = strlen(text);
-
   if (length > *pRemainingSize)
     return false;
 
-  memcpy(*pBufferPos, text, length + 1);
+  memcpy(*pBufferPos, text, length);
 
   (*pRemainingSize) -= length;
   (*pBufferPos) += length;
 
   return true;
 }
+
+bool zydec_WriteRaw(char **pBufferPos, size_t *pRemainingSize, const ZydecString &string)
+{
+  return zydec_WriteRaw(pBufferPos, pRemainingSize, string.text, string.length);
+}